@@ -20,6 +20,11 @@
 
 #include "utility.h"
 
+#if defined(KD_CUSTOM_API_URL)
+#include <mutex>
+#include <optional>
+#endif
+
 namespace KDC {
 
 static const std::string prodInfomaniakApiUrl = "https://api.infomaniak.com/";
@@ -32,14 +37,17 @@ static const std::string prodLoginApiUrl = "https://login.infomaniak.com";
 static const std::string preprodLoginApiUrl = "https://login.preprod.dev.infomaniak.ch";
 
 std::string UrlHelper::infomaniakApiUrl(const uint8_t version /*= 2*/) {
+    if (const auto url = customApiUrl(); !url.empty()) return url + std::to_string(version);
     return (usePreProdUrl() ? preprodInfomaniakApiUrl : prodInfomaniakApiUrl) + std::to_string(version);
 }
 
 std::string UrlHelper::kDriveApiUrl(const uint8_t version /*= 2*/) {
+    if (const auto url = customApiUrl(); !url.empty()) return url + std::to_string(version);
     return (usePreProdUrl() ? preprodKDriveApiUrl : prodKDriveApiUrl) + std::to_string(version);
 }
 
 std::string UrlHelper::notifyApiUrl(const uint8_t version /*= 2*/) {
+    if (const auto url = customApiUrl(); !url.empty()) return url + std::to_string(version);
     return (usePreProdUrl() ? preprodNotifyApiUrl : prodNotifyApiUrl) + std::to_string(version);
 }
 
@@ -47,6 +55,30 @@ std::string UrlHelper::loginApiUrl() {
     return usePreProdUrl() ? preprodLoginApiUrl : prodLoginApiUrl;
 }
 
+#if defined(KD_CUSTOM_API_URL)
+namespace {
+
+std::mutex customApiUrlMutex;
+std::optional<std::string> customApiUrlValue;
+
+} // namespace
+
+std::string UrlHelper::customApiUrl() {
+    const std::scoped_lock lock(customApiUrlMutex);
+    if (!customApiUrlValue) customApiUrlValue = CommonUtility::envVarValue("KDRIVE_CUSTOM_API_URL");
+    return *customApiUrlValue;
+}
+
+void UrlHelper::setCustomApiUrl(const std::string &url) {
+    const std::scoped_lock lock(customApiUrlMutex);
+    customApiUrlValue = url;
+}
+#else
+std::string UrlHelper::customApiUrl() {
+    return {};
+}
+#endif
+
 bool UrlHelper::usePreProdUrl() {
     static const bool usePreProdUrl = CommonUtility::envVarValue("KDRIVE_USE_PREPROD_URL") == "1";
     return usePreProdUrl;
@@ -27,7 +27,21 @@ class UrlHelper {
         static std::string notifyApiUrl(uint8_t version = 2);
         static std::string loginApiUrl();
 
+#if defined(KD_CUSTOM_API_URL)
+        /**
+         * @brief Replace the URL read from the KDRIVE_CUSTOM_API_URL environment variable, e.g. to redirect the requests of a
+         * test to a local server. An empty URL restores the default ones.
+         */
+        static void setCustomApiUrl(const std::string &url);
+#endif
+
     private:
+        /**
+         * @brief In test and preprod builds, the base URL set in the KDRIVE_CUSTOM_API_URL environment variable, e.g.
+         * "http://127.0.0.1:8080/". If not empty, it replaces the base URL of the Infomaniak, kDrive and notification APIs.
+         * The variable is read once. Always empty in release builds.
+         */
+        static std::string customApiUrl();
         static bool usePreProdUrl();
 };
 
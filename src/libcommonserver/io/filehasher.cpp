@@ -0,0 +1,206 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filehasher.h"
+#include "iohelper.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#if defined(KD_MACOS) || defined(KD_LINUX)
+#include <cerrno>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace KDC {
+
+namespace {
+
+struct HashStateDeleter {
+        void operator()(XXH3_state_t *state) const { (void) XXH3_freeState(state); }
+};
+
+IoError hashStream(const SyncPath &path, XXH3_state_t *state, const size_t chunkSize) {
+    std::ifstream ifs;
+    IoError ioError = IoError::Success;
+    (void) IoHelper::openFile(path, ifs, ioError, 0); // No retry on a locked file
+    if (ioError != IoError::Success) return ioError;
+    if (!ifs.is_open()) return IoError::Unknown;
+
+    std::vector<char> buffer(chunkSize);
+    std::streamsize readBytes = 0;
+    while ((readBytes = ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size())).gcount()) > 0) {
+        if (XXH3_64bits_update(state, buffer.data(), static_cast<size_t>(readBytes)) == XXH_ERROR) return IoError::Unknown;
+    }
+
+    return ifs.bad() ? IoError::Unknown : IoError::Success;
+}
+
+#if defined(KD_MACOS) || defined(KD_LINUX)
+constexpr size_t mmapWindowSize = 64 * 1024 * 1024; // 64MB
+
+class FileDescriptor {
+    public:
+        explicit FileDescriptor(const int fd) :
+            _fd(fd) {}
+        ~FileDescriptor() {
+            if (_fd >= 0) (void) ::close(_fd);
+        }
+        FileDescriptor(FileDescriptor const &) = delete;
+        void operator=(FileDescriptor const &) = delete;
+
+        int get() const { return _fd; }
+
+    private:
+        const int _fd;
+};
+
+size_t pageSize() {
+    static const size_t size = [] {
+        const long value = sysconf(_SC_PAGESIZE);
+        return value > 0 ? static_cast<size_t>(value) : size_t{4096};
+    }();
+    return size;
+}
+
+size_t roundUpToPageSize(const size_t size) {
+    const size_t page = pageSize();
+    return std::max(page, (size + page - 1) / page * page);
+}
+
+void adviseSequentialAccess(const int fd, const bool dropPageCache) {
+#if defined(KD_LINUX)
+    (void) dropPageCache;
+    (void) posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    (void) fcntl(fd, F_RDAHEAD, 1);
+    // A range of pages cannot be dropped from the cache, the pages read are not kept at all instead
+    if (dropPageCache) (void) fcntl(fd, F_NOCACHE, 1);
+#endif
+}
+
+void dropFromPageCache(const int fd, const int64_t offset, const int64_t length) {
+#if defined(KD_LINUX)
+    (void) posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_DONTNEED);
+#else
+    (void) fd;
+    (void) offset;
+    (void) length;
+#endif
+}
+
+IoError hashLargeReads(const int fd, XXH3_state_t *state, const FileHasher::Settings &settings) {
+    const size_t readSize = roundUpToPageSize(settings.readSize);
+    const std::unique_ptr<char, decltype(&std::free)> buffer(static_cast<char *>(std::aligned_alloc(pageSize(), readSize)),
+                                                             &std::free);
+    if (!buffer) return IoError::Unknown;
+
+    adviseSequentialAccess(fd, settings.dropPageCache);
+
+    int64_t offset = 0;
+    int64_t droppedOffset = 0; // Page aligned
+    for (;;) {
+        const ssize_t readBytes = ::read(fd, buffer.get(), readSize);
+        if (readBytes < 0) {
+            if (errno == EINTR) continue;
+            return IoHelper::posixError2ioError(errno);
+        }
+        if (readBytes == 0) break;
+
+        if (XXH3_64bits_update(state, buffer.get(), static_cast<size_t>(readBytes)) == XXH_ERROR) return IoError::Unknown;
+        offset += readBytes;
+
+        if (settings.dropPageCache && offset - droppedOffset >= static_cast<int64_t>(readSize)) {
+            dropFromPageCache(fd, droppedOffset, offset - droppedOffset);
+            droppedOffset = offset - offset % static_cast<int64_t>(pageSize());
+        }
+    }
+
+    if (settings.dropPageCache && offset > droppedOffset) dropFromPageCache(fd, droppedOffset, offset - droppedOffset);
+    return IoError::Success;
+}
+
+// Only the first `size` bytes are hashed if the file grows in the meantime
+IoError hashMemoryMapped(const int fd, const int64_t size, XXH3_state_t *state, const FileHasher::Settings &settings) {
+    const auto windowSize = static_cast<int64_t>(std::max(roundUpToPageSize(settings.readSize), mmapWindowSize));
+    for (int64_t offset = 0; offset < size; offset += windowSize) {
+        const auto length = static_cast<size_t>(std::min(windowSize, size - offset));
+        void *const data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(offset));
+        if (data == MAP_FAILED) return IoHelper::posixError2ioError(errno);
+
+        (void) madvise(data, length, MADV_SEQUENTIAL);
+        const bool updated = XXH3_64bits_update(state, data, length) != XXH_ERROR;
+        (void) munmap(data, length);
+        if (!updated) return IoError::Unknown;
+
+        // The pages of the window can only be dropped once they are unmapped
+        if (settings.dropPageCache) dropFromPageCache(fd, offset, static_cast<int64_t>(length));
+    }
+
+    return IoError::Success;
+}
+#endif
+
+} // namespace
+
+IoError FileHasher::xxh3(const SyncPath &path, XXH64_hash_t &hash) noexcept {
+    return xxh3(path, hash, Settings());
+}
+
+IoError FileHasher::xxh3(const SyncPath &path, XXH64_hash_t &hash, const Settings &settings) noexcept {
+    try {
+        const std::unique_ptr<XXH3_state_t, HashStateDeleter> state(XXH3_createState());
+        if (!state || XXH3_64bits_reset(state.get()) == XXH_ERROR) return IoError::Unknown;
+
+        IoError ioError = IoError::Success;
+#if defined(KD_MACOS) || defined(KD_LINUX)
+        if (settings.strategy == Strategy::Buffered) {
+            ioError = hashStream(path, state.get(), BUFSIZ);
+        } else {
+            const FileDescriptor fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+            if (fd.get() < 0) return IoHelper::posixError2ioError(errno);
+
+            struct stat fileStat;
+            if (fstat(fd.get(), &fileStat) != 0) return IoHelper::posixError2ioError(errno);
+
+            const bool mapped = settings.strategy == Strategy::MemoryMapped ||
+                                (settings.strategy == Strategy::Auto && fileStat.st_size >= settings.mmapThreshold);
+            ioError = mapped ? hashMemoryMapped(fd.get(), fileStat.st_size, state.get(), settings)
+                             : hashLargeReads(fd.get(), state.get(), settings);
+        }
+#else
+        ioError = hashStream(path, state.get(), settings.strategy == Strategy::Buffered ? BUFSIZ : settings.readSize);
+#endif
+        if (ioError != IoError::Success) return ioError;
+
+        hash = XXH3_64bits_digest(state.get());
+        return IoError::Success;
+    } catch (...) {
+        // E.g. `std::bad_alloc` with a huge read size
+        return IoError::Unknown;
+    }
+}
+
+} // namespace KDC
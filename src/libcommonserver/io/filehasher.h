@@ -0,0 +1,59 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "libcommonserver/commonserverlib.h"
+#include "libcommon/utility/types.h"
+
+#include <xxhash.h>
+
+namespace KDC {
+
+/**
+ * XXH3 hash of the content of a file.
+ * Large reads announce a sequential access to the kernel and drop the pages already hashed from the page cache, so that
+ * hashing a large video does not evict the files the user is working on. Pages that were cached before are dropped as well.
+ * Memory mapping is opt-in: a file truncated while it is mapped makes the process receive SIGBUS.
+ * On Windows, large reads go through a file stream and memory mapping falls back to large reads.
+ */
+class COMMONSERVER_EXPORT FileHasher {
+    public:
+        enum class Strategy {
+            Buffered, // `BUFSIZ` reads, as done before large reads were introduced
+            LargeReads,
+            MemoryMapped,
+            Auto // Memory mapping for the files of at least `mmapThreshold` bytes, large reads otherwise
+        };
+
+        static constexpr size_t defaultReadSize = 2 * 1024 * 1024; // 2MB
+        static constexpr int64_t defaultMmapThreshold = 64 * 1024 * 1024; // 64MB
+
+        struct Settings {
+                Strategy strategy{Strategy::LargeReads};
+                // Rounded up to a multiple of the page size
+                size_t readSize{defaultReadSize};
+                int64_t mmapThreshold{defaultMmapThreshold};
+                bool dropPageCache{true};
+        };
+
+        static IoError xxh3(const SyncPath &path, XXH64_hash_t &hash) noexcept;
+        static IoError xxh3(const SyncPath &path, XXH64_hash_t &hash, const Settings &settings) noexcept;
+};
+
+} // namespace KDC
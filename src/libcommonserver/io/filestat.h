@@ -25,6 +25,8 @@ namespace KDC {
 struct FileStat {
         SyncTime creationTime = 0;
         SyncTime modificationTime = 0;
+        // Last status change time (ctime), updated by any metadata or content change.
+        SyncTime changeTime = 0;
         int64_t size = 0;
         uint64_t inode = 0;
         bool isHidden = false;
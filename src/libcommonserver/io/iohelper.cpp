@@ -26,7 +26,9 @@
 #include <system_error>
 
 #if defined(KD_MACOS) || defined(KD_LINUX)
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #endif
 #include <fstream>
 #include <log4cplus/loggingmacros.h> // LOGW_WARN
@@ -1075,6 +1077,15 @@ bool IoHelper::_setRightsStd(const SyncPath &path, bool read, bool write, bool e
 }
 
 #if defined(KD_MACOS) || defined(KD_LINUX)
+IoError IoHelper::syncFile(const SyncPath &filePath) noexcept {
+    const int fd = open(filePath.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return posixError2ioError(errno);
+
+    const IoError ioError = fsync(fd) == 0 ? IoError::Success : posixError2ioError(errno);
+    (void) close(fd);
+    return ioError;
+}
+
 NodeType IoHelper::getTargetNodeType(const SyncPath &path) {
     auto nodeType = NodeType::Unknown;
     if (struct stat sbTarget; stat(path.string().c_str(), &sbTarget) >= 0) {
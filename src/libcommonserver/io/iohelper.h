@@ -517,6 +517,21 @@ struct IoHelper {
         static IoError setFileDates(const KDC::SyncPath &filePath, SyncTime creationDate, SyncTime modificationDate,
                                     bool symlink) noexcept;
 
+        /**
+         * @brief Reserve on disk the space of a file that is about to be written, without changing its size.
+         * Nothing is reserved on the file systems that do not support it.
+         * @param filePath The absolute path to the file.
+         * @param size The expected final size of the file.
+         * @return IoError::Success if the space has been reserved or cannot be, IoError::DiskFull if there is not enough space.
+         */
+        static IoError preallocateFile(const SyncPath &filePath, int64_t size) noexcept;
+        /**
+         * @brief Flush the content of a file to the storage device.
+         * @param filePath The absolute path to the file.
+         * @return IoError::Success if the process succeeds. An appropriate IoError otherwise.
+         */
+        static IoError syncFile(const SyncPath &filePath) noexcept;
+
         static inline bool isLink(LinkType linkType) {
             return linkType == LinkType::Symlink || linkType == LinkType::Hardlink ||
                    (linkType == LinkType::FinderAlias && CommonUtility::isMac()) ||
@@ -97,6 +97,7 @@ bool IoHelper::_getFileStatFn(const SyncPath &path, FileStat *buf, IoError &ioEr
     }
 
     buf->modificationTime = sb.stx_mtime.tv_sec;
+    buf->changeTime = sb.stx_ctime.tv_sec;
     buf->size = static_cast<int64_t>(sb.stx_size);
     buf->nodeType = S_ISDIR(sb.stx_mode) ? NodeType::Directory : NodeType::File;
 
@@ -120,6 +121,20 @@ IoError IoHelper::setFileDates(const SyncPath &filePath, const SyncTime /*creati
     return IoError::Success;
 }
 
+IoError IoHelper::preallocateFile(const SyncPath &filePath, const int64_t size) noexcept {
+    if (size <= 0) return IoError::Success;
+
+    const int fd = open(filePath.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return posixError2ioError(errno);
+
+    IoError ioError = IoError::Success;
+    if (fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) != 0 && errno != EOPNOTSUPP && errno != ENOSYS) {
+        ioError = posixError2ioError(errno);
+    }
+    (void) close(fd);
+    return ioError;
+}
+
 IoError IoHelper::lock(const SyncPath &) noexcept {
     return IoError::Success; // Only on macOS
 }
@@ -29,6 +29,8 @@
 
 #include <sys/xattr.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace KDC {
 
@@ -162,6 +164,7 @@ bool IoHelper::_getFileStatFn(const SyncPath &path, FileStat *buf, IoError &ioEr
     buf->creationTime =
             sb.st_birthtime; // Supported on all 64-bits macOS versions (32-bits macOS are not supported since nov 2014).
     buf->modificationTime = sb.st_mtime;
+    buf->changeTime = sb.st_ctime;
     buf->size = sb.st_size;
     buf->nodeType = S_ISDIR(sb.st_mode) ? NodeType::Directory : NodeType::File;
 
@@ -170,6 +173,28 @@ bool IoHelper::_getFileStatFn(const SyncPath &path, FileStat *buf, IoError &ioEr
     return true;
 }
 
+IoError IoHelper::preallocateFile(const SyncPath &filePath, const int64_t size) noexcept {
+    if (size <= 0) return IoError::Success;
+
+    const int fd = open(filePath.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return posixError2ioError(errno);
+
+    // Try a contiguous allocation first, F_PREALLOCATE does not change the file size.
+    fstore_t store = {F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0};
+    int rc = fcntl(fd, F_PREALLOCATE, &store);
+    if (rc == -1) {
+        store.fst_flags = F_ALLOCATEALL;
+        rc = fcntl(fd, F_PREALLOCATE, &store);
+    }
+
+    IoError ioError = IoError::Success;
+    if (rc == -1 && errno != ENOTSUP) {
+        ioError = posixError2ioError(errno);
+    }
+    (void) close(fd);
+    return ioError;
+}
+
 IoError IoHelper::lock(const SyncPath &path) noexcept {
     // Set uchg flag to lock the item.
     if (chflags(path.string().c_str(), UF_IMMUTABLE)) {
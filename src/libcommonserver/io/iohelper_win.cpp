@@ -334,6 +334,7 @@ bool IoHelper::_getFileStatFn(const SyncPath &path, FileStat *filestat, IoError
     DWORD rem;
     filestat->modificationTime = FileTimeToUnixTime(pFileInfo->LastWriteTime, &rem);
     filestat->creationTime = FileTimeToUnixTime(pFileInfo->CreationTime, &rem);
+    filestat->changeTime = FileTimeToUnixTime(pFileInfo->ChangeTime, &rem);
 
     filestat->isHidden = pFileInfo->FileAttributes & FILE_ATTRIBUTE_HIDDEN;
     filestat->nodeType = pFileInfo->FileAttributes & FILE_ATTRIBUTE_DIRECTORY ? NodeType::Directory : NodeType::File;
@@ -792,6 +793,43 @@ IoError IoHelper::setRights(const SyncPath &path, bool read, bool write, bool ex
     return ioError;
 }
 
+IoError IoHelper::preallocateFile(const SyncPath &filePath, const int64_t size) noexcept {
+    if (size <= 0) return IoError::Success;
+
+    HANDLE hFile = CreateFileW(Path2WStr(filePath).c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return dWordError2ioError(GetLastError(), logger());
+    }
+
+    // The allocation size is independent of the end of file position.
+    FILE_ALLOCATION_INFO allocationInfo;
+    allocationInfo.AllocationSize.QuadPart = size;
+    IoError ioError = IoError::Success;
+    if (!SetFileInformationByHandle(hFile, FileAllocationInfo, &allocationInfo, sizeof(allocationInfo))) {
+        if (const DWORD dwError = GetLastError(); dwError == ERROR_DISK_FULL) {
+            ioError = IoError::DiskFull;
+        }
+    }
+    CloseHandle(hFile);
+    return ioError;
+}
+
+IoError IoHelper::syncFile(const SyncPath &filePath) noexcept {
+    HANDLE hFile = CreateFileW(Path2WStr(filePath).c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return dWordError2ioError(GetLastError(), logger());
+    }
+
+    IoError ioError = IoError::Success;
+    if (!FlushFileBuffers(hFile)) {
+        ioError = dWordError2ioError(GetLastError(), logger());
+    }
+    CloseHandle(hFile);
+    return ioError;
+}
+
 IoError IoHelper::lock(const SyncPath &path) noexcept {
     return IoError::Success;
 }
@@ -0,0 +1,121 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "freediskspacetracker.h"
+#include "libcommonserver/io/iohelper.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <algorithm>
+
+namespace KDC {
+
+std::shared_ptr<FreeDiskSpaceTracker> FreeDiskSpaceTracker::_instance = nullptr;
+
+std::shared_ptr<FreeDiskSpaceTracker> FreeDiskSpaceTracker::instance() {
+    static std::mutex instanceMutex;
+    const std::scoped_lock lock(instanceMutex);
+    if (_instance == nullptr) {
+        _instance = std::make_shared<FreeDiskSpaceTracker>(&Utility::getFreeDiskSpace);
+    }
+
+    return _instance;
+}
+
+void FreeDiskSpaceTracker::reset() {
+    _instance.reset();
+}
+
+FreeDiskSpaceTracker::FreeDiskSpaceTracker(const FreeDiskSpaceProvider &provider,
+                                           std::chrono::steady_clock::duration refreshInterval, int64_t refreshMargin) :
+    _provider(provider),
+    _refreshInterval(refreshInterval),
+    _refreshMargin(refreshMargin) {}
+
+int64_t FreeDiskSpaceTracker::freeDiskSpace(const SyncPath &path, int64_t neededSpace) {
+    const std::scoped_lock lock(_mutex);
+
+    Volume *volume = findVolume(path);
+    if (!volume) {
+        // Identify the volume by the directory actually queried, so that the other items of this directory are found
+        Volume newVolume;
+        if (!query(path, newVolume)) return -1;
+
+        bool isDirectory = false;
+        auto ioError = IoError::Success;
+        (void) IoHelper::checkIfIsDirectory(path, isDirectory, ioError);
+        const auto it = _volumes.try_emplace(isDirectory ? path : path.parent_path(), newVolume).first;
+        volume = &it->second;
+    } else {
+        const bool expired = std::chrono::steady_clock::now() - volume->queryTime >= _refreshInterval;
+        const bool nearLimit =
+                volume->freeSpace - volume->reservedSpace < neededSpace + Utility::freeDiskSpaceLimit() + _refreshMargin;
+        if ((expired || nearLimit) && !query(path, *volume)) return -1;
+    }
+
+    return volume->freeSpace - volume->reservedSpace;
+}
+
+void FreeDiskSpaceTracker::reserve(const SyncPath &path, int64_t size) {
+    const std::scoped_lock lock(_mutex);
+    if (Volume *volume = findVolume(path); volume) {
+        volume->reservedSpace += size;
+    }
+}
+
+void FreeDiskSpaceTracker::release(const SyncPath &path, int64_t size, bool written) {
+    const std::scoped_lock lock(_mutex);
+    if (Volume *volume = findVolume(path); volume) {
+        volume->reservedSpace = std::max<int64_t>(volume->reservedSpace - size, 0);
+        // The data may already be accounted for if the free space has been queried since, it will be fixed by the next query
+        if (written) volume->freeSpace -= size;
+    }
+}
+
+void FreeDiskSpaceTracker::clear() {
+    const std::scoped_lock lock(_mutex);
+    _volumes.clear();
+}
+
+uint64_t FreeDiskSpaceTracker::queryCount() const {
+    const std::scoped_lock lock(_mutex);
+    return _queryCount;
+}
+
+FreeDiskSpaceTracker::Volume *FreeDiskSpaceTracker::findVolume(const SyncPath &path) {
+    if (_volumes.empty()) return nullptr;
+
+    for (SyncPath ancestor = path; !ancestor.empty(); ancestor = ancestor.parent_path()) {
+        if (const auto it = _volumes.find(ancestor); it != _volumes.end()) return &it->second;
+        if (ancestor == ancestor.parent_path()) break; // Root reached
+    }
+
+    return nullptr;
+}
+
+bool FreeDiskSpaceTracker::query(const SyncPath &path, Volume &volume) {
+    ++_queryCount;
+    const int64_t freeSpace = _provider(path);
+    if (freeSpace < 0) return false;
+
+    volume.freeSpace = freeSpace;
+    volume.queryTime = std::chrono::steady_clock::now();
+    return true;
+}
+
+} // namespace KDC
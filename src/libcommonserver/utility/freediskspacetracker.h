@@ -0,0 +1,90 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "libcommonserver/commonserverlib.h"
+#include "libcommon/utility/types.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace KDC {
+
+/**
+ * Cache of the free disk space, so that the sync engine does not query the file system before each operation.
+ * A volume is identified by the first directory queried on it (e.g. a sync root) and covers all the paths below it.
+ * The cached value is queried again when it is older than the refresh interval or when it gets close to the space needed
+ * plus the free disk space limit, so that a lack of space is always reported from a fresh value.
+ * The space reserved by the ongoing downloads is subtracted from the cached value.
+ */
+class COMMONSERVER_EXPORT FreeDiskSpaceTracker {
+    public:
+        // Returns the free disk space in bytes at the given path, or -1 if an error occurs
+        using FreeDiskSpaceProvider = std::function<int64_t(const SyncPath &path)>;
+
+        static constexpr std::chrono::seconds defaultRefreshInterval{10};
+        static constexpr int64_t defaultRefreshMargin = 1000 * 1000 * 1000LL; // 1GB
+
+        static std::shared_ptr<FreeDiskSpaceTracker> instance();
+        static void reset();
+
+        explicit FreeDiskSpaceTracker(const FreeDiskSpaceProvider &provider,
+                                      std::chrono::steady_clock::duration refreshInterval = defaultRefreshInterval,
+                                      int64_t refreshMargin = defaultRefreshMargin);
+
+        FreeDiskSpaceTracker(FreeDiskSpaceTracker const &) = delete;
+        void operator=(FreeDiskSpaceTracker const &) = delete;
+
+        // Returns the free disk space in bytes at `path` minus the reserved space, or -1 if an error occurs
+        int64_t freeDiskSpace(const SyncPath &path, int64_t neededSpace = 0);
+
+        // Account for a download of `size` bytes to `path` until it is released
+        void reserve(const SyncPath &path, int64_t size);
+        // `written` is true if the downloaded data is now on disk, i.e. not yet seen by the last query of the free space
+        void release(const SyncPath &path, int64_t size, bool written);
+
+        void clear();
+
+        uint64_t queryCount() const;
+
+    private:
+        struct Volume {
+                int64_t freeSpace{-1};
+                int64_t reservedSpace{0};
+                std::chrono::steady_clock::time_point queryTime;
+        };
+
+        static std::shared_ptr<FreeDiskSpaceTracker> _instance;
+
+        const FreeDiskSpaceProvider _provider;
+        const std::chrono::steady_clock::duration _refreshInterval;
+        const int64_t _refreshMargin;
+        std::map<SyncPath, Volume> _volumes;
+        uint64_t _queryCount{0};
+        mutable std::mutex _mutex;
+
+        Volume *findVolume(const SyncPath &path);
+        bool query(const SyncPath &path, Volume &volume);
+};
+
+} // namespace KDC
@@ -1499,6 +1499,7 @@ bool ParmsDb::deleteUser(const UserDbId dbId, bool &found) {
     }
     if (numRowsAffected() == 1) {
         found = true;
+        ++_syncsRevision; // The syncs of the deleted user are deleted in cascade
     } else {
         LOG_WARN(_logger, "Error running query: " << DELETE_USER_REQUEST_ID << " - num rows affected != 1");
         found = false;
@@ -1802,6 +1803,7 @@ bool ParmsDb::deleteAccount(const AccountDbId dbId, bool &found) {
     }
     if (numRowsAffected() == 1) {
         found = true;
+        ++_syncsRevision; // The syncs of the deleted account are deleted in cascade
     } else {
         LOG_WARN(_logger, "Error running query: " << DELETE_ACCOUNT_REQUEST_ID << " - num rows affected != 1");
         found = false;
@@ -2011,6 +2013,7 @@ bool ParmsDb::deleteDrive(const DriveDbId dbId, bool &found) {
     }
     if (numRowsAffected() == 1) {
         found = true;
+        ++_syncsRevision; // The syncs of the deleted drive are deleted in cascade
     } else {
         LOG_WARN(_logger, "Error running query: " << DELETE_DRIVE_REQUEST_ID << " - num rows affected != 1");
         found = false;
@@ -2258,6 +2261,7 @@ bool ParmsDb::insertSync(const Sync &sync) {
         LOG_WARN(_logger, "Error running query: " << requestId);
         return false;
     }
+    ++_syncsRevision;
 
     return true;
 }
@@ -2294,6 +2298,7 @@ bool ParmsDb::updateSync(const Sync &sync, bool &found) {
     }
     if (numRowsAffected() == 1) {
         found = true;
+        ++_syncsRevision;
     } else {
         LOG_WARN(_logger, "Error running query: " << UPDATE_SYNC_REQUEST_ID << " - num rows affected != 1");
         found = false;
@@ -2317,6 +2322,7 @@ bool ParmsDb::setSyncPaused(const SyncDbId dbId, bool value, bool &found) {
     }
     if (numRowsAffected() == 1) {
         found = true;
+        ++_syncsRevision;
     } else {
         LOG_WARN(_logger, "Error running query: " << UPDATE_SYNC_PAUSED_REQUEST_ID << " - num rows affected != 1");
         found = false;
@@ -2340,6 +2346,7 @@ bool ParmsDb::setSyncHasFullyCompleted(const SyncDbId dbId, bool value, bool &fo
     }
     if (numRowsAffected() == 1) {
         found = true;
+        ++_syncsRevision;
     } else {
         LOG_WARN(_logger, "Error running query: " << UPDATE_SYNC_HASFULLYCOMPLETED_REQUEST_ID << " - num rows affected != 1");
         found = false;
@@ -2362,6 +2369,7 @@ bool ParmsDb::deleteSync(const SyncDbId dbId, bool &found) {
     }
     if (numRowsAffected() == 1) {
         found = true;
+        ++_syncsRevision;
     } else {
         LOG_WARN(_logger, "Error running query: " << DELETE_SYNC_REQUEST_ID << " - num rows affected != 1");
         found = false;
@@ -32,6 +32,8 @@
 #include "migrationselectivesync.h"
 #include "libcommonserver/db/db.h"
 
+#include <atomic>
+
 namespace KDC {
 
 class PARMS_EXPORT ParmsDb : public Db {
@@ -96,6 +98,8 @@ class PARMS_EXPORT ParmsDb : public Db {
         bool selectAllSyncs(std::vector<Sync> &syncList);
         bool selectAllSyncs(DriveDbId driveDbId, std::vector<Sync> &syncList);
         bool getNewSyncDbId(SyncDbId &dbId);
+        // Incremented each time a sync record is inserted, updated or deleted, including by the deletion of its drive
+        uint64_t syncsRevision() const { return _syncsRevision; }
 
         bool insertExclusionTemplate(const ExclusionTemplate &exclusionTemplate, bool &constraintError);
         bool updateExclusionTemplate(const ExclusionTemplate &exclusionTemplate, bool &found);
@@ -146,6 +150,7 @@ class PARMS_EXPORT ParmsDb : public Db {
     private:
         friend class TestParmsDb;
         bool _test{false};
+        std::atomic_uint64_t _syncsRevision{0};
 
         static std::shared_ptr<ParmsDb> _instance;
 
@@ -262,6 +262,11 @@
     "DELETE FROM sync_node "     \
     "WHERE nodeid=?1;"
 
+#define DELETE_SYNC_NODE_BY_TYPE_REQUEST_ID "delete_sync_node_by_type"
+#define DELETE_SYNC_NODE_BY_TYPE_REQUEST \
+    "DELETE FROM sync_node "             \
+    "WHERE nodeid=?1 AND type=?2;"
+
 #define DELETE_ALL_SYNC_NODE_BY_TYPE_REQUEST_ID "delete_all_sync_node_by_type"
 #define DELETE_ALL_SYNC_NODE_BY_TYPE_REQUEST \
     "DELETE FROM sync_node "                 \
@@ -297,6 +302,45 @@
 #define DELETE_ALL_UPLOAD_SESSION_TOKEN_REQUEST_ID "delete_all_upload_session_token"
 #define DELETE_ALL_UPLOAD_SESSION_TOKEN_REQUEST "DELETE FROM upload_session_token;"
 
+//
+// checksum_cache
+//
+#define CREATE_CHECKSUM_CACHE_TABLE_ID "create_checksum_cache"
+#define CREATE_CHECKSUM_CACHE_TABLE              \
+    "CREATE TABLE IF NOT EXISTS checksum_cache(" \
+    "nodeId TEXT PRIMARY KEY,"                   \
+    "size INTEGER NOT NULL,"                     \
+    "modified INTEGER NOT NULL,"                 \
+    "changed INTEGER NOT NULL,"                  \
+    "checksum TEXT NOT NULL);"
+
+#define INSERT_CHECKSUM_CACHE_REQUEST_ID "insert_checksum_cache"
+#define INSERT_CHECKSUM_CACHE_REQUEST                                                      \
+    "INSERT OR REPLACE INTO checksum_cache (nodeId, size, modified, changed, checksum) " \
+    "VALUES (?1, ?2, ?3, ?4, ?5);"
+
+#define SELECT_CHECKSUM_CACHE_REQUEST_ID "select_checksum_cache"
+#define SELECT_CHECKSUM_CACHE_REQUEST      \
+    "SELECT checksum FROM checksum_cache " \
+    "WHERE nodeId=?1 AND size=?2 AND modified=?3 AND changed=?4;"
+
+#define DELETE_CHECKSUM_CACHE_REQUEST_ID "delete_checksum_cache"
+#define DELETE_CHECKSUM_CACHE_REQUEST \
+    "DELETE FROM checksum_cache "     \
+    "WHERE nodeId=?1;"
+
+#define DELETE_ALL_CHECKSUM_CACHE_REQUEST_ID "delete_all_checksum_cache"
+#define DELETE_ALL_CHECKSUM_CACHE_REQUEST "DELETE FROM checksum_cache;"
+
+#define SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID "select_all_checksum_cache"
+#define SELECT_ALL_CHECKSUM_CACHE_REQUEST "SELECT nodeId, size, modified, changed, checksum FROM checksum_cache;"
+
+// Also fired by the cascade deletion of the children of a deleted node
+#define CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER_ID "create_checksum_cache_node_delete_trigger"
+#define CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER                                   \
+    "CREATE TRIGGER IF NOT EXISTS checksum_cache_node_delete AFTER DELETE ON node " \
+    "BEGIN DELETE FROM checksum_cache WHERE nodeId=OLD.nodeIdLocal; END;"
+
 namespace KDC {
 
 DbNode SyncDb::_driveRootNode(0, std::nullopt, SyncName(), SyncName(), "1", "1", std::nullopt, std::nullopt, std::nullopt,
@@ -388,6 +432,9 @@ bool SyncDb::create(bool &retry) {
     }
     queryFree(CREATE_UPLOAD_SESSION_TOKEN_TABLE_ID);
 
+    // Checksum cache table
+    if (!createChecksumCacheTable()) return false;
+
     return true;
 }
 
@@ -430,6 +477,7 @@ bool SyncDb::prepare() {
     if (!createAndPrepareRequest(DELETE_ALL_SYNC_NODE_BY_TYPE_REQUEST_ID, DELETE_ALL_SYNC_NODE_BY_TYPE_REQUEST)) return false;
     if (!createAndPrepareRequest(SELECT_ALL_SYNC_NODE_REQUEST_ID, SELECT_ALL_SYNC_NODE_REQUEST)) return false;
     if (!createAndPrepareRequest(DELETE_SYNC_NODE_REQUEST_ID, DELETE_SYNC_NODE_REQUEST)) return false;
+    if (!createAndPrepareRequest(DELETE_SYNC_NODE_BY_TYPE_REQUEST_ID, DELETE_SYNC_NODE_BY_TYPE_REQUEST)) return false;
 
     // Upload session token table
     if (!createAndPrepareRequest(INSERT_UPLOAD_SESSION_TOKEN_REQUEST_ID, INSERT_UPLOAD_SESSION_TOKEN_REQUEST)) return false;
@@ -440,6 +488,13 @@ bool SyncDb::prepare() {
     if (!createAndPrepareRequest(SELECT_ALL_UPLOAD_SESSION_TOKEN_REQUEST_ID, SELECT_ALL_UPLOAD_SESSION_TOKEN_REQUEST))
         return false;
 
+    // Checksum cache table
+    if (!createAndPrepareRequest(INSERT_CHECKSUM_CACHE_REQUEST_ID, INSERT_CHECKSUM_CACHE_REQUEST)) return false;
+    if (!createAndPrepareRequest(SELECT_CHECKSUM_CACHE_REQUEST_ID, SELECT_CHECKSUM_CACHE_REQUEST)) return false;
+    if (!createAndPrepareRequest(DELETE_CHECKSUM_CACHE_REQUEST_ID, DELETE_CHECKSUM_CACHE_REQUEST)) return false;
+    if (!createAndPrepareRequest(DELETE_ALL_CHECKSUM_CACHE_REQUEST_ID, DELETE_ALL_CHECKSUM_CACHE_REQUEST)) return false;
+    if (!createAndPrepareRequest(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID, SELECT_ALL_CHECKSUM_CACHE_REQUEST)) return false;
+
     if (!initData()) {
         LOG_WARN(_logger, "Error in initParameters");
         return false;
@@ -591,6 +646,9 @@ bool SyncDb::upgrade(const std::string &fromVersion, const std::string &toVersio
     }
 #endif // KD_WINDOWS
 
+    // The checksum cache table is created if missing, whatever the version of the DB.
+    if (!createChecksumCacheTable()) return false;
+
     LOG_DEBUG(_logger, "Upgrade of Sync DB successfully completed.");
 
     return true;
@@ -826,7 +884,7 @@ bool SyncDb::checkNodeIds(const DbNode &node) {
 bool SyncDb::insertNode(const DbNode &node, DbNodeId &dbNodeId, bool &constraintError) {
     const std::scoped_lock lock(_mutex);
     if (!checkNodeIds(node)) return false;
-    invalidateCache();
+    if (!commitWriteBatch()) return false; // Committed on its own
 
     const char *queryId = INSERT_NODE_REQUEST_ID;
     int errId;
@@ -853,6 +911,7 @@ bool SyncDb::insertNode(const DbNode &node, DbNodeId &dbNodeId, bool &constraint
         constraintError = (errId == SQLITE_CONSTRAINT);
         return false;
     }
+    invalidateCache(dbNodeId);
 
     return true;
 }
@@ -866,7 +925,8 @@ bool SyncDb::insertNode(const DbNode &node) {
 bool SyncDb::updateNode(const DbNode &node, bool &found) {
     const std::scoped_lock lock(_mutex);
     if (!checkNodeIds(node)) return false;
-    invalidateCache();
+    invalidateCache(node.nodeId());
+    if (!beginWrite()) return false;
 
     SyncName remoteNormalizedName;
     if (!Utility::normalizedSyncName(node.nameRemote(), remoteNormalizedName)) {
@@ -908,13 +968,15 @@ bool SyncDb::updateNode(const DbNode &node, bool &found) {
         LOG_WARN(_logger, "Error running query: " << UPDATE_NODE_REQUEST_ID << " - num rows affected != 1");
         found = false;
     }
+    if (!endWrite()) return false;
 
     return true;
 }
 
 bool SyncDb::updateNodeStatus(DbNodeId nodeId, SyncFileStatus status, bool &found) {
     const std::scoped_lock lock(_mutex);
-    invalidateCache();
+    invalidateCache(nodeId);
+    if (!beginWrite()) return false;
 
     int errId;
     std::string error;
@@ -932,13 +994,15 @@ bool SyncDb::updateNodeStatus(DbNodeId nodeId, SyncFileStatus status, bool &foun
         LOG_WARN(_logger, "Error running query: " << UPDATE_NODE_STATUS_REQUEST_ID << " - num rows affected != 1");
         found = false;
     }
+    if (!endWrite()) return false;
 
     return true;
 }
 
 bool SyncDb::updateNodeLocalName(DbNodeId nodeId, const SyncName &nameLocal, bool &found) {
     const std::scoped_lock lock(_mutex);
-    invalidateCache();
+    invalidateCache(nodeId);
+    if (!beginWrite()) return false;
 
     const char *queryId = UPDATE_NODE_NAME_LOCAL_REQUEST_ID;
     LOG_IF_FAIL(queryResetAndClearBindings(queryId));
@@ -957,12 +1021,14 @@ bool SyncDb::updateNodeLocalName(DbNodeId nodeId, const SyncName &nameLocal, boo
         LOG_WARN(_logger, "Error running query: " << queryId << " - num rows affected != 1");
         found = false;
     }
+    if (!endWrite()) return false;
 
     return true;
 }
 
 bool SyncDb::updateNodesSyncing(bool syncing) {
     const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
     invalidateCache();
 
     int errId;
@@ -980,7 +1046,8 @@ bool SyncDb::updateNodesSyncing(bool syncing) {
 
 bool SyncDb::updateNodeSyncing(DbNodeId nodeId, bool syncing, bool &found) {
     const std::scoped_lock lock(_mutex);
-    invalidateCache();
+    invalidateCache(nodeId);
+    if (!beginWrite()) return false;
 
     int errId;
     std::string error;
@@ -998,13 +1065,15 @@ bool SyncDb::updateNodeSyncing(DbNodeId nodeId, bool syncing, bool &found) {
         LOG_WARN(_logger, "Error running query: " << UPDATE_NODE_SYNCING_REQUEST_ID << " - num rows affected != 1");
         found = false;
     }
+    if (!endWrite()) return false;
 
     return true;
 }
 
 bool SyncDb::deleteNode(DbNodeId nodeId, bool &found) {
     const std::scoped_lock lock(_mutex);
-    invalidateCache();
+    invalidateCache(nodeId);
+    if (!commitWriteBatch()) return false; // Committed on its own
 
     int errId;
     std::string error;
@@ -1541,6 +1610,7 @@ bool SyncDb::dbId(ReplicaSide side, const SyncPath &path, DbNodeId &dbNodeId, bo
 
 bool SyncDb::clearNodes() {
     const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
     invalidateCache();
 
     int errId;
@@ -2050,6 +2120,7 @@ bool SyncDb::correspondingNodeId(ReplicaSide side, const NodeId &nodeIdIn, NodeI
 
 bool SyncDb::deleteSyncNode(const NodeId &nodeId, bool &found) {
     const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
 
     int errId = -1;
     std::string error;
@@ -2072,11 +2143,50 @@ bool SyncDb::deleteSyncNode(const NodeId &nodeId, bool &found) {
     return true;
 }
 
+bool SyncDb::insertSyncNode(const NodeId &nodeId, const SyncNodeType type) {
+    const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
+
+    int errId = -1;
+    std::string error;
+
+    LOG_IF_FAIL(queryResetAndClearBindings(INSERT_SYNC_NODE_REQUEST_ID));
+    LOG_IF_FAIL(queryBindValue(INSERT_SYNC_NODE_REQUEST_ID, 1, nodeId));
+    LOG_IF_FAIL(queryBindValue(INSERT_SYNC_NODE_REQUEST_ID, 2, toInt(type)));
+    if (!queryExec(INSERT_SYNC_NODE_REQUEST_ID, errId, error)) {
+        LOG_WARN(_logger, "Error running query: " << INSERT_SYNC_NODE_REQUEST_ID);
+        return false;
+    }
+
+    return true;
+}
+
+bool SyncDb::deleteSyncNode(const NodeId &nodeId, const SyncNodeType type, bool &found) {
+    const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
+
+    int errId = -1;
+    std::string error;
+
+    LOG_IF_FAIL(queryResetAndClearBindings(DELETE_SYNC_NODE_BY_TYPE_REQUEST_ID));
+    LOG_IF_FAIL(queryBindValue(DELETE_SYNC_NODE_BY_TYPE_REQUEST_ID, 1, nodeId));
+    LOG_IF_FAIL(queryBindValue(DELETE_SYNC_NODE_BY_TYPE_REQUEST_ID, 2, toInt(type)));
+    if (!queryExec(DELETE_SYNC_NODE_BY_TYPE_REQUEST_ID, errId, error)) {
+        LOG_WARN(_logger, "Error running query: " << DELETE_SYNC_NODE_BY_TYPE_REQUEST_ID);
+        return false;
+    }
+    found = numRowsAffected() > 0;
+
+    return true;
+}
+
 bool SyncDb::updateAllSyncNodes(const SyncNodeType type, const NodeSet &nodeIdSet) {
     const std::scoped_lock lock(_mutex);
     int errId = 0;
     std::string error;
 
+    // The rollback below must not discard the pending node writes
+    if (!commitWriteBatch()) return false;
     startTransaction();
 
     // Delete existing SyncNodes
@@ -2135,6 +2245,9 @@ bool SyncDb::selectAllSyncNodes(const SyncNodeType type, NodeSet &nodeIdSet) {
 bool SyncDb::insertUploadSessionToken(const UploadSessionToken &uploadSessionToken, int64_t &uploadSessionTokenDbId) {
     const std::scoped_lock lock(_mutex);
 
+    // The upload session tokens must be durable: an interrupted upload session is canceled on next start from its token.
+    if (!commitWriteBatch()) return false;
+
     int errId;
     std::string error;
 
@@ -2151,6 +2264,8 @@ bool SyncDb::insertUploadSessionToken(const UploadSessionToken &uploadSessionTok
 bool SyncDb::deleteUploadSessionTokenByDbId(int64_t dbId, bool &found) {
     const std::scoped_lock lock(_mutex);
 
+    if (!commitWriteBatch()) return false;
+
     int errId;
     std::string error;
 
@@ -2202,6 +2317,8 @@ bool SyncDb::selectAllUploadSessionTokens(std::vector<UploadSessionToken> &uploa
 bool SyncDb::deleteAllUploadSessionToken() {
     const std::scoped_lock lock(_mutex);
 
+    if (!commitWriteBatch()) return false;
+
     int errId;
     std::string error;
 
@@ -2214,12 +2331,250 @@ bool SyncDb::deleteAllUploadSessionToken() {
     return true;
 }
 
+bool SyncDb::insertChecksumCacheEntry(const NodeId &nodeId, int64_t size, SyncTime modificationTime, SyncTime changeTime,
+                                      const std::string &checksum) {
+    const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
+
+    int errId;
+    std::string error;
+
+    LOG_IF_FAIL(queryResetAndClearBindings(INSERT_CHECKSUM_CACHE_REQUEST_ID));
+    LOG_IF_FAIL(queryBindValue(INSERT_CHECKSUM_CACHE_REQUEST_ID, 1, nodeId));
+    LOG_IF_FAIL(queryBindValue(INSERT_CHECKSUM_CACHE_REQUEST_ID, 2, size));
+    LOG_IF_FAIL(queryBindValue(INSERT_CHECKSUM_CACHE_REQUEST_ID, 3, modificationTime));
+    LOG_IF_FAIL(queryBindValue(INSERT_CHECKSUM_CACHE_REQUEST_ID, 4, changeTime));
+    LOG_IF_FAIL(queryBindValue(INSERT_CHECKSUM_CACHE_REQUEST_ID, 5, checksum));
+    if (!queryExec(INSERT_CHECKSUM_CACHE_REQUEST_ID, errId, error)) {
+        LOG_WARN(_logger, "Error running query: " << INSERT_CHECKSUM_CACHE_REQUEST_ID);
+        return false;
+    }
+
+    return true;
+}
+
+bool SyncDb::selectChecksumCacheEntry(const NodeId &nodeId, int64_t size, SyncTime modificationTime, SyncTime changeTime,
+                                      std::string &checksum, bool &found) {
+    const std::scoped_lock lock(_mutex);
+
+    LOG_IF_FAIL(queryResetAndClearBindings(SELECT_CHECKSUM_CACHE_REQUEST_ID));
+    LOG_IF_FAIL(queryBindValue(SELECT_CHECKSUM_CACHE_REQUEST_ID, 1, nodeId));
+    LOG_IF_FAIL(queryBindValue(SELECT_CHECKSUM_CACHE_REQUEST_ID, 2, size));
+    LOG_IF_FAIL(queryBindValue(SELECT_CHECKSUM_CACHE_REQUEST_ID, 3, modificationTime));
+    LOG_IF_FAIL(queryBindValue(SELECT_CHECKSUM_CACHE_REQUEST_ID, 4, changeTime));
+    if (!queryNext(SELECT_CHECKSUM_CACHE_REQUEST_ID, found)) {
+        LOG_WARN(_logger, "Error getting query result: " << SELECT_CHECKSUM_CACHE_REQUEST_ID);
+        return false;
+    }
+    if (found) {
+        LOG_IF_FAIL(queryStringValue(SELECT_CHECKSUM_CACHE_REQUEST_ID, 0, checksum));
+    }
+    LOG_IF_FAIL(queryResetAndClearBindings(SELECT_CHECKSUM_CACHE_REQUEST_ID));
+
+    return true;
+}
+
+bool SyncDb::deleteChecksumCacheEntry(const NodeId &nodeId) {
+    const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
+
+    int errId;
+    std::string error;
+
+    LOG_IF_FAIL(queryResetAndClearBindings(DELETE_CHECKSUM_CACHE_REQUEST_ID));
+    LOG_IF_FAIL(queryBindValue(DELETE_CHECKSUM_CACHE_REQUEST_ID, 1, nodeId));
+    if (!queryExec(DELETE_CHECKSUM_CACHE_REQUEST_ID, errId, error)) {
+        LOG_WARN(_logger, "Error running query: " << DELETE_CHECKSUM_CACHE_REQUEST_ID);
+        return false;
+    }
+
+    return true;
+}
+
+bool SyncDb::deleteChecksumCacheEntries(const NodeSet &nodeIds) {
+    if (nodeIds.empty()) return true;
+
+    const std::scoped_lock lock(_mutex);
+    int errId;
+    std::string error;
+
+    // The rollback below must not discard the pending node writes
+    if (!commitWriteBatch()) return false;
+    startTransaction();
+
+    for (const NodeId &nodeId: nodeIds) {
+        LOG_IF_FAIL(queryResetAndClearBindings(DELETE_CHECKSUM_CACHE_REQUEST_ID));
+        LOG_IF_FAIL(queryBindValue(DELETE_CHECKSUM_CACHE_REQUEST_ID, 1, nodeId));
+        if (!queryExec(DELETE_CHECKSUM_CACHE_REQUEST_ID, errId, error)) {
+            LOG_WARN(_logger, "Error running query: " << DELETE_CHECKSUM_CACHE_REQUEST_ID);
+            rollbackTransaction();
+            return false;
+        }
+    }
+
+    commitTransaction();
+
+    return true;
+}
+
+bool SyncDb::selectAllChecksumCacheEntries(ChecksumCacheMap &entries) {
+    const std::scoped_lock lock(_mutex);
+
+    LOG_IF_FAIL(queryResetAndClearBindings(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID));
+    bool found = false;
+    for (;;) {
+        if (!queryNext(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID, found)) {
+            LOG_WARN(_logger, "Error getting query result: " << SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID);
+            return false;
+        }
+        if (!found) {
+            break;
+        }
+
+        NodeId nodeId;
+        ChecksumCacheEntry entry;
+        LOG_IF_FAIL(queryStringValue(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID, 0, nodeId));
+        LOG_IF_FAIL(queryInt64Value(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID, 1, entry.size));
+        LOG_IF_FAIL(queryInt64Value(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID, 2, entry.modificationTime));
+        LOG_IF_FAIL(queryInt64Value(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID, 3, entry.changeTime));
+        LOG_IF_FAIL(queryStringValue(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID, 4, entry.checksum));
+        (void) entries.insert_or_assign(std::move(nodeId), std::move(entry));
+    }
+    LOG_IF_FAIL(queryResetAndClearBindings(SELECT_ALL_CHECKSUM_CACHE_REQUEST_ID));
+
+    return true;
+}
+
+bool SyncDb::deleteAllChecksumCacheEntries() {
+    const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
+
+    int errId;
+    std::string error;
+
+    LOG_IF_FAIL(queryResetAndClearBindings(DELETE_ALL_CHECKSUM_CACHE_REQUEST_ID));
+    if (!queryExec(DELETE_ALL_CHECKSUM_CACHE_REQUEST_ID, errId, error)) {
+        LOG_WARN(_logger, "Error running query: " << DELETE_ALL_CHECKSUM_CACHE_REQUEST_ID);
+        return false;
+    }
+
+    return true;
+}
+
+bool SyncDb::createChecksumCacheTable() {
+    int errId = -1;
+    std::string error;
+
+    if (!createAndPrepareRequest(CREATE_CHECKSUM_CACHE_TABLE_ID, CREATE_CHECKSUM_CACHE_TABLE)) return false;
+    if (!queryExec(CREATE_CHECKSUM_CACHE_TABLE_ID, errId, error)) {
+        queryFree(CREATE_CHECKSUM_CACHE_TABLE_ID);
+        return sqlFail(CREATE_CHECKSUM_CACHE_TABLE_ID, error);
+    }
+    queryFree(CREATE_CHECKSUM_CACHE_TABLE_ID);
+
+    if (!createAndPrepareRequest(CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER_ID, CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER))
+        return false;
+    if (!queryExec(CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER_ID, errId, error)) {
+        queryFree(CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER_ID);
+        return sqlFail(CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER_ID, error);
+    }
+    queryFree(CREATE_CHECKSUM_CACHE_NODE_DELETE_TRIGGER_ID);
+
+    return true;
+}
+
 bool SyncDb::setTargetNodeId(const std::string &targetNodeId, bool &found) {
     // Update root node
     _rootNode.setNodeIdRemote(targetNodeId);
     return updateNode(_rootNode, found);
 }
 
+void SyncDb::enableWriteBatching(const size_t maxSize, const std::chrono::milliseconds maxLatency) {
+    const std::scoped_lock lock(_mutex);
+    _writeBatchingEnabled = true;
+    _writeBatchThreadId = std::this_thread::get_id();
+    _writeBatchMaxSize = maxSize;
+    _writeBatchMaxLatency = maxLatency;
+}
+
+bool SyncDb::disableWriteBatching() {
+    const std::scoped_lock lock(_mutex);
+    _writeBatchingEnabled = false;
+    return commitWriteBatch();
+}
+
+bool SyncDb::commitWriteBatchIfExpired() {
+    const std::scoped_lock lock(_mutex);
+    if (_writeBatchSize == 0 || std::chrono::steady_clock::now() - _writeBatchStart < _writeBatchMaxLatency) return true;
+    return commitWriteBatch();
+}
+
+bool SyncDb::beginWrite() {
+    if (!_writeBatchingEnabled) return true;
+    if (std::this_thread::get_id() != _writeBatchThreadId) return commitWriteBatch(); // Committed on its own
+
+    if (!_transaction) {
+        startTransaction();
+        _writeBatchStart = std::chrono::steady_clock::now();
+    }
+    return true;
+}
+
+bool SyncDb::endWrite() {
+    if (!_transaction) return true; // Not batched
+    if (++_writeBatchSize < _writeBatchMaxSize &&
+        std::chrono::steady_clock::now() - _writeBatchStart < _writeBatchMaxLatency) {
+        return true;
+    }
+    return commitWriteBatch();
+}
+
+bool SyncDb::commitWriteBatch() {
+    _writeBatchSize = 0;
+    if (!_transaction) return true;
+
+    commitTransaction();
+    if (_transaction) {
+        LOG_WARN(_logger, "Error committing the write batch, rolling it back");
+        rollbackTransaction();
+        _transaction = false;
+        invalidateCache(); // The rolled back writes were already logged as node changes
+        return false;
+    }
+    return true;
+}
+
+void SyncDb::invalidateCache() {
+    ++_revision;
+    _changedDbNodeIds.clear();
+    _changeLogRevision = _revision;
+}
+
+void SyncDb::invalidateCache(const DbNodeId dbNodeId) {
+    // Above this number of changes, a full reload of the cache is cheaper than fetching each changed node.
+    static constexpr size_t maxChangedDbNodeIds = 100000;
+
+    ++_revision;
+    if (_changedDbNodeIds.size() >= maxChangedDbNodeIds) {
+        _changedDbNodeIds.clear();
+        _changeLogRevision = _revision;
+        return;
+    }
+    (void) _changedDbNodeIds.insert(dbNodeId);
+}
+
+bool SyncDb::takeNodeChanges(const SyncDbRevision fromRevision, std::unordered_set<DbNodeId> &dbNodeIds,
+                             SyncDbRevision &revision) {
+    const std::scoped_lock lock(_mutex);
+    revision = _revision;
+    if (fromRevision < _changeLogRevision) return false;
+
+    dbNodeIds.clear();
+    dbNodeIds.swap(_changedDbNodeIds);
+    _changeLogRevision = _revision;
+    return true;
+}
+
 SyncDbRevision SyncDb::revision() const {
     const std::scoped_lock lock(_mutex);
     return _revision;
@@ -2456,6 +2811,7 @@ bool SyncDb::selectAllRenamedNodes(std::vector<DbNode> &dbNodeList, bool onlyCol
 
 bool SyncDb::deleteNodesWithNullParentNodeId() {
     const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
     invalidateCache();
 
     int errId;
@@ -2748,6 +3104,7 @@ bool SyncDb::updateNamesWithDistinctEncodings(const SyncNameMap &localNames) {
 
 bool SyncDb::normalizeRemoteNames() {
     const std::scoped_lock lock(_mutex);
+    if (!commitWriteBatch()) return false; // Committed on its own
     invalidateCache();
     static const char *requestId = "normalize_remote_names";
     static const char *query =
@@ -2920,6 +3277,13 @@ bool SyncDb::tryToFixDbNodeIdsAfterSyncDirChange(const SyncPath &syncDirPath) {
         LOG_INFO(_logger, "Updated DbNode ID " << dbNodeId << " with new local node ID " << newLocalNodeId);
     }
     dbCache.clear();
+
+    // The checksum cache is keyed by local node IDs, which are no longer valid.
+    if (!deleteAllChecksumCacheEntries()) {
+        LOG_WARN(_logger, "Unable to clear the checksum cache");
+        return false;
+    }
+
     return true;
 }
 
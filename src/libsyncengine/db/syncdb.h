@@ -26,6 +26,8 @@
 
 #include <log4cplus/loggingmacros.h>
 
+#include <chrono>
+#include <thread>
 #include <unordered_set>
 
 namespace KDC {
@@ -50,6 +52,18 @@ class SyncDb : public Db {
         bool updateNodesSyncing(bool syncing);
         bool updateNodeSyncing(DbNodeId nodeId, bool syncing, bool &found);
         bool deleteNode(DbNodeId nodeId, bool &found);
+
+        // Write batching. While enabled, the node updates made by the thread which enabled it are grouped in transactions,
+        // committed after `maxSize` writes, when the first pending write is older than `maxLatency`, and when batching is
+        // disabled or the DB is closed. These updates are idempotent: a crash loses the pending ones only, and they are detected
+        // again by the next sync. Any other write, e.g. a node insertion or deletion, or a write from another thread, first
+        // commits the pending batch and is then committed on its own. Reads see the pending writes.
+        void enableWriteBatching(size_t maxSize = defaultWriteBatchMaxSize,
+                                 std::chrono::milliseconds maxLatency = defaultWriteBatchMaxLatency);
+        bool disableWriteBatching(); // Commits the pending writes
+        bool commitWriteBatchIfExpired(); // To be called regularly by the writer to bound the latency when idle
+        [[nodiscard]] bool writeBatchingEnabled() const { return _writeBatchingEnabled; }
+
         bool selectStatus(DbNodeId nodeId, SyncFileStatus &status, bool &found);
         bool selectSyncing(DbNodeId nodeId, bool &syncing, bool &found);
         bool clearNodes();
@@ -90,6 +104,8 @@ class SyncDb : public Db {
         bool setSyncing(ReplicaSide side, const SyncPath &path, bool syncing, bool &found);
 
         bool deleteSyncNode(const NodeId &nodeId, bool &found);
+        bool insertSyncNode(const NodeId &nodeId, SyncNodeType type);
+        bool deleteSyncNode(const NodeId &nodeId, SyncNodeType type, bool &found);
         bool updateAllSyncNodes(SyncNodeType type, const NodeSet &nodeIdSet);
         bool selectAllSyncNodes(SyncNodeType type, NodeSet &nodeIdSet);
 
@@ -101,6 +117,25 @@ class SyncDb : public Db {
         bool selectAllUploadSessionTokens(std::vector<UploadSessionToken> &uploadSessionTokenList);
         bool deleteAllUploadSessionToken();
 
+        // Content checksum cache, keyed by local node ID. An entry is only returned if the size, the modification time and
+        // the status change time of the file match the ones stored with the checksum. The entry of a node is deleted along
+        // with the node.
+        bool insertChecksumCacheEntry(const NodeId &nodeId, int64_t size, SyncTime modificationTime, SyncTime changeTime,
+                                      const std::string &checksum);
+        bool selectChecksumCacheEntry(const NodeId &nodeId, int64_t size, SyncTime modificationTime, SyncTime changeTime,
+                                      std::string &checksum, bool &found);
+        bool deleteChecksumCacheEntry(const NodeId &nodeId);
+        bool deleteChecksumCacheEntries(const NodeSet &nodeIds);
+        bool deleteAllChecksumCacheEntries();
+        struct ChecksumCacheEntry {
+                int64_t size = 0;
+                SyncTime modificationTime = 0;
+                SyncTime changeTime = 0;
+                std::string checksum;
+        };
+        using ChecksumCacheMap = std::unordered_map<NodeId, ChecksumCacheEntry, StringHashFunction, std::equal_to<>>;
+        bool selectAllChecksumCacheEntries(ChecksumCacheMap &entries);
+
         static DbNode driveRootNode() { return _driveRootNode; }
         DbNode rootNode() { return _rootNode; }
 
@@ -109,6 +144,12 @@ class SyncDb : public Db {
         SyncDbRevision revision() const;
         SyncDbReadOnlyCache &cache() { return _cache; }
 
+        // Moves to `dbNodeIds` the DB IDs of the nodes inserted, updated or deleted since revision `fromRevision` and sets
+        // `revision` to the current revision. Used by the cache to refresh itself incrementally, the changes are therefore
+        // consumed by the call. Returns false if these changes are not known anymore (change on all nodes or too many
+        // changes), in which case the cache must be fully reloaded.
+        bool takeNodeChanges(SyncDbRevision fromRevision, std::unordered_set<DbNodeId> &dbNodeIds, SyncDbRevision &revision);
+
         // Fix the local node IDs after a sync directory nodeId change.
         // This can happen when the sync directory is moved between two disks, after a migration from an other device (Apple
         // migration assistant, etc.).
@@ -124,12 +165,28 @@ class SyncDb : public Db {
         DbNode _rootNode = _driveRootNode;
         SyncDbRevision _revision = 1;
         SyncDbReadOnlyCache _cache;
-        void invalidateCache() { ++_revision; }
+        static constexpr size_t defaultWriteBatchMaxSize = 1000;
+        static constexpr std::chrono::milliseconds defaultWriteBatchMaxLatency = std::chrono::milliseconds(1000);
+        bool _writeBatchingEnabled = false;
+        size_t _writeBatchMaxSize = defaultWriteBatchMaxSize;
+        std::chrono::milliseconds _writeBatchMaxLatency = defaultWriteBatchMaxLatency;
+        size_t _writeBatchSize = 0;
+        std::chrono::steady_clock::time_point _writeBatchStart;
+        std::thread::id _writeBatchThreadId;
+        bool beginWrite(); // Start a node update, which joins the current batch if it is made by the batching thread
+        bool endWrite();
+        bool commitWriteBatch();
+
+        std::unordered_set<DbNodeId> _changedDbNodeIds; // The nodes changed since revision `_changeLogRevision`
+        SyncDbRevision _changeLogRevision = 1;
+        void invalidateCache(); // A change that may affect any node
+        void invalidateCache(DbNodeId dbNodeId);
         bool pushChildIds(ReplicaSide side, DbNodeId parentNodeDbId, std::vector<NodeId> &ids);
         bool pushChildIds(ReplicaSide side, DbNodeId parentNodeDbId, NodeSet &ids);
 
         // Helpers
         bool checkNodeIds(const DbNode &node);
+        bool createChecksumCacheTable();
 
         // Fixes
         bool updateNodeLocalName(DbNodeId nodeId, const SyncName &localName, bool &found);
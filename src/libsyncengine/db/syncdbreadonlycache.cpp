@@ -48,6 +48,11 @@ std::optional<const std::reference_wrapper<DbNode>> SyncDbReadOnlyCache::getDbNo
     return std::ref(dbNodeIt->second);
 }
 
+void SyncDbReadOnlyCache::suspend() {
+    const std::scoped_lock lock(_mutex);
+    _cachedRevision = 0;
+}
+
 void SyncDbReadOnlyCache::clear() {
     const std::scoped_lock lock(_mutex);
     _dbNodesCache.clear();
@@ -56,10 +61,34 @@ void SyncDbReadOnlyCache::clear() {
     _remoteNodeIdToDbNodeIdMap.clear();
     _dbNodesPathCache.clear();
     _cachedRevision = 0;
+    _loadedRevision = 0;
 }
 
 bool SyncDbReadOnlyCache::reloadIfNeeded() {
+    const std::scoped_lock lock(_mutex);
     if (isCacheUpToDate()) return true;
+
+    if (_loadedRevision != 0) {
+        std::unordered_set<DbNodeId> changedDbNodeIds;
+        SyncDbRevision revision = 0;
+        if (_syncDb.takeNodeChanges(_loadedRevision, changedDbNodeIds, revision)) {
+            if (applyNodeChanges(changedDbNodeIds)) {
+                _loadedRevision = revision;
+                _cachedRevision = revision;
+                LOG_INFO(Log::instance()->getLogger(), "SyncDbReadOnlyCache updated with " << changedDbNodeIds.size()
+                                                                                            << " changed nodes, cached revision="
+                                                                                            << revision);
+                return true;
+            }
+            LOG_WARN(Log::instance()->getLogger(),
+                     "SyncDbReadOnlyCache::reloadIfNeeded: Error applying node changes, reloading all nodes");
+        }
+    }
+
+    return reload();
+}
+
+bool SyncDbReadOnlyCache::reload() {
     clear();
     bool found = false;
     std::unordered_set<DbNode, DbNode::HashFunction> dbNodes;
@@ -74,21 +103,112 @@ bool SyncDbReadOnlyCache::reloadIfNeeded() {
     }
 
     for (const auto &dbNode: dbNodes) {
-        (void) _dbNodesCache.try_emplace(dbNode.nodeId(), dbNode);
-        if (dbNode.parentNodeId()) {
-            (void) _dbNodesParentToChildrenMap[dbNode.parentNodeId().value()].push_back(dbNode.nodeId());
+        addNode(dbNode);
+    }
+    _loadedRevision = _cachedRevision;
+    LOG_INFO(Log::instance()->getLogger(), "SyncDbReadOnlyCache reloaded, cached revision=" << _cachedRevision);
+    return true;
+}
+
+bool SyncDbReadOnlyCache::applyNodeChanges(const std::unordered_set<DbNodeId> &changedDbNodeIds) {
+    // Fetch the current state of the changed nodes
+    std::unordered_map<DbNodeId, DbNode> updatedDbNodes;
+    std::vector<DbNodeId> deletedDbNodeIds;
+    for (const auto dbNodeId: changedDbNodeIds) {
+        DbNode dbNode;
+        bool found = false;
+        if (!_syncDb.node(dbNodeId, dbNode, found)) {
+            LOG_WARN(Log::instance()->getLogger(), "SyncDbReadOnlyCache::applyNodeChanges: Error getting node " << dbNodeId);
+            return false;
         }
-        if (dbNode.hasLocalNodeId()) {
-            (void) _localNodeIdToDbNodeIdMap.try_emplace(dbNode.nodeIdLocal().value(), dbNode.nodeId());
+        if (found) {
+            (void) updatedDbNodes.try_emplace(dbNodeId, dbNode);
+        } else {
+            deletedDbNodeIds.push_back(dbNodeId);
         }
-        if (dbNode.hasRemoteNodeId()) {
-            (void) _remoteNodeIdToDbNodeIdMap.try_emplace(dbNode.nodeIdRemote().value(), dbNode.nodeId());
+    }
+
+    // The cached paths of the descendants of a moved or renamed directory are not valid anymore
+    bool clearPathCache = false;
+    for (const auto &[dbNodeId, dbNode]: updatedDbNodes) {
+        if (const auto cachedDbNode = getDbNodeFromDbNodeId(dbNodeId); cachedDbNode) {
+            const DbNode &previousDbNode = cachedDbNode->get();
+            clearPathCache = clearPathCache || (previousDbNode.type() == NodeType::Directory &&
+                                                (previousDbNode.parentNodeId() != dbNode.parentNodeId() ||
+                                                 previousDbNode.nameLocal() != dbNode.nameLocal() ||
+                                                 previousDbNode.nameRemote() != dbNode.nameRemote()));
         }
+        removeNode(dbNodeId);
+    }
+
+    // The descendants of a deleted node have been deleted by cascade. The ones moved elsewhere have been detached above.
+    for (const auto dbNodeId: deletedDbNodeIds) {
+        removeNodeAndDescendants(dbNodeId);
+    }
+
+    for (const auto &[_, dbNode]: updatedDbNodes) {
+        addNode(dbNode);
     }
-    LOG_INFO(Log::instance()->getLogger(), "SyncDbReadOnlyCache updated, cached revision=" << _syncDb.revision());
+
+    if (clearPathCache) _dbNodesPathCache.clear();
     return true;
 }
 
+void SyncDbReadOnlyCache::addNode(const DbNode &dbNode) {
+    (void) _dbNodesCache.try_emplace(dbNode.nodeId(), dbNode);
+    if (dbNode.parentNodeId()) {
+        (void) _dbNodesParentToChildrenMap[dbNode.parentNodeId().value()].insert(dbNode.nodeId());
+    }
+    if (dbNode.hasLocalNodeId()) {
+        _localNodeIdToDbNodeIdMap[dbNode.nodeIdLocal().value()] = dbNode.nodeId();
+    }
+    if (dbNode.hasRemoteNodeId()) {
+        _remoteNodeIdToDbNodeIdMap[dbNode.nodeIdRemote().value()] = dbNode.nodeId();
+    }
+}
+
+void SyncDbReadOnlyCache::removeNode(const DbNodeId dbNodeId) {
+    const auto dbNodeIt = _dbNodesCache.find(dbNodeId);
+    if (dbNodeIt == _dbNodesCache.end()) return;
+
+    const DbNode &dbNode = dbNodeIt->second;
+    if (dbNode.parentNodeId()) {
+        if (const auto childrenIt = _dbNodesParentToChildrenMap.find(dbNode.parentNodeId().value());
+            childrenIt != _dbNodesParentToChildrenMap.end()) {
+            (void) childrenIt->second.erase(dbNodeId);
+            if (childrenIt->second.empty()) (void) _dbNodesParentToChildrenMap.erase(childrenIt);
+        }
+    }
+
+    // The replica IDs might already be used by another node
+    if (dbNode.hasLocalNodeId()) {
+        if (const auto it = _localNodeIdToDbNodeIdMap.find(dbNode.nodeIdLocal().value());
+            it != _localNodeIdToDbNodeIdMap.end() && it->second == dbNodeId) {
+            (void) _localNodeIdToDbNodeIdMap.erase(it);
+        }
+    }
+    if (dbNode.hasRemoteNodeId()) {
+        if (const auto it = _remoteNodeIdToDbNodeIdMap.find(dbNode.nodeIdRemote().value());
+            it != _remoteNodeIdToDbNodeIdMap.end() && it->second == dbNodeId) {
+            (void) _remoteNodeIdToDbNodeIdMap.erase(it);
+        }
+    }
+
+    (void) _dbNodesPathCache.erase(dbNodeId);
+    (void) _dbNodesCache.erase(dbNodeIt);
+}
+
+void SyncDbReadOnlyCache::removeNodeAndDescendants(const DbNodeId dbNodeId) {
+    if (const auto childrenIt = _dbNodesParentToChildrenMap.find(dbNodeId); childrenIt != _dbNodesParentToChildrenMap.end()) {
+        const auto childrenDbNodeIds = std::move(childrenIt->second);
+        (void) _dbNodesParentToChildrenMap.erase(childrenIt);
+        for (const auto childDbNodeId: childrenDbNodeIds) {
+            removeNodeAndDescendants(childDbNodeId);
+        }
+    }
+    removeNode(dbNodeId);
+}
+
 bool SyncDbReadOnlyCache::parentId(ReplicaSide side, const NodeId &nodeId, NodeId &parentNodeId, bool &found) {
     const std::scoped_lock lock(_mutex);
     LOG_IF_FAIL(Log::instance()->getLogger(), _cachedRevision != 0);
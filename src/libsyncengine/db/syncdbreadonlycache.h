@@ -20,7 +20,7 @@
 #include "libcommon/utility/types.h"
 #include <set>
 #include <unordered_map>
-#include <list>
+#include <unordered_set>
 #include <mutex>
 
 namespace KDC {
@@ -29,7 +29,12 @@ class SyncDbReadOnlyCache {
     public:
         explicit SyncDbReadOnlyCache(SyncDb &syncDb) :
             _syncDb(syncDb) {};
+        // Brings the cache up to date with the database. Only the nodes changed since the last reload are fetched, unless
+        // the cache is empty or the database cannot provide these changes anymore.
         bool reloadIfNeeded();
+        // Makes the getters query the database until the next call to `reloadIfNeeded`. Unlike `clear`, the cached nodes
+        // are kept so that the next reload only has to apply the changes made in the meantime.
+        void suspend();
         void clear();
         // Getters with replica IDs
         bool parentId(ReplicaSide side, const NodeId &nodeId, NodeId &parentNodeid, bool &found);
@@ -57,14 +62,21 @@ class SyncDbReadOnlyCache {
 
     private:
         bool isCacheUpToDate() const;
+        bool reload();
+        bool applyNodeChanges(const std::unordered_set<DbNodeId> &changedDbNodeIds);
+        void addNode(const DbNode &dbNode);
+        // Removes a node from the cache, its children are left untouched.
+        void removeNode(DbNodeId dbNodeId);
+        void removeNodeAndDescendants(DbNodeId dbNodeId);
         DbNodeId getDbNodeIdFromNodeId(ReplicaSide side, const NodeId &nodeId, bool &found);
         std::optional<const std::reference_wrapper<DbNode>> getDbNodeFromDbNodeId(const DbNodeId &dbNodeId);
-        SyncDbRevision _cachedRevision = 0;
+        SyncDbRevision _cachedRevision = 0; // 0 if the getters must query the database
+        SyncDbRevision _loadedRevision = 0; // The revision of the cached nodes, 0 if the cache is empty
         SyncDb &_syncDb;
         mutable std::recursive_mutex _mutex;
         std::unordered_map<DbNodeId, std::pair<SyncPath /*local*/, SyncPath /*remote*/>> _dbNodesPathCache;
         std::unordered_map<DbNodeId, DbNode> _dbNodesCache;
-        std::unordered_map<DbNodeId /*parent*/, std::list<DbNodeId /*children*/>> _dbNodesParentToChildrenMap;
+        std::unordered_map<DbNodeId /*parent*/, std::unordered_set<DbNodeId /*children*/>> _dbNodesParentToChildrenMap;
         std::unordered_map<NodeId, DbNodeId> _localNodeIdToDbNodeIdMap;
         std::unordered_map<NodeId, DbNodeId> _remoteNodeIdToDbNodeIdMap;
 };
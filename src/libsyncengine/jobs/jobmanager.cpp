@@ -27,6 +27,7 @@
 #include "libcommonserver/utility/utility.h"
 
 #include <algorithm> // std::max
+#include <chrono>
 
 #include <log4cplus/loggingmacros.h>
 
@@ -35,6 +36,11 @@
 
 namespace KDC {
 
+namespace {
+// Delay before retrying to dispatch jobs when a completed job has not yet given its thread back to the pool.
+constexpr std::chrono::milliseconds threadReleaseRetryDelay(5);
+} // namespace
+
 void JobManager::startMainThreadIfNeeded() {
     if (!_mainThread) {
         const std::function<void()> runFunction = std::bind_front(&JobManager::run, this);
@@ -44,6 +50,7 @@ void JobManager::startMainThreadIfNeeded() {
 
 void JobManager::stop() {
     _stop = true;
+    wakeUp();
 }
 
 void JobManager::clear() {
@@ -62,6 +69,7 @@ void JobManager::queueAsyncJob(const std::shared_ptr<AbstractJob> job, const Poc
     const std::function<void(const UniqueId)> callback = std::bind_front(&JobManager::eraseJob, this);
     job->setMainCallback(callback);
     _data.queue(job, priority);
+    wakeUp();
 }
 
 void JobManager::queueAsyncJob(const std::shared_ptr<AbstractJob> job) noexcept {
@@ -84,6 +92,7 @@ void JobManager::setPoolCapacity(const int nbThread) {
     _maxNbThread = std::max(nbThread, threadPoolMinCapacity);
     _threadPool.addCapacity(_maxNbThread - _threadPool.capacity());
     LOG_DEBUG(_logger, "Max number of thread changed to " << _maxNbThread << " threads");
+    wakeUp();
 }
 
 void JobManager::decreasePoolCapacity() {
@@ -105,33 +114,60 @@ JobManager::JobManager() :
 }
 
 void JobManager::run() noexcept {
-    while (true) {
-        if (_stop) {
-            break;
+    while (!_stop) {
+        dispatchJobs();
+        waitForWakeUp();
+    }
+}
+
+void JobManager::dispatchJobs() {
+    auto availableThreads = availableThreadsInPool();
+    // Always keep 1 thread available for jobs with highest priority
+    while (availableThreads > 1 && !_stop && _data.hasQueuedJob()) {
+        const auto [job, priority] = _data.pop();
+        if (canRunJob(job)) {
+            startJob(job, priority);
+        } else {
+            addToPendingJobs(job, priority);
         }
 
-        auto availableThreads = availableThreadsInPool();
-        // Always keep 1 thread available for jobs with highest priority
-        while (availableThreads > 1 && !_stop && _data.hasQueuedJob()) {
-            const auto [job, priority] = _data.pop();
-            if (canRunJob(job)) {
-                startJob(job, priority);
-            } else {
-                addToPendingJobs(job, priority);
-            }
+        availableThreads = availableThreadsInPool();
+    }
 
-            availableThreads = availableThreadsInPool();
-        }
+    // Start job with the highest priority
+    if (_data.hasHighestPriorityJob()) {
+        const auto [job, priority] = _data.pop();
+        startJob(job, priority);
+    }
 
-        // Start job with the highest priority
-        if (_data.hasHighestPriorityJob()) {
-            const auto [job, priority] = _data.pop();
-            startJob(job, priority);
-        }
+    managePendingJobs();
+}
+
+void JobManager::wakeUp() {
+    {
+        const std::scoped_lock lock(_wakeUpMutex);
+        _wakeUpRequested = true;
+    }
+    _wakeUpCondition.notify_one();
+}
 
-        managePendingJobs();
+void JobManager::waitForWakeUp() {
+    std::unique_lock lock(_wakeUpMutex);
+    if (!_wakeUpRequested && _data.hasQueuedJob() && isThreadBeingReleased()) {
+        (void) _wakeUpCondition.wait_for(lock, threadReleaseRetryDelay, [this] { return _wakeUpRequested; });
+    } else {
+        _wakeUpCondition.wait(lock, [this] { return _wakeUpRequested; });
+    }
+    _wakeUpRequested = false;
+    _wakeUpCount++;
+}
 
-        Utility::msleep(100); // Sleep for 0.1 s
+bool JobManager::isThreadBeingReleased() const {
+    // A job is removed from the running jobs in its callback, i.e. slightly before its thread is given back to the pool.
+    try {
+        return _threadPool.capacity() - static_cast<int>(_data.runningJobsCount()) > _threadPool.available();
+    } catch (Poco::Exception &) {
+        return true;
     }
 }
 
@@ -142,21 +178,25 @@ void JobManager::startJob(const std::shared_ptr<AbstractJob> job, const Poco::Th
             _data.erase(job->jobId());
         } else {
             LOG_DEBUG(Log::instance()->getLogger(), "Starting job " << job->jobId() << " with priority " << priority);
-            _threadPool.startWithPriority(priority, *job);
+            // Register the job as running before starting it, otherwise a fast job might complete before being registered.
             if (!_data.addToRunningJobs(job->jobId())) {
                 LOG_WARN(Log::instance()->getLogger(), "Failed to insert job " << job->jobId() << " in _runningJobs map");
             }
+            _threadPool.startWithPriority(priority, *job);
         }
     } catch (Poco::NoThreadAvailableException &) {
         LOG_DEBUG(Log::instance()->getLogger(), "No more thread available, job " << job->jobId() << " queued");
+        _data.removeFromRunningJobs(job->jobId());
         _data.queue(job, priority);
     } catch (Poco::Exception &e) {
         LOG_WARN(Log::instance()->getLogger(), "Failed to start job: " << e.what());
+        _data.removeFromRunningJobs(job->jobId());
     }
 }
 
 void JobManager::eraseJob(const UniqueId jobId) {
     _data.erase(jobId);
+    wakeUp();
 }
 
 void JobManager::addToPendingJobs(const std::shared_ptr<AbstractJob> job, const Poco::Thread::Priority priority) {
@@ -192,6 +232,7 @@ void JobManager::managePendingJobs() {
             } else {
                 LOGW_DEBUG(Log::instance()->getLogger(), L"Queuing job " << job->jobId() << L" for execution");
                 _data.queue(job, priority);
+                wakeUp(); // Dispatch the job on the next iteration of the main loop.
             }
             _data.removeFromPendingJobs(job->jobId());
         }
@@ -25,6 +25,10 @@
 
 #include <log4cplus/logger.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 #include <Poco/Thread.h>
 #include <Poco/ThreadPool.h>
 #include <Poco/Net/HTTPSClientSession.h>
@@ -70,20 +74,38 @@ class JobManager {
         void startMainThreadIfNeeded();
 
         void run() noexcept;
+        void dispatchJobs();
+        /**
+         * @brief Wake up the main thread so that queued and pending jobs are dispatched without delay.
+         * Called when a job is queued, when a job completes and when the pool capacity changes.
+         */
+        void wakeUp();
+        /**
+         * @brief Block the main thread until `wakeUp` is called. If queued jobs are only waiting for the thread of a job that
+         * has just completed to be given back to the pool, the wait is bounded by `threadReleaseRetryDelay`.
+         */
+        void waitForWakeUp();
+        bool isThreadBeingReleased() const;
         void startJob(std::shared_ptr<AbstractJob> job, Poco::Thread::Priority priority);
         void eraseJob(UniqueId jobId);
         void addToPendingJobs(std::shared_ptr<AbstractJob> job, Poco::Thread::Priority priority);
         void managePendingJobs();
 
         JobManagerData _data;
-        bool _stop{false};
+        std::atomic_bool _stop{false};
         int _maxNbThread{0};
         Poco::ThreadPool _threadPool;
 
+        std::mutex _wakeUpMutex;
+        std::condition_variable _wakeUpCondition;
+        bool _wakeUpRequested{false};
+        uint64_t _wakeUpCount{0}; // Number of times the main thread has been woken up, used in tests.
+
         log4cplus::Logger _logger;
         std::unique_ptr<StdLoggingThread> _mainThread{nullptr};
 
         friend class TestSyncJobManagerSingleton;
+        friend class BenchmarkJobManager;
 };
 
 } // namespace KDC
@@ -37,6 +37,7 @@ std::pair<std::shared_ptr<AbstractJob>, Poco::Thread::Priority> JobManagerData::
 }
 
 bool JobManagerData::hasQueuedJob() const {
+    const std::scoped_lock lock(_mutex);
     return !_queuedJobs.empty();
 }
 
@@ -60,6 +61,16 @@ bool JobManagerData::addToRunningJobs(const UniqueId jobId) {
     return inserted;
 }
 
+void JobManagerData::removeFromRunningJobs(const UniqueId jobId) {
+    const std::scoped_lock lock(_mutex);
+    (void) _runningJobs.erase(jobId);
+}
+
+size_t JobManagerData::runningJobsCount() const {
+    const std::scoped_lock lock(_mutex);
+    return _runningJobs.size();
+}
+
 bool JobManagerData::addToPendingJobs(const UniqueId jobId, std::shared_ptr<AbstractJob> job, Poco::Thread::Priority priority) {
     const std::scoped_lock lock(_mutex);
     const auto [_, inserted] = _pendingJobs.try_emplace(jobId, job, priority);
@@ -82,6 +82,17 @@ class JobManagerData {
          * @return 'true' if the job ID has been successfully inserted in the map.
          */
         bool addToRunningJobs(const UniqueId jobId);
+        /**
+         * @brief Remove a job from the list of running jobs, e.g. if it could not be started.
+         * @param jobId The ID of the job.
+         */
+        void removeFromRunningJobs(const UniqueId jobId);
+
+        /**
+         * @brief Get the number of jobs currently running.
+         * @return The size of the list of running jobs.
+         */
+        size_t runningJobsCount() const;
 
         /**
          * @brief Add a job to the list of pending jobs.
@@ -17,6 +17,7 @@
  */
 
 #include "abstractnetworkjob.h"
+#include "httpsessionpool.h"
 
 #include "network/proxy.h"
 #include "jobs/network/networkjobsparams.h"
@@ -37,6 +38,7 @@
 #include <Poco/Error.h>
 
 #include <iostream> // std::ios, std::istream, std::cout, std::cerr
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <thread>
@@ -45,7 +47,7 @@
 #include "kDrive_API/upload/upload_session/uploadsessionchunkjob.h"
 #include "kDrive_API/upload/uploadjob.h"
 
-#define BUF_SIZE 1024
+#define BUF_SIZE (64 * 1024) // 64KB
 
 #define MAX_TRIALS 5
 
@@ -54,6 +56,7 @@ namespace KDC {
 const std::string rateLimitHeaderReset = "X-RateLimit-Reset"; // Timestamp (in seconds since epoch)
 const std::string rateLimitHeaderDelay = "Retry-After"; // Delay (in seconds)
 const int64_t sleepDurationThreshold = 60000; // 60'000 ms -> 1 min
+const int defaultSessionTimeout = 60; // Same as Poco::Net::HTTPSession default timeout (sec)
 
 const std::string AbstractNetworkJob::_userAgent = KDC::CommonUtility::userAgentString();
 Poco::Net::Context::Ptr AbstractNetworkJob::_context = nullptr;
@@ -196,11 +199,21 @@ ExitInfo AbstractNetworkJob::runJob() noexcept {
 
         uri = Poco::URI(url);
 
-        createSession(uri);
+        outputExitInfo = createSession(uri);
+        if (!outputExitInfo) {
+            if (isAborted()) {
+                LOG_INFO(_logger, "Request " << jobId() << " " << uri.toString() << " aborted");
+                outputExitInfo = ExitCode::Ok;
+            } else {
+                LOG_WARN(_logger, "Request " << jobId() << ": no session for URL " << uri.toString() << " : " << outputExitInfo);
+            }
+            break;
+        }
 
         try {
             outputExitInfo = canRun();
             if (!outputExitInfo) {
+                clearSession();
                 return outputExitInfo;
             }
         } catch (Poco::Exception const &e) {
@@ -301,6 +314,8 @@ ExitInfo AbstractNetworkJob::runJob() noexcept {
         }
     }
 
+    clearSession();
+
     return outputExitInfo;
 }
 
@@ -330,47 +345,43 @@ void AbstractNetworkJob::abort() {
     abortSession();
 }
 
-void AbstractNetworkJob::createSession(const Poco::URI &uri) {
+ExitInfo AbstractNetworkJob::createSession(const Poco::URI &uri) {
     const std::scoped_lock lock(_mutexSession);
 
     if (_session) {
-        // Redirection case
+        // Redirection or retry case
         clearSession();
     }
 
-    _session.reset(new Poco::Net::HTTPSClientSession(uri.getHost(), uri.getPort(), _context));
+    ExitInfo exitInfo;
+    auto session = HttpSessionPool::instance()->acquire(uri, Proxy::instance()->proxyConfig(), _context, exitInfo,
+                                                        [this]() { return isAborted(); });
+    if (!session) return exitInfo;
+    session->setTimeout(Poco::Timespan(_customTimeout ? _customTimeout : defaultSessionTimeout, 0));
 
-    if (_customTimeout) {
-        _session->setTimeout(Poco::Timespan(_customTimeout, 0));
-    }
-
-    // Set proxy params
-    if (Proxy::instance()->proxyConfig().type() == ProxyType::HTTP) {
-        _session->setProxy(Proxy::instance()->proxyConfig().hostName(),
-                           static_cast<Poco::UInt16>(Proxy::instance()->proxyConfig().port()));
-        if (Proxy::instance()->proxyConfig().needsAuth()) {
-            _session->setProxyCredentials(Proxy::instance()->proxyConfig().user(), Proxy::instance()->proxyConfig().token());
-        }
-    }
+    const std::scoped_lock abortLock(_mutexSessionAbort);
+    _session = std::move(session);
+    return ExitCode::Ok;
 }
 
 void AbstractNetworkJob::clearSession() {
     const std::scoped_lock lock(_mutexSession);
 
-    if (_session) {
-        try {
-            if (_session->connected()) {
-                _session->flushRequest();
-                _session->reset();
-            }
-        } catch (Poco::Exception &e) {
-            // Not an issue
-            LOG_DEBUG(_logger, "Error in clearSession " << jobId() << " : " << errorText(e));
-        }
+    if (!_session) return;
+
+    const bool reusable = !isAborted() && isResponseFullyRead();
+    std::unique_ptr<Poco::Net::HTTPClientSession> session;
+    {
+        const std::scoped_lock abortLock(_mutexSessionAbort);
+        session = std::move(_session);
+        _responseStream = nullptr;
     }
+
+    HttpSessionPool::instance()->release(std::move(session), reusable);
 }
 
 void AbstractNetworkJob::abortSession() {
+    const std::scoped_lock lock(_mutexSessionAbort);
     if (_session) {
         try {
             if (_session->connected()) {
@@ -383,6 +394,17 @@ void AbstractNetworkJob::abortSession() {
     }
 }
 
+bool AbstractNetworkJob::isResponseFullyRead() const {
+    if (!_responseStream) return false;
+
+    try {
+        // Does not block if the whole body has been consumed, the Poco stream buffers keep track of the remaining length.
+        return _responseStream->rdbuf()->sgetc() == std::char_traits<char>::eof();
+    } catch (...) {
+        return false;
+    }
+}
+
 ExitInfo AbstractNetworkJob::sendRequest(const Poco::URI &uri) {
     std::string path(uri.getPathAndQuery());
     if (path.empty()) {
@@ -396,8 +418,9 @@ ExitInfo AbstractNetworkJob::sendRequest(const Poco::URI &uri) {
     // Set headers
     setHeaders(req);
 
-    if (!_data.empty()) {
-        req.setContentLength(static_cast<std::streamsize>(_data.size()));
+    const uint64_t bodySize = requestBodySize();
+    if (bodySize > 0) {
+        req.setContentLength(static_cast<std::streamsize>(bodySize));
     }
     logRequestInfo(req);
 
@@ -406,6 +429,7 @@ ExitInfo AbstractNetworkJob::sendRequest(const Poco::URI &uri) {
     try {
         const std::scoped_lock lock(_mutexSession);
         if (_session) {
+            _responseStream = nullptr;
             stream.push_back(_session->sendRequest(req));
             if (ioOrLogicalErrorOccurred(stream[0].get())) {
                 return processSocketError("invalid send stream", jobId());
@@ -418,17 +442,27 @@ ExitInfo AbstractNetworkJob::sendRequest(const Poco::URI &uri) {
     }
 
     // Send data
-    std::string::const_iterator itBegin = _data.begin();
-    while (itBegin != _data.end()) {
+    uint64_t offset = 0;
+    while (offset < bodySize) {
         const std::scoped_lock lock(_mutexSession);
         if (isAborted()) {
             LOG_DEBUG(_logger, "Request " << jobId() << ": aborting HTTPS session");
             return {};
         }
 
-        std::string::const_iterator itEnd = (_data.end() - itBegin > BUF_SIZE ? itBegin + BUF_SIZE : _data.end());
+        std::string_view slice;
+        if (const auto exitInfo = readRequestBodySlice(offset, BUF_SIZE, slice); !exitInfo) {
+            LOG_WARN(_logger, "Request " << jobId() << ": failed to read the request body at offset " << offset);
+            return exitInfo;
+        }
+        if (slice.empty()) {
+            LOG_WARN(_logger, "Request " << jobId() << ": request body shorter than expected");
+            return ExitCode::LogicError;
+        }
+
+        const size_t length = slice.size();
         try {
-            stream[0].get() << std::string(itBegin, itEnd);
+            (void) stream[0].get().write(slice.data(), static_cast<std::streamsize>(length));
             if (ioOrLogicalErrorOccurred(stream[0].get())) {
                 return processSocketError("stream write error", jobId());
             }
@@ -439,15 +473,20 @@ ExitInfo AbstractNetworkJob::sendRequest(const Poco::URI &uri) {
         }
 
         if (isProgressTracked()) {
-            addProgress(itEnd - itBegin);
+            addProgress(static_cast<int64_t>(length));
         }
 
-        itBegin = itEnd;
+        offset += length;
     }
 
     return ExitCode::Ok;
 }
 
+ExitInfo AbstractNetworkJob::readRequestBodySlice(const uint64_t offset, const size_t maxLength, std::string_view &slice) {
+    slice = requestBody().substr(static_cast<size_t>(offset), maxLength);
+    return ExitCode::Ok;
+}
+
 void AbstractNetworkJob::setHeaders(Poco::Net::HTTPRequest &req) {
     req.set("User-Agent", _userAgent);
     req.setContentType(contentType());
@@ -465,6 +504,7 @@ ExitInfo AbstractNetworkJob::receiveResponseFromSession(StreamVector &stream) {
         const std::scoped_lock lock(_mutexSession);
         if (_session) {
             (void) stream.emplace_back(_session->receiveResponse(_httpResponse));
+            _responseStream = &stream[0].get();
             if (ioOrLogicalErrorOccurred(stream[0].get())) {
                 return processSocketError("invalid receive stream", jobId());
             }
@@ -671,7 +711,11 @@ ExitInfo AbstractNetworkJob::followRedirect() {
 
     // Follow redirection
     LOG_DEBUG(_logger, "Request " << jobId() << ", following redirection: " << redirectUrl);
-    createSession(uri);
+    if (const auto exitInfo = createSession(uri); !exitInfo) {
+        if (exitInfo.code() != ExitCode::DataError) return exitInfo;
+        LOG_WARN(_logger, "Request " << jobId() << ": redirection to an unsupported URL refused");
+        return {ExitCode::DataError, ExitCause::RedirectionError};
+    }
 
     if (const auto exitInfo = sendRequest(uri); !exitInfo) {
         return exitInfo;
@@ -23,10 +23,12 @@
 #include "kDrive_API/backerror.h"
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <queue>
 
-#include <Poco/Net/HTTPSClientSession.h>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/Context.h>
 #include <Poco/Net/HTTPResponse.h>
 #include <Poco/URI.h>
 #include <Poco/JSON/Object.h>
@@ -76,6 +78,12 @@ class AbstractNetworkJob : public SyncJob {
         virtual ExitInfo handleOctetStreamResponse(std::istream &is);
         ExitInfo extractJson(const std::string &replyBody, Poco::JSON::Object::Ptr &jsonObj);
         void getStringFromStream(std::istream &inputStream, std::string &res);
+        // The body of the request, `_data` by default. Overridden by the jobs sending a buffer they do not want to copy.
+        virtual std::string_view requestBody() const { return _data; }
+        // Overridden by the jobs streaming their body instead of holding it in memory. The body is sent by slices of at most
+        // `maxLength` bytes, read in order from offset 0 at each try of the request.
+        virtual uint64_t requestBodySize() const { return requestBody().size(); }
+        virtual ExitInfo readRequestBodySlice(uint64_t offset, size_t maxLength, std::string_view &slice);
 
         std::string _httpMethod;
         uint8_t _apiVersion{2};
@@ -117,9 +125,16 @@ class AbstractNetworkJob : public SyncJob {
         virtual std::string contentType() { return {}; }
         virtual std::string acceptHeader() { return contentType(); }
 
-        void createSession(const Poco::URI &uri);
+        // Fails with `ExitCode::DataError` if the pool refuses the URI, e.g. a plain HTTP one, with `ExitCode::OperationCanceled`
+        // if the job is aborted while waiting for a session, or with `ExitCode::NetworkError` if none is given back in time.
+        ExitInfo createSession(const Poco::URI &uri);
+        /**
+         * @brief Give the session back to the HttpSessionPool. The session is reused by other jobs only if the response has
+         * been fully read and no error occurred.
+         */
         void clearSession();
         void abortSession();
+        bool isResponseFullyRead() const;
         ExitInfo sendRequest(const Poco::URI &uri);
         void setHeaders(Poco::Net::HTTPRequest &req);
         ExitInfo followRedirect();
@@ -150,8 +165,10 @@ class AbstractNetworkJob : public SyncJob {
         Poco::JSON::Object::Ptr _jsonRes{nullptr};
         std::string _octetStreamRes;
 
-        std::unique_ptr<Poco::Net::HTTPSClientSession> _session;
+        std::unique_ptr<Poco::Net::HTTPClientSession> _session;
         std::recursive_mutex _mutexSession;
+        std::mutex _mutexSessionAbort; // Prevents aborting a session that has already been given back to the pool
+        std::istream *_responseStream{nullptr}; // Owned by _session
 
         std::unordered_map<std::string, std::string, StringHashFunction, std::equal_to<>> _rawHeaders;
 };
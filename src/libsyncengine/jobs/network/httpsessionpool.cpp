@@ -0,0 +1,244 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "httpsessionpool.h"
+
+#include "libcommonserver/log/log.h"
+
+#include <log4cplus/loggingmacros.h>
+
+#include <Poco/Net/HTTPSClientSession.h>
+#include <Poco/Net/Socket.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace KDC {
+
+std::shared_ptr<HttpSessionPool> HttpSessionPool::_instance = nullptr;
+
+std::shared_ptr<HttpSessionPool> HttpSessionPool::instance() noexcept {
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        try {
+            _instance = std::shared_ptr<HttpSessionPool>(new HttpSessionPool());
+        } catch (...) {
+            _instance = nullptr;
+        }
+    });
+
+    return _instance;
+}
+
+std::unique_ptr<Poco::Net::HTTPClientSession> HttpSessionPool::acquire(const Poco::URI &uri, const ProxyConfig &proxyConfig,
+                                                                       Poco::Net::Context::Ptr context, ExitInfo &exitInfo,
+                                                                       const std::function<bool()> &abortRequested) {
+    exitInfo = ExitCode::Ok;
+
+    const bool plainHttp = uri.getScheme() == "http" && _plainHttpAllowedCount > 0;
+    if (!plainHttp && uri.getScheme() != "https") {
+        LOG_WARN(Log::instance()->getLogger(),
+                 "Session refused for a non HTTPS URL - scheme=" << uri.getScheme() << " host=" << uri.getHost());
+        exitInfo = ExitCode::DataError;
+        return nullptr;
+    }
+
+    const bool useProxy = proxyConfig.type() == ProxyType::HTTP;
+    const std::string proxyHost = useProxy ? proxyConfig.hostName() : std::string();
+    const auto proxyPort = useProxy ? static_cast<Poco::UInt16>(proxyConfig.port()) : Poco::UInt16(0);
+    const auto sessions = hostSessions(makeKey(uri.getScheme(), uri.getHost(), uri.getPort()));
+
+    std::unique_ptr<Poco::Net::HTTPClientSession> session;
+    {
+        const auto waitDeadline = std::chrono::steady_clock::now() + maxWaitDuration;
+        std::unique_lock lock(sessions->mutex);
+        while (!session) {
+            if (!sessions->idleSessions.empty()) {
+                IdleSession idleSession = std::move(sessions->idleSessions.back());
+                sessions->idleSessions.pop_back();
+                sessions->lentSessionsCount++;
+
+                // The health check is done outside the lock. An unhealthy session is closed when `idleSession` goes out of
+                // scope, and its slot is used by the next iteration.
+                lock.unlock();
+                const bool healthy = isHealthy(idleSession, proxyHost, proxyPort);
+                if (!healthy) idleSession.session.reset();
+                lock.lock();
+
+                if (healthy) {
+                    _reusedSessionsCount++;
+                    session = std::move(idleSession.session);
+                } else {
+                    sessions->lentSessionsCount--;
+                }
+            } else if (sessions->lentSessionsCount < maxSessionsPerHost) {
+                sessions->lentSessionsCount++;
+                break;
+            } else if (abortRequested && abortRequested()) {
+                exitInfo = ExitCode::OperationCanceled;
+                return nullptr;
+            } else if (std::chrono::steady_clock::now() >= waitDeadline) {
+                LOG_WARN(Log::instance()->getLogger(), "No session given back in time - host=" << uri.getHost());
+                exitInfo = {ExitCode::NetworkError, ExitCause::NetworkTimeout};
+                return nullptr;
+            } else {
+                (void) sessions->sessionReleased.wait_for(lock, waitCheckPeriod);
+            }
+        }
+    }
+
+    if (!session) {
+        try {
+            if (plainHttp) {
+                session = std::make_unique<Poco::Net::HTTPClientSession>(uri.getHost(), uri.getPort());
+            } else {
+                session = std::make_unique<Poco::Net::HTTPSClientSession>(uri.getHost(), uri.getPort(), context);
+            }
+            session->setKeepAlive(true);
+
+            if (useProxy) {
+                session->setProxy(proxyHost, proxyPort);
+                if (proxyConfig.needsAuth()) {
+                    session->setProxyCredentials(proxyConfig.user(), proxyConfig.token());
+                }
+            }
+        } catch (...) {
+            {
+                const std::scoped_lock lock(sessions->mutex);
+                sessions->lentSessionsCount--;
+            }
+            sessions->sessionReleased.notify_one();
+            throw;
+        }
+        _createdSessionsCount++;
+    }
+
+    const std::scoped_lock lock(_lentSessionsMutex);
+    (void) _lentSessions.insert_or_assign(session.get(), LentSession{sessions, _generation});
+    return session;
+}
+
+void HttpSessionPool::release(std::unique_ptr<Poco::Net::HTTPClientSession> session, const bool reusable) {
+    if (!session) return;
+
+    const auto lentSession = takeLentSession(session.get());
+    const auto &sessions = lentSession.hostSessions;
+    if (!sessions) {
+        LOG_WARN(Log::instance()->getLogger(), "Released session was not lent by the pool");
+        return;
+    }
+
+    bool keep = reusable;
+    try {
+        keep = keep && session->connected() && session->getKeepAlive();
+    } catch (const Poco::Exception &) {
+        keep = false;
+    }
+
+    {
+        const std::scoped_lock lock(sessions->mutex);
+        sessions->lentSessionsCount--;
+        // A session lent before the pool was cleared is not kept. The generation is checked under the lock of the host, so
+        // that `clear` either sees the session as idle or the session sees the new generation.
+        if (keep && lentSession.generation == _generation) {
+            sessions->idleSessions.push_back({std::move(session), std::chrono::steady_clock::now()});
+        }
+    }
+    sessions->sessionReleased.notify_one();
+    // A session which is not kept is closed when it goes out of scope, outside the lock
+}
+
+void HttpSessionPool::clear() {
+    _generation++;
+
+    std::vector<IdleSession> idleSessions;
+    {
+        const std::shared_lock lock(_hostSessionsMutex);
+        for (const auto &[_, sessions]: _hostSessions) {
+            const std::scoped_lock sessionsLock(sessions->mutex);
+            std::move(sessions->idleSessions.begin(), sessions->idleSessions.end(), std::back_inserter(idleSessions));
+            sessions->idleSessions.clear();
+        }
+    }
+    // Idle sessions are closed when `idleSessions` goes out of scope, outside the locks. The entries of the hosts are kept
+    // so that the sessions currently lent still count towards the cap.
+}
+
+size_t HttpSessionPool::idleSessionsCount() const {
+    const std::shared_lock lock(_hostSessionsMutex);
+    size_t count = 0;
+    for (const auto &[_, sessions]: _hostSessions) {
+        const std::scoped_lock sessionsLock(sessions->mutex);
+        count += sessions->idleSessions.size();
+    }
+    return count;
+}
+
+size_t HttpSessionPool::lentSessionsCount() const {
+    const std::scoped_lock lock(_lentSessionsMutex);
+    return _lentSessions.size();
+}
+
+HttpSessionPool::LentSession HttpSessionPool::takeLentSession(const Poco::Net::HTTPClientSession *session) {
+    const std::scoped_lock lock(_lentSessionsMutex);
+    auto node = _lentSessions.extract(session);
+    return node.empty() ? LentSession() : std::move(node.mapped());
+}
+
+std::shared_ptr<HttpSessionPool::HostSessions> HttpSessionPool::hostSessions(const std::string &key) {
+    {
+        const std::shared_lock lock(_hostSessionsMutex);
+        if (const auto it = _hostSessions.find(key); it != _hostSessions.end()) {
+            return it->second;
+        }
+    }
+
+    const std::unique_lock lock(_hostSessionsMutex);
+    const auto [it, _] = _hostSessions.try_emplace(key, std::make_shared<HostSessions>());
+    return it->second;
+}
+
+std::string HttpSessionPool::makeKey(const std::string &scheme, const std::string &host, const Poco::UInt16 port) {
+    return scheme + "://" + host + ":" + std::to_string(port);
+}
+
+bool HttpSessionPool::isHealthy(const IdleSession &idleSession, const std::string &proxyHost, const Poco::UInt16 proxyPort) {
+    if (std::chrono::steady_clock::now() - idleSession.releaseTime > maxIdleDuration) {
+        return false;
+    }
+
+    // A session connected through another proxy is not reused
+    if (idleSession.session->getProxyHost() != proxyHost) return false;
+    if (!proxyHost.empty() && idleSession.session->getProxyPort() != proxyPort) return false;
+
+    try {
+        if (!idleSession.session->connected()) return false;
+        // An idle connection must not be readable. Otherwise, the server has closed it or sent unexpected data.
+        return !idleSession.session->socket().poll(Poco::Timespan(0), Poco::Net::Socket::SELECT_READ |
+                                                                             Poco::Net::Socket::SELECT_ERROR);
+    } catch (const Poco::Exception &e) {
+        LOG_DEBUG(Log::instance()->getLogger(), "Idle session discarded: " << e.displayText());
+        return false;
+    }
+}
+
+void HttpSessionPool::allowPlainHttp(const bool allowed) {
+    _plainHttpAllowedCount += allowed ? 1 : -1;
+}
+
+} // namespace KDC
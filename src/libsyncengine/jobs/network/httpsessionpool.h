@@ -0,0 +1,141 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "libcommon/utility/types.h"
+#include "libcommonserver/network/proxyconfig.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Poco/Net/Context.h>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/URI.h>
+
+namespace KDC {
+
+/**
+ * @brief A process-wide pool of idle keep-alive HTTPS sessions, grouped by host.
+ * Network jobs borrow a session before sending their request and give it back once the response has been fully read, so
+ * that consecutive requests to the same host reuse the same TCP connection and TLS session instead of paying a new handshake.
+ * At most `maxSessionsPerHost` sessions, lent or idle, are open to a host: above that, `acquire` waits for a session to be
+ * given back.
+ */
+class HttpSessionPool {
+    public:
+        static std::shared_ptr<HttpSessionPool> instance() noexcept;
+
+        HttpSessionPool(HttpSessionPool const &) = delete;
+        void operator=(HttpSessionPool const &) = delete;
+
+        /**
+         * @brief Lend a session connected to the host of `uri`. An idle session is reused if a healthy one is available,
+         * otherwise a new session is created once the number of sessions open to the host is below `maxSessionsPerHost`.
+         * @param uri The URI of the request. The `http` scheme is refused, so that the access token is never sent in clear
+         * text, e.g. after a redirection.
+         * @param proxyConfig The proxy configuration to apply to a newly created session.
+         * @param context The SSL context used to create HTTPS sessions.
+         * @param exitInfo Set with `ExitCode::DataError` if the URI is refused, with `ExitCode::OperationCanceled` if the wait
+         * has been aborted, or with `ExitCode::NetworkError` if no session has been given back within `maxWaitDuration`.
+         * @param abortRequested If set, checked every `waitCheckPeriod` while waiting for a session to be given back.
+         * @return A session ready to send a request, or nullptr on error.
+         */
+        std::unique_ptr<Poco::Net::HTTPClientSession> acquire(const Poco::URI &uri, const ProxyConfig &proxyConfig,
+                                                              Poco::Net::Context::Ptr context, ExitInfo &exitInfo,
+                                                              const std::function<bool()> &abortRequested = nullptr);
+
+        /**
+         * @brief Give back a session lent by `acquire`. Every lent session must be given back, even if it is not reusable.
+         * @param session The session to be given back.
+         * @param reusable 'false' if an error occurred or if the response has not been fully read. The session is then closed.
+         */
+        void release(std::unique_ptr<Poco::Net::HTTPClientSession> session, bool reusable);
+
+        /**
+         * @brief Close all idle sessions, e.g. when the proxy configuration changes. The sessions currently lent still count
+         * towards the cap of their host until they are given back, and are then closed.
+         */
+        void clear();
+
+        size_t idleSessionsCount() const;
+        size_t lentSessionsCount() const;
+        uint64_t createdSessionsCount() const { return _createdSessionsCount; }
+        uint64_t reusedSessionsCount() const { return _reusedSessionsCount; }
+
+        static constexpr size_t maxSessionsPerHost = 16;
+        static constexpr std::chrono::seconds maxIdleDuration{30}; // Must be lower than the server keep-alive timeout
+        static constexpr std::chrono::minutes maxWaitDuration{5};
+        static constexpr std::chrono::milliseconds waitCheckPeriod{100};
+
+    private:
+        HttpSessionPool() = default;
+
+        struct IdleSession {
+                std::unique_ptr<Poco::Net::HTTPClientSession> session;
+                std::chrono::steady_clock::time_point releaseTime;
+        };
+
+        struct HostSessions {
+                std::mutex mutex;
+                std::condition_variable sessionReleased;
+                std::vector<IdleSession> idleSessions; // Used as a stack so that the most recently used session is reused first
+                size_t lentSessionsCount{0};
+        };
+
+        struct LentSession {
+                std::shared_ptr<HostSessions> hostSessions;
+                uint64_t generation{0}; // The value of `_generation` when the session was lent
+        };
+
+        std::shared_ptr<HostSessions> hostSessions(const std::string &key);
+        // Returns the host of a lent session, and forgets it
+        LentSession takeLentSession(const Poco::Net::HTTPClientSession *session);
+        static std::string makeKey(const std::string &scheme, const std::string &host, Poco::UInt16 port);
+        static bool isHealthy(const IdleSession &idleSession, const std::string &proxyHost, Poco::UInt16 proxyPort);
+
+        // Test seam: plain HTTP sessions are only created while a local test server is running
+        void allowPlainHttp(bool allowed);
+
+        static std::shared_ptr<HttpSessionPool> _instance;
+
+        // The sessions are grouped by host whatever the proxy, so that the cap still applies after a proxy change
+        std::unordered_map<std::string, std::shared_ptr<HostSessions>> _hostSessions;
+        mutable std::shared_mutex _hostSessionsMutex;
+
+        std::unordered_map<const Poco::Net::HTTPClientSession *, LentSession> _lentSessions;
+        mutable std::mutex _lentSessionsMutex;
+        std::atomic_uint64_t _generation{0}; // Incremented by `clear`
+
+        std::atomic_int _plainHttpAllowedCount{0};
+
+        std::atomic_uint64_t _createdSessionsCount{0};
+        std::atomic_uint64_t _reusedSessionsCount{0};
+
+        friend class LocalHttpServer;
+};
+
+} // namespace KDC
@@ -21,6 +21,7 @@
 #include "libcommonserver/io/filestat.h"
 #include "libcommonserver/io/iohelper.h"
 #include "libcommonserver/utility/utility.h"
+#include "libcommonserver/utility/freediskspacetracker.h"
 #include "libcommonserver/io/permissionsgiver.h"
 
 #include "libcommon/utility/utility.h"
@@ -31,7 +32,9 @@
 
 #include "utility/timerutility.h"
 
+#include <array>
 #include <fstream>
+#include <future>
 
 #include <Poco/File.h>
 #include <Poco/Net/HTTPRequest.h>
@@ -63,6 +66,12 @@ DownloadJob::DownloadJob(const std::shared_ptr<Vfs> vfs, std::shared_ptr<CacheDi
 }
 
 DownloadJob::~DownloadJob() {
+    if (_reservedSpace > 0) {
+        const bool written = exitInfo().code() == ExitCode::Ok;
+        FreeDiskSpaceTracker::instance()->release(_tmpPath, _reservedSpace, written);
+        FreeDiskSpaceTracker::instance()->release(_fileDownloadInfo.localpath, _reservedSpace, written);
+    }
+
     // Remove tmp file
     // For a remote CREATE operation, the tmp file should no longer exist, but if an error occurred in handleResponse, it must
     // be deleted.
@@ -508,6 +517,12 @@ ExitInfo DownloadJob::moveTmpFile() {
             // Make sure we are allowed to propagate the change
             PermissionsGiver _(_fileDownloadInfo.localpath.parent_path(), _logger);
 
+            // The content must be on disk before the rename, otherwise a crash could leave an empty file behind
+            if (const IoError syncError = IoHelper::syncFile(_tmpPath); syncError != IoError::Success) {
+                LOGW_WARN(_logger, L"Failed to sync downloaded file: " << Utility::formatIoError(_tmpPath, syncError));
+                return ExitCode::SystemError;
+            }
+
             // Move file
             IoError ioError = IoError::Success;
             (void) IoHelper::moveItem(_tmpPath, _fileDownloadInfo.localpath, ioError);
@@ -538,6 +553,11 @@ ExitInfo DownloadJob::moveTmpFile() {
 #if defined(KD_WINDOWS)
                 sharingViolationError = ec.value() == ERROR_SHARING_VIOLATION; // In this case, we will try again
 #endif
+            } else if (const IoError syncError = IoHelper::syncFile(_fileDownloadInfo.localpath);
+                       syncError != IoError::Success) {
+                // The content has been replaced anyway
+                LOGW_WARN(_logger,
+                          L"Failed to sync local file: " << Utility::formatIoError(_fileDownloadInfo.localpath, syncError));
             }
         }
 
@@ -594,8 +614,8 @@ ExitInfo DownloadJob::moveTmpFile() {
 
 bool DownloadJob::hasEnoughPlace(const SyncPath &tmpDirPath, const SyncPath &destDirPath, int64_t neededPlace,
                                  log4cplus::Logger logger) {
-    auto tmpDirSize = Utility::getFreeDiskSpace(tmpDirPath);
-    auto destDirSize = Utility::getFreeDiskSpace(destDirPath);
+    auto tmpDirSize = FreeDiskSpaceTracker::instance()->freeDiskSpace(tmpDirPath, neededPlace);
+    auto destDirSize = FreeDiskSpaceTracker::instance()->freeDiskSpace(destDirPath, neededPlace);
 
     if (const auto &freeBytes = std::min(tmpDirSize, destDirSize); freeBytes >= 0) {
         const auto totalNeededSpace = neededPlace + Utility::freeDiskSpaceLimit();
@@ -629,6 +649,9 @@ ExitInfo DownloadJob::createTmpFile(std::optional<std::reference_wrapper<std::is
         return exitInfo;
     }
 
+    // A previous trial of the request may have left a partial tmp file
+    (void) removeTmpFile();
+
     std::ofstream output;
     do {
         const std::string tmpFileName = CacheDirectory::createTmpFileName();
@@ -655,6 +678,11 @@ ExitInfo DownloadJob::createTmpFile(std::optional<std::reference_wrapper<std::is
         if (expectedSize != Poco::Net::HTTPMessage::UNKNOWN_CONTENT_LENGTH) {
             if (!hasEnoughPlace(_tmpPath, _fileDownloadInfo.localpath, expectedSize, _logger)) {
                 writeError = true;
+            } else if (expectedSize > 0 && _reservedSpace == 0) {
+                // Until the job ends, the other downloads must not count on this space
+                FreeDiskSpaceTracker::instance()->reserve(_tmpPath, expectedSize);
+                FreeDiskSpaceTracker::instance()->reserve(_fileDownloadInfo.localpath, expectedSize);
+                _reservedSpace = expectedSize;
             }
             if (expectedSize < 0) {
                 LOG_WARN(_logger, "Request " << jobId() << ": invalid content length: " << expectedSize);
@@ -662,9 +690,24 @@ ExitInfo DownloadJob::createTmpFile(std::optional<std::reference_wrapper<std::is
             }
         }
 
+        if (!writeError && !readError && expectedSize > 0) {
+            // Reserve the space upfront: limits fragmentation and fails early if the disk is full
+            if (const IoError ioError = IoHelper::preallocateFile(_tmpPath, expectedSize); ioError == IoError::DiskFull) {
+                LOGW_WARN(_logger, L"Not enough space to preallocate " << Utility::formatSyncPath(_tmpPath));
+                writeError = true;
+            } else if (ioError != IoError::Success) {
+                LOGW_DEBUG(_logger, L"Failed to preallocate " << Utility::formatIoError(_tmpPath, ioError));
+            }
+        }
+
         if (!writeError && !readError) {
             TimerUtility timer;
-            std::unique_ptr<char[]> buffer(new char[BUF_SIZE]);
+            // The next buffer is read from the network while the previous one is written to the tmp file
+            std::array<std::unique_ptr<char[]>, 2> buffers{std::unique_ptr<char[]>(new char[BUF_SIZE]), nullptr};
+            size_t bufferIndex = 0;
+            std::future<bool> pendingWrite;
+            const auto waitForPendingWrite = [&pendingWrite]() { return !pendingWrite.valid() || pendingWrite.get(); };
+
             bool done = false;
             int retryCount = 0;
             while (!done) {
@@ -673,7 +716,8 @@ ExitInfo DownloadJob::createTmpFile(std::optional<std::reference_wrapper<std::is
                     break;
                 }
 
-                istr->get().read(buffer.get(), BUF_SIZE);
+                char *buffer = buffers[bufferIndex].get();
+                istr->get().read(buffer, BUF_SIZE);
                 if (istr->get().bad() && !istr->get().fail()) {
                     // Read/writing error and not logical error
                     LOG_WARN(_logger,
@@ -686,21 +730,30 @@ ExitInfo DownloadJob::createTmpFile(std::optional<std::reference_wrapper<std::is
                     addProgress(readSize);
 
                     if (readSize > 0) {
-                        output.write(buffer.get(), readSize);
-                        if (output.bad()) {
+                        if (!waitForPendingWrite()) {
                             // Read/writing error or logical error
-                            LOG_WARN(_logger,
-                                     "Request " << jobId() << ": error after writing " << getProgress() << " bytes to tmp file");
+                            LOG_WARN(_logger, "Request " << jobId() << ": error after writing " << getProgress() - readSize
+                                                         << " bytes to tmp file");
                             writeError = true;
                             break;
                         }
-                        output.flush();
-                        if (output.bad()) {
-                            // Read/writing error or logical error
-                            LOG_WARN(_logger,
-                                     "Request " << jobId() << ": error after flushing " << getProgress() << " bytes to tmp file");
-                            writeError = true;
-                            break;
+
+                        const auto writeBuffer = [&output, buffer, readSize]() {
+                            (void) output.write(buffer, readSize);
+                            return !output.bad();
+                        };
+                        if (istr->get().eof()) {
+                            // Last buffer, nothing to overlap with
+                            if (!writeBuffer()) {
+                                LOG_WARN(_logger, "Request " << jobId() << ": error after writing " << getProgress()
+                                                             << " bytes to tmp file");
+                                writeError = true;
+                                break;
+                            }
+                        } else {
+                            pendingWrite = std::async(std::launch::async, writeBuffer);
+                            bufferIndex = 1 - bufferIndex;
+                            if (!buffers[bufferIndex]) buffers[bufferIndex].reset(new char[BUF_SIZE]);
                         }
                         retryCount = 0;
                     }
@@ -746,6 +799,14 @@ ExitInfo DownloadJob::createTmpFile(std::optional<std::reference_wrapper<std::is
 
                 if (_vfs && !_isHydrated) { // updateFetchStatus is used only for hydration.
                     if (timer.elapsed<std::chrono::milliseconds>().count() > NOTIFICATION_DELAY || done) {
+                        // The tmp file is read by the VFS, it must contain all the data received so far
+                        if (!waitForPendingWrite() || !output.flush()) {
+                            LOG_WARN(_logger,
+                                     "Request " << jobId() << ": error after flushing " << getProgress() << " bytes to tmp file");
+                            writeError = true;
+                            break;
+                        }
+
                         // Update fetch status
                         if (!_vfs->updateFetchStatus(_tmpPath, _fileDownloadInfo.localpath, getProgress(), fetchCanceled,
                                                      fetchFinished)) {
@@ -762,6 +823,12 @@ ExitInfo DownloadJob::createTmpFile(std::optional<std::reference_wrapper<std::is
                     }
                 }
             }
+
+            // The buffers must outlive the last write
+            if (!waitForPendingWrite() && !writeError) {
+                LOG_WARN(_logger, "Request " << jobId() << ": error after writing " << getProgress() << " bytes to tmp file");
+                writeError = true;
+            }
         }
     } else if (data) {
         expectedSize = static_cast<std::streamsize>(data->get().length());
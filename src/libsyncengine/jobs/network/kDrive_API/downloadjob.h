@@ -92,6 +92,7 @@ class DownloadJob : public AbstractTokenNetworkJob {
         FileDownloadInfo _fileDownloadInfo;
 
         SyncPath _tmpPath;
+        int64_t _reservedSpace = 0; // Space reserved in FreeDiskSpaceTracker while the job runs
         DateTimePolicy _dateTimePolicy;
         bool _responseHandlingCanceled = false;
 
@@ -18,6 +18,8 @@
 
 #include "csvfullfilelistwithcursorjob.h"
 
+#include <Poco/InflatingStream.h>
+
 #if defined(KD_WINDOWS)
 #include "reconciliation/platform_inconsistency_checker/platforminconsistencycheckerutility.h"
 #endif
@@ -25,6 +27,8 @@
 namespace KDC {
 
 static const uint32_t apiTimout = 900;
+static const size_t readChunkSize = 64 * 1024;
+static const size_t maxPendingItems = 10000;
 
 CsvFullFileListWithCursorJob::CsvFullFileListWithCursorJob(const DriveDbId driveDbId, const NodeId &dirId,
                                                            const NodeSet &blacklist /*= {}*/, const bool zip /*= true*/) :
@@ -43,7 +47,30 @@ bool CsvFullFileListWithCursorJob::getItem(SnapshotItem &item, bool &error, bool
     error = false;
     ignore = false;
 
-    return _snapshotItemHandler.getItem(item, _ss, error, ignore, eof);
+    std::unique_lock lock(_itemsMutex);
+    _consumerAttached = true;
+    _itemsCondition.wait(lock, [this] { return !_items.empty() || _itemsComplete || _itemsAborted; });
+    if (_items.empty()) {
+        eof = _eof;
+        return false;
+    }
+
+    const bool wasFull = _items.size() >= maxPendingItems;
+    auto &parsedItem = _items.front();
+    item = std::move(parsedItem.item);
+    error = parsedItem.error;
+    ignore = parsedItem.ignore;
+    _items.pop_front();
+    lock.unlock();
+
+    if (wasFull) _itemsCondition.notify_all();
+    return true;
+}
+
+bool CsvFullFileListWithCursorJob::waitForItem(const std::chrono::milliseconds timeout) {
+    std::unique_lock lock(_itemsMutex);
+    _consumerAttached = true;
+    return _itemsCondition.wait_for(lock, timeout, [this] { return !_items.empty() || _itemsComplete || _itemsAborted; });
 }
 
 std::string CsvFullFileListWithCursorJob::getCursor() {
@@ -71,27 +98,83 @@ void CsvFullFileListWithCursorJob::setQueryParameters(Poco::URI &uri) {
     uri.addQueryParameter("with", "files.is_link");
 }
 
+void CsvFullFileListWithCursorJob::abort() {
+    AbstractListingJob::abort();
+
+    {
+        const std::scoped_lock lock(_itemsMutex);
+        _itemsAborted = true;
+    }
+    _itemsCondition.notify_all();
+}
+
+ExitInfo CsvFullFileListWithCursorJob::runJob() noexcept {
+    const ExitInfo exitInfo = AbstractListingJob::runJob();
+
+    {
+        const std::scoped_lock lock(_itemsMutex);
+        _itemsComplete = true;
+        _eof = _snapshotItemHandler.eofReached();
+    }
+    _itemsCondition.notify_all();
+
+    return exitInfo;
+}
+
 ExitInfo CsvFullFileListWithCursorJob::handleResponse(std::istream &is) {
+    // The items are handed over to the consumer while the reply is read, a retry would provide them twice.
+    disableRetry();
+
+    std::unique_ptr<Poco::InflatingInputStream> inflater;
+    std::istream *input = &is;
     if (_zip) {
-        Utility::unzipStream(is, _ss);
-    } else {
-        _ss << is.rdbuf();
+        inflater = std::make_unique<Poco::InflatingInputStream>(is, Poco::InflatingStreamBuf::STREAM_GZIP);
+        input = inflater.get();
+    }
+
+    const auto onItem = [this](const SnapshotItem &item, const bool error, const bool ignore) { pushItem(item, error, ignore); };
+    std::vector<char> buffer(readChunkSize);
+    uint64_t length = 0;
+    bool parsing = true;
+    while (!isAborted()) {
+        (void) input->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto count = input->gcount();
+        if (count <= 0) break;
+
+        length += static_cast<uint64_t>(count);
+        if (parsing) {
+            // Once the end of file delimiter is reached, the rest of the reply is only drained.
+            parsing = _snapshotItemHandler.parseChunk(std::string_view(buffer.data(), static_cast<size_t>(count)), onItem);
+        }
     }
 
-    // Check that the stringstream is not empty (network issues)
-    _ss.seekg(0, std::ios_base::end);
-    const auto length = _ss.tellg();
+    if (isAborted()) return ExitCode::Ok;
+
+    _snapshotItemHandler.finishParsing(onItem);
+
+    // Check that the reply is not empty (network issues)
     if (length == 0) {
         LOG_ERROR(_logger, "Reply " << jobId() << " received with empty content.");
         return {ExitCode::BackError, ExitCause::FullListParsingError};
     }
 
-    _ss.seekg(0, std::ios_base::beg);
     if (isExtendedLog()) {
-        LOGW_DEBUG(_logger,
-                   L"Reply " << jobId() << L" received - length=" << length << L" value=" << CommonUtility::s2ws(_ss.str()));
+        LOG_DEBUG(_logger, "Reply " << jobId() << " received - length=" << length);
     }
     return ExitCode::Ok;
 }
 
+void CsvFullFileListWithCursorJob::pushItem(const SnapshotItem &item, const bool error, const bool ignore) {
+    std::unique_lock lock(_itemsMutex);
+    // Wait for the consumer rather than buffering the whole listing in memory
+    _itemsCondition.wait(lock, [this] { return !_consumerAttached || _items.size() < maxPendingItems || _itemsAborted; });
+    if (_itemsAborted) return;
+
+    const bool wasEmpty = _items.empty();
+    _items.push_back({item, error, ignore});
+    lock.unlock();
+
+    if (wasEmpty) _itemsCondition.notify_all();
+}
+
 } // namespace KDC
@@ -21,6 +21,10 @@
 #include "abstractlistingjob.h"
 #include "snapshotitemhandler.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 namespace KDC {
 
 class CsvFullFileListWithCursorJob final : public AbstractListingJob {
@@ -28,7 +32,7 @@ class CsvFullFileListWithCursorJob final : public AbstractListingJob {
         CsvFullFileListWithCursorJob(DriveDbId driveDbId, const NodeId &dirId, const NodeSet &blacklist = {}, bool zip = true);
 
         /**
-         * @brief getItem
+         * @brief getItem waits for the next item while the reply is received and parsed.
          * @param item : item extracted from line of the CSV file
          * @param error : blocking error, stop the process
          * @param ignore : parsing issue, non-blocking, just ignore the item
@@ -36,8 +40,18 @@ class CsvFullFileListWithCursorJob final : public AbstractListingJob {
          * @return if return == true, continue parsing
          */
         bool getItem(SnapshotItem &item, bool &error, bool &ignore, bool &eof);
+        /**
+         * @brief Waits until `getItem` can return without blocking.
+         * @return `false` if the timeout expired
+         */
+        bool waitForItem(std::chrono::milliseconds timeout);
         std::string getCursor();
 
+        void abort() override;
+
+    protected:
+        ExitInfo runJob() noexcept override;
+
     private:
         std::string getSpecificUrl() override;
         std::string contentType() override;
@@ -45,12 +59,26 @@ class CsvFullFileListWithCursorJob final : public AbstractListingJob {
         void setQueryParameters(Poco::URI &uri) override;
 
         ExitInfo handleResponse(std::istream &is) override;
+        void pushItem(const SnapshotItem &item, bool error, bool ignore);
 
         NodeId _dirId;
         bool _zip = true;
 
-        std::stringstream _ss;
         SnapshotItemHandler _snapshotItemHandler;
+
+        // Items parsed from the reply, waiting to be consumed by `getItem`
+        struct ParsedItem {
+                SnapshotItem item;
+                bool error = false;
+                bool ignore = false;
+        };
+        std::deque<ParsedItem> _items;
+        std::mutex _itemsMutex;
+        std::condition_variable _itemsCondition;
+        bool _consumerAttached = false; // The reply is read at the pace of the consumer only once it is waiting for items.
+        bool _itemsComplete = false;
+        bool _itemsAborted = false;
+        bool _eof = false;
 };
 
 } // namespace KDC
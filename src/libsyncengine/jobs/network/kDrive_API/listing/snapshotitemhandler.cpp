@@ -203,31 +203,35 @@ bool SnapshotItemHandler::getItem(SnapshotItem &item, std::stringstream &ss, boo
     }
 
     ParsingState state;
-    while (state.readNextLine) {
-        state.readNextLine = false;
+    while (!parseItemLine(item, line, ss.eof(), state, error, ignore)) {
+        std::getline(ss, line);
+    }
 
-        // Ignore the lines containing escaped double quotes
-        if (line.find(R"(\")") != std::string::npos) {
-            LOGW_WARN(_logger, L"Line containing an escaped double quotes, ignored it - line=" << CommonUtility::s2ws(line));
-            ignore = true;
-            return true;
-        }
+    return true;
+}
 
-        readSnapshotItemFields(item, line, error, state);
-        if (error) return true;
+bool SnapshotItemHandler::parseItemLine(SnapshotItem &item, const std::string &line, const bool lastLine, ParsingState &state,
+                                        bool &error, bool &ignore) {
+    // Ignore the lines containing escaped double quotes
+    if (line.find(R"(\")") != std::string::npos) {
+        LOGW_WARN(_logger, L"Line containing an escaped double quotes, ignored it - line=" << CommonUtility::s2ws(line));
+        ignore = true;
+        return true;
+    }
 
-        // A file name surrounded by double quotes can have a line return in it. If so, read next line and continue parsing
-        if (state.readingDoubleQuotedValue) {
-            if (ss.eof()) {
-                LOG_WARN(_logger, "EOF file reached prematurely");
-                error = true;
-                return true;
-            }
+    readSnapshotItemFields(item, line, error, state);
+    if (error) return true;
 
-            state.tmp.push_back('\n');
-            state.readNextLine = true;
-            std::getline(ss, line);
+    // A file name surrounded by double quotes can have a line return in it. If so, read next line and continue parsing
+    if (state.readingDoubleQuotedValue) {
+        if (lastLine) {
+            LOG_WARN(_logger, "EOF file reached prematurely");
+            error = true;
+            return true;
         }
+
+        state.tmp.push_back('\n');
+        return false;
     }
 
     if (state.index < CsvIndexEnd - 1) {
@@ -246,4 +250,62 @@ bool SnapshotItemHandler::getItem(SnapshotItem &item, std::stringstream &ss, boo
     return true;
 }
 
+bool SnapshotItemHandler::parseChunk(std::string_view chunk, const ItemCallback &onItem) {
+    while (!_parsingEnded && !chunk.empty()) {
+        const auto lineEnd = chunk.find('\n');
+        if (lineEnd == std::string_view::npos) {
+            (void) _pendingLine.append(chunk);
+            break;
+        }
+
+        (void) _pendingLine.append(chunk.substr(0, lineEnd));
+        chunk.remove_prefix(lineEnd + 1);
+        parseLine(_pendingLine, false, onItem);
+        _pendingLine.clear();
+    }
+
+    return !_parsingEnded;
+}
+
+void SnapshotItemHandler::finishParsing(const ItemCallback &onItem) {
+    if (!_parsingEnded && (!_pendingLine.empty() || _itemInProgress)) {
+        parseLine(_pendingLine, true, onItem);
+    }
+    _pendingLine.clear();
+    _parsingEnded = true;
+}
+
+void SnapshotItemHandler::parseLine(const std::string &line, const bool lastLine, const ItemCallback &onItem) {
+    if (!_itemInProgress) {
+        if (line.empty()) {
+            _parsingEnded = true;
+            return;
+        }
+
+        if (_ignoreFirstLine) {
+            // The first line of the CSV full listing consists of the column names
+            _ignoreFirstLine = false;
+            return;
+        }
+
+        if (line == endOfFileDelimiter) {
+            LOG_INFO(_logger, "End of file reached");
+            _eofReached = true;
+            _parsingEnded = true;
+            return;
+        }
+
+        _pendingItem = SnapshotItem();
+        _pendingItemState = ParsingState();
+        _itemInProgress = true;
+    }
+
+    bool error = false;
+    bool ignore = false;
+    if (!parseItemLine(_pendingItem, line, lastLine, _pendingItemState, error, ignore)) return;
+
+    _itemInProgress = false;
+    onItem(_pendingItem, error, ignore);
+}
+
 } // namespace KDC
@@ -20,6 +20,9 @@
 
 #include "update_detection/file_system_observer/snapshot/snapshotitem.h"
 
+#include <functional>
+#include <string_view>
+
 namespace KDC {
 
 class SnapshotItemHandler {
@@ -45,7 +48,6 @@ class SnapshotItemHandler {
                 bool readingDoubleQuotedValue{false}; // True if an opening double quote is encountered with no closing
                                                       // counter-part at this stage.
                 bool prevCharDoubleQuotes{false};
-                bool readNextLine{true}; // If true, read the next line, stop item parsing otherwise.
                 std::string tmp;
                 int doubleQuoteCount{0};
         };
@@ -62,12 +64,40 @@ class SnapshotItemHandler {
          */
         bool getItem(SnapshotItem &item, std::stringstream &ss, bool &error, bool &ignore, bool &eof);
 
+        using ItemCallback = std::function<void(const SnapshotItem &item, bool error, bool ignore)>;
+        /**
+         * @brief Incremental parsing of the full listing CSV file, received in chunks of any size. `onItem` is called with the
+         * same items and flags as the successive calls to `getItem` on the whole file would return, as soon as their last line
+         * has been received.
+         * @param chunk the next bytes of the CSV file
+         * @return `false` if the parsing has ended (end of file delimiter or empty line), `true` if more data is expected
+         */
+        bool parseChunk(std::string_view chunk, const ItemCallback &onItem);
+        /**
+         * @brief Parses the last line of the CSV file if it has no line return. Must be called after the last chunk.
+         */
+        void finishParsing(const ItemCallback &onItem);
+        [[nodiscard]] bool eofReached() const { return _eofReached; }
+
     private:
         bool _ignoreFirstLine = true;
         log4cplus::Logger _logger;
+
+        // Incremental parsing state
+        std::string _pendingLine; // The beginning of a line whose line return has not been received yet.
+        SnapshotItem _pendingItem;
+        ParsingState _pendingItemState;
+        bool _itemInProgress = false; // Whether `_pendingItem` spreads on several lines and the next one is awaited.
+        bool _parsingEnded = false;
+        bool _eofReached = false;
+
         void logError(const std::wstring &methodName, const std::wstring &stdErrorType, const std::string &str,
                       const std::exception &exc);
         void readSnapshotItemFields(SnapshotItem &item, const std::string &line, bool &error, ParsingState &state);
+        // Parses a line of `item`. Returns `false` if the item continues on the next line, `true` if it is complete.
+        bool parseItemLine(SnapshotItem &item, const std::string &line, bool lastLine, ParsingState &state, bool &error,
+                           bool &ignore);
+        void parseLine(const std::string &line, bool lastLine, const ItemCallback &onItem);
 };
 
 } // namespace KDC
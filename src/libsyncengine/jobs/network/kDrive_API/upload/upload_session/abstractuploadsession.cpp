@@ -31,6 +31,7 @@
 
 #include <log4cplus/loggingmacros.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include <xxhash.h>
@@ -266,6 +267,12 @@ ExitInfo AbstractUploadSession::sendChunks() {
         return exitInfo;
     }
 
+    const auto bufferPool = ChunkBufferPool::instance();
+    if (!bufferPool) {
+        LOG_WARN(_logger, "Failed to get the chunk buffer pool");
+        return ExitCode::SystemError;
+    }
+
     // Create a hash state
     XXH3_state_t *const state = XXH3_createState();
     if (!state) {
@@ -285,19 +292,19 @@ ExitInfo AbstractUploadSession::sendChunks() {
             break;
         }
 
-        const auto memblock = std::make_unique<char[]>(_chunkSize);
-        (void) file.read(memblock.get(), static_cast<std::streamsize>(_chunkSize));
-        if (file.bad() && !file.fail()) {
-            // Read/writing error and not logical error
-            LOGW_WARN(_logger, L"Failed to read chunk - path=" << Path2WStr(_filePath));
-            readError = true;
+        // Wait for a buffer if the memory cap of the concurrent uploads is reached
+        const uint64_t expectedChunkSize = std::min(_chunkSize, _filesize - (chunkNb - 1) * _chunkSize);
+        auto chunkBuffer = bufferPool->acquire(static_cast<size_t>(expectedChunkSize),
+                                               [this]() { return isAborted() || _jobExecutionError; });
+        if (!chunkBuffer) {
+            LOG_DEBUG(_logger, "Request " << jobId() << ": aborted while waiting for a chunk buffer");
             break;
         }
 
-        std::error_code ec; // Using noexcept signature of file_size.
-        if (const auto actualFileSize = std::filesystem::file_size(_filePath, ec); actualFileSize != _filesize) {
-            LOG_ERROR(_logger, "File size has changed while uploading.");
-            sentry::Handler::captureMessage(sentry::Level::Warning, "Upload chunk error", "File size has changed");
+        (void) file.read(chunkBuffer->data(), static_cast<std::streamsize>(expectedChunkSize));
+        if (file.bad() && !file.fail()) {
+            // Read/writing error and not logical error
+            LOGW_WARN(_logger, L"Failed to read chunk - path=" << Path2WStr(_filePath));
             readError = true;
             break;
         }
@@ -310,11 +317,17 @@ ExitInfo AbstractUploadSession::sendChunks() {
             break;
         }
 
-        const auto chunkContent = std::string(memblock.get(), static_cast<size_t>(actualChunkSize));
+        // A short read means that the file has shrunk, a growth is detected once all chunks are read
+        if (static_cast<uint64_t>(actualChunkSize) != expectedChunkSize) {
+            LOG_ERROR(_logger, "File size has changed while uploading.");
+            sentry::Handler::captureMessage(sentry::Level::Warning, "Upload chunk error", "File size has changed");
+            readError = true;
+            break;
+        }
 
         std::shared_ptr<UploadSessionChunkJob> chunkJob;
         try {
-            chunkJob = createChunkJob(chunkContent, chunkNb, actualChunkSize);
+            chunkJob = createChunkJob(std::move(chunkBuffer), chunkNb);
         } catch (const std::exception &e) {
             LOG_ERROR(_logger, "Error in UploadSessionChunkJob::UploadSessionChunkJob: error=" << e.what());
             jobCreationError = true;
@@ -369,6 +382,15 @@ ExitInfo AbstractUploadSession::sendChunks() {
         readError = true;
     }
 
+    if (!readError && !isAborted() && !_jobExecutionError) {
+        std::error_code ec; // Using noexcept signature of file_size.
+        if (const auto actualFileSize = std::filesystem::file_size(_filePath, ec); actualFileSize != _filesize) {
+            LOG_ERROR(_logger, "File size has changed while uploading.");
+            sentry::Handler::captureMessage(sentry::Level::Warning, "Upload chunk error", "File size has changed");
+            readError = true;
+        }
+    }
+
     sendChunksCanceled = isAborted() || readError || checksumError || jobCreationError || _jobExecutionError;
 
     if (!sendChunksCanceled) {
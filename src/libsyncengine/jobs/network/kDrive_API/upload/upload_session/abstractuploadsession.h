@@ -20,6 +20,7 @@
 
 #include "jobs/syncjob.h"
 #include "utility/types.h"
+#include "chunkbufferpool.h"
 #include "uploadsessionchunkjob.h"
 #include "uploadsessionfinishjob.h"
 #include "uploadsessionstartjob.h"
@@ -54,8 +55,8 @@ class AbstractUploadSession : public SyncJob {
         virtual std::shared_ptr<UploadSessionCancelJob> createCancelJob() = 0;
         virtual std::shared_ptr<UploadSessionStartJob> createStartJob() = 0;
         virtual std::shared_ptr<UploadSessionFinishJob> createFinishJob() = 0;
-        virtual std::shared_ptr<UploadSessionChunkJob> createChunkJob(const std::string &chunkContent, uint64_t chunkNb,
-                                                                      std::streamsize actualChunkSize) = 0;
+        virtual std::shared_ptr<UploadSessionChunkJob> createChunkJob(ChunkBufferPool::BufferPtr chunkBuffer,
+                                                                      uint64_t chunkNb) = 0;
 
         virtual ExitInfo runJobInit() = 0;
         virtual ExitInfo handleStartJobResult(const std::shared_ptr<UploadSessionStartJob> startJob,
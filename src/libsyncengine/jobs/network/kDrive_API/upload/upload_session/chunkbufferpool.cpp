@@ -0,0 +1,159 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chunkbufferpool.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace KDC {
+
+std::shared_ptr<ChunkBufferPool> ChunkBufferPool::_instance = nullptr;
+
+ChunkBufferPool::Buffer::Buffer(const size_t capacity) :
+    _data(new char[capacity]), // Not value-initialized: the content is overwritten anyway
+    _capacity(capacity),
+    _size(capacity) {}
+
+void ChunkBufferPool::Buffer::setSize(const size_t size) {
+    assert(size <= _capacity);
+    _size = std::min(size, _capacity);
+}
+
+std::shared_ptr<ChunkBufferPool> ChunkBufferPool::instance() noexcept {
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        try {
+            _instance = std::make_shared<ChunkBufferPool>(defaultMaxTotalSize);
+        } catch (...) {
+            _instance = nullptr;
+        }
+    });
+
+    return _instance;
+}
+
+ChunkBufferPool::ChunkBufferPool(const size_t maxTotalSize) :
+    _maxTotalSize(maxTotalSize) {}
+
+ChunkBufferPool::BufferPtr ChunkBufferPool::acquire(const size_t size, const std::function<bool()> &abortRequested) {
+    static constexpr std::chrono::milliseconds abortPollingPeriod(100);
+
+    std::unique_ptr<Buffer> buffer;
+    {
+        std::unique_lock lock(_mutex);
+        freeExpiredIdleBuffers();
+        for (;;) {
+            // Reuse the smallest idle buffer that is big enough
+            auto bestIt = _idleBuffers.end();
+            for (auto it = _idleBuffers.begin(); it != _idleBuffers.end(); ++it) {
+                if (it->buffer->capacity() >= size &&
+                    (bestIt == _idleBuffers.end() || it->buffer->capacity() < bestIt->buffer->capacity())) {
+                    bestIt = it;
+                }
+            }
+            if (bestIt != _idleBuffers.end()) {
+                buffer = std::move(bestIt->buffer);
+                (void) _idleBuffers.erase(bestIt);
+                break;
+            }
+
+            // Otherwise, allocate a new buffer, freeing the idle buffers that are too small if needed
+            while (!_idleBuffers.empty() && _totalSize + size > _maxTotalSize) {
+                freeIdleBuffer(_idleBuffers.begin());
+            }
+            if (_totalSize + size <= _maxTotalSize || _totalSize == 0) {
+                _totalSize += size;
+                _peakTotalSize = std::max(_peakTotalSize, _totalSize);
+                break;
+            }
+
+            if (abortRequested && abortRequested()) return nullptr;
+            (void) _bufferReleased.wait_for(lock, abortPollingPeriod);
+        }
+    }
+
+    if (!buffer) {
+        try {
+            buffer = std::make_unique<Buffer>(size);
+        } catch (const std::bad_alloc &) {
+            {
+                const std::scoped_lock lock(_mutex);
+                _totalSize -= size;
+            }
+            _bufferReleased.notify_all();
+            throw;
+        }
+    }
+    buffer->setSize(size);
+
+    return {buffer.release(), [pool = shared_from_this()](Buffer *releasedBuffer) { pool->release(releasedBuffer); }};
+}
+
+void ChunkBufferPool::clear() {
+    {
+        const std::scoped_lock lock(_mutex);
+        while (!_idleBuffers.empty()) {
+            freeIdleBuffer(_idleBuffers.begin());
+        }
+    }
+    _bufferReleased.notify_all();
+}
+
+size_t ChunkBufferPool::totalSize() const {
+    const std::scoped_lock lock(_mutex);
+    return _totalSize;
+}
+
+size_t ChunkBufferPool::peakTotalSize() const {
+    const std::scoped_lock lock(_mutex);
+    return _peakTotalSize;
+}
+
+size_t ChunkBufferPool::idleBuffersCount() const {
+    const std::scoped_lock lock(_mutex);
+    return _idleBuffers.size();
+}
+
+void ChunkBufferPool::release(Buffer *buffer) {
+    {
+        const std::scoped_lock lock(_mutex);
+        _idleBuffers.push_back({std::unique_ptr<Buffer>(buffer), std::chrono::steady_clock::now()});
+        freeExpiredIdleBuffers();
+    }
+    _bufferReleased.notify_all();
+}
+
+void ChunkBufferPool::freeExpiredIdleBuffers() {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = _idleBuffers.begin(); it != _idleBuffers.end();) {
+        if (now - it->releaseTime > maxIdleDuration) {
+            _totalSize -= it->buffer->capacity();
+            it = _idleBuffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ChunkBufferPool::freeIdleBuffer(const std::vector<IdleBuffer>::iterator it) {
+    _totalSize -= it->buffer->capacity();
+    (void) _idleBuffers.erase(it);
+}
+
+} // namespace KDC
@@ -0,0 +1,110 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "jobs/network/networkjobsparams.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace KDC {
+
+/**
+ * @brief A process-wide pool of the buffers holding the content of the upload session chunks.
+ * The total size of the buffers, in use or idle, is capped so that the memory used by the concurrent upload sessions is
+ * bounded whatever their number. A released buffer is kept for the next chunks instead of being freed, until it has been
+ * idle for too long.
+ */
+class ChunkBufferPool : public std::enable_shared_from_this<ChunkBufferPool> {
+    public:
+        class Buffer {
+            public:
+                explicit Buffer(size_t capacity);
+
+                [[nodiscard]] char *data() { return _data.get(); }
+                [[nodiscard]] std::string_view content() const { return {_data.get(), _size}; }
+                [[nodiscard]] size_t size() const { return _size; }
+                void setSize(size_t size);
+                [[nodiscard]] size_t capacity() const { return _capacity; }
+
+            private:
+                std::unique_ptr<char[]> _data;
+                size_t _capacity = 0;
+                size_t _size = 0; // Number of bytes of content, at most `_capacity`
+        };
+
+        // The buffer goes back to the pool when the last reference is dropped
+        using BufferPtr = std::shared_ptr<Buffer>;
+
+        static std::shared_ptr<ChunkBufferPool> instance() noexcept;
+
+        explicit ChunkBufferPool(size_t maxTotalSize);
+        ChunkBufferPool(ChunkBufferPool const &) = delete;
+        void operator=(ChunkBufferPool const &) = delete;
+
+        /**
+         * @brief Lend a buffer with a capacity of at least `size` bytes, and a content size of `size` bytes. If the cap is
+         * reached, wait until enough buffers are given back to the pool. A buffer bigger than the cap is lent only when no
+         * other buffer is allocated.
+         * @param size The size of the buffer.
+         * @param abortRequested Polled while waiting. The wait stops if it returns true.
+         * @return A buffer, or nullptr if the wait has been aborted.
+         */
+        BufferPtr acquire(size_t size, const std::function<bool()> &abortRequested = {});
+
+        /**
+         * @brief Free all idle buffers.
+         */
+        void clear();
+
+        [[nodiscard]] size_t maxTotalSize() const { return _maxTotalSize; }
+        [[nodiscard]] size_t totalSize() const;
+        [[nodiscard]] size_t peakTotalSize() const;
+        [[nodiscard]] size_t idleBuffersCount() const;
+
+        // Enough for 4 chunks of max size, or 40 chunks of min size, i.e. the chunks of files up to 2GB
+        static constexpr size_t defaultMaxTotalSize = 4 * chunkMaxSize;
+        static constexpr std::chrono::seconds maxIdleDuration{30};
+
+    private:
+        struct IdleBuffer {
+                std::unique_ptr<Buffer> buffer;
+                std::chrono::steady_clock::time_point releaseTime;
+        };
+
+        void release(Buffer *buffer);
+        void freeExpiredIdleBuffers();
+        void freeIdleBuffer(std::vector<IdleBuffer>::iterator it);
+
+        static std::shared_ptr<ChunkBufferPool> _instance;
+
+        size_t _maxTotalSize = defaultMaxTotalSize;
+        size_t _totalSize = 0; // Allocated size, in use or idle
+        size_t _peakTotalSize = 0;
+        std::vector<IdleBuffer> _idleBuffers;
+        mutable std::mutex _mutex;
+        std::condition_variable _bufferReleased;
+};
+
+} // namespace KDC
@@ -79,10 +79,10 @@ std::shared_ptr<UploadSessionStartJob> DriveUploadSession::createStartJob() {
     }
 }
 
-std::shared_ptr<UploadSessionChunkJob> DriveUploadSession::createChunkJob(const std::string &chunkContent, uint64_t chunkNb,
-                                                                          std::streamsize actualChunkSize) {
+std::shared_ptr<UploadSessionChunkJob> DriveUploadSession::createChunkJob(ChunkBufferPool::BufferPtr chunkBuffer,
+                                                                          uint64_t chunkNb) {
     return std::make_shared<UploadSessionChunkJob>(UploadSessionType::Drive, _driveDbId, getFilePath(), getSessionToken(),
-                                                   chunkContent, chunkNb, actualChunkSize, jobId());
+                                                   std::move(chunkBuffer), chunkNb, jobId());
 }
 
 std::shared_ptr<UploadSessionFinishJob> DriveUploadSession::createFinishJob() {
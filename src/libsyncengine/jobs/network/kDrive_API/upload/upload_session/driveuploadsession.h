@@ -49,8 +49,7 @@ class DriveUploadSession : public AbstractUploadSession {
         ExitInfo runJobInit() override;
 
         std::shared_ptr<UploadSessionStartJob> createStartJob() override;
-        std::shared_ptr<UploadSessionChunkJob> createChunkJob(const std::string &chunkContent, uint64_t chunkNb,
-                                                              std::streamsize actualChunkSize) override;
+        std::shared_ptr<UploadSessionChunkJob> createChunkJob(ChunkBufferPool::BufferPtr chunkBuffer, uint64_t chunkNb) override;
         std::shared_ptr<UploadSessionFinishJob> createFinishJob() override;
         std::shared_ptr<UploadSessionCancelJob> createCancelJob() override;
 
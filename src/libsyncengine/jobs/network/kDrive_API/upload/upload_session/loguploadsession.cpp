@@ -37,10 +37,10 @@ std::shared_ptr<UploadSessionStartJob> LogUploadSession::createStartJob() {
     return std::make_shared<UploadSessionStartJob>(UploadSessionType::Log, getFileName(), getFileSize(), getTotalChunks());
 }
 
-std::shared_ptr<UploadSessionChunkJob> LogUploadSession::createChunkJob(const std::string &chunkContent, uint64_t chunkNb,
-                                                                        std::streamsize actualChunkSize) {
-    return std::make_shared<UploadSessionChunkJob>(UploadSessionType::Log, getFilePath(), getSessionToken(), chunkContent,
-                                                   chunkNb, actualChunkSize, jobId());
+std::shared_ptr<UploadSessionChunkJob> LogUploadSession::createChunkJob(ChunkBufferPool::BufferPtr chunkBuffer,
+                                                                        uint64_t chunkNb) {
+    return std::make_shared<UploadSessionChunkJob>(UploadSessionType::Log, getFilePath(), getSessionToken(),
+                                                   std::move(chunkBuffer), chunkNb, jobId());
 }
 
 std::shared_ptr<UploadSessionFinishJob> LogUploadSession::createFinishJob() {
@@ -26,27 +26,39 @@
 namespace KDC {
 
 UploadSessionChunkJob::UploadSessionChunkJob(UploadSessionType uploadType, DriveDbId driveDbId, const SyncPath &filepath,
-                                             const std::string &sessionToken, const std::string &chunkContent, uint64_t chunkNb,
-                                             uint64_t chunkSize, UniqueId sessionJobId) :
+                                             const std::string &sessionToken, ChunkBufferPool::BufferPtr chunkBuffer,
+                                             uint64_t chunkNb, UniqueId sessionJobId) :
     AbstractUploadSessionJob(uploadType, driveDbId, filepath, sessionToken),
+    _chunkBuffer(std::move(chunkBuffer)),
     _chunkNb(chunkNb),
-    _chunkSize(chunkSize),
+    _chunkSize(_chunkBuffer->size()),
     _sessionJobId(sessionJobId) {
     _httpMethod = Poco::Net::HTTPRequest::HTTP_POST;
     _customTimeout = 60;
     _trials = TRIALS;
 
-    _data = chunkContent;
-    _chunkHash = Utility::computeXxHash(_data);
+    const auto content = _chunkBuffer->content();
+    _chunkHash = Utility::computeXxHash(content.data(), content.size());
 }
 
 UploadSessionChunkJob::UploadSessionChunkJob(UploadSessionType uploadType, const SyncPath &filepath,
-                                             const std::string &sessionToken, const std::string &chunkContent, uint64_t chunkNb,
-                                             uint64_t chunkSize, UniqueId sessionJobId) :
-    UploadSessionChunkJob(uploadType, 0, filepath, sessionToken, chunkContent, chunkNb, chunkSize, sessionJobId) {}
+                                             const std::string &sessionToken, ChunkBufferPool::BufferPtr chunkBuffer,
+                                             uint64_t chunkNb, UniqueId sessionJobId) :
+    UploadSessionChunkJob(uploadType, 0, filepath, sessionToken, std::move(chunkBuffer), chunkNb, sessionJobId) {}
 
 UploadSessionChunkJob::~UploadSessionChunkJob() {}
 
+ExitInfo UploadSessionChunkJob::runJob() noexcept {
+    const auto exitInfo = AbstractUploadSessionJob::runJob();
+    // The job may outlive its execution, e.g. in the job manager, while the next chunks wait for a buffer
+    _chunkBuffer.reset();
+    return exitInfo;
+}
+
+std::string_view UploadSessionChunkJob::requestBody() const {
+    return _chunkBuffer ? _chunkBuffer->content() : std::string_view();
+}
+
 std::string UploadSessionChunkJob::getSpecificUrl() {
     std::string str = AbstractTokenNetworkJob::getSpecificUrl();
     str += "/upload/session/";
@@ -19,17 +19,19 @@
 #pragma once
 
 #include "abstractuploadsessionjob.h"
+#include "chunkbufferpool.h"
 
 namespace KDC {
 
 class UploadSessionChunkJob : public AbstractUploadSessionJob {
     public:
+        // The chunk content is sent directly from `chunkBuffer`, which is given back to the pool once the job has run.
         UploadSessionChunkJob(UploadSessionType uploadType, DriveDbId driveDbId, const SyncPath &filepath,
-                              const std::string &sessionToken, const std::string &chunkContent, uint64_t chunkNb,
-                              uint64_t chunkSize, UniqueId sessionJobId);
+                              const std::string &sessionToken, ChunkBufferPool::BufferPtr chunkBuffer, uint64_t chunkNb,
+                              UniqueId sessionJobId);
 
         UploadSessionChunkJob(UploadSessionType uploadType, const SyncPath &filepath, const std::string &sessionToken,
-                              const std::string &chunkContent, uint64_t chunkNb, uint64_t chunkSize, UniqueId sessionJobId);
+                              ChunkBufferPool::BufferPtr chunkBuffer, uint64_t chunkNb, UniqueId sessionJobId);
         ~UploadSessionChunkJob() override;
 
         const std::string &chunkHash() const { return _chunkHash; }
@@ -37,12 +39,17 @@ class UploadSessionChunkJob : public AbstractUploadSessionJob {
         uint64_t chunkSize() const { return _chunkSize; }
         uint64_t chunkNb() const { return _chunkNb; }
 
+    protected:
+        ExitInfo runJob() noexcept override;
+        std::string_view requestBody() const override;
+
     private:
         std::string getSpecificUrl() override;
         std::string contentType() override;
         void setQueryParameters(Poco::URI &) override;
         ExitInfo setData() override { return ExitCode::Ok; }
 
+        ChunkBufferPool::BufferPtr _chunkBuffer;
         std::string _chunkHash;
         uint64_t _chunkNb = 0;
         uint64_t _chunkSize = 0;
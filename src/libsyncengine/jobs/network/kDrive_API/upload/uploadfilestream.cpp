@@ -0,0 +1,144 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uploadfilestream.h"
+
+#include "libcommonserver/io/iohelper.h"
+#include "libcommonserver/log/log.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <log4cplus/loggingmacros.h>
+
+#include <algorithm>
+
+namespace KDC {
+
+namespace {
+constexpr size_t hashBufferSize = 1024 * 1024; // 1MB
+} // namespace
+
+UploadFileStream::UploadFileStream(const SyncPath &path) :
+    _logger(Log::instance()->getLogger()),
+    _path(path) {}
+
+ExitInfo UploadFileStream::open() {
+    close();
+
+    // Some applications generate locked temporary files during save operations. To avoid spurious "access denied" errors,
+    // we retry for 10 seconds, which is usually sufficient for the application to delete the tmp file. If the file is still
+    // locked after 10 seconds, a file access error is displayed to the user. Proper handling is also implemented for
+    // "file not found" errors.
+    if (const auto exitInfo = IoHelper::openFile(_path, _file, 10); !exitInfo) {
+        LOGW_WARN(_logger, L"Failed to open file " << Utility::formatSyncPath(_path));
+        return exitInfo;
+    }
+
+    _hashState.reset(XXH3_createState());
+    if (!_hashState || XXH3_64bits_reset(_hashState.get()) == XXH_ERROR) {
+        LOGW_WARN(_logger, L"Checksum computation failed for file " << Utility::formatSyncPath(_path));
+        return ExitCode::SystemError;
+    }
+
+    // First read: size and content hash
+    _buffer.resize(hashBufferSize);
+    _size = 0;
+    std::streamsize readBytes = 0;
+    while ((readBytes = _file.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size())).gcount()) > 0) {
+        if (XXH3_64bits_update(_hashState.get(), _buffer.data(), static_cast<size_t>(readBytes)) == XXH_ERROR) {
+            LOGW_WARN(_logger, L"Checksum computation failed for file " << Utility::formatSyncPath(_path));
+            return ExitCode::SystemError;
+        }
+        _size += static_cast<uint64_t>(readBytes);
+    }
+    if (_file.bad()) {
+        LOGW_WARN(_logger, L"Failed to read file - path=" << Path2WStr(_path));
+        return {ExitCode::SystemError, ExitCause::FileAccessError};
+    }
+    _contentHash = Utility::xxHashToStr(XXH3_64bits_digest(_hashState.get()));
+
+    return rewind();
+}
+
+void UploadFileStream::close() {
+    if (_file.is_open()) _file.close();
+    _file.clear();
+    _hashState.reset();
+    _readSize = 0;
+    std::vector<char>().swap(_buffer);
+}
+
+ExitInfo UploadFileStream::readSlice(const uint64_t offset, const size_t maxLength, std::string_view &slice) {
+    slice = {};
+    if (!_file.is_open()) {
+        LOGW_WARN(_logger, L"File is not open - path=" << Path2WStr(_path));
+        return ExitCode::LogicError;
+    }
+
+    if (offset == 0 && _readSize > 0) {
+        if (const auto exitInfo = rewind(); !exitInfo) return exitInfo;
+    }
+    if (offset != _readSize) {
+        LOG_WARN(_logger, "Slices must be read in order - offset=" << offset << " expected=" << _readSize);
+        return ExitCode::LogicError;
+    }
+    if (_readSize == _size) return ExitCode::Ok;
+
+    const auto length = static_cast<size_t>(std::min(static_cast<uint64_t>(maxLength), _size - _readSize));
+    if (_buffer.size() < length) _buffer.resize(length);
+    (void) _file.read(_buffer.data(), static_cast<std::streamsize>(length));
+    if (_file.bad()) {
+        LOGW_WARN(_logger, L"Failed to read file - path=" << Path2WStr(_path));
+        return {ExitCode::SystemError, ExitCause::FileAccessError};
+    }
+    if (static_cast<size_t>(_file.gcount()) != length) return fileChanged(); // The file has shrunk
+
+    if (XXH3_64bits_update(_hashState.get(), _buffer.data(), length) == XXH_ERROR) {
+        LOGW_WARN(_logger, L"Checksum computation failed for file " << Utility::formatSyncPath(_path));
+        return ExitCode::SystemError;
+    }
+    _readSize += length;
+
+    if (_readSize == _size) {
+        // Check before the last slice is sent that the file has neither grown nor been modified
+        if (_file.peek() != std::ifstream::traits_type::eof() ||
+            Utility::xxHashToStr(XXH3_64bits_digest(_hashState.get())) != _contentHash) {
+            return fileChanged();
+        }
+    }
+
+    slice = std::string_view(_buffer.data(), length);
+    return ExitCode::Ok;
+}
+
+ExitInfo UploadFileStream::rewind() {
+    _file.clear();
+    (void) _file.seekg(0);
+    if (!_file || XXH3_64bits_reset(_hashState.get()) == XXH_ERROR) {
+        LOGW_WARN(_logger, L"Failed to rewind file - path=" << Path2WStr(_path));
+        return {ExitCode::SystemError, ExitCause::FileAccessError};
+    }
+    _readSize = 0;
+    return ExitCode::Ok;
+}
+
+ExitInfo UploadFileStream::fileChanged() {
+    LOGW_WARN(_logger, L"File has changed while uploading - " << Utility::formatSyncPath(_path));
+    return {ExitCode::SystemError, ExitCause::FileAccessError};
+}
+
+} // namespace KDC
@@ -0,0 +1,82 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "libcommon/utility/types.h"
+
+#include <log4cplus/logger.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <xxhash.h>
+
+namespace KDC {
+
+/**
+ * @brief The content of a file read from disk by slices while it is uploaded, instead of being loaded in memory.
+ * The content hash must be sent before the content, it is computed by a first read of the file. The second read, during the
+ * upload, hashes the content again: a change of the file is detected before the last slice is read, so that the server
+ * never receives a complete content that does not match the announced hash.
+ */
+class UploadFileStream {
+    public:
+        explicit UploadFileStream(const SyncPath &path);
+
+        /**
+         * @brief Open the file, compute its size and content hash, and rewind it. To be called before each try of the upload.
+         */
+        ExitInfo open();
+        void close();
+
+        [[nodiscard]] bool isOpen() const { return _file.is_open(); }
+        [[nodiscard]] uint64_t size() const { return _size; }
+        [[nodiscard]] const std::string &contentHash() const { return _contentHash; }
+
+        /**
+         * @brief Read the next slice of the content.
+         * @param offset The offset of the slice, i.e. the end of the previous slice, or 0 to start over.
+         * @param maxLength The maximum length of the slice.
+         * @param slice The slice, valid until the next call.
+         * @return ExitCode::SystemError with ExitCause::FileAccessError if the file cannot be read or has changed since open().
+         */
+        ExitInfo readSlice(uint64_t offset, size_t maxLength, std::string_view &slice);
+
+    private:
+        struct HashStateDeleter {
+                void operator()(XXH3_state_t *state) const { (void) XXH3_freeState(state); }
+        };
+
+        ExitInfo rewind();
+        ExitInfo fileChanged();
+
+        log4cplus::Logger _logger;
+        SyncPath _path;
+        std::ifstream _file;
+        uint64_t _size = 0;
+        std::string _contentHash;
+        uint64_t _readSize = 0; // Size of the content read since the last rewind
+        std::unique_ptr<XXH3_state_t, HashStateDeleter> _hashState;
+        std::vector<char> _buffer;
+};
+
+} // namespace KDC
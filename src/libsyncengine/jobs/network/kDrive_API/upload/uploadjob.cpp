@@ -23,7 +23,6 @@
 #include "libcommonserver/utility/utility.h"
 #include "libcommonserver/utility/jsonparserutility.h"
 
-#include <fstream>
 #include <Poco/Net/HTTPRequest.h>
 
 #define TRIALS 5
@@ -35,6 +34,7 @@ UploadJob::UploadJob(const std::shared_ptr<Vfs> vfs, const DriveDbId driveDbId,
                      const SyncTime modificationTime) :
     AbstractTokenNetworkJob(ApiType::Drive, 0, 0, driveDbId, 0),
     _absoluteFilePath(absoluteFilePath),
+    _fileStream(absoluteFilePath),
     _filename(filename),
     _remoteParentDirId(remoteParentDirId),
     _creationTimeIn(creationTime),
@@ -72,6 +72,13 @@ UploadJob::~UploadJob() {
     }
 }
 
+ExitInfo UploadJob::runJob() noexcept {
+    const auto exitInfo = AbstractTokenNetworkJob::runJob();
+    // Do not keep the file open while the job waits to be deleted
+    _fileStream.close();
+    return exitInfo;
+}
+
 ExitInfo UploadJob::canRun() {
     if (bypassCheck()) {
         return ExitCode::Ok;
@@ -132,7 +139,7 @@ void UploadJob::setQueryParameters(Poco::URI &uri) {
         uri.addQueryParameter("file_id", _fileId);
     }
 
-    uri.addQueryParameter("total_size", std::to_string(_data.size()));
+    uri.addQueryParameter("total_size", std::to_string(requestBodySize()));
 
     uri.addQueryParameter("total_chunk_hash", "xxh3:" + _contentHash);
     uri.addQueryParameter(lastModifiedAtKey, std::to_string(_modificationTimeIn));
@@ -142,11 +149,14 @@ void UploadJob::setQueryParameters(Poco::URI &uri) {
         uri.addQueryParameter(symbolicLinkKey, str2HtmlStr(Path2Str(_linkTarget)));
     }
 
-    setProgressExpectedFinalValue(static_cast<int64_t>(_data.size()));
+    setProgressExpectedFinalValue(static_cast<int64_t>(requestBodySize()));
     setProgress(0);
 }
 
 ExitInfo UploadJob::setData() {
+    _fileStream.close();
+    _data.clear();
+
     ItemType itemType;
     if (!IoHelper::getItemType(_absoluteFilePath, itemType)) {
         LOGW_WARN(_logger, L"Error in IoHelper::getItemType - " << Utility::formatSyncPath(_absoluteFilePath));
@@ -174,7 +184,7 @@ ExitInfo UploadJob::setData() {
         if (ExitInfo exitInfo = readFile(); !exitInfo) return exitInfo;
     }
 
-    _contentHash = Utility::computeXxHash(_data);
+    _contentHash = _fileStream.isOpen() ? _fileStream.contentHash() : Utility::computeXxHash(_data);
     return ExitCode::Ok;
 }
 
@@ -194,46 +204,17 @@ std::string UploadJob::contentType() {
 }
 
 ExitInfo UploadJob::readFile() {
-    // Some applications generate locked temporary files during save operations. To avoid spurious "access denied" errors,
-    // we retry for 10 seconds, which is usually sufficient for the application to delete the tmp file. If the file is still
-    // locked after 10 seconds, a file access error is displayed to the user. Proper handling is also implemented for
-    // "file not found" errors.
-    std::ifstream file;
-    if (ExitInfo exitInfo = IoHelper::openFile(_absoluteFilePath, file, 10); !exitInfo) {
-        LOGW_WARN(_logger, L"Failed to open file " << Utility::formatSyncPath(_absoluteFilePath));
-        return exitInfo;
-    }
-
-    std::ostringstream ostrm;
-    ostrm << file.rdbuf();
-    if (ostrm.bad()) {
-        // Read/writing error or logical error
-        LOGW_WARN(_logger, L"Failed to insert file content into string stream - path=" << Path2WStr(_absoluteFilePath));
-        return {ExitCode::SystemError, ExitCause::FileAccessError};
-    }
-
-    ostrm.flush();
-    if (ostrm.bad()) {
-        // Read/writing error or logical error
-        LOGW_WARN(_logger, L"Failed to flush string stream - path=" << Path2WStr(_absoluteFilePath));
-        return {ExitCode::SystemError, ExitCause::FileAccessError};
-    }
-
-    file.close();
-    if (file.bad()) {
-        // Read/writing error or logical error
-        LOGW_WARN(_logger, L"Failed to close file - path=" << Path2WStr(_absoluteFilePath));
-        return {ExitCode::SystemError, ExitCause::FileAccessError};
-    }
+    // Only the size and the content hash are computed here, the content is read again while the request is sent
+    return _fileStream.open();
+}
 
-    try {
-        _data = ostrm.str();
-    } catch (const std::bad_alloc &) {
-        LOGW_WARN(_logger, L"Memory allocation error when setting data content - path=" << Path2WStr(_absoluteFilePath));
-        return {ExitCode::SystemError, ExitCause::NotEnoughMemory};
-    }
+uint64_t UploadJob::requestBodySize() const {
+    return _fileStream.isOpen() ? _fileStream.size() : _data.size();
+}
 
-    return ExitCode::Ok;
+ExitInfo UploadJob::readRequestBodySlice(const uint64_t offset, const size_t maxLength, std::string_view &slice) {
+    if (!_fileStream.isOpen()) return AbstractTokenNetworkJob::readRequestBodySlice(offset, maxLength, slice);
+    return _fileStream.readSlice(offset, maxLength, slice);
 }
 
 ExitInfo UploadJob::readLink() {
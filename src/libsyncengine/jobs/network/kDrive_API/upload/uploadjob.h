@@ -17,6 +17,7 @@
 #pragma once
 
 #include "jobs/network/abstracttokennetworkjob.h"
+#include "uploadfilestream.h"
 
 #include "libcommon/utility/types.h"
 #include "libcommonserver/vfs/vfs.h"
@@ -44,8 +45,11 @@ class UploadJob : public AbstractTokenNetworkJob {
         int64_t size() const { return _sizeOut; }
 
     protected:
+        ExitInfo runJob() noexcept override;
         ExitInfo canRun() override;
         ExitInfo handleResponse(std::istream &is) override;
+        uint64_t requestBodySize() const override;
+        ExitInfo readRequestBodySlice(uint64_t offset, size_t maxLength, std::string_view &slice) override;
 
     private:
         std::string getSpecificUrl() override;
@@ -57,6 +61,7 @@ class UploadJob : public AbstractTokenNetworkJob {
         ExitInfo readLink();
 
         SyncPath _absoluteFilePath;
+        UploadFileStream _fileStream; // The content of a file is not loaded in memory but streamed from disk
         SyncName _filename;
         NodeId _fileId;
         NodeId _remoteParentDirId;
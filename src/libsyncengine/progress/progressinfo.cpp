@@ -32,6 +32,15 @@ ProgressInfo::~ProgressInfo() {
 
 auto ProgressInfo::GetItemIterator(const SyncPath &path) {
     // The caller must acquire a lock on _mutex before calling this method.
+    // The items are keyed by normalized path: the normalization is skipped if the path is found as is, or if it is the path
+    // with which an item has been initialized.
+    if (const auto it = _currentItems.find(path); it != _currentItems.end()) {
+        return it;
+    }
+    if (const auto normalizedPathIt = _normalizedPaths.find(path); normalizedPathIt != _normalizedPaths.end()) {
+        return _currentItems.find(normalizedPathIt->second);
+    }
+
     SyncPath normalizedPath;
     if (!Utility::normalizedSyncPath(path, normalizedPath)) {
         LOGW_WARN(Log::instance()->getLogger(), L"Error in Utility::normalizedSyncPath: " << Utility::formatSyncPath(path));
@@ -41,11 +50,15 @@ auto ProgressInfo::GetItemIterator(const SyncPath &path) {
 }
 
 void ProgressInfo::reset() {
+    flushCompletedItems();
+
     const std::scoped_lock lock(_mutex);
     _currentItems.clear();
+    _normalizedPaths.clear();
     _sizeProgress = Progress();
     _fileProgress = Progress();
     _totalSizeOfCompletedJobs = 0;
+    _completedSizeOfCurrentItems = 0;
 
     // Historically, these starting estimates were way lower, but that lead
     // to gross overestimation of ETA when a good estimate wasn't available.
@@ -68,6 +81,8 @@ static bool shouldCountProgress(const SyncFileItem &item) {
 }
 
 void ProgressInfo::updateEstimates() {
+    flushCompletedItems();
+
     if (!_update) {
         return;
     }
@@ -104,6 +119,9 @@ bool ProgressInfo::initProgress(const SyncFileItem &item) {
 
     const std::scoped_lock lock(_mutex);
     _currentItems[normalizedPath].push(progressItem);
+    if (normalizedPath != path) {
+        (void) _normalizedPaths.try_emplace(path, normalizedPath);
+    }
 
     _fileProgress.setTotal(_fileProgress.total() + 1);
     _sizeProgress.setTotal(_sizeProgress.total() + item.size());
@@ -121,61 +139,76 @@ bool ProgressInfo::getSyncFileItem(const SyncPath &path, SyncFileItem &item) {
 }
 
 bool ProgressInfo::setProgress(const SyncPath &path, int progress) {
-    const std::scoped_lock lock(_mutex);
-    const auto it = GetItemIterator(path);
-    if (it == _currentItems.end() || it->second.empty()) {
-        return true;
-    }
-
-    SyncFileItem &item = it->second.front().item();
-    item.setStatus(SyncFileStatus::Syncing);
-    item.setProgress(progress);
-
-    _syncPal->addCompletedItem(_syncPal->syncDbId(), item);
+    bool flush = false;
+    {
+        const std::scoped_lock lock(_mutex);
+        const auto it = GetItemIterator(path);
+        if (it == _currentItems.end() || it->second.empty()) {
+            return true;
+        }
 
-    if (!shouldCountProgress(item)) {
-        return true;
+        ProgressItem &progressItem = it->second.front();
+        SyncFileItem &item = progressItem.item();
+        item.setStatus(SyncFileStatus::Syncing);
+        item.setProgress(progress);
+
+        flush = addPendingCompletedItem(it->first, item, true);
+
+        if (shouldCountProgress(item)) {
+            const int64_t previousCompleted = progressItem.progress().completed();
+            progressItem.progress().setCompleted(
+                    std::max(static_cast<int64_t>(0), progress * progressItem.progress().total() / 100));
+            if (isSizeDependent(item)) {
+                _completedSizeOfCurrentItems += progressItem.progress().completed() - previousCompleted;
+                updateCompletedSize();
+            }
+        }
     }
 
-    it->second.front().progress().setCompleted(
-            std::max(static_cast<int64_t>(0), progress * it->second.front().progress().total() / 100));
-    recomputeCompletedSize();
+    if (flush) {
+        flushCompletedItems();
+    }
     return true;
 }
 
 bool ProgressInfo::setProgressComplete(const SyncPath &path, const SyncFileStatus status) {
-    const std::scoped_lock lock(_mutex);
-    const auto it = GetItemIterator(path);
-    if (it == _currentItems.end() || it->second.empty()) {
-        LOGW_INFO(Log::instance()->getLogger(),
-                  L"Item not found in ProgressInfo list (normal for ommited operation): " << Utility::formatSyncPath(path));
-        return true;
-    }
-
-    SyncFileItem &item = it->second.front().item();
-    item.setStatus(status);
+    bool flush = false;
+    {
+        const std::scoped_lock lock(_mutex);
+        const auto it = GetItemIterator(path);
+        if (it == _currentItems.end() || it->second.empty()) {
+            LOGW_INFO(Log::instance()->getLogger(),
+                      L"Item not found in ProgressInfo list (normal for ommited operation): " << Utility::formatSyncPath(path));
+            return true;
+        }
 
-    item.setProgress(100); // 100%
+        ProgressItem &progressItem = it->second.front();
+        SyncFileItem &item = progressItem.item();
+        item.setStatus(status);
 
-    _syncPal->addCompletedItem(_syncPal->syncDbId(), item);
+        item.setProgress(100); // 100%
 
-    if (!shouldCountProgress(item)) {
-        return true;
-    }
+        flush = addPendingCompletedItem(it->first, item, false);
 
-    _fileProgress.setCompleted(_fileProgress.completed() + 1);
-    if (ProgressInfo::isSizeDependent(item)) {
-        _totalSizeOfCompletedJobs += it->second.front().progress().total();
-    }
+        if (shouldCountProgress(item)) {
+            _fileProgress.setCompleted(_fileProgress.completed() + 1);
+            if (ProgressInfo::isSizeDependent(item)) {
+                _totalSizeOfCompletedJobs += progressItem.progress().total();
+                _completedSizeOfCurrentItems -= progressItem.progress().completed();
+                updateCompletedSize();
+            }
 
-    it->second.pop();
-    if (it->second.empty()) {
-        const auto normalizedPath = it->first;
-        _currentItems.erase(normalizedPath);
+            const SyncPath initPath = item.newPath().has_value() ? item.newPath().value() : item.path();
+            it->second.pop();
+            if (it->second.empty()) {
+                (void) _normalizedPaths.erase(initPath);
+                _currentItems.erase(it);
+            }
+        }
     }
 
-    if (const auto currentItemsSize = _currentItems.size(); currentItemsSize < 100 || currentItemsSize % 1000 == 0) {
-        recomputeCompletedSize();
+    if (flush) {
+        flushCompletedItems();
     }
     return true;
 }
@@ -239,15 +272,58 @@ bool ProgressInfo::trustEta() const {
     return totalProgress().estimatedEta() < 100 * optimisticEta();
 }
 
-void ProgressInfo::recomputeCompletedSize() {
+void ProgressInfo::updateCompletedSize() {
+    // The caller must acquire a lock on _mutex before calling this method.
+    _sizeProgress.setCompleted(_totalSizeOfCompletedJobs + _completedSizeOfCurrentItems);
+}
+
+int64_t ProgressInfo::computeCompletedSize() const {
+    // Full computation of the completed size, which `_completedSizeOfCurrentItems` keeps up to date incrementally.
     const std::scoped_lock lock(_mutex);
     int64_t r = _totalSizeOfCompletedJobs;
-    for (auto &itemElt: _currentItems) {
-        if (isSizeDependent(itemElt.second.front().item())) {
-            r += itemElt.second.front().progress().completed();
+    for (const auto &itemElt: _currentItems) {
+        const ProgressItem &progressItem = itemElt.second.front();
+        if (isSizeDependent(progressItem.item())) {
+            r += progressItem.progress().completed();
+        }
+    }
+    return std::min(r, _sizeProgress.total());
+}
+
+bool ProgressInfo::addPendingCompletedItem(const SyncPath &normalizedPath, const SyncFileItem &item, const bool syncing) {
+    // The caller must acquire a lock on _mutex before calling this method.
+    if (const auto indexIt = _pendingSyncingItemIndexes.find(normalizedPath); indexIt != _pendingSyncingItemIndexes.end()) {
+        // Only the last state of the item is worth sending
+        _pendingCompletedItems[indexIt->second] = item;
+        if (!syncing) {
+            _pendingSyncingItemIndexes.erase(indexIt);
         }
+    } else {
+        if (_pendingCompletedItems.empty()) {
+            _firstPendingCompletedItemTime = std::chrono::steady_clock::now();
+        }
+        if (syncing) {
+            (void) _pendingSyncingItemIndexes.try_emplace(normalizedPath, _pendingCompletedItems.size());
+        }
+        _pendingCompletedItems.push_back(item);
+    }
+
+    return std::chrono::steady_clock::now() - _firstPendingCompletedItemTime >= _completedItemsFlushDelay;
+}
+
+void ProgressInfo::flushCompletedItems() {
+    // Flushes are serialized so that the batches are sent in order
+    const std::scoped_lock flushLock(_flushMutex);
+    std::vector<SyncFileItem> completedItems;
+    {
+        const std::scoped_lock lock(_mutex);
+        completedItems.swap(_pendingCompletedItems);
+        _pendingSyncingItemIndexes.clear();
+    }
+
+    for (const auto &item: completedItems) {
+        _syncPal->addCompletedItem(_syncPal->syncDbId(), item);
     }
-    _sizeProgress.setCompleted(r);
 }
 
 } // namespace KDC
@@ -23,11 +23,13 @@
 #include "progress.h"
 #include "progressitem.h"
 
+#include <chrono>
 #include <cstdint>
 #include <map>
 #include <queue>
 #include <list>
 #include <mutex>
+#include <vector>
 
 namespace KDC {
 
@@ -48,6 +50,8 @@ class ProgressInfo {
         [[nodiscard]] bool setSyncFileItemRemoteId(const SyncPath &path, const NodeId &remoteId);
         [[nodiscard]] bool getSyncFileItem(const SyncPath &path, SyncFileItem &item);
         [[nodiscard]] auto GetItemIterator(const SyncPath &path);
+        // Sends the pending item notifications to the SyncPal. Must not be called with `_mutex` locked.
+        void flushCompletedItems();
         [[nodiscard]] int64_t totalFiles() const {
             const std::scoped_lock lock(_mutex);
             return _fileProgress.total();
@@ -76,17 +80,33 @@ class ProgressInfo {
         std::map<SyncPath, std::queue<ProgressItem>>
                 _currentItems; // Use a queue here because in a few cases, we can have several operations on the same path (e.g.:
                                // DELETE a file and CREATE a directory with exact same name)
+        // Normalized form of the paths used to initialize the current items, when it differs from the path itself
+        std::map<SyncPath, SyncPath> _normalizedPaths;
         Progress _sizeProgress;
         Progress _fileProgress;
         int64_t _totalSizeOfCompletedJobs{0};
+        int64_t _completedSizeOfCurrentItems{0};
         double _maxFilesPerSecond{0.0};
         double _maxBytesPerSecond{0.0};
         bool _update{false};
 
+        // Item notifications waiting to be sent, at most `_completedItemsFlushDelay` after the first of them. Successive
+        // notifications of an item still syncing replace each other.
+        std::chrono::milliseconds _completedItemsFlushDelay{500};
+        std::vector<SyncFileItem> _pendingCompletedItems;
+        std::map<SyncPath, size_t> _pendingSyncingItemIndexes;
+        std::chrono::steady_clock::time_point _firstPendingCompletedItemTime;
+        std::mutex _flushMutex;
+
         [[nodiscard]] int64_t optimisticEta() const;
         [[nodiscard]] bool trustEta() const;
-        void recomputeCompletedSize();
+        void updateCompletedSize();
+        [[nodiscard]] int64_t computeCompletedSize() const;
         [[nodiscard]] bool isSizeDependent(const SyncFileItem &item) const;
+        [[nodiscard]] bool addPendingCompletedItem(const SyncPath &normalizedPath, const SyncFileItem &item, bool syncing);
+
+        friend class TestSyncPal;
+        friend class BenchmarkProgressInfo;
 };
 
 } // namespace KDC
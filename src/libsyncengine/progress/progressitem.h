@@ -26,8 +26,10 @@ namespace KDC {
 class ProgressItem {
     public:
         inline SyncFileItem &item() { return _item; }
+        inline const SyncFileItem &item() const { return _item; }
         inline void setItem(const SyncFileItem &newItem) { _item = newItem; }
         inline Progress &progress() { return _progress; }
+        inline const Progress &progress() const { return _progress; }
         inline void setProgress(const Progress &newProgress) { _progress = newProgress; }
 
     private:
@@ -44,11 +44,13 @@
 #include "libcommonserver/io/filestat.h"
 #include "libcommonserver/io/iohelper.h"
 #include "libcommonserver/utility/utility.h"
+#include "libcommonserver/utility/freediskspacetracker.h"
 #include "libcommonserver/utility/jsonparserutility.h"
 
 #include "requests/parameterscache.h"
 #include "requests/syncnodecache.h"
 
+#include <algorithm>
 #include <iostream>
 #include <log4cplus/loggingmacros.h>
 
@@ -72,10 +74,14 @@ void ExecutorWorker::execute() {
     LOG_SYNCPAL_DEBUG(_logger, "Worker started: name=" << name());
 
     // Keep a copy of the sorted list
-    _opList = _syncPal->_syncOps->opSortedList();
+    setOpList(_syncPal->_syncOps->opSortedList());
     initProgressManager();
+    initOperationScheduler();
     uint64_t changesCounter = 0;
 
+    // Group the node updates made by this thread in transactions, committed at the latest by the end of the execution
+    _syncPal->syncDb()->enableWriteBatching();
+
     // Create all the jobs
     sentry::pTraces::scoped::JobGeneration perfMonitor(syncDbId());
     while (!_opList.empty()) {
@@ -91,17 +97,23 @@ void ExecutorWorker::execute() {
         }
 
         UniqueId opId = 0;
-        _opListMutex.lock();
-        if (!_opList.empty()) {
-            opId = _opList.front();
-            _opList.pop_front();
+        if (const auto exitInfo = popNextOp(opId); !exitInfo) {
+            executorExitInfo = exitInfo;
+            cancelAllOngoingJobs();
+            break;
+        }
+        if (!opId) {
+            if (_opList.empty()) break;
+
+            // All the remaining operations wait for an ongoing job
+            (void) _terminatedJobs.waitForJob(std::chrono::milliseconds(LOOP_EXEC_SLEEP_PERIOD));
+            continue;
         }
-        _opListMutex.unlock();
-        if (!opId) break;
 
         SyncOpPtr syncOp = _syncPal->_syncOps->getOp(opId);
         if (!syncOp) {
             LOG_SYNCPAL_WARN(_logger, "Operation doesn't exist anymore: id=" << opId);
+            _operationScheduler.release(opId);
             continue;
         }
 
@@ -123,11 +135,11 @@ void ExecutorWorker::execute() {
                 break;
             }
             case OperationType::Move: {
-                executorExitInfo = handleMoveOp(syncOp, ignored, bypassProgressComplete);
+                executorExitInfo = handleMoveOp(syncOp, job, ignored, bypassProgressComplete);
                 break;
             }
             case OperationType::Delete: {
-                executorExitInfo = handleDeleteOp(syncOp, ignored, bypassProgressComplete);
+                executorExitInfo = handleDeleteOp(syncOp, job, ignored, bypassProgressComplete);
                 break;
             }
             default: {
@@ -144,6 +156,7 @@ void ExecutorWorker::execute() {
         if (executorExitInfo.cause() == ExitCause::OperationCanceled) {
             if (!bypassProgressComplete)
                 setProgressComplete(job ? job->affectedFilePath() : SyncPath{}, syncOp, SyncFileStatus::Error);
+            _operationScheduler.release(opId);
             continue;
         }
 
@@ -158,6 +171,7 @@ void ExecutorWorker::execute() {
             // If the error is handled, continue the execution
             if (!bypassProgressComplete)
                 setProgressComplete(job ? job->affectedFilePath() : SyncPath{}, syncOp, SyncFileStatus::Error);
+            _operationScheduler.release(opId);
             continue;
         }
 
@@ -198,6 +212,7 @@ void ExecutorWorker::execute() {
                     setProgressComplete(SyncPath{}, syncOp, hydrating ? SyncFileStatus::Syncing : SyncFileStatus::Success);
                 }
             }
+            _operationScheduler.release(opId);
         }
     }
 
@@ -208,6 +223,10 @@ void ExecutorWorker::execute() {
     }
     perfMonitorwaitForAllJobsToFinish.stop();
 
+    if (!_syncPal->syncDb()->disableWriteBatching()) {
+        LOG_SYNCPAL_WARN(_logger, "Error in SyncDb::disableWriteBatching");
+        if (executorExitInfo) executorExitInfo = {ExitCode::DbError, ExitCause::DbAccessError};
+    }
 
     _syncPal->_syncOps->clear();
     _syncPal->_remoteFSObserverWorker->forceUpdate();
@@ -248,6 +267,48 @@ void ExecutorWorker::initProgressManager() {
     }
 }
 
+void ExecutorWorker::initOperationScheduler() {
+    std::list<SyncOpPtr> sortedOps;
+    for (const auto opId: _opList) {
+        if (SyncOpPtr syncOp = _syncPal->_syncOps->getOp(opId); syncOp) sortedOps.push_back(syncOp);
+    }
+    _operationScheduler.init(sortedOps);
+}
+
+ExitInfo ExecutorWorker::popNextOp(UniqueId &opId) {
+    const std::scoped_lock lock(_opListMutex);
+
+    while ((opId = _operationScheduler.popReadyOp())) {
+        // The operations removed from the list because an operation they depend on failed are skipped
+        if (eraseOp(opId)) return ExitCode::Ok;
+    }
+
+    if (_opList.empty() || !_ongoingJobs.empty()) return ExitCode::Ok;
+
+    // No ongoing job can release the remaining operations: the prerequisites computed by the scheduler are wrong
+    LOG_SYNCPAL_ERROR(_logger, "No operation ready while no job is running, " << _opList.size() << " operations left");
+    assert(false);
+    return ExitCode::LogicError;
+}
+
+void ExecutorWorker::setOpList(const std::list<UniqueId> &opList) {
+    const std::scoped_lock lock(_opListMutex);
+    _opList = opList;
+    _opListIndex.clear();
+    for (auto it = _opList.begin(); it != _opList.end(); ++it) {
+        _opListIndex[*it] = it;
+    }
+}
+
+bool ExecutorWorker::eraseOp(const UniqueId opId) {
+    const auto indexIt = _opListIndex.find(opId);
+    if (indexIt == _opListIndex.end()) return false;
+
+    (void) _opList.erase(indexIt->second);
+    (void) _opListIndex.erase(indexIt);
+    return true;
+}
+
 void ExecutorWorker::initSyncFileItem(SyncOpPtr syncOp, SyncFileItem &syncItem) {
     syncItem.setType(syncOp->affectedNode()->type());
     syncItem.setConflict(syncOp->conflict().type());
@@ -934,7 +995,8 @@ ExitInfo ExecutorWorker::checkLiteSyncInfoForEdit(SyncOpPtr syncOp, const SyncPa
     return ExitCode::Ok;
 }
 
-ExitInfo ExecutorWorker::handleMoveOp(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete) {
+ExitInfo ExecutorWorker::handleMoveOp(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job, bool &ignored,
+                                      bool &bypassProgressComplete) {
     // The three execution steps are as follows:
     // 1. If omit-flag is False, move the object on replica Y (where it still needs to be moved) from uY to vY, changing
     // the name to nameX.
@@ -961,7 +1023,7 @@ ExitInfo ExecutorWorker::handleMoveOp(SyncOpPtr syncOp, bool &ignored, bool &byp
         FileRescuer fileRescuer(_syncPal);
         if (const auto exitInfo = fileRescuer.executeRescueMoveJob(syncOp); !exitInfo) return exitInfo;
     } else {
-        if (const auto exitInfo = generateMoveJob(syncOp, ignored, bypassProgressComplete); !exitInfo) {
+        if (const auto exitInfo = generateMoveJob(syncOp, job, ignored, bypassProgressComplete); !exitInfo) {
             LOGW_SYNCPAL_WARN(_logger, L"Failed to generate move job for: "
                                                << Utility::formatSyncName(syncOp->affectedNode()->name()) << L" " << exitInfo);
             return exitInfo;
@@ -999,12 +1061,13 @@ bool checkIfAnyParentHasMoveOperation(const std::shared_ptr<Node> affectedNode)
 }
 } // namespace
 
-ExitInfo ExecutorWorker::generateMoveJob(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete) {
+ExitInfo ExecutorWorker::generateMoveJob(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job, bool &ignored,
+                                         bool &bypassProgressComplete) {
     bypassProgressComplete = false;
 
     // 1. If omit-flag is False, move the object on replica Y (where it still needs to be moved) from uY to vY, changing
     // the name to nameX.
-    std::shared_ptr<SyncJob> job = nullptr;
+    job = nullptr;
 
     SyncPath relativeDestLocalFilePath;
     SyncPath absoluteDestLocalFilePath;
@@ -1123,19 +1186,22 @@ ExitInfo ExecutorWorker::generateMoveJob(SyncOpPtr syncOp, bool &ignored, bool &
 
     job->setScope(Scope::Sync);
     job->setAffectedFilePath(relativeDestLocalFilePath);
-    job->runSynchronously();
+    if (syncOp->conflict().type() == ConflictType::None) {
+        // The job is queued by the caller and its result handled once it is terminated
+        return ExitCode::Ok;
+    }
 
-    VfsStatus vfsStatus;
-    _syncPal->vfs()->status(absoluteDestLocalFilePath, vfsStatus);
-    vfsStatus.isSyncing = false;
-    vfsStatus.progress = 100;
-    _syncPal->vfs()->forceStatus(absoluteDestLocalFilePath, vfsStatus);
+    // Conflict fixing moves are not run concurrently with other operations, see OperationScheduler
+    const std::shared_ptr<SyncJob> conflictJob = std::move(job);
+    job = nullptr;
+    conflictJob->runSynchronously();
+    clearSyncingStatus(absoluteDestLocalFilePath);
 
-    if (job->exitInfo().code() == ExitCode::Ok && syncOp->conflict().type() != ConflictType::None) {
+    if (conflictJob->exitInfo().code() == ExitCode::Ok) {
         // Conflict fixing job finished successfully
         // Propagate changes to DB and update trees
         std::shared_ptr<Node> newNode = nullptr;
-        if (ExitInfo exitInfo = propagateChangeToDbAndTree(syncOp, job, newNode); !exitInfo) {
+        if (ExitInfo exitInfo = propagateChangeToDbAndTree(syncOp, conflictJob, newNode); !exitInfo) {
             LOGW_WARN(_logger, L"Failed to propagate changes in DB or update tree for: "
                                        << Utility::formatSyncName(syncOp->affectedNode()->name()) << L" " << exitInfo);
             return exitInfo;
@@ -1163,10 +1229,19 @@ ExitInfo ExecutorWorker::generateMoveJob(SyncOpPtr syncOp, bool &ignored, bool &
         return ExitCode::Ok;
     }
 
-    return handleFinishedJob(job, syncOp, relativeDestLocalFilePath, ignored, bypassProgressComplete);
+    return handleFinishedJob(conflictJob, syncOp, relativeDestLocalFilePath, ignored, bypassProgressComplete);
 }
 
-ExitInfo ExecutorWorker::handleDeleteOp(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete) {
+void ExecutorWorker::clearSyncingStatus(const SyncPath &absoluteLocalPath) {
+    VfsStatus vfsStatus;
+    _syncPal->vfs()->status(absoluteLocalPath, vfsStatus);
+    vfsStatus.isSyncing = false;
+    vfsStatus.progress = 100;
+    _syncPal->vfs()->forceStatus(absoluteLocalPath, vfsStatus);
+}
+
+ExitInfo ExecutorWorker::handleDeleteOp(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job, bool &ignored,
+                                        bool &bypassProgressComplete) {
     // The three execution steps are as follows:
     // 1. If omit-flag is False, delete the file or directory on replicaY, because the objects till exists there
     // 2. Remove the entry from the database. If nX is a directory node, also remove all entries for each node n ∈ S. This
@@ -1191,18 +1266,16 @@ ExitInfo ExecutorWorker::handleDeleteOp(SyncOpPtr syncOp, bool &ignored, bool &b
             return exitInfo;
         }
     } else {
-        if (const auto exitInfo = generateDeleteJob(syncOp, ignored, bypassProgressComplete); !exitInfo) {
+        if (const auto exitInfo = generateDeleteJob(syncOp, job); !exitInfo) {
             return exitInfo;
         }
     }
     return ExitCode::Ok;
 }
 
-ExitInfo ExecutorWorker::generateDeleteJob(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete) {
-    bypassProgressComplete = false;
-
+ExitInfo ExecutorWorker::generateDeleteJob(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job) {
     // 1. If omit-flag is False, delete the file or directory on replicaY, because the objects till exists there
-    std::shared_ptr<SyncJob> job = nullptr;
+    job = nullptr;
     SyncPath relativeLocalFilePath = syncOp->nodePath(ReplicaSide::Local);
     SyncPath absoluteLocalFilePath = _syncPal->localPath() / relativeLocalFilePath;
     bool isDehydratedPlaceholder = false;
@@ -1249,8 +1322,7 @@ ExitInfo ExecutorWorker::generateDeleteJob(SyncOpPtr syncOp, bool &ignored, bool
 
     job->setScope(Scope::Sync);
     job->setAffectedFilePath(relativeLocalFilePath);
-    job->runSynchronously();
-    return handleFinishedJob(job, syncOp, relativeLocalFilePath, ignored, bypassProgressComplete);
+    return ExitCode::Ok;
 }
 
 bool ExecutorWorker::isValidDestination(const SyncOpPtr syncOp) {
@@ -1302,7 +1374,7 @@ bool ExecutorWorker::enoughLocalSpace(SyncOpPtr syncOp) {
         newSize -= syncOp->correspondingNode()->size();
     }
 
-    const int64_t freeBytes = Utility::getFreeDiskSpace(_syncPal->localPath());
+    const int64_t freeBytes = FreeDiskSpaceTracker::instance()->freeDiskSpace(_syncPal->localPath(), newSize);
     if (freeBytes >= 0) {
         if (freeBytes < newSize + Utility::freeDiskSpaceLimit()) {
             LOGW_SYNCPAL_WARN(_logger, L"Disk almost full, only " << freeBytes << L"B available at "
@@ -1328,7 +1400,7 @@ ExitInfo ExecutorWorker::waitForAllJobsToFinish() {
             cancelAllOngoingJobs();
             return exitInfo;
         }
-        Utility::msleep(LOOP_EXEC_SLEEP_PERIOD);
+        (void) _terminatedJobs.waitForJob(std::chrono::milliseconds(LOOP_EXEC_SLEEP_PERIOD));
     }
     return ExitCode::Ok;
 }
@@ -1358,10 +1430,22 @@ ExitInfo ExecutorWorker::deleteFinishedAsyncJobs() {
 
             SyncOpPtr syncOp = jobToSyncOpIt->second;
             SyncPath relativeLocalPath = syncOp->nodePath(ReplicaSide::Local);
+            if (syncOp->type() == OperationType::Move) {
+                // The affected path of a move job is its destination
+                relativeLocalPath = job->affectedFilePath();
+                clearSyncingStatus(_syncPal->localPath() / relativeLocalPath);
+            }
+
             bool ignored = false;
             bool bypassProgressComplete = false;
             exitInfo = handleFinishedJob(job, syncOp, relativeLocalPath, ignored, bypassProgressComplete);
-            if (exitInfo) {
+            // Like for the operations without job, the progress of moves and deletes is not always completed here
+            const bool skipProgressComplete =
+                    bypassProgressComplete &&
+                    (syncOp->type() == OperationType::Move || syncOp->type() == OperationType::Delete);
+            if (exitInfo && skipProgressComplete) {
+                exitInfo = ExitCode::Ok;
+            } else if (exitInfo) {
                 if (!ignored && exitInfo.cause() == ExitCause::OperationCanceled) {
                     setProgressComplete(job->affectedFilePath(), syncOp, SyncFileStatus::Error);
                     exitInfo = ExitCode::Ok;
@@ -1383,9 +1467,15 @@ ExitInfo ExecutorWorker::deleteFinishedAsyncJobs() {
 
             // Delete job
             _ongoingJobs.erase(_terminatedJobs.front());
+            _operationScheduler.release(syncOp->id());
         }
         _terminatedJobs.pop();
     }
+
+    if (exitInfo && !_syncPal->syncDb()->commitWriteBatchIfExpired()) {
+        LOG_SYNCPAL_WARN(_logger, "Error in SyncDb::commitWriteBatchIfExpired");
+        return {ExitCode::DbError, ExitCause::DbAccessError};
+    }
     return exitInfo;
 }
 
@@ -2147,6 +2237,8 @@ void ExecutorWorker::cancelAllOngoingJobs() {
     }
     _ongoingJobs.clear();
     _opList.clear();
+    _opListIndex.clear();
+    _operationScheduler.clear();
     LOG_SYNCPAL_DEBUG(_logger, "All queued executor jobs cancelled.");
 }
 
@@ -2407,7 +2499,8 @@ ExitInfo ExecutorWorker::removeDependentOps(const std::shared_ptr<Node> localNod
     }
 
     for (const auto &opId: dependentOps) {
-        _opList.remove(opId);
+        (void) eraseOp(opId);
+        _operationScheduler.release(opId);
     }
     for (const auto &opId: dependentOps) {
         removeDependentOps(_syncPal->_syncOps->getOp(opId));
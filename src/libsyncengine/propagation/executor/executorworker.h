@@ -18,12 +18,15 @@
 
 #pragma once
 
+#include "operationscheduler.h"
 #include "syncpal/operationprocessor.h"
 #include "syncpal/syncpal.h"
 #include "reconciliation/syncoperation.h"
 #include "jobs/syncjob.h"
 #include "utility/timerutility.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <queue>
 #include <unordered_map>
 
@@ -42,8 +45,11 @@ class SyncDb;
 class TerminatedJobsQueue : public std::recursive_mutex {
     public:
         void push(const UniqueId id) {
-            const std::scoped_lock lock(*this);
-            _terminatedJobs.push(id);
+            {
+                const std::scoped_lock lock(*this);
+                _terminatedJobs.push(id);
+            }
+            _jobTerminated.notify_one();
         }
         void pop() {
             const std::scoped_lock lock(*this);
@@ -57,9 +63,18 @@ class TerminatedJobsQueue : public std::recursive_mutex {
             const std::scoped_lock lock(*this);
             return _terminatedJobs.empty();
         }
+        /**
+         * @brief Wait until a job is terminated, or until `timeout` expires.
+         * @return true if the queue is not empty.
+         */
+        bool waitForJob(const std::chrono::milliseconds timeout) {
+            std::unique_lock<std::recursive_mutex> lock(*this);
+            return _jobTerminated.wait_for(lock, timeout, [this] { return !_terminatedJobs.empty(); });
+        }
 
     private:
         std::queue<UniqueId> _terminatedJobs;
+        std::condition_variable_any _jobTerminated;
 };
 
 class ExecutorWorker : public OperationProcessor {
@@ -75,6 +90,15 @@ class ExecutorWorker : public OperationProcessor {
     private:
         void initProgressManager();
         void initSyncFileItem(SyncOpPtr syncOp, SyncFileItem &syncItem);
+        void initOperationScheduler();
+        /**
+         * @brief Remove from the operation list the first operation whose prerequisites are all done.
+         * @param opId The operation ID, 0 if all the remaining operations wait for an ongoing job.
+         * @return ExitCode::LogicError if operations remain while none is ready and no job is running.
+         */
+        ExitInfo popNextOp(UniqueId &opId);
+        void setOpList(const std::list<UniqueId> &opList);
+        bool eraseOp(UniqueId opId); // Returns false if the operation is not in the list
 
         ExitInfo handleCreateOp(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job, bool &ignored, bool &hydrating);
         ExitInfo checkAlreadyExcluded(const SyncPath &absolutePath, const NodeId &parentId);
@@ -89,12 +113,14 @@ class ExecutorWorker : public OperationProcessor {
                                           bool &isSyncing); // TODO : is called "check..." but perform some actions. Wording not
                                                             // good, function probably does too much
 
-        ExitInfo handleMoveOp(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete);
-        ExitInfo generateMoveJob(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete);
+        ExitInfo handleMoveOp(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job, bool &ignored, bool &bypassProgressComplete);
+        /// @note Conflict fixing moves are run synchronously, the job of the other moves is returned to be queued.
+        ExitInfo generateMoveJob(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job, bool &ignored, bool &bypassProgressComplete);
         ExitInfo getPathFromDb(const std::shared_ptr<Node> node, SyncPath &dbPath);
+        void clearSyncingStatus(const SyncPath &absoluteLocalPath);
 
-        ExitInfo handleDeleteOp(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete);
-        ExitInfo generateDeleteJob(SyncOpPtr syncOp, bool &ignored, bool &bypassProgressComplete);
+        ExitInfo handleDeleteOp(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job, bool &ignored, bool &bypassProgressComplete);
+        ExitInfo generateDeleteJob(SyncOpPtr syncOp, std::shared_ptr<SyncJob> &job);
 
         ExitInfo waitForAllJobsToFinish();
         ExitInfo deleteFinishedAsyncJobs();
@@ -158,8 +184,10 @@ class ExecutorWorker : public OperationProcessor {
         TerminatedJobsQueue _terminatedJobs;
         std::unordered_map<UniqueId, SyncOpPtr> _jobToSyncOpMap;
 
-        std::list<UniqueId> _opList;
+        std::list<UniqueId> _opList; // The operations not started yet
+        std::unordered_map<UniqueId, std::list<UniqueId>::iterator> _opListIndex;
         std::recursive_mutex _opListMutex;
+        OperationScheduler _operationScheduler;
 
         TimerUtility _timer;
 
@@ -0,0 +1,149 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "operationscheduler.h"
+#include "update_detection/update_detector/node.h"
+
+#include "libcommonserver/utility/utility.h"
+
+#include <algorithm>
+
+namespace KDC {
+
+namespace {
+// Unlike std::filesystem::path::parent_path, always ends on the empty path
+SyncPath parentPath(const SyncPath &path) {
+    return path.has_relative_path() ? path.parent_path() : SyncPath();
+}
+} // namespace
+
+void OperationScheduler::init(const std::list<SyncOpPtr> &sortedOps) {
+    clear();
+
+    std::unordered_map<SyncPath, PathState, PathHashFunction> pathStates;
+    size_t index = 0;
+    for (const auto &syncOp: sortedOps) {
+        if (!syncOp) continue;
+
+        auto &opState = _ops[syncOp->id()];
+        opState.index = index++;
+
+        const auto paths = touchedPaths(syncOp);
+        std::vector<UniqueId> prerequisites;
+        for (const auto &path: paths) {
+            // Operations on the path itself or on one of its ancestors
+            for (SyncPath ancestor = path;; ancestor = parentPath(ancestor)) {
+                if (const auto it = pathStates.find(ancestor); it != pathStates.end() && it->second.lastOpId) {
+                    prerequisites.push_back(it->second.lastOpId);
+                }
+                if (ancestor.empty()) break;
+            }
+
+            // Operations on one of its descendants
+            if (const auto it = pathStates.find(path); it != pathStates.end()) {
+                prerequisites.insert(prerequisites.end(), it->second.descendantOpIds.begin(), it->second.descendantOpIds.end());
+            }
+        }
+
+        for (const auto &path: paths) {
+            auto &pathState = pathStates[path];
+            pathState.lastOpId = syncOp->id();
+            pathState.descendantOpIds.clear();
+            for (SyncPath ancestor = path; !ancestor.empty();) {
+                ancestor = parentPath(ancestor);
+                pathStates[ancestor].descendantOpIds.push_back(syncOp->id());
+            }
+        }
+
+        std::ranges::sort(prerequisites);
+        const auto [first, last] = std::ranges::unique(prerequisites);
+        prerequisites.erase(first, last);
+        std::erase(prerequisites, syncOp->id());
+
+        for (const auto prerequisiteId: prerequisites) {
+            _ops[prerequisiteId].dependents.push_back(syncOp->id());
+        }
+        opState.remainingPrerequisites = prerequisites.size();
+        opState.prerequisites = std::move(prerequisites);
+        if (!opState.remainingPrerequisites) {
+            (void) _readyOps.emplace(opState.index, syncOp->id());
+        }
+    }
+}
+
+void OperationScheduler::clear() {
+    _ops.clear();
+    _readyOps.clear();
+}
+
+UniqueId OperationScheduler::popReadyOp() {
+    if (_readyOps.empty()) return 0;
+
+    const UniqueId opId = _readyOps.begin()->second;
+    _readyOps.erase(_readyOps.begin());
+    _ops[opId].popped = true;
+    return opId;
+}
+
+void OperationScheduler::release(const UniqueId opId) {
+    const auto it = _ops.find(opId);
+    if (it == _ops.end() || it->second.released) return;
+
+    auto &opState = it->second;
+    opState.released = true;
+    if (!opState.popped) {
+        // The operation has been dropped before being executed
+        (void) _readyOps.erase({opState.index, opId});
+    }
+
+    for (const auto dependentId: opState.dependents) {
+        auto &dependentState = _ops[dependentId];
+        if (dependentState.remainingPrerequisites && --dependentState.remainingPrerequisites == 0 && !dependentState.popped &&
+            !dependentState.released) {
+            (void) _readyOps.emplace(dependentState.index, dependentId);
+        }
+    }
+}
+
+const std::vector<UniqueId> &OperationScheduler::prerequisites(const UniqueId opId) const {
+    static const std::vector<UniqueId> noPrerequisites;
+    const auto it = _ops.find(opId);
+    return it != _ops.end() ? it->second.prerequisites : noPrerequisites;
+}
+
+std::vector<SyncPath> OperationScheduler::touchedPaths(const SyncOpPtr &syncOp) {
+    // Conflict resolutions, cycle breaking and rescue operations are rare and can touch items far away from their own path,
+    // they are executed alone. The empty path is the ancestor of all paths.
+    if (syncOp->hasConflict() || syncOp->isBreakingCycleOp() || syncOp->isRescueOperation() || !syncOp->affectedNode()) {
+        return {SyncPath()};
+    }
+
+    std::vector<SyncPath> paths{syncOp->affectedNode()->getPath()};
+    if (syncOp->correspondingNode()) paths.push_back(syncOp->correspondingNode()->getPath());
+    if (syncOp->type() == OperationType::Move) paths.push_back(syncOp->affectedNode()->moveOriginInfos().normalizedPath());
+
+    for (auto &path: paths) {
+        if (SyncPath normalizedPath; Utility::normalizedSyncPath(path, normalizedPath)) path = normalizedPath;
+    }
+    std::ranges::sort(paths);
+    const auto [first, last] = std::ranges::unique(paths);
+    paths.erase(first, last);
+    return paths;
+}
+
+} // namespace KDC
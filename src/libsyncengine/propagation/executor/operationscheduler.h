@@ -0,0 +1,81 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "reconciliation/syncoperation.h"
+
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace KDC {
+
+/**
+ * @brief Decides which sync operations can be executed at a given time.
+ * Two operations conflict if one of the paths touched by the first one is equal to, an ancestor or a descendant of one of the
+ * paths touched by the second one. An operation is only released once all the conflicting operations that come before it in
+ * the sorted list are done, so that operations on disjoint subtrees can run concurrently.
+ */
+class OperationScheduler {
+    public:
+        /**
+         * @brief Compute the prerequisites of each operation.
+         * @param sortedOps The operations, in the order computed by the OperationSorterWorker.
+         */
+        void init(const std::list<SyncOpPtr> &sortedOps);
+        void clear();
+
+        /**
+         * @brief Pop the ready operation which comes first in the sorted list.
+         * @return The operation ID, 0 if no operation is ready.
+         */
+        [[nodiscard]] UniqueId popReadyOp();
+        [[nodiscard]] bool hasReadyOp() const { return !_readyOps.empty(); }
+        /**
+         * @brief Mark an operation as done, or as dropped if it has not been popped yet. The operations waiting for it only are
+         * made ready.
+         */
+        void release(UniqueId opId);
+
+        [[nodiscard]] bool isEmpty() const { return _ops.empty(); }
+        [[nodiscard]] const std::vector<UniqueId> &prerequisites(UniqueId opId) const;
+
+    private:
+        struct OpState {
+                size_t index = 0;
+                size_t remainingPrerequisites = 0;
+                std::vector<UniqueId> prerequisites;
+                std::vector<UniqueId> dependents;
+                bool popped = false;
+                bool released = false;
+        };
+
+        struct PathState {
+                UniqueId lastOpId = 0; // The last operation touching this exact path
+                std::vector<UniqueId> descendantOpIds; // The operations touching a descendant path since `lastOpId`
+        };
+
+        static std::vector<SyncPath> touchedPaths(const SyncOpPtr &syncOp);
+
+        std::unordered_map<UniqueId, OpState> _ops;
+        std::set<std::pair<size_t, UniqueId>> _readyOps; // Ordered by position in the sorted list
+};
+
+} // namespace KDC
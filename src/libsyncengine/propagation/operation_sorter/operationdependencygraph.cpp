@@ -0,0 +1,102 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "operationdependencygraph.h"
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+namespace KDC {
+
+bool OperationDependencyGraph::addDependency(const SyncOpPtr &op, const SyncOpPtr &prerequisiteOp) {
+    return _prerequisites[op->id()].insert(prerequisiteOp->id()).second;
+}
+
+void OperationDependencyGraph::clear() {
+    _prerequisites.clear();
+}
+
+bool OperationDependencyGraph::sort(const std::list<UniqueId> &opIds, std::list<UniqueId> &sortedOpIds,
+                                    std::list<UniqueId> &cycle) const {
+    sortedOpIds.clear();
+    cycle.clear();
+
+    // Work on the positions of the operations in `opIds`
+    const std::vector<UniqueId> ids(opIds.begin(), opIds.end());
+    std::unordered_map<UniqueId, size_t> idToIndex;
+    idToIndex.reserve(ids.size());
+    for (size_t index = 0; index < ids.size(); ++index) (void) idToIndex.try_emplace(ids[index], index);
+
+    std::vector<std::vector<size_t>> prerequisites(ids.size());
+    std::vector<std::vector<size_t>> dependents(ids.size());
+    std::vector<size_t> pendingPrerequisiteCount(ids.size(), 0);
+    for (const auto &[opId, prerequisiteIds]: _prerequisites) {
+        const auto opIt = idToIndex.find(opId);
+        if (opIt == idToIndex.end()) continue;
+        for (const auto prerequisiteId: prerequisiteIds) {
+            const auto prerequisiteIt = idToIndex.find(prerequisiteId);
+            if (prerequisiteIt == idToIndex.end() || prerequisiteIt->second == opIt->second) continue;
+            prerequisites[opIt->second].push_back(prerequisiteIt->second);
+            dependents[prerequisiteIt->second].push_back(opIt->second);
+            ++pendingPrerequisiteCount[opIt->second];
+        }
+    }
+
+    // Kahn's algorithm, the ready operation with the lowest position being picked first
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<>> readyOps;
+    for (size_t index = 0; index < ids.size(); ++index) {
+        if (pendingPrerequisiteCount[index] == 0) readyOps.push(index);
+    }
+    while (!readyOps.empty()) {
+        const size_t index = readyOps.top();
+        readyOps.pop();
+        sortedOpIds.push_back(ids[index]);
+        for (const auto dependent: dependents[index]) {
+            if (--pendingPrerequisiteCount[dependent] == 0) readyOps.push(dependent);
+        }
+    }
+
+    if (sortedOpIds.size() == ids.size()) return true;
+
+    // Each remaining operation has at least one remaining prerequisite. Walking up the prerequisites from any of them
+    // therefore ends up on an operation already visited, which closes a cycle.
+    const auto isRemaining = [&pendingPrerequisiteCount](const size_t index) { return pendingPrerequisiteCount[index] > 0; };
+    size_t index = 0;
+    while (!isRemaining(index)) ++index;
+
+    std::vector<size_t> chain;
+    std::unordered_map<size_t, size_t> chainPositions;
+    while (!chainPositions.contains(index)) {
+        (void) chainPositions.try_emplace(index, chain.size());
+        chain.push_back(index);
+
+        size_t nextIndex = ids.size();
+        for (const auto prerequisite: prerequisites[index]) {
+            if (isRemaining(prerequisite)) nextIndex = std::min(nextIndex, prerequisite);
+        }
+        index = nextIndex;
+    }
+
+    for (auto it = chain.begin() + static_cast<std::ptrdiff_t>(chainPositions[index]); it != chain.end(); ++it) {
+        cycle.push_back(ids[*it]);
+    }
+    return false;
+}
+
+} // namespace KDC
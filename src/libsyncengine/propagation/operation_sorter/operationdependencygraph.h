@@ -0,0 +1,65 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "reconciliation/syncoperation.h"
+
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace KDC {
+
+/**
+ * @brief Ordering constraints between sync operations. Each edge states that an operation must be executed after another one.
+ * The order of the operations is then computed in a single pass by a topological sort.
+ */
+class OperationDependencyGraph {
+    public:
+        /**
+         * @brief Record that `op` must be executed after `prerequisiteOp`.
+         * @return false if this dependency was already recorded.
+         */
+        bool addDependency(const SyncOpPtr &op, const SyncOpPtr &prerequisiteOp);
+        void clear();
+
+        [[nodiscard]] bool isEmpty() const { return _prerequisites.empty(); }
+        [[nodiscard]] const std::unordered_map<UniqueId, std::unordered_set<UniqueId>> &prerequisites() const {
+            return _prerequisites;
+        }
+
+        /**
+         * @brief Sort the operations so that each one comes after its prerequisites. Among the operations that are ready to be
+         * executed, the one which comes first in `opIds` is always picked first, so the initial order is kept as much as
+         * possible. Dependencies on operations that are not in `opIds` are ignored.
+         * @param opIds The operations in their current order.
+         * @param sortedOpIds The sorted operations. If a cycle is found, only the operations that neither belong to a cycle nor
+         * depend on one.
+         * @param cycle The IDs of the operations of one cycle, if any, each one being a prerequisite of the previous one and the
+         * first one being a prerequisite of the last one.
+         * @return true if all the operations could be sorted, false if a cycle was found.
+         */
+        bool sort(const std::list<UniqueId> &opIds, std::list<UniqueId> &sortedOpIds, std::list<UniqueId> &cycle) const;
+
+    private:
+        // The operations that must be executed before each operation
+        std::unordered_map<UniqueId, std::unordered_set<UniqueId>> _prerequisites;
+};
+
+} // namespace KDC
@@ -18,7 +18,6 @@
 
 #include "operationsorterworker.h"
 
-#include "cyclefinder.h"
 #include "libcommon/utility/utility.h"
 #include "libcommonserver/utility/utility.h"
 #include "requests/parameterscache.h"
@@ -37,7 +36,7 @@ void OperationSorterWorker::execute() {
 
     const TimerUtility timer;
 
-    _reorderings.clear();
+    _dependencyGraph.clear();
     _syncPal->_syncOps->startUpdate();
     _filter.filterOperations();
     sortOperations();
@@ -48,53 +47,33 @@ void OperationSorterWorker::execute() {
     setDone(ExitCode::Ok);
 }
 
-bool hasMoveOperation(const std::shared_ptr<SyncOperationList> syncOps) {
-    return !syncOps->opListIdByType(OperationType::Move).empty() || !syncOps->opListIdByType(OperationType::MoveEdit).empty() ||
-           !syncOps->opListIdByType(OperationType::MoveOut).empty();
-}
-
 void OperationSorterWorker::sortOperations() {
     _syncPal->_syncOps->startUpdate();
-    SyncOperationList completeCycle;
-    bool cycleFound = false;
-    _hasOrderChanged = true;
-    while (_hasOrderChanged) {
-        if (stopAsked()) {
-            return;
-        }
-
-        _hasOrderChanged = false;
-        fixDeleteBeforeMove();
-        fixMoveBeforeCreate();
-        fixMoveBeforeDelete();
-        fixCreateBeforeMove();
-        fixDeleteBeforeCreate();
-        fixMoveBeforeMoveOccupied();
-        fixCreateBeforeCreate();
-        fixEditBeforeMove();
-        fixMoveBeforeMoveHierarchyFlip();
-
-        // Cycles can occur only in presence of at least 1 Move operation.
-        if (hasMoveOperation(_syncPal->_syncOps)) {
-            // Check for cycles.
-            CycleFinder cycleFinder(_reorderings);
-            cycleFinder.findCompleteCycle();
-            if (cycleFinder.hasCompleteCycle()) {
-                completeCycle = cycleFinder.completeCycle();
-                cycleFound = true;
-                break;
-            }
-        }
+    _hasOrderChanged = false;
+
+    fixDeleteBeforeMove();
+    fixMoveBeforeCreate();
+    fixMoveBeforeDelete();
+    fixCreateBeforeMove();
+    fixDeleteBeforeCreate();
+    fixMoveBeforeMoveOccupied();
+    fixCreateBeforeCreate();
+    fixEditBeforeMove();
+    fixMoveBeforeMoveHierarchyFlip();
+
+    if (stopAsked()) {
+        return;
     }
 
-    if (cycleFound) {
-        if (const auto resolutionOperation = std::make_shared<SyncOperation>(); breakCycle(completeCycle, resolutionOperation)) {
+    if (SyncOperationList cycle; !sortByDependencies(cycle)) {
+        if (const auto resolutionOperation = std::make_shared<SyncOperation>(); breakCycle(cycle, resolutionOperation)) {
             _syncPal->_syncOps->setOpList({resolutionOperation});
             _hasOrderChanged = true;
             // If a cycle is discovered, the sync must be restarted after the execution of the operation in _syncOps
             _syncPal->setRestart(true);
             return;
         }
+        LOG_SYNCPAL_WARN(_logger, "Unable to break the dependency cycle, operations are left in their initial order");
     }
 
     SyncOperationList reshuffledOps;
@@ -105,6 +84,26 @@ void OperationSorterWorker::sortOperations() {
     }
 }
 
+bool OperationSorterWorker::sortByDependencies(SyncOperationList &cycle) {
+    cycle.clear();
+    if (_dependencyGraph.isEmpty()) return true;
+
+    std::list<UniqueId> sortedOpIds;
+    if (std::list<UniqueId> cycleOpIds; !_dependencyGraph.sort(_syncPal->_syncOps->opSortedList(), sortedOpIds, cycleOpIds)) {
+        for (const auto opId: cycleOpIds) (void) cycle.pushOp(_syncPal->_syncOps->getOp(opId));
+        LOG_SYNCPAL_INFO(_logger, "Dependency cycle found between " << cycleOpIds.size() << " operations");
+        return false;
+    }
+
+    if (sortedOpIds == _syncPal->_syncOps->opSortedList()) return true;
+
+    std::list<SyncOpPtr> sortedOps;
+    for (const auto opId: sortedOpIds) sortedOps.push_back(_syncPal->_syncOps->getOp(opId));
+    _syncPal->_syncOps->setOpList(sortedOps);
+    _hasOrderChanged = true;
+    return true;
+}
+
 void OperationSorterWorker::fixDeleteBeforeMove() {
     LOG_SYNCPAL_DEBUG(_logger, "Start fixDeleteBeforeMove");
     for (const auto &[op1, op2]: _filter.fixDeleteBeforeMoveCandidates()) {
@@ -134,8 +133,7 @@ void OperationSorterWorker::fixDeleteBeforeMove() {
         }
 
         if (deleteNode->normalizedName() == moveNode->normalizedName()) {
-            // move only if moveOp is before deleteOp
-            moveFirstAfterSecond(moveOp, deleteOp);
+            addDependency(moveOp, deleteOp);
         }
     }
     LOG_SYNCPAL_DEBUG(_logger, "End fixDeleteBeforeMove");
@@ -167,8 +165,7 @@ void OperationSorterWorker::fixMoveBeforeCreate() {
         }
 
         if (moveNode->moveOriginInfos().normalizedPath().filename() == createNode->normalizedName()) {
-            // move only if createOp is before moveOp
-            moveFirstAfterSecond(createOp, moveOp);
+            addDependency(createOp, moveOp);
         }
     }
     LOG_SYNCPAL_DEBUG(_logger, "End fixMoveBeforeCreate");
@@ -178,8 +175,7 @@ void OperationSorterWorker::fixMoveBeforeDelete() {
     LOG_SYNCPAL_DEBUG(_logger, "Start fixMoveBeforeDelete");
     for (const auto &[op1, op2]: _filter.fixMoveBeforeDeleteCandidates()) {
         const auto [moveOp, deleteOp] = extractOpsByType(OperationType::Move, OperationType::Delete, op1, op2);
-        // move only if deleteOp is before moveOp
-        moveFirstAfterSecond(deleteOp, moveOp);
+        addDependency(deleteOp, moveOp);
     }
     LOG_SYNCPAL_DEBUG(_logger, "End fixMoveBeforeDelete");
 }
@@ -188,8 +184,7 @@ void OperationSorterWorker::fixCreateBeforeMove() {
     LOG_SYNCPAL_DEBUG(_logger, "Start fixCreateBeforeMove");
     for (const auto &[op1, op2]: _filter.fixCreateBeforeMoveCandidates()) {
         const auto [createOp, moveOp] = extractOpsByType(OperationType::Create, OperationType::Move, op1, op2);
-        // move only if moveOp is before createOp
-        moveFirstAfterSecond(moveOp, createOp);
+        addDependency(moveOp, createOp);
     }
     LOG_SYNCPAL_DEBUG(_logger, "End fixCreateBeforeMove");
 }
@@ -220,8 +215,7 @@ void OperationSorterWorker::fixDeleteBeforeCreate() {
         }
 
         if (createNode->normalizedName() == deleteNode->normalizedName()) {
-            // move only if createOp is before deleteOp
-            moveFirstAfterSecond(createOp, deleteOp);
+            addDependency(createOp, deleteOp);
         }
     }
     LOG_SYNCPAL_DEBUG(_logger, "End fixDeleteBeforeCreate");
@@ -247,8 +241,7 @@ void OperationSorterWorker::fixMoveBeforeMoveOccupied() {
         const auto nodeParentId = node->parentNode()->id();
         const auto otherNodeOriginPath = otherNode->moveOriginInfos().normalizedPath();
         if (nodeParentId == otherNodeOriginParentId && node->normalizedName() == otherNodeOriginPath.filename()) {
-            // move only if op is before otherOp
-            moveFirstAfterSecond(moveOp, otherMoveOp);
+            addDependency(moveOp, otherMoveOp);
         }
     }
     LOG_SYNCPAL_DEBUG(_logger, "End fixMoveBeforeMoveOccupied");
@@ -257,61 +250,28 @@ void OperationSorterWorker::fixMoveBeforeMoveOccupied() {
 
 void OperationSorterWorker::fixCreateBeforeCreate() {
     LOG_SYNCPAL_DEBUG(_logger, "Start fixCreateBeforeCreate");
-    // The method described in the thesis slow. Therefore, we use a std::priority_queue to efficiently sort the
-    // operations before moving them in the sorted list.
-    CreateOperationPairQueue opsToMove;
-
-    std::unordered_map<UniqueId, int32_t> opIdToIndexMap;
-    _syncPal->_syncOps->getOpIdToIndexMap(opIdToIndexMap, OperationType::Create);
-
-    for (const auto &opId: _syncPal->_syncOps->opSortedList()) {
-        SyncOpPtr createOp = _syncPal->_syncOps->getOp(opId);
+    for (const auto &opId: _syncPal->_syncOps->opListIdByType(OperationType::Create)) {
+        const auto createOp = _syncPal->_syncOps->getOp(opId);
         LOG_IF_FAIL(createOp)
-        if (createOp->type() != OperationType::Create) continue;
-
-        if (int32_t depth = 0; auto ancestorOpWithHighestIndex = getAncestorOpWithHighestIndex(opIdToIndexMap, createOp, depth))
-            opsToMove.emplace(createOp, depth, ancestorOpWithHighestIndex);
-    }
-
-    while (!opsToMove.empty()) {
-        const auto createPair = opsToMove.top();
-        LOGW_SYNCPAL_DEBUG(_logger, L"op: " << Utility::formatSyncName(createPair.op->affectedNode()->name()) << L", ancestorOp: "
-                                            << Utility::formatSyncName(createPair.ancestorOp->affectedNode()->name())
-                                            << L", depth; " << createPair.opNodeDepth);
-        moveFirstAfterSecond(createPair.op, createPair.ancestorOp);
-        opsToMove.pop();
-    }
-    LOG_SYNCPAL_DEBUG(_logger, "End fixCreateBeforeCreate");
-}
-
-SyncOpPtr OperationSorterWorker::getAncestorOpWithHighestIndex(const std::unordered_map<UniqueId, int32_t> &opIdToIndexMap,
-                                                               const SyncOpPtr &op, int32_t &depth) const {
-    SyncOpPtr ancestorOpWithHighestIndex = nullptr;
-    int32_t highestIndex = opIdToIndexMap.at(op->id());
-
-    const auto node = op->affectedNode();
-    std::shared_ptr<const Node> ancestorNode = node->parentNode();
-    depth = ancestorNode ? 1 : 0;
-
-    while (ancestorNode && ancestorNode != _syncPal->updateTree(node->side())->rootNode()) {
-        for (const auto parentOpIdList = _syncPal->_syncOps->getOpIdsFromSourceNodeId(*ancestorNode->id(), node->side());
-             const auto &parentOpId: parentOpIdList) {
-            const auto parentOp = _syncPal->_syncOps->getOp(parentOpId);
-            if (parentOp->type() != OperationType::Create) {
-                continue;
-            }
-
-            // Check whether the index of `parentOp` is greater than the index of `op`.
-            if (opIdToIndexMap.at(parentOpId) > highestIndex) {
-                highestIndex = opIdToIndexMap.at(parentOpId);
-                ancestorOpWithHighestIndex = parentOp;
+        const auto node = createOp->affectedNode();
+        const auto rootNode = _syncPal->updateTree(node->side())->rootNode();
+
+        // Only the closest created ancestor is needed, it depends itself on the creation of its own created ancestors.
+        bool ancestorOpFound = false;
+        for (auto ancestorNode = node->parentNode(); ancestorNode && ancestorNode != rootNode && !ancestorOpFound;
+             ancestorNode = ancestorNode->parentNode()) {
+            for (const auto &ancestorOpId: _syncPal->_syncOps->getOpIdsFromSourceNodeId(*ancestorNode->id(), node->side())) {
+                const auto ancestorOp = _syncPal->_syncOps->getOp(ancestorOpId);
+                if (ancestorOp->type() != OperationType::Create) {
+                    continue;
+                }
+
+                addDependency(createOp, ancestorOp);
+                ancestorOpFound = true;
             }
         }
-        ancestorNode = ancestorNode->parentNode();
-        ++depth;
     }
-
-    return ancestorOpWithHighestIndex;
+    LOG_SYNCPAL_DEBUG(_logger, "End fixCreateBeforeCreate");
 }
 
 void OperationSorterWorker::fixEditBeforeMove() {
@@ -334,7 +294,7 @@ void OperationSorterWorker::fixEditBeforeMove() {
         // MOVE) in the executor step.
         for (auto &op: opList) {
             if (op->type() == OperationType::Edit) {
-                moveFirstAfterSecond(op, *moveOpIt);
+                addDependency(op, *moveOpIt);
             }
         }
     }
@@ -344,8 +304,7 @@ void OperationSorterWorker::fixEditBeforeMove() {
 void OperationSorterWorker::fixMoveBeforeMoveHierarchyFlip() {
     LOG_SYNCPAL_DEBUG(_logger, "Start fixMoveBeforeMoveHierarchyFlip");
     for (const auto &[op, otherOp]: _filter.fixMoveBeforeMoveHierarchyFlipCandidates()) {
-        // move only if op is before opOtherOp
-        moveFirstAfterSecond(op, otherOp);
+        addDependency(op, otherOp);
     }
     LOG_SYNCPAL_DEBUG(_logger, "End fixMoveBeforeMoveHierarchyFlip");
 }
@@ -487,50 +446,16 @@ bool OperationSorterWorker::breakCycle(SyncOperationList &cycle, const SyncOpPtr
     return true;
 }
 
-void OperationSorterWorker::moveFirstAfterSecond(const SyncOpPtr &opFirst, const SyncOpPtr &opSecond) {
-    std::list<UniqueId>::const_iterator firstIt;
-    std::list<UniqueId>::const_iterator secondIt;
-    bool firstFound = false;
-    for (auto it = _syncPal->_syncOps->opSortedList().begin(); it != _syncPal->_syncOps->opSortedList().end(); ++it) {
-        const auto op = _syncPal->_syncOps->getOp(*it);
-        if (op == opSecond) {
-            if (firstFound) {
-                secondIt = it;
-            }
-            break;
-        }
-        if (op == opFirst) {
-            firstFound = true;
-            firstIt = it;
-        }
-    }
+void OperationSorterWorker::addDependency(const SyncOpPtr &opFirst, const SyncOpPtr &opSecond) {
+    if (!_dependencyGraph.addDependency(opFirst, opSecond)) return;
 
-    if (firstFound) {
-        // make sure opSecond is executed after opFirst
-        if (ParametersCache::isExtendedLogEnabled()) {
-            LOGW_SYNCPAL_DEBUG(_logger, L"Operation " << opFirst->id() << L" (" << opFirst->type() << L" "
-                                                      << Utility::formatSyncName(opFirst->affectedNode()->name())
-                                                      << L") moved after operation " << opSecond->id() << L" ("
-                                                      << opSecond->type() << L" "
-                                                      << Utility::formatSyncName(opSecond->affectedNode()->name()) << L")");
-        }
-
-        _syncPal->_syncOps->deleteOp(firstIt);
-        _syncPal->_syncOps->insertOp(++secondIt, opFirst);
-        _hasOrderChanged = true;
-        addPairToReorderings(opFirst, opSecond);
-    }
-}
-
-void OperationSorterWorker::addPairToReorderings(const SyncOpPtr &op1, const SyncOpPtr &op2 /*opOnFirstDepends*/) {
-    const auto pair = std::make_pair(op1, op2);
-    for (auto const &opPair: _reorderings) {
-        // Check that the pair does not already exist in the list
-        if (opPair == pair) {
-            return; // Usefull?
-        }
+    if (ParametersCache::isExtendedLogEnabled()) {
+        LOGW_SYNCPAL_DEBUG(_logger, L"Operation " << opFirst->id() << L" (" << opFirst->type() << L" "
+                                                  << Utility::formatSyncName(opFirst->affectedNode()->name())
+                                                  << L") must be executed after operation " << opSecond->id() << L" ("
+                                                  << opSecond->type() << L" "
+                                                  << Utility::formatSyncName(opSecond->affectedNode()->name()) << L")");
     }
-    _reorderings.push_back(pair);
 }
 
 bool OperationSorterWorker::getIdFromDb(const ReplicaSide side, const SyncPath &path, NodeId &id) const {
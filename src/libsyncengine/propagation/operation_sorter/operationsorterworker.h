@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "operationdependencygraph.h"
 #include "operationsorterfilter.h"
 #include "syncpal/operationprocessor.h"
 #include "syncpal/syncpal.h"
@@ -36,33 +37,10 @@ class OperationSorterWorker : public OperationProcessor {
         [[nodiscard]] bool hasOrderChanged() const { return _hasOrderChanged; }
 
     private:
-        struct CreateOperationPair {
-                CreateOperationPair(SyncOpPtr op_, const int32_t opNodeDepth_, SyncOpPtr ancestorOp_) :
-                    op(op_),
-                    opNodeDepth(opNodeDepth_),
-                    ancestorOp(ancestorOp_) {}
-                SyncOpPtr op{nullptr};
-                int32_t opNodeDepth{};
-                SyncOpPtr ancestorOp{nullptr};
-        };
-        class CreateOperationPairDepthCmp {
-            public:
-                bool operator()(const CreateOperationPair &a, const CreateOperationPair &b) const {
-                    if (a.opNodeDepth == b.opNodeDepth) {
-                        // If depths are equal, nodes with higher IDs have higher priority in the queue.
-                        // This has the benefit of preserving the initial ordering of nodes with of equal depth
-                        // and with the same parent.
-                        return a.op->id() < b.op->id();
-                    }
-                    // Nodes with higher depth have a higher priority in the queue.
-                    return a.opNodeDepth < b.opNodeDepth;
-                }
-        };
-
-        // Recall that `std::priority_queue` is a max-heap (https://en.wikipedia.org/wiki/Heap_(data_structure)).
-        using CreateOperationPairQueue =
-                std::priority_queue<CreateOperationPair, std::vector<CreateOperationPair>, CreateOperationPairDepthCmp>;
-
+        /**
+         * @brief Record the dependencies between operations according to each ordering rule below, then sort the operations in
+         * a single pass. If the dependencies form a cycle, the operation list is replaced by an operation breaking it.
+         */
         void sortOperations();
 
         /**
@@ -106,42 +84,28 @@ class OperationSorterWorker : public OperationProcessor {
         bool fixImpossibleFirstMoveOp(SyncOperationList &syncOperationList);
         bool breakCycle(SyncOperationList &cycle, const SyncOpPtr &renameResolutionOp);
         /**
-         * @brief Move `opFirst` immediately after `opSecond` in the sorted operation list.
-         * @param opFirst The operation to be moved.
+         * @brief Record that `opFirst` must be executed after `opSecond`.
+         * @param opFirst The dependent operation.
          * @param opSecond The operation that must be executed before `opFirst`.
          */
-        void moveFirstAfterSecond(const SyncOpPtr &opFirst, const SyncOpPtr &opSecond);
-        /**
-         * @brief Insert `op` and `parentOp` inside a list of re-ordered nodes.
-         * @param op1 A permuted operation.
-         * @param op2 The associated permuted operation.
-         */
-        void addPairToReorderings(const SyncOpPtr &op1, const SyncOpPtr &op2);
-
+        void addDependency(const SyncOpPtr &opFirst, const SyncOpPtr &opSecond);
         /**
-         * @brief Check if a CREATE operation has a parent CREATE operation with higher index in the sorted operation list. Higher
-         * index means positioned further in the list and, therefor, the parent operation would be processed after the child
-         * operation.
-         * @param opIdToIndexMap A map giving the correspondence between an operation ID and its position in the sorted operation
-         * list.
-         * @param op The child operation to be compared.
-         * highest distance.
-         * @param depth The depth of op's affected node.
-         * @return The operation on an ancestor of op's node with the highest index in the operation list, if it exists. Returns
-         * nullptr otherwise.
+         * @brief Reorder the operation list according to the recorded dependencies.
+         * @param cycle The operations of a dependency cycle, if any.
+         * @return false if a dependency cycle prevents the sorting, in which case the operation list is left unchanged.
          */
-        SyncOpPtr getAncestorOpWithHighestIndex(const std::unordered_map<UniqueId, int32_t> &opIdToIndexMap, const SyncOpPtr &op,
-                                                int32_t &relativeDepth) const;
+        bool sortByDependencies(SyncOperationList &cycle);
 
         bool getIdFromDb(ReplicaSide side, const SyncPath &path, NodeId &id) const;
 
         std::pair<SyncOpPtr, SyncOpPtr> extractOpsByType(OperationType type1, OperationType type2, SyncOpPtr op,
                                                          SyncOpPtr otherOp) const;
 
-        std::list<std::pair<SyncOpPtr, SyncOpPtr>> _reorderings;
+        OperationDependencyGraph _dependencyGraph;
         bool _hasOrderChanged{false};
         OperationSorterFilter _filter;
 
         friend class TestOperationSorterWorker;
+        friend class BenchmarkOperationSorter;
 };
 } // namespace KDC
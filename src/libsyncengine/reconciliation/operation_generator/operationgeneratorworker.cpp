@@ -19,6 +19,7 @@
 #include "operationgeneratorworker.h"
 #include "update_detection/update_detector/updatetree.h"
 #include "libcommonserver/utility/utility.h"
+#include "libcommonserver/utility/freediskspacetracker.h"
 #include "requests/parameterscache.h"
 #include "libcommon/log/sentry/ptraces.h"
 
@@ -121,7 +122,7 @@ void OperationGeneratorWorker::execute() {
     }
 
     if (_bytesToDownload > 0) {
-        const int64_t freeBytes = Utility::getFreeDiskSpace(_syncPal->localPath());
+        const int64_t freeBytes = FreeDiskSpaceTracker::instance()->freeDiskSpace(_syncPal->localPath(), _bytesToDownload);
         if (freeBytes >= 0) {
             if (freeBytes < _bytesToDownload + Utility::freeDiskSpaceLimit()) {
                 LOGW_SYNCPAL_WARN(_logger, L"Disk almost full, only " << freeBytes << L" B available at path "
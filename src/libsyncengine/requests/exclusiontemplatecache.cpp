@@ -28,6 +28,7 @@
 namespace KDC {
 
 std::shared_ptr<ExclusionTemplateCache> ExclusionTemplateCache::_instance = nullptr;
+std::atomic<uint64_t> ExclusionTemplateCache::_matcherGeneration = 0;
 
 std::shared_ptr<ExclusionTemplateCache> ExclusionTemplateCache::instance() {
     if (_instance == nullptr) {
@@ -121,6 +122,34 @@ void ExclusionTemplateCache::updateRegexPatterns() {
 
         addRegexForAllNormalizationForms(regexPattern, exclPattern);
     }
+
+    publishMatcher();
+}
+
+void ExclusionTemplateCache::publishMatcher() {
+    // Called with `_mutex` locked
+    std::vector<ExclusionTemplate> exclusionTemplates;
+    exclusionTemplates.reserve(_regexPatterns.size());
+    for (const auto &[regex, exclusionTemplate]: _regexPatterns) {
+        exclusionTemplates.push_back(exclusionTemplate);
+    }
+
+    _matcher = std::make_shared<const ExclusionTemplateMatcher>(exclusionTemplates);
+    // The generation is shared by all instances so that a thread never mistakes the matcher of a reset cache for a current one.
+    _matcherGeneration.fetch_add(1, std::memory_order_release);
+}
+
+const ExclusionTemplateMatcher &ExclusionTemplateCache::matcher() {
+    thread_local uint64_t cachedGeneration = 0;
+    thread_local std::shared_ptr<const ExclusionTemplateMatcher> cachedMatcher;
+
+    if (_matcherGeneration.load(std::memory_order_acquire) != cachedGeneration || !cachedMatcher) {
+        const std::scoped_lock<std::mutex> lock(_mutex);
+        cachedMatcher = _matcher;
+        cachedGeneration = _matcherGeneration.load(std::memory_order_relaxed);
+    }
+
+    return *cachedMatcher;
 }
 
 void ExclusionTemplateCache::addRegexForAllNormalizationForms(std::string regexPattern, ExclusionTemplate exclusionTemplate) {
@@ -201,71 +230,20 @@ bool ExclusionTemplateCache::isExcluded(const SyncPath &relativePath) noexcept {
 }
 
 bool ExclusionTemplateCache::isExcluded(const SyncPath &relativePath, bool &isWarning) noexcept {
-    const std::scoped_lock lock(_mutex);
     const std::string fileName = SyncName2Str(relativePath.filename().native());
-    for (const auto &[regex, exclusionTemplate]: _regexPatterns) {
-        const std::string &patternStr = exclusionTemplate.templ();
-        isWarning = exclusionTemplate.warning();
-
-        switch (exclusionTemplate.complexity()) {
-            case ExclusionTemplateComplexity::Simplest: {
-                if (fileName == patternStr) {
-                    if (ParametersCache::isExtendedLogEnabled()) {
-                        LOGW_INFO(Log::instance()->getLogger(),
-                                  L"Item \"" << Utility::formatSyncPath(relativePath) << L"\" rejected because of rule \""
-                                             << CommonUtility::s2ws(exclusionTemplate.templ()) << L"\"");
-                    }
-                    return true; // Filename match exactly the pattern
-                }
-                break;
-            }
-            case ExclusionTemplateComplexity::Simple: {
-                std::string tmpStr = patternStr;
-                bool atBeginning = tmpStr[0] == '*';
-                bool atEnd = tmpStr[tmpStr.length() - 1] == '*';
-                std::string::size_type n = tmpStr.find('*');
-                while (n != std::string::npos) {
-                    tmpStr.erase(n, 1);
-                    n = tmpStr.find('*');
-                }
-
-                bool exclude = false;
-                if (atBeginning && atEnd) {
-                    // Template can be anywhere
-                    exclude = fileName.find(tmpStr) != std::string::npos;
-                } else if (atBeginning) {
-                    // Must be at the end only
-                    exclude = CommonUtility::endsWith(fileName, tmpStr);
-                } else {
-                    // Must be at the beginning only
-                    exclude = CommonUtility::startsWith(fileName, tmpStr);
-                }
-
-                if (exclude) {
-                    if (ParametersCache::isExtendedLogEnabled()) {
-                        LOGW_INFO(Log::instance()->getLogger(),
-                                  L"Item \"" << Utility::formatSyncPath(relativePath) << L"\" rejected because of rule \""
-                                             << CommonUtility::s2ws(exclusionTemplate.templ()) << L"\"");
-                    }
-                    return true; // Filename contains the pattern
-                }
-                break;
-            }
-            case ExclusionTemplateComplexity::Complex:
-            default: {
-                if (std::regex_match(fileName, regex)) {
-                    if (ParametersCache::isExtendedLogEnabled()) {
-                        LOGW_INFO(Log::instance()->getLogger(),
-                                  L"Item \"" << Utility::formatSyncPath(relativePath) << L"\" rejected because of rule \""
-                                             << CommonUtility::s2ws(exclusionTemplate.templ()) << L"\"");
-                    }
-                    return true;
-                }
-                break;
-            }
-        }
+    const ExclusionTemplate *exclusionTemplate = matcher().match(fileName);
+    if (!exclusionTemplate) {
+        isWarning = false;
+        return false;
+    }
+
+    isWarning = exclusionTemplate->warning();
+    if (ParametersCache::isExtendedLogEnabled()) {
+        LOGW_INFO(Log::instance()->getLogger(),
+                  L"Item \"" << Utility::formatSyncPath(relativePath) << L"\" rejected because of rule \""
+                             << CommonUtility::s2ws(exclusionTemplate->templ()) << L"\"");
     }
-    return false;
+    return true;
 }
 
 } // namespace KDC
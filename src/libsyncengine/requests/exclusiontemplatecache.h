@@ -19,9 +19,11 @@
 #pragma once
 
 #include "syncenginelib.h"
+#include "exclusiontemplatematcher.h"
 #include "libparms/db/exclusiontemplate.h"
 #include "libcommon/utility/types.h"
 
+#include <atomic>
 #include <vector>
 #include <regex>
 #include <mutex>
@@ -55,6 +57,11 @@ class SYNCENGINE_EXPORT ExclusionTemplateCache {
         std::vector<ExclusionTemplate> _userExclusionTemplates;
         std::vector<std::pair<std::regex, ExclusionTemplate>> _regexPatterns;
 
+        // Matcher compiled from `_regexPatterns`, replaced as a whole on every update. Readers keep a thread-local copy of it
+        // and only lock `_mutex` when `_matcherGeneration` tells them that a newer matcher has been published.
+        std::shared_ptr<const ExclusionTemplateMatcher> _matcher;
+        static std::atomic<uint64_t> _matcherGeneration;
+
         std::mutex _mutex;
 
         ExclusionTemplateCache();
@@ -62,6 +69,8 @@ class SYNCENGINE_EXPORT ExclusionTemplateCache {
         void populateExclusionTemplates();
 
         void updateRegexPatterns();
+        void publishMatcher();
+        const ExclusionTemplateMatcher &matcher();
 
         void escapeRegexSpecialChar(std::string &in);
 
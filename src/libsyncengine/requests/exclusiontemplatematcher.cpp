@@ -0,0 +1,160 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "exclusiontemplatematcher.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <algorithm>
+
+namespace KDC {
+
+namespace {
+// Characters that a wildcard cannot match, like the `.` of the regular expressions that this matcher replaces.
+#ifdef KD_WINDOWS
+constexpr std::string_view wildcardExcludedCharacters = "\r\n";
+#else
+constexpr std::string_view wildcardExcludedCharacters = "\r";
+#endif
+} // namespace
+
+ExclusionTemplateMatcher::ExclusionTemplateMatcher(const std::vector<ExclusionTemplate> &exclusionTemplates) :
+    _exclusionTemplates(exclusionTemplates) {
+    for (size_t index = 0; index < _exclusionTemplates.size(); ++index) {
+        const auto &exclusionTemplate = _exclusionTemplates[index];
+        addTemplate(exclusionTemplate.templ(), exclusionTemplate.complexity(), index);
+    }
+}
+
+void ExclusionTemplateMatcher::addTemplate(const std::string &templ, const ExclusionTemplateComplexity complexity,
+                                           const size_t index) {
+    switch (complexity) {
+        case ExclusionTemplateComplexity::Simplest: {
+            (void) _names.try_emplace(templ, index); // Keep the first template if the same name appears twice
+            break;
+        }
+        case ExclusionTemplateComplexity::Simple: {
+            const bool atBeginning = templ.front() == '*';
+            const bool atEnd = templ.back() == '*';
+            std::string literal = templ;
+            std::erase(literal, '*');
+
+            if (atBeginning && atEnd) {
+                _substrings.push_back({std::move(literal), index});
+            } else if (atBeginning) {
+                _suffixes.push_back({std::move(literal), index});
+            } else {
+                _prefixes.push_back({std::move(literal), index});
+            }
+            break;
+        }
+        case ExclusionTemplateComplexity::Complex:
+        default: {
+            Glob glob;
+            glob.anchoredAtStart = templ.front() != '*';
+            glob.anchoredAtEnd = templ.back() != '*';
+            glob.index = index;
+            for (auto &segment: Utility::splitStr(templ, '*')) {
+                if (segment.empty()) continue;
+                glob.backtrack |= segment.find_first_of(wildcardExcludedCharacters) != std::string::npos;
+                glob.segments.push_back(std::move(segment));
+            }
+            _globs.push_back(std::move(glob));
+            break;
+        }
+    }
+}
+
+const ExclusionTemplate *ExclusionTemplateMatcher::match(const std::string &fileName) const {
+    // Every family is sorted by template index, so each scan stops as soon as it cannot improve on the best match found.
+    size_t best = _exclusionTemplates.size();
+    if (const auto it = _names.find(fileName); it != _names.end()) {
+        best = it->second;
+    }
+
+    for (const auto &[prefix, index]: _prefixes) {
+        if (index >= best) break;
+        if (fileName.starts_with(prefix)) {
+            best = index;
+            break;
+        }
+    }
+
+    for (const auto &[suffix, index]: _suffixes) {
+        if (index >= best) break;
+        if (fileName.ends_with(suffix)) {
+            best = index;
+            break;
+        }
+    }
+
+    for (const auto &[substring, index]: _substrings) {
+        if (index >= best) break;
+        if (fileName.find(substring) != std::string::npos) {
+            best = index;
+            break;
+        }
+    }
+
+    for (const auto &glob: _globs) {
+        if (glob.index >= best) break;
+        if (matchGlob(glob, fileName)) {
+            best = glob.index;
+            break;
+        }
+    }
+
+    return best < _exclusionTemplates.size() ? &_exclusionTemplates[best] : nullptr;
+}
+
+bool ExclusionTemplateMatcher::matchGlob(const Glob &glob, const std::string_view fileName) {
+    if (!glob.anchoredAtStart) return matchSegments(glob, fileName, 0, 0);
+
+    if (glob.segments.empty() || !fileName.starts_with(glob.segments.front())) return false;
+    return matchSegments(glob, fileName, 1, glob.segments.front().size());
+}
+
+bool ExclusionTemplateMatcher::matchSegments(const Glob &glob, const std::string_view fileName, const size_t segmentIndex,
+                                             const size_t pos) {
+    // A wildcard stands between `pos` and the next segment, it can extend up to the first excluded character.
+    const size_t wildcardEnd = std::min(fileName.find_first_of(wildcardExcludedCharacters, pos), fileName.size());
+
+    if (segmentIndex == glob.segments.size()) {
+        // Only the trailing wildcard is left
+        return wildcardEnd == fileName.size();
+    }
+
+    const std::string &segment = glob.segments[segmentIndex];
+    if (glob.anchoredAtEnd && segmentIndex + 1 == glob.segments.size()) {
+        // The last segment must end the name
+        if (fileName.size() < pos + segment.size()) return false;
+        const size_t start = fileName.size() - segment.size();
+        return start <= wildcardEnd && fileName.substr(start) == segment;
+    }
+
+    for (size_t start = fileName.find(segment, pos); start != std::string_view::npos && start <= wildcardEnd;
+         start = fileName.find(segment, start + 1)) {
+        if (matchSegments(glob, fileName, segmentIndex + 1, start + segment.size())) return true;
+        // Without excluded characters in the segments, a later occurrence cannot succeed where the leftmost one failed.
+        if (!glob.backtrack) break;
+    }
+
+    return false;
+}
+
+} // namespace KDC
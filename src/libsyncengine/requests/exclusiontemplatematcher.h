@@ -0,0 +1,74 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "libparms/db/exclusiontemplate.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace KDC {
+
+// Immutable set of exclusion templates, compiled once so that file names can be checked from any thread without locking.
+// Templates without a wildcard are looked up in a hash map, those with wildcards at their ends only are reduced to prefix,
+// suffix or substring literals, and the others are split into the literal segments found between their wildcards.
+class ExclusionTemplateMatcher {
+    public:
+        explicit ExclusionTemplateMatcher(const std::vector<ExclusionTemplate> &exclusionTemplates);
+
+        // Returns the first template of the list matching `fileName`, or nullptr if the name is not excluded.
+        [[nodiscard]] const ExclusionTemplate *match(const std::string &fileName) const;
+
+        [[nodiscard]] const std::vector<ExclusionTemplate> &exclusionTemplates() const { return _exclusionTemplates; }
+
+    private:
+        friend class TestExclusionTemplateCache;
+
+        struct Literal {
+                std::string value;
+                size_t index{0};
+        };
+
+        struct Glob {
+                std::vector<std::string> segments;
+                bool anchoredAtStart{false};
+                bool anchoredAtEnd{false};
+                // True if a segment contains a character that a wildcard cannot match, in which case the leftmost occurrence
+                // of a segment is not always the right one.
+                bool backtrack{false};
+                size_t index{0};
+        };
+
+        std::vector<ExclusionTemplate> _exclusionTemplates;
+        std::unordered_map<std::string, size_t> _names;
+        std::vector<Literal> _prefixes;
+        std::vector<Literal> _suffixes;
+        std::vector<Literal> _substrings;
+        std::vector<Glob> _globs;
+
+        void addTemplate(const std::string &templ, ExclusionTemplateComplexity complexity, size_t index);
+
+        static bool matchGlob(const Glob &glob, std::string_view fileName);
+        static bool matchSegments(const Glob &glob, std::string_view fileName, size_t segmentIndex, size_t pos);
+};
+
+} // namespace KDC
@@ -138,6 +138,39 @@ ExitCode SyncNodeCache::update(const SyncDbId syncDbId, const SyncNodeType type,
     return ExitCode::Ok;
 }
 
+ExitCode SyncNodeCache::insertSyncNode(const SyncDbId syncDbId, const SyncNodeType type, const NodeId &nodeId) {
+    const std::scoped_lock lock(_mutex);
+
+    if (auto exitCode = checkIfSyncExists(syncDbId); exitCode != ExitCode::Ok) return exitCode;
+    if (auto exitCode = checkIfSyncNodeListExists(syncDbId, type); exitCode != ExitCode::Ok) return exitCode;
+
+    if (!_syncNodesMap[syncDbId][type].insert(nodeId).second) return ExitCode::Ok; // Already there
+
+    if (!_syncDbMap[syncDbId]->insertSyncNode(nodeId, type)) {
+        LOG_WARN(Log::instance()->getLogger(), "Error in SyncDb::insertSyncNode");
+        return ExitCode::DbError;
+    }
+
+    return ExitCode::Ok;
+}
+
+ExitCode SyncNodeCache::deleteSyncNode(const SyncDbId syncDbId, const SyncNodeType type, const NodeId &nodeId) {
+    const std::scoped_lock lock(_mutex);
+
+    if (auto exitCode = checkIfSyncExists(syncDbId); exitCode != ExitCode::Ok) return exitCode;
+    if (auto exitCode = checkIfSyncNodeListExists(syncDbId, type); exitCode != ExitCode::Ok) return exitCode;
+
+    if (!_syncNodesMap[syncDbId][type].erase(nodeId)) return ExitCode::Ok; // Not there
+
+    bool found = false;
+    if (!_syncDbMap[syncDbId]->deleteSyncNode(nodeId, type, found)) {
+        LOG_WARN(Log::instance()->getLogger(), "Error in SyncDb::deleteSyncNode");
+        return ExitCode::DbError;
+    }
+
+    return ExitCode::Ok;
+}
+
 ExitCode SyncNodeCache::initCache(const SyncDbId syncDbId, std::shared_ptr<SyncDb> syncDb) {
     const std::scoped_lock lock(_mutex);
 
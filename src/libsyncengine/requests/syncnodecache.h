@@ -40,6 +40,9 @@ class SYNCENGINE_EXPORT SyncNodeCache {
         ExitCode syncNodes(const SyncDbId syncDbId, const SyncNodeType type, NodeSet &syncNodes);
         ExitInfo deleteSyncNode(const SyncDbId syncDbId, const NodeId &nodeId);
         ExitCode update(const SyncDbId syncDbId, const SyncNodeType type, const NodeSet &syncNodes);
+        // Add or remove a single node, without rewriting the whole list
+        ExitCode insertSyncNode(const SyncDbId syncDbId, const SyncNodeType type, const NodeId &nodeId);
+        ExitCode deleteSyncNode(const SyncDbId syncDbId, const SyncNodeType type, const NodeId &nodeId);
         ExitCode initCache(const SyncDbId syncDbId, std::shared_ptr<SyncDb> syncDb);
         ExitCode clear(const SyncDbId syncDbId);
 
@@ -120,6 +120,9 @@ void ISyncWorker::setDone(const ExitCode exitCode) {
     _isRunning = false;
     _stopAsked = false;
     _exitCode = exitCode;
+
+    // The SyncPalWorker waits for its workers to finish
+    if (_syncPal) _syncPal->notifySyncPalWorker();
 }
 
 } // namespace KDC
@@ -0,0 +1,137 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pathtrie.h"
+
+#include <deque>
+
+namespace KDC {
+
+bool PathTrie::isIgnored(const SyncPath &component) {
+    // Trailing separators yield empty components
+    return component.empty() || component == ".";
+}
+
+template<typename Node>
+Node *PathTrie::find(Node *root, const SyncPath &path) {
+    Node *node = root;
+    for (const auto &component: path) {
+        if (isIgnored(component)) continue;
+
+        const auto childIt = node->children.find(component.native());
+        if (childIt == node->children.end()) return nullptr;
+        node = childIt->second.get();
+    }
+
+    return node;
+}
+
+void PathTrie::insert(const SyncPath &path, const NodeId &nodeId) {
+    TrieNode *node = &_root;
+    for (const auto &component: path) {
+        if (isIgnored(component)) continue;
+
+        auto &child = node->children[component.native()];
+        if (!child) {
+            child = std::make_unique<TrieNode>();
+            child->parent = node;
+            child->name = component.native();
+        }
+        node = child.get();
+    }
+
+    if (node->nodeIds.insert(nodeId).second) ++_size;
+}
+
+bool PathTrie::erase(const SyncPath &path, const NodeId &nodeId) {
+    TrieNode *node = find(&_root, path);
+    if (!node || !node->nodeIds.erase(nodeId)) return false;
+    --_size;
+
+    // Prune the branches left empty
+    while (node != &_root && node->nodeIds.empty() && node->children.empty()) {
+        TrieNode *parent = node->parent;
+        (void) parent->children.erase(node->name);
+        node = parent;
+    }
+
+    return true;
+}
+
+void PathTrie::clear() {
+    _root.nodeIds.clear();
+    _root.children.clear();
+    _size = 0;
+}
+
+bool PathTrie::containsAncestorOrEqual(const SyncPath &path) const {
+    const TrieNode *node = &_root;
+    if (!node->nodeIds.empty()) return true;
+
+    for (const auto &component: path) {
+        if (isIgnored(component)) continue;
+
+        const auto childIt = node->children.find(component.native());
+        if (childIt == node->children.end()) return false;
+
+        node = childIt->second.get();
+        if (!node->nodeIds.empty()) return true;
+    }
+
+    return false;
+}
+
+std::vector<NodeId> PathTrie::descendantsOrEqual(const SyncPath &path) const {
+    std::vector<NodeId> nodeIds;
+    visit(path, [&nodeIds](const TrieNode &node) {
+        nodeIds.insert(nodeIds.end(), node.nodeIds.begin(), node.nodeIds.end());
+        return true;
+    });
+
+    return nodeIds;
+}
+
+std::optional<NodeId> PathTrie::firstDescendantOrEqual(const SyncPath &path) const {
+    std::optional<NodeId> nodeId;
+    visit(path, [&nodeId](const TrieNode &node) {
+        if (node.nodeIds.empty()) return true;
+        nodeId = *node.nodeIds.begin();
+        return false;
+    });
+
+    return nodeId;
+}
+
+void PathTrie::visit(const SyncPath &path, const std::function<bool(const TrieNode &)> &visitor) const {
+    const TrieNode *node = find(&_root, path);
+    if (!node) return;
+
+    std::deque<const TrieNode *> queue{node};
+    while (!queue.empty()) {
+        const TrieNode *current = queue.front();
+        queue.pop_front();
+
+        if (!visitor(*current)) return;
+        for (const auto &[name, child]: current->children) {
+            queue.push_back(child.get());
+        }
+    }
+}
+
+} // namespace KDC
@@ -0,0 +1,77 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "syncenginelib.h"
+#include "libcommon/utility/types.h"
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace KDC {
+
+/**
+ * Node IDs indexed by relative path, one path component per level, so that the ancestors and the descendants of a path are
+ * found in O(depth) instead of comparing the path with every indexed one.
+ * Path components are compared as is, like in `CommonUtility::isDescendantOrEqual`.
+ */
+class SYNCENGINE_EXPORT PathTrie {
+    public:
+        PathTrie() = default;
+        PathTrie(PathTrie const &) = delete;
+        void operator=(PathTrie const &) = delete;
+
+        void insert(const SyncPath &path, const NodeId &nodeId);
+        // Returns false if `nodeId` is not indexed at `path`
+        bool erase(const SyncPath &path, const NodeId &nodeId);
+        void clear();
+
+        // Returns true if a node ID is indexed at `path` or at one of its ancestors
+        bool containsAncestorOrEqual(const SyncPath &path) const;
+        // Returns the node IDs indexed at `path` and at its descendants, the shallowest first
+        std::vector<NodeId> descendantsOrEqual(const SyncPath &path) const;
+        // Returns the first node ID that `descendantsOrEqual` would return, without visiting the whole subtree
+        std::optional<NodeId> firstDescendantOrEqual(const SyncPath &path) const;
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+    private:
+        struct TrieNode {
+                TrieNode *parent{nullptr};
+                SyncName name;
+                NodeSet nodeIds;
+                std::unordered_map<SyncName, std::unique_ptr<TrieNode>> children;
+        };
+
+        TrieNode _root;
+        size_t _size{0};
+
+        template<typename Node>
+        static Node *find(Node *root, const SyncPath &path);
+        // Breadth-first visit of the nodes of the subtree of `path`, until `visitor` returns false
+        void visit(const SyncPath &path, const std::function<bool(const TrieNode &)> &visitor) const;
+        static bool isIgnored(const SyncPath &component);
+};
+
+} // namespace KDC
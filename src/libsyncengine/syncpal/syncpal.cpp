@@ -34,6 +34,7 @@
 #include "update_detection/file_system_observer/remotefilesystemobserverworker.h"
 #include "update_detection/blacklist_changes_propagator/blacklistpropagator.h"
 #include "update_detection/file_system_observer/computefsoperationworker.h"
+#include "update_detection/file_system_observer/snapshot/snapshotfile.h"
 #include "update_detection/update_detector/updatetreeworker.h"
 #include "reconciliation/platform_inconsistency_checker/platforminconsistencycheckerworker.h"
 #include "reconciliation/platform_inconsistency_checker/platforminconsistencycheckerutility.h"
@@ -171,6 +172,8 @@ SyncPal::SyncPal(std::shared_ptr<Vfs> vfs, const int syncDbId_, const std::strin
             SyncPath dbPathWal(dbPath);
             dbPathWal.replace_filename(dbPathWal.filename().native() + Str("-wal"));
             (void) IoHelper::deleteItem(dbPathWal);
+
+            (void) IoHelper::deleteItem(SnapshotFile::path(dbPath));
         }
 
         sync.setDbPath(dbPath);
@@ -578,6 +581,7 @@ void SyncPal::startEstimateUpdates() {
 
 void SyncPal::stopEstimateUpdates() {
     _progressInfo->setUpdate(false);
+    _progressInfo->flushCompletedItems();
 }
 
 void SyncPal::updateEstimates() {
@@ -1313,6 +1317,25 @@ void SyncPal::stop(PauseCaller caller, DbBehaviorAfterStop behavior) {
     freeSharedObjects();
 
     _syncDb->setAutoDelete(behavior == DbBehaviorAfterStop::Remove);
+    if (behavior == DbBehaviorAfterStop::Remove) {
+        // The remote snapshot saved on stop belongs to the sync database
+        (void) IoHelper::deleteItem(SnapshotFile::path(_syncDb->dbPath()));
+    }
+}
+
+void SyncPal::notifySyncPalWorker() {
+    {
+        const std::scoped_lock lock(_syncPalWorkerNotificationMutex);
+        _syncPalWorkerNotified = true;
+    }
+    _syncPalWorkerNotification.notify_one();
+}
+
+bool SyncPal::waitForSyncPalWorkerNotification(const std::chrono::milliseconds timeout) {
+    std::unique_lock lock(_syncPalWorkerNotificationMutex);
+    const bool notified = _syncPalWorkerNotification.wait_for(lock, timeout, [this] { return _syncPalWorkerNotified; });
+    _syncPalWorkerNotified = false;
+    return notified;
 }
 
 bool SyncPal::isPaused() const {
@@ -1585,8 +1608,11 @@ void SyncPal::copySnapshots() {
     LOG_IF_FAIL(_localFSObserverWorker)
     LOG_IF_FAIL(_remoteFSObserverWorker)
 
-    _localSnapshot = std::make_shared<ConstSnapshot>(liveSnapshot(ReplicaSide::Local));
-    _remoteSnapshot = std::make_shared<ConstSnapshot>(liveSnapshot(ReplicaSide::Remote));
+    // Release the previous copies first so that the live snapshots can update their frozen items in place
+    _localSnapshot.reset();
+    _remoteSnapshot.reset();
+    _localSnapshot = liveSnapshot(ReplicaSide::Local).freeze();
+    _remoteSnapshot = liveSnapshot(ReplicaSide::Remote).freeze();
     liveSnapshot(ReplicaSide::Local).startRead();
     liveSnapshot(ReplicaSide::Remote).startRead();
 }
@@ -37,7 +37,9 @@
 
 #include "libparms/db/parmsdb.h"
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <comm.h>
 
 namespace KDC {
@@ -190,6 +192,9 @@ class SYNCENGINE_EXPORT SyncPal : public std::enable_shared_from_this<SyncPal> {
         void setVfsMode(const VirtualFileMode mode) { _syncInfo.vfsMode = mode; }
         void setIsPaused(const bool paused) { _syncInfo.isPaused = paused; }
 
+        //! Wakes up the SyncPalWorker so that it checks the state of the workers and of the live snapshots right away.
+        void notifySyncPalWorker();
+
         [[nodiscard]] std::shared_ptr<SyncOperationList> syncOps() const { return _syncOps; }
         [[nodiscard]] std::shared_ptr<ConflictQueue> conflictQueue() const { return _conflictQueue; }
 
@@ -339,7 +344,7 @@ class SYNCENGINE_EXPORT SyncPal : public std::enable_shared_from_this<SyncPal> {
          * SyncPal::snapshot(ReplicaSide side)) There are a few exceptions where reading
          * directly from the liveSnapshot is necessary:
          * - To check if the filesystem has changed (liveSnapshot().updated()).
-         * - To create a ConstSnapshot (ConstSnapshot(liveSnapshot())).
+         * - To create a ConstSnapshot (liveSnapshot().freeze()).
          * - When outside of a sync process (i.e., not in a worker), since no ConstSnapshot is
          * available. Ideally, we would query the filesystem directly in these situations.
          * However, for optimization purposes, it may be preferable to read from the live
@@ -452,6 +457,9 @@ class SYNCENGINE_EXPORT SyncPal : public std::enable_shared_from_this<SyncPal> {
         // Direct download callback
         void directDownloadCallback(UniqueId jobId);
 
+        //! Waits until `notifySyncPalWorker` is called or `timeout` expires. Returns true if a notification was received.
+        bool waitForSyncPalWorkerNotification(std::chrono::milliseconds timeout);
+
     private:
         void setUpBlacklistPropagator(bool restartSync);
         void setUpExcludelistPropagator();
@@ -461,6 +469,10 @@ class SYNCENGINE_EXPORT SyncPal : public std::enable_shared_from_this<SyncPal> {
 
         int64_t _consecutiveBackErrors{0};
 
+        std::mutex _syncPalWorkerNotificationMutex;
+        std::condition_variable _syncPalWorkerNotification;
+        bool _syncPalWorkerNotified{false};
+
         std::shared_ptr<CacheDirectory> _cacheDirectory;
 
         // TODO : Refactor to not use friend classes (should be reserved for test purpose).
@@ -504,6 +516,8 @@ class SYNCENGINE_EXPORT SyncPal : public std::enable_shared_from_this<SyncPal> {
         friend class MockSyncPal;
         friend class TestSituationGenerator;
         friend class TestFileRescuer;
+        friend class BenchmarkSyncCycles;
+        friend class BenchmarkOperationSorter;
 };
 
 } // namespace KDC
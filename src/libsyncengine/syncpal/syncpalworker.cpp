@@ -45,6 +45,9 @@
 namespace KDC {
 
 static constexpr auto snapshotMinSizeForDeleteAlert = 100; // 100 items
+// The workers and the observers notify the SyncPalWorker of their changes, the timeout only paces the progress estimates
+// and the rare state changes that are not notified (e.g. a restart requested by a propagator).
+static constexpr std::chrono::milliseconds notificationTimeout(1000);
 
 SyncPalWorker::SyncPalWorker(std::shared_ptr<SyncPal> syncPal, const std::string &name, const std::string &shortName,
                              const std::chrono::seconds &startDelay) :
@@ -338,7 +341,7 @@ void SyncPalWorker::execute() {
                 LOG_SYNCPAL_INFO(_logger, "***** Pause");
             }
 
-            Utility::msleep(LOOP_PAUSE_SLEEP_PERIOD);
+            (void) _syncPal->waitForSyncPalWorkerNotification(notificationTimeout);
 
             // Manage unpause
             if (_unpauseAsked) {
@@ -365,6 +368,7 @@ void SyncPalWorker::execute() {
                     waitForExitOfWorkers(stepWorkers);
                     initStep(step, stepWorkers, inputSharedObject);
                     isStepInProgress = false;
+                    continue; // Start the next step right away
                 }
             } else if (shouldBePaused(stepWorkers[0], stepWorkers[1])) {
                 LOG_SYNCPAL_INFO(_logger, "***** Step " << stepName(_step) << " has aborted");
@@ -422,13 +426,17 @@ void SyncPalWorker::execute() {
                     stepWorkers[index]->start();
                 }
             }
+
+            // Steps without workers (Idle, Done) are evaluated right away, nothing would notify their completion
+            if (!stepWorkers[0] && !stepWorkers[1]) continue;
         }
 
         if (exitCode != ExitCode::Unknown) {
             break;
         }
 
-        Utility::msleep(LOOP_EXEC_SLEEP_PERIOD);
+        (void) _syncPal->waitForSyncPalWorkerNotification(notificationTimeout);
+        ++_wakeUpCount;
     }
 
     LOG_SYNCPAL_INFO(_logger, "Worker " << name() << " stopped");
@@ -439,6 +447,7 @@ void SyncPalWorker::stop() {
     _pauseAsked = false;
     _unpauseAsked = true;
     ISyncWorker::stop();
+    _syncPal->notifySyncPalWorker();
 #if defined(KD_WINDOWS)
     if (_resetVfsFilesStatusThread && _resetVfsFilesStatusThread->joinable()) {
         _resetVfsFilesStatusThread->join();
@@ -461,6 +470,7 @@ void SyncPalWorker::pause() {
     LOG_SYNCPAL_DEBUG(_logger, "Worker " << name() << " pause");
     _pauseAsked = true;
     _unpauseAsked = false;
+    _syncPal->notifySyncPalWorker();
 }
 
 void SyncPalWorker::unpause() {
@@ -479,6 +489,7 @@ void SyncPalWorker::unpause() {
     _unpauseAsked = true;
     _pauseAsked = false;
     _syncPal->setRestart(true);
+    _syncPal->notifySyncPalWorker();
 }
 
 std::string SyncPalWorker::stepName(SyncStep step) {
@@ -503,7 +514,7 @@ void SyncPalWorker::initStep(SyncStep step, std::shared_ptr<ISyncWorker> (&worke
             _syncPal->resetEstimateUpdates();
             _syncPal->refreshTmpBlacklist();
             _syncPal->freeSnapshotsCopies();
-            _syncPal->syncDb()->cache().clear();
+            _syncPal->syncDb()->cache().suspend();
             _syncPal->resetConsecutiveBackErrors();
             break;
         case SyncStep::UpdateDetection1:
@@ -557,7 +568,8 @@ void SyncPalWorker::initStep(SyncStep step, std::shared_ptr<ISyncWorker> (&worke
             workers[1] = nullptr;
             inputSharedObject[0] = nullptr;
             inputSharedObject[1] = nullptr;
-            _syncPal->syncDb()->cache().clear(); // Cache is not needed anymore, free resources
+            // The cache is not used during propagation. Its nodes are kept to be refreshed incrementally at the next sync.
+            _syncPal->syncDb()->cache().suspend();
             break;
         case SyncStep::Done:
             workers[0] = nullptr;
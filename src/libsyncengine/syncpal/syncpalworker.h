@@ -21,6 +21,7 @@
 #include "isyncworker.h"
 #include "libcommon/utility/types.h"
 
+#include <atomic>
 #include <ctime>
 
 namespace backoffVariable {
@@ -53,6 +54,7 @@ class SyncPalWorker : public ISyncWorker {
         bool _pauseAsked{false};
         bool _unpauseAsked{false};
         bool _isPaused{false};
+        std::atomic_uint64_t _wakeUpCount{0}; // Number of times the sync loop has waited for a notification
 #if defined(KD_WINDOWS)
         std::unique_ptr<StdLoggingThread> _resetVfsFilesStatusThread{nullptr};
 #endif
@@ -43,9 +43,9 @@ void TmpBlacklistManager::logMessage(const std::wstring &msg, const NodeId &id,
 
 void TmpBlacklistManager::increaseErrorCount(const NodeId &nodeId, const NodeType type, const SyncPath &relativePath,
                                              const ReplicaSide side, ExitInfo exitInfo /*= ExitInfo()*/) {
-    auto &errors = side == ReplicaSide::Local ? _localErrors : _remoteErrors;
+    auto &errors_ = errors(side);
 
-    if (const auto errorItem = errors.find(nodeId); errorItem != errors.end()) {
+    if (const auto errorItem = errors_.find(nodeId); errorItem != errors_.end()) {
         errorItem->second.lastErrorTime = std::chrono::steady_clock::now();
         insertInBlacklist(nodeId, side);
 
@@ -55,47 +55,36 @@ void TmpBlacklistManager::increaseErrorCount(const NodeId &nodeId, const NodeTyp
                         exitInfo ? CancelType::TmpBlacklisted : CancelType::None, "", exitInfo.code(), exitInfo.cause());
         _syncPal->addError(err);
     } else {
-        TmpErrorInfo errorInfo;
-        errorInfo.path = relativePath;
-        (void) errors.try_emplace(nodeId, errorInfo);
+        addError(nodeId, relativePath, side);
         logMessage(L"First time we try to blacklist this item, it is not blacklisted yet", nodeId, side, relativePath);
     }
 }
 
 void TmpBlacklistManager::blacklistItem(const NodeId &nodeId, const SyncPath &relativePath, const ReplicaSide side) {
-    auto &errors = side == ReplicaSide::Local ? _localErrors : _remoteErrors;
-    if (const auto &errorItem = errors.find(nodeId); errorItem != errors.end()) {
+    auto &errors_ = errors(side);
+    if (const auto &errorItem = errors_.find(nodeId); errorItem != errors_.end()) {
         // Reset error timer
         errorItem->second.lastErrorTime = std::chrono::steady_clock::now();
     } else {
-        TmpErrorInfo errorInfo;
-        errorInfo.path = relativePath;
-        (void) errors.try_emplace(nodeId, errorInfo);
+        addError(nodeId, relativePath, side);
         logMessage(L"Item added in error list", nodeId, side, relativePath);
     }
 
     insertInBlacklist(nodeId, side);
 
-    std::list<NodeId> toBeRemoved;
-    for (const auto &[id, errorInfo]: errors) {
-        if (CommonUtility::isDescendantOrEqual(errorInfo.path, relativePath) && id != nodeId) {
-            toBeRemoved.push_back(id);
-        }
-    }
-
-    for (const auto &id: toBeRemoved) {
-        removeItemFromTmpBlacklist(id, side);
+    for (const auto &id: errorPaths(side).descendantsOrEqual(relativePath)) {
+        if (id != nodeId) removeItemFromTmpBlacklist(id, side);
     }
 }
 
 void TmpBlacklistManager::clear() {
     for (const auto side: std::array<ReplicaSide, 2>{ReplicaSide::Local, ReplicaSide::Remote}) {
-        auto &errors = side == ReplicaSide::Local ? _localErrors : _remoteErrors;
-        auto errorIt = errors.begin();
-        while (errorIt != errors.end()) {
-            logMessage(L"Removing item from tmp blacklist", errorIt->first, side);
-            errorIt = errors.erase(errorIt);
+        auto &errors_ = errors(side);
+        for (const auto &[nodeId, errorInfo]: errors_) {
+            logMessage(L"Removing item from tmp blacklist", nodeId, side);
         }
+        errors_.clear();
+        errorPaths(side).clear();
         const auto blacklistType_ = blackListType(side);
 
         // Force a new detection of changes for all the nodes that were blacklisted.
@@ -115,20 +104,13 @@ void TmpBlacklistManager::refreshBlacklist() {
     using namespace std::chrono;
     const auto now = steady_clock::now();
     for (const auto side: std::array<ReplicaSide, 2>{ReplicaSide::Local, ReplicaSide::Remote}) {
-        auto &errors = side == ReplicaSide::Local ? _localErrors : _remoteErrors;
-        auto errorIt = errors.begin();
-        while (errorIt != errors.end()) {
+        auto &errors_ = errors(side);
+        auto errorIt = errors_.begin();
+        while (errorIt != errors_.end()) {
             if (const duration<double> elapsed_seconds = now - errorIt->second.lastErrorTime; elapsed_seconds.count() > oneHour) {
                 logMessage(L"Removing item from tmp blacklist", errorIt->first, side);
-
-                const auto blacklistType_ = blackListType(side);
-
-                NodeSet tmp;
-                SyncNodeCache::instance()->syncNodes(_syncPal->syncDbId(), blacklistType_, tmp);
-                tmp.erase(errorIt->first);
-                SyncNodeCache::instance()->update(_syncPal->syncDbId(), blacklistType_, tmp);
-
-                errorIt = errors.erase(errorIt);
+                (void) SyncNodeCache::instance()->deleteSyncNode(_syncPal->syncDbId(), blackListType(side), errorIt->first);
+                errorIt = removeError(errorIt, side);
                 continue;
             }
 
@@ -138,30 +120,16 @@ void TmpBlacklistManager::refreshBlacklist() {
 }
 
 void TmpBlacklistManager::removeItemFromTmpBlacklist(const SyncPath &relativePath) {
-    NodeId remotedId;
-    NodeId localId;
-
     // Find the node id of the item to be removed
-    for (const auto &[nodeId, tmpInfo]: _localErrors) {
-        if (CommonUtility::isDescendantOrEqual(tmpInfo.path, relativePath)) {
-            localId = nodeId;
-            break;
-        }
-    }
+    const auto localId = _localErrorPaths.firstDescendantOrEqual(relativePath);
+    const auto remoteId = _remoteErrorPaths.firstDescendantOrEqual(relativePath);
 
-    for (const auto &[nodeId, tmpInfo]: _remoteErrors) {
-        if (CommonUtility::isDescendantOrEqual(tmpInfo.path, relativePath)) {
-            remotedId = nodeId;
-            break;
-        }
+    if (localId) {
+        eraseSingleItemFromBlacklist(*localId, ReplicaSide::Local);
     }
 
-    if (!localId.empty()) {
-        eraseSingleItemFromBlacklist(localId, ReplicaSide::Local);
-    }
-
-    if (!remotedId.empty()) {
-        eraseSingleItemFromBlacklist(remotedId, ReplicaSide::Remote);
+    if (remoteId) {
+        eraseSingleItemFromBlacklist(*remoteId, ReplicaSide::Remote);
     }
 }
 
@@ -172,39 +140,38 @@ void TmpBlacklistManager::removeItemFromTmpBlacklist(const NodeId &nodeId, const
 }
 
 bool TmpBlacklistManager::isTmpBlacklisted(const SyncPath &path, const ReplicaSide side) const {
-    for (auto &errors = side == ReplicaSide::Local ? _localErrors : _remoteErrors; const auto &errorInfo: errors) {
-        if (CommonUtility::isDescendantOrEqual(path, errorInfo.second.path)) return true;
-    }
-
-    return false;
+    return errorPaths(side).containsAncestorOrEqual(path);
 }
 
 void TmpBlacklistManager::insertInBlacklist(const NodeId &nodeId, const ReplicaSide side) const {
-    const auto blacklistType_ = blackListType(side);
-
-    NodeSet tmp;
-    SyncNodeCache::instance()->syncNodes(_syncPal->syncDbId(), blacklistType_, tmp);
-    tmp.insert(nodeId);
-    SyncNodeCache::instance()->update(_syncPal->syncDbId(), blacklistType_, tmp);
+    (void) SyncNodeCache::instance()->insertSyncNode(_syncPal->syncDbId(), blackListType(side), nodeId);
 
     logMessage(L"Item added in tmp blacklist", nodeId, side);
 }
 
 void TmpBlacklistManager::eraseSingleItemFromBlacklist(const NodeId &nodeId, const ReplicaSide side) {
-    const SyncNodeType blacklistType_ = blackListType(side);
+    (void) SyncNodeCache::instance()->deleteSyncNode(_syncPal->syncDbId(), blackListType(side), nodeId);
 
-    NodeSet tmp;
-    SyncNodeCache::instance()->syncNodes(_syncPal->syncDbId(), blacklistType_, tmp);
-    if (tmp.contains(nodeId)) {
-        tmp.erase(nodeId);
-        SyncNodeCache::instance()->update(_syncPal->syncDbId(), blacklistType_, tmp);
+    if (auto &errors_ = errors(side); errors_.contains(nodeId)) {
+        (void) removeError(errors_.find(nodeId), side);
     }
 
-    auto &errors = side == ReplicaSide::Local ? _localErrors : _remoteErrors;
-    errors.erase(nodeId);
-
     (void) _syncPal->forceUpdateLastChangeRevision(nodeId, side);
     logMessage(L"Item removed from tmp blacklist", nodeId, side);
 }
 
+void TmpBlacklistManager::addError(const NodeId &nodeId, const SyncPath &relativePath, const ReplicaSide side) {
+    TmpErrorInfo errorInfo;
+    errorInfo.path = relativePath;
+    if (errors(side).try_emplace(nodeId, errorInfo).second) {
+        errorPaths(side).insert(relativePath, nodeId);
+    }
+}
+
+std::unordered_map<NodeId, TmpBlacklistManager::TmpErrorInfo>::iterator TmpBlacklistManager::removeError(
+        std::unordered_map<NodeId, TmpErrorInfo>::iterator errorIt, const ReplicaSide side) {
+    (void) errorPaths(side).erase(errorIt->second.path, errorIt->first);
+    return errors(side).erase(errorIt);
+}
+
 } // namespace KDC
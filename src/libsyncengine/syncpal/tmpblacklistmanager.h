@@ -20,6 +20,7 @@
 
 #include "utility/types.h"
 #include "syncpal.h"
+#include "pathtrie.h"
 #include <unordered_map>
 
 namespace KDC {
@@ -57,9 +58,28 @@ class TmpBlacklistManager {
             return side == ReplicaSide::Local ? SyncNodeType::TmpLocalBlacklist : SyncNodeType::TmpRemoteBlacklist;
         }
 
+        std::unordered_map<NodeId, TmpErrorInfo> &errors(const ReplicaSide side) {
+            return side == ReplicaSide::Local ? _localErrors : _remoteErrors;
+        }
+        PathTrie &errorPaths(const ReplicaSide side) {
+            return side == ReplicaSide::Local ? _localErrorPaths : _remoteErrorPaths;
+        }
+        const PathTrie &errorPaths(const ReplicaSide side) const {
+            return side == ReplicaSide::Local ? _localErrorPaths : _remoteErrorPaths;
+        }
+        void addError(const NodeId &nodeId, const SyncPath &relativePath, ReplicaSide side);
+        // Returns an iterator to the next error
+        std::unordered_map<NodeId, TmpErrorInfo>::iterator removeError(std::unordered_map<NodeId, TmpErrorInfo>::iterator errorIt,
+                                                                      ReplicaSide side);
+
         std::unordered_map<NodeId, TmpErrorInfo> _localErrors;
         std::unordered_map<NodeId, TmpErrorInfo> _remoteErrors;
+        // The paths of the errors above, so that the errors of a path and of its ancestors are found without a full scan
+        PathTrie _localErrorPaths;
+        PathTrie _remoteErrorPaths;
         std::shared_ptr<SyncPal> _syncPal;
+
+        friend class TestTmpBlacklistManager;
 };
 
 } // namespace KDC
@@ -22,20 +22,23 @@
 
 #include "libcommonserver/log/log.h"
 
+#include "libcommonserver/io/filehasher.h"
+#include "libcommonserver/io/iohelper.h"
 #include "libcommonserver/utility/utility.h"
 
 #include <log4cplus/loggingmacros.h>
 
-#include <xxhash.h>
+#include <ctime>
 
 namespace KDC {
 
 ComputeChecksumJob::ComputeChecksumJob(const NodeId &nodeId, const SyncPath &filepath,
-                                       const std::shared_ptr<LiveSnapshot> localSnapshot) :
+                                       const std::shared_ptr<LiveSnapshot> localSnapshot, const std::shared_ptr<SyncDb> syncDb) :
     _logger(Log::instance()->getLogger()),
     _nodeId(nodeId),
     _filePath(filepath),
-    _localSnapshot(localSnapshot) {}
+    _localSnapshot(localSnapshot),
+    _syncDb(syncDb) {}
 
 ExitInfo ComputeChecksumJob::runJob() {
     if (isExtendedLog()) {
@@ -43,66 +46,87 @@ ExitInfo ComputeChecksumJob::runJob() {
     }
 
     const TimerUtility timer;
-    bool stopped = false;
 
-    // Create a hash stat
-    XXH3_state_t *const state = XXH3_createState();
-    if (!state) {
-        LOGW_WARN(_logger, L"Checksum computation " << jobId() << L" failed for file " << Path2WStr(_filePath));
-        return {};
-    }
-
-    // Initialize state with selected seed
-    if (XXH3_64bits_reset(state) == XXH_ERROR) {
-        LOGW_WARN(_logger, L"Checksum computation " << jobId() << L" failed for file " << Path2WStr(_filePath));
-        XXH3_freeState(state);
-        return {};
+    FileStat fileStat;
+    bool hasFileStat = false;
+    if (_syncDb) {
+        auto ioError = IoError::Success;
+        hasFileStat = IoHelper::getFileStat(_filePath, &fileStat, ioError, IoHelper::PathCheckOption::Insensitive) &&
+                      ioError == IoError::Success;
+
+        if (std::string checksum; hasFileStat && readFromCache(fileStat, checksum)) {
+            _localSnapshot->setContentChecksum(_nodeId, checksum);
+            if (isExtendedLog()) {
+                LOGW_DEBUG(_logger, L"Checksum of file " << Path2WStr(_filePath) << L" read from cache");
+            }
+            return ExitCode::Ok;
+        }
     }
-
-    try {
-        FILE *f = fopen(SyncName2Str(_filePath.native()).c_str(), "rb");
-        if (f) {
-            std::size_t len;
-            unsigned char buf[BUFSIZ];
-            do {
-                len = fread(buf, 1, BUFSIZ, f);
-                if (XXH3_64bits_update(state, buf, len) == XXH_ERROR) {
-                    LOGW_WARN(_logger, L"Checksum computation " << jobId() << L" failed for file " << Path2WStr(_filePath));
-                    fclose(f);
-                    XXH3_freeState(state);
-                    return {};
-                }
-            } while (len == BUFSIZ);
-
-            if (!stopped) {
-                // Produce the final hash value
-                XXH64_hash_t const hash = XXH3_64bits_digest(state);
-                _localSnapshot->setContentChecksum(_nodeId, Utility::xxHashToStr(hash));
+    const SyncTime hashStartTime = std::time(nullptr);
+
+    XXH64_hash_t hash = 0;
+    switch (const IoError ioError = FileHasher::xxh3(_filePath, hash); ioError) {
+        case IoError::Success: {
+            const std::string checksum = Utility::xxHashToStr(hash);
+            _localSnapshot->setContentChecksum(_nodeId, checksum);
+            if (hasFileStat) {
+                writeToCache(fileStat, hashStartTime, checksum);
             }
 
-            fclose(f);
-
-            if (stopped) {
-                LOGW_WARN(_logger, L"Checksum computation " << jobId() << L" aborted for file " << Path2WStr(_filePath));
-            } else {
-                if (isExtendedLog()) {
-                    LOGW_DEBUG(_logger, L"Checksum computation " << jobId() << L" for file " << Path2WStr(_filePath) << L" took "
-                                                                 << timer.elapsed<DoubleSeconds>().count() << L"s");
-                }
+            if (isExtendedLog()) {
+                LOGW_DEBUG(_logger, L"Checksum computation " << jobId() << L" for file " << Path2WStr(_filePath) << L" took "
+                                                             << timer.elapsed<DoubleSeconds>().count() << L"s");
             }
-        } else {
-            LOGW_DEBUG(_logger, L"Item does not exist anymore - path=" << Path2WStr(_filePath));
+            break;
         }
-    } catch (...) {
-        LOGW_DEBUG(_logger, L"File " << Path2WStr(_filePath) << L" is not readable");
+        case IoError::NoSuchFileOrDirectory:
+            LOGW_DEBUG(_logger, L"Item does not exist anymore - path=" << Path2WStr(_filePath));
+            break;
+        case IoError::Unknown:
+            LOGW_WARN(_logger, L"Checksum computation " << jobId() << L" failed for file " << Path2WStr(_filePath));
+            return {};
+        default:
+            LOGW_DEBUG(_logger, L"File is not readable - " << Utility::formatIoError(_filePath, ioError));
+            break;
     }
 
-    XXH3_freeState(state);
-
     if (isExtendedLog()) {
         LOG_DEBUG(_logger, "Checksum job finished: id=" << jobId());
     }
     return ExitCode::Ok;
 }
 
+bool ComputeChecksumJob::readFromCache(const FileStat &fileStat, std::string &checksum) const {
+    bool found = false;
+    if (!_syncDb->selectChecksumCacheEntry(_nodeId, fileStat.size, fileStat.modificationTime, fileStat.changeTime, checksum,
+                                           found)) {
+        LOG_WARN(_logger, "Error in SyncDb::selectChecksumCacheEntry");
+        return false;
+    }
+
+    return found;
+}
+
+void ComputeChecksumJob::writeToCache(const FileStat &fileStat, SyncTime hashStartTime, const std::string &checksum) const {
+    // Timestamps have a one second resolution: a file modified during the second the hash started could be modified again
+    // without any visible change of its status. Such a checksum is not cached.
+    if (fileStat.modificationTime >= hashStartTime || fileStat.changeTime >= hashStartTime) return;
+
+    // Make sure that the file has not been modified while it was read.
+    FileStat newFileStat;
+    if (auto ioError = IoError::Success;
+        !IoHelper::getFileStat(_filePath, &newFileStat, ioError, IoHelper::PathCheckOption::Insensitive) ||
+        ioError != IoError::Success) {
+        return;
+    }
+    if (newFileStat.inode != fileStat.inode || newFileStat.size != fileStat.size ||
+        newFileStat.modificationTime != fileStat.modificationTime || newFileStat.changeTime != fileStat.changeTime) {
+        return;
+    }
+
+    if (!_syncDb->insertChecksumCacheEntry(_nodeId, fileStat.size, fileStat.modificationTime, fileStat.changeTime, checksum)) {
+        LOG_WARN(_logger, "Error in SyncDb::insertChecksumCacheEntry");
+    }
+}
+
 } // namespace KDC
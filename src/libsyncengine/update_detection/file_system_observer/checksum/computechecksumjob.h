@@ -19,7 +19,9 @@
 #pragma once
 
 #include "jobs/syncjob.h"
+#include "db/syncdb.h"
 #include "update_detection/file_system_observer/snapshot/livesnapshot.h"
+#include "libcommonserver/io/filestat.h"
 
 #include <log4cplus/logger.h>
 
@@ -27,17 +29,24 @@ namespace KDC {
 
 class ComputeChecksumJob : public SyncJob {
     public:
-        ComputeChecksumJob(const NodeId &nodeId, const SyncPath &filepath, std::shared_ptr<LiveSnapshot> localSnapshot);
+        // If `syncDb` is not null, the checksum is read from its checksum cache when the file is unchanged since it was last
+        // hashed, and the computed checksum is stored in it otherwise.
+        ComputeChecksumJob(const NodeId &nodeId, const SyncPath &filepath, std::shared_ptr<LiveSnapshot> localSnapshot,
+                           std::shared_ptr<SyncDb> syncDb = nullptr);
 
     protected:
         ExitInfo runJob() override;
 
     private:
+        bool readFromCache(const FileStat &fileStat, std::string &checksum) const;
+        void writeToCache(const FileStat &fileStat, SyncTime hashStartTime, const std::string &checksum) const;
+
         log4cplus::Logger _logger;
 
         NodeId _nodeId;
         SyncPath _filePath;
         std::shared_ptr<LiveSnapshot> _localSnapshot;
+        std::shared_ptr<SyncDb> _syncDb;
 };
 
 } // namespace KDC
@@ -88,8 +88,8 @@ void ContentChecksumWorker::execute() {
 
             if (_threadPool.available()) {
                 const std::scoped_lock<std::mutex> lock(_checksumMutex);
-                std::shared_ptr<ComputeChecksumJob> job =
-                        std::make_shared<ComputeChecksumJob>(_toCompute.front().first, _toCompute.front().second, _localSnapshot);
+                std::shared_ptr<ComputeChecksumJob> job = std::make_shared<ComputeChecksumJob>(
+                        _toCompute.front().first, _toCompute.front().second, _localSnapshot, _syncPal->syncDb());
                 _runningJobs.insert({job->jobId(), job});
                 job->setMainCallback(callback);
                 _threadPool.start(*job);
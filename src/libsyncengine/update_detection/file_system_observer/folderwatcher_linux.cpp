@@ -19,23 +19,40 @@
 #include "folderwatcher_linux.h"
 #include "localfilesystemobserverworker.h"
 #include "libcommon/utility/types.h"
+#include "libcommonserver/io/filestat.h"
 #include "libcommonserver/io/iohelper.h"
 #include "libcommonserver/utility/utility.h"
 #include "requests/parameterscache.h"
 
+#include <sys/eventfd.h>
 #include <sys/inotify.h>
-#include <sys/ioctl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <string.h>
 
 namespace KDC {
 
-#define EVENT_SIZE (sizeof(struct inotify_event))
-#define BUF_LEN (1024 * (EVENT_SIZE + 16))
-#define SLEEP_TIME 100 // 100ms
+#define EVENT_BUF_LEN (64 * 1024) // Room for more than a thousand events per read
+#define MAX_READS_PER_BATCH 16
+#define MOVED_TO_TIMEOUT 10 // 10ms
 
 FolderWatcher_linux::FolderWatcher_linux(LocalFileSystemObserverWorker *parent, const SyncPath &path) :
-    FolderWatcher(parent, path) {}
+    FolderWatcher(parent, path) {
+    _stopEventFileDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_stopEventFileDescriptor == -1) {
+        LOG_WARN(_logger, "eventfd() failed: " << strerror(errno));
+    }
+}
+
+FolderWatcher_linux::~FolderWatcher_linux() {
+    if (_fileDescriptor != -1) {
+        (void) close(static_cast<int>(_fileDescriptor));
+    }
+
+    if (_stopEventFileDescriptor != -1) {
+        (void) close(_stopEventFileDescriptor);
+    }
+}
 
 SyncPath FolderWatcher_linux::makeSyncPath(const SyncPath &watchedFolderPath, const char *fileName) {
     const auto syncName = SyncName(fileName);
@@ -55,9 +72,7 @@ void FolderWatcher_linux::startWatching() {
     LOG_DEBUG(_logger, "File system format: " << fileSystemName);
     LOG_DEBUG(_logger, "Free space on disk: " << Utility::getFreeDiskSpace(_folder) << " bytes.");
 
-    _fileDescriptor = inotify_init();
-    if (_fileDescriptor == -1) {
-        LOG_WARN(_logger, "inotify_init() failed: " << strerror(errno));
+    if (!initInotify()) {
         return;
     }
 
@@ -66,90 +81,247 @@ void FolderWatcher_linux::startWatching() {
         return;
     }
 
+    readEvents();
+
+    LOGW_DEBUG(_logger, L"Folder watching stopped: " << Utility::formatSyncPath(_folder));
+}
+
+bool FolderWatcher_linux::initInotify() {
+    if (_fileDescriptor != -1) {
+        // The watcher is restarted
+        (void) close(static_cast<int>(_fileDescriptor));
+        _watchToPath.clear();
+        _pathToWatch.clear();
+        _pendingMovesFrom.clear();
+    }
+
+    // Discard a stop request addressed to a previous run
+    eventfd_t value = 0;
+    (void) eventfd_read(_stopEventFileDescriptor, &value);
+
+    _fileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_fileDescriptor == -1) {
+        LOG_WARN(_logger, "inotify_init1() failed: " << strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+void FolderWatcher_linux::readEvents() {
+    alignas(inotify_event) char buffer[EVENT_BUF_LEN];
+    pollfd fds[2] = {{static_cast<int>(_fileDescriptor), POLLIN, 0}, {_stopEventFileDescriptor, POLLIN, 0}};
+
     while (!_stop) {
         _ready = true;
-        unsigned int avail = 0;
-        (void) ioctl(static_cast<int>(_fileDescriptor), FIONREAD,
-                     &avail); // Since read() is blocking until something has changed, we use ioctl to check if there is changes
-        if (avail > 0) {
-            char buffer[BUF_LEN];
-            ssize_t len = read(static_cast<int>(_fileDescriptor), buffer, BUF_LEN);
-            if (len == -1) {
-                LOG_WARN(_logger, "Error reading file descriptor " << errno);
-                continue;
-            }
-            // iterate events in buffer
-            std::uint64_t offset = 0;
-            while (offset < static_cast<std::uint64_t>(len)) {
-                if (_stop) {
+
+        // Block until the next event unless a move destination is awaited
+        const int timeout = _pendingMovesFrom.empty() ? -1 : MOVED_TO_TIMEOUT;
+        const int ret = poll(fds, _stopEventFileDescriptor == -1 ? 1 : 2, timeout);
+        if (ret == -1) {
+            if (errno == EINTR) continue;
+            LOG_WARN(_logger, "Error in poll: " << strerror(errno));
+            setExitInfo({ExitCode::SystemError, ExitCause::Unknown});
+            break;
+        }
+
+        if (_stop || (fds[1].revents & POLLIN)) {
+            break;
+        }
+
+        ChangeList changes;
+        bool overflow = false;
+        if (fds[0].revents & POLLIN) {
+            for (int readCount = 0; readCount < MAX_READS_PER_BATCH && !_stop; ++readCount) {
+                const ssize_t len = read(static_cast<int>(_fileDescriptor), buffer, EVENT_BUF_LEN);
+                if (len == -1) {
+                    if (errno == EINTR) continue;
+                    if (errno != EAGAIN) {
+                        LOG_WARN(_logger, "Error reading file descriptor " << errno);
+                    }
                     break;
                 }
-                auto *event = (inotify_event *) (buffer + offset);
-
-                auto opType = OperationType::None;
-                bool skip = false;
-                if (event->mask & IN_CREATE) {
-                    opType = OperationType::Create;
-                } else if (event->mask & IN_DELETE || event->mask & IN_MOVED_FROM) {
-                    opType = OperationType::Delete;
-                } else if (event->mask & IN_MOVED_TO) {
-                    opType = OperationType::Move;
-                } else if (event->mask & (IN_MODIFY | IN_ATTRIB)) {
-                    opType = OperationType::Edit;
-                } else {
-                    // Ignore all other events
-                    skip = true;
-                }
 
-                if (!skip && !_stop) {
-                    if (_watchToPath.contains(event->wd)) {
-                        // `event->name` is empty for instance if the event is a permission change on a watched
-                        // directory (see inotify man page).
-                        const SyncPath path = makeSyncPath(_watchToPath[event->wd], event->name);
-                        if (ParametersCache::isExtendedLogEnabled()) {
-                            LOGW_DEBUG(_logger,
-                                       L"Operation " << opType << L" detected on item with " << Utility::formatSyncPath(path));
-                        }
-
-                        if (const auto exitInfo = changeDetected(path, opType); !exitInfo) {
-                            LOGW_WARN(KDC::Log::instance()->getLogger(), L"Error in FolderWatcher_linux::changeDetected for "
-                                                                                 << Utility::formatSyncPath(path) << L" "
-                                                                                 << exitInfo);
-                        }
-
-                        bool isDirectory = false;
-                        auto ioError = IoError::Success;
-                        if (const bool isDirSuccess = IoHelper::checkIfIsDirectory(path, isDirectory, ioError); !isDirSuccess) {
-                            LOGW_WARN(_logger,
-                                      L"Error in IoHelper::checkIfIsDirectory: " << Utility::formatIoError(path, ioError));
-                            continue;
-                        }
-
-                        if (ioError == IoError::AccessDenied) {
-                            LOGW_WARN(_logger, L"The item misses search/exec permission - " << Utility::formatSyncPath(path));
-                        }
-
-                        if ((event->mask & (IN_MOVED_TO | IN_CREATE)) && isDirectory) {
-                            if (auto exitInfo = addFolderRecursive(path); !exitInfo) {
-                                setExitInfo(exitInfo);
-                                return;
-                            };
-                        }
-
-                        if (event->mask & (IN_MOVED_FROM | IN_DELETE)) {
-                            removeFoldersBelow(path);
-                        }
-                    }
+                if (!processEvents(buffer, static_cast<std::size_t>(len), changes, overflow)) {
+                    return;
                 }
+            }
+        }
+
+        flushPendingMovesFrom(changes);
+
+        if (!changes.empty() && !_stop) {
+            if (const auto exitInfo = changesDetected(changes); !exitInfo) {
+                LOGW_WARN(_logger, L"Error in FolderWatcher_linux::changesDetected: " << exitInfo);
+            }
+        }
+
+        if (overflow && !_stop && !recoverFromOverflow()) {
+            return;
+        }
+    }
+}
+
+bool FolderWatcher_linux::processEvents(const char *buffer, std::size_t length, ChangeList &changes, bool &overflow) {
+    std::size_t offset = 0;
+    while (offset < length && !_stop) {
+        const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+        offset += sizeof(inotify_event) + event->len;
 
-                offset += sizeof(inotify_event) + event->len;
+        if (event->mask & IN_Q_OVERFLOW) {
+            overflow = true;
+            continue;
+        }
+
+        const auto watchIt = _watchToPath.find(event->wd);
+        if (watchIt == _watchToPath.end()) {
+            continue;
+        }
+
+        if (event->mask & IN_IGNORED) {
+            // The watch has been removed, either explicitly or because the folder has been deleted
+            if (const auto pathIt = _pathToWatch.find(watchIt->second.native());
+                pathIt != _pathToWatch.end() && pathIt->second == event->wd) {
+                (void) _pathToWatch.erase(pathIt);
+            }
+            (void) _watchToPath.erase(watchIt);
+            continue;
+        }
+
+        // `event->name` is empty for instance if the event is a permission change on a watched
+        // directory (see inotify man page).
+        const SyncPath path = makeSyncPath(watchIt->second, event->name);
+        const bool isDirectory = event->mask & IN_ISDIR;
+
+        auto opType = OperationType::None;
+        if (event->mask & IN_MOVED_FROM) {
+            // Wait for the matching IN_MOVED_TO event, if any, to report a single move
+            _pendingMovesFrom[event->cookie] = {path, isDirectory, std::chrono::steady_clock::now()};
+            continue;
+        } else if (event->mask & IN_MOVED_TO) {
+            opType = OperationType::Move;
+            if (const auto moveFromIt = _pendingMovesFrom.find(event->cookie); moveFromIt != _pendingMovesFrom.end()) {
+                if (isDirectory) {
+                    renameFoldersBelow(moveFromIt->second.path, path);
+                }
+                (void) _pendingMovesFrom.erase(moveFromIt);
+            } else if (isDirectory) {
+                // The folder has been moved from outside the synchronized folder
+                if (const auto exitInfo = addFolderRecursive(path); !exitInfo) {
+                    setExitInfo(exitInfo);
+                    return false;
+                }
+            }
+        } else if (event->mask & IN_CREATE) {
+            opType = OperationType::Create;
+            if (isDirectory) {
+                if (const auto exitInfo = addFolderRecursive(path); !exitInfo) {
+                    setExitInfo(exitInfo);
+                    return false;
+                }
+            }
+        } else if (event->mask & IN_DELETE) {
+            opType = OperationType::Delete;
+            if (isDirectory) {
+                removeFoldersBelow(path);
             }
+        } else if (event->mask & (IN_MODIFY | IN_ATTRIB)) {
+            opType = OperationType::Edit;
         } else {
-            Utility::msleep(SLEEP_TIME);
+            // Ignore all other events
+            continue;
+        }
+
+        if (ParametersCache::isExtendedLogEnabled()) {
+            LOGW_DEBUG(_logger, L"Operation " << opType << L" detected on item with " << Utility::formatSyncPath(path));
         }
+
+        (void) changes.emplace_back(path, opType);
     }
 
-    LOGW_DEBUG(_logger, L"Folder watching stopped: " << Utility::formatSyncPath(_folder));
+    return true;
+}
+
+void FolderWatcher_linux::flushPendingMovesFrom(ChangeList &changes) {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = _pendingMovesFrom.begin(); it != _pendingMovesFrom.end();) {
+        if (now - it->second.time < std::chrono::milliseconds(MOVED_TO_TIMEOUT)) {
+            ++it;
+            continue;
+        }
+
+        // The item has been moved outside the synchronized folder
+        const auto &moveFrom = it->second;
+        if (ParametersCache::isExtendedLogEnabled()) {
+            LOGW_DEBUG(_logger, L"Operation " << OperationType::Delete << L" detected on item with "
+                                              << Utility::formatSyncPath(moveFrom.path));
+        }
+
+        (void) changes.emplace_back(moveFrom.path, OperationType::Delete);
+        if (moveFrom.isDirectory) {
+            removeFoldersBelow(moveFrom.path);
+        }
+        it = _pendingMovesFrom.erase(it);
+    }
+}
+
+bool FolderWatcher_linux::recoverFromOverflow() {
+    // Any watched folder may have lost events. Neither the folder events nor the folder change time reveal an in-place edit
+    // of a file, so the files of every watched folder are checked again.
+    std::set<SyncPath> dirPaths;
+    std::list<SyncPath> missingDirPaths;
+    for (const auto &[pathStr, wd]: _pathToWatch) {
+        const SyncPath dirPath(pathStr);
+        FileStat fileStat;
+        auto ioError = IoError::Success;
+        if (!IoHelper::getFileStat(dirPath, &fileStat, ioError, IoHelper::PathCheckOption::Sensitive)) {
+            LOGW_WARN(_logger, L"Error in IoHelper::getFileStat: " << Utility::formatIoError(dirPath, ioError));
+            (void) dirPaths.insert(dirPath);
+            continue;
+        }
+
+        if (ioError == IoError::NoSuchFileOrDirectory) {
+            missingDirPaths.push_back(dirPath);
+            (void) dirPaths.insert(dirPath.parent_path());
+            continue;
+        }
+
+        (void) dirPaths.insert(dirPath);
+    }
+
+    for (const auto &dirPath: missingDirPaths) {
+        removeFoldersBelow(dirPath);
+    }
+
+    std::list<SyncPath> rescannedDirPaths;
+    for (const auto &dirPath: dirPaths) {
+        if (!_pathToWatch.contains(dirPath.native())) {
+            // Parent of a deleted folder that is not watched itself
+            continue;
+        }
+
+        // Watch the folders created while the events were lost
+        std::error_code ec;
+        for (auto dirIt = std::filesystem::directory_iterator(dirPath, ec); !ec && dirIt != std::filesystem::directory_iterator();
+             dirIt.increment(ec)) {
+            if (dirIt->is_directory(ec) && !dirIt->is_symlink(ec) && !_pathToWatch.contains(dirIt->path().native())) {
+                if (const auto exitInfo = addFolderRecursive(dirIt->path()); !exitInfo) {
+                    setExitInfo(exitInfo);
+                    return false;
+                }
+            }
+        }
+
+        rescannedDirPaths.push_back(dirPath);
+    }
+
+    LOG_WARN(_logger, "inotify event queue overflow, rescanning " << rescannedDirPaths.size() << " watched folders");
+
+    if (const auto exitInfo = rescanDirectories(rescannedDirPaths); !exitInfo) {
+        LOGW_WARN(_logger, L"Error in FolderWatcher_linux::rescanDirectories: " << exitInfo);
+    }
+
+    return true;
 }
 
 bool FolderWatcher_linux::findSubFolders(const SyncPath &dir, std::list<SyncPath> &fullList) {
@@ -262,38 +434,54 @@ ExitInfo FolderWatcher_linux::addFolderRecursive(const SyncPath &path) {
     return ExitCode::Ok;
 }
 
-void FolderWatcher_linux::removeFoldersBelow(const SyncPath &dirPath) {
-    auto it = _pathToWatch.find(dirPath.string());
-    if (it == _pathToWatch.end()) {
-        return;
+std::list<std::map<std::string, int>::iterator> FolderWatcher_linux::watchesBelow(const SyncPath &dirPath) {
+    // The descendants of `dirPath` are not necessarily contiguous in `_pathToWatch`: e.g., "A b" is sorted between "A" and
+    // "A/b". All of them start with `dirPath` though.
+    std::list<std::map<std::string, int>::iterator> result;
+    const auto &prefix = dirPath.native();
+    for (auto it = _pathToWatch.lower_bound(prefix); it != _pathToWatch.end() && it->first.starts_with(prefix); ++it) {
+        if (CommonUtility::isDescendantOrEqual(it->first, dirPath)) {
+            result.push_back(it);
+        }
     }
 
-    // Remove the entry and all subentries
-    while (it != _pathToWatch.end()) {
-        auto itPath = it->first;
-        if (!CommonUtility::isDescendantOrEqual(itPath, dirPath)) {
-            break;
-        }
+    return result;
+}
 
-        auto wid = it->second;
-        if (const auto wd = inotify_rm_watch(static_cast<int>(_fileDescriptor), wid); wd > -1) {
-            _watchToPath.erase(wid);
-            it = _pathToWatch.erase(it);
-            LOG_DEBUG(_logger, "Removed watch on" << itPath);
+void FolderWatcher_linux::removeFoldersBelow(const SyncPath &dirPath) {
+    // Remove the entry and all subentries
+    for (const auto &it: watchesBelow(dirPath)) {
+        const auto itPath = it->first;
+        const auto wid = it->second;
+        if (const auto wd = inotify_rm_watch(static_cast<int>(_fileDescriptor), wid); wd == -1 && errno != EINVAL) {
+            // EINVAL: the watch has already been removed by the kernel because the folder has been deleted
+            LOG_ERROR(_logger, "Error in inotify_rm_watch :" << errno);
+            sentry::Handler::captureMessage(sentry::Level::Error, "FolderWatcher_linux::removeFoldersBelow",
+                                            "Error in inotify_rm_watch :" + std::to_string(errno));
             continue;
         }
 
-        ++it;
-        LOG_ERROR(_logger, "Error in inotify_rm_watch :" << errno);
-        sentry::Handler::captureMessage(sentry::Level::Error, "FolderWatcher_linux::removeFoldersBelow",
-                                        "Error in inotify_rm_watch :" + std::to_string(errno));
+        (void) _watchToPath.erase(wid);
+        (void) _pathToWatch.erase(it);
+        LOG_DEBUG(_logger, "Removed watch on" << itPath);
+    }
+}
+
+void FolderWatcher_linux::renameFoldersBelow(const SyncPath &oldDirPath, const SyncPath &newDirPath) {
+    std::list<std::pair<SyncPath, int>> renamedWatches;
+    for (const auto &it: watchesBelow(oldDirPath)) {
+        (void) renamedWatches.emplace_back(newDirPath.native() + it->first.substr(oldDirPath.native().size()), it->second);
+        (void) _pathToWatch.erase(it);
+    }
+
+    for (const auto &[path, wd]: renamedWatches) {
+        _watchToPath[wd] = path;
+        _pathToWatch[path.native()] = wd;
     }
 }
 
-ExitInfo FolderWatcher_linux::changeDetected(const SyncPath &path, OperationType opType) const {
-    std::list<std::pair<SyncPath, OperationType>> list;
-    (void) list.emplace_back(path, opType);
-    if (const auto exitInfo = _parent->changesDetected(list); !exitInfo) {
+ExitInfo FolderWatcher_linux::changesDetected(const ChangeList &changes) {
+    if (const auto exitInfo = _parent->changesDetected(changes); !exitInfo) {
         LOGW_WARN(_logger, L"Error in LocalFileSystemObserverWorker::changesDetected: " << exitInfo);
         _parent->invalidateSnapshot();
         return exitInfo;
@@ -302,10 +490,21 @@ ExitInfo FolderWatcher_linux::changeDetected(const SyncPath &path, OperationType
     return ExitCode::Ok;
 }
 
+ExitInfo FolderWatcher_linux::rescanDirectories(const std::list<SyncPath> &dirPaths) {
+    if (const auto exitInfo = _parent->rescanDirectories(dirPaths); !exitInfo) {
+        LOGW_WARN(_logger, L"Error in LocalFileSystemObserverWorker::rescanDirectories: " << exitInfo);
+        _parent->invalidateSnapshot();
+        return exitInfo;
+    }
+
+    return ExitCode::Ok;
+}
+
 void FolderWatcher_linux::stopWatching() {
     LOGW_DEBUG(_logger, L"Stop watching folder: " << Utility::formatSyncPath(_folder));
 
-    (void) close(static_cast<int>(_fileDescriptor));
+    // Wake up the watching thread blocked in `poll`
+    (void) eventfd_write(_stopEventFileDescriptor, 1);
 }
 
 } // namespace KDC
@@ -20,7 +20,9 @@
 
 #include "folderwatcher.h"
 
+#include <chrono>
 #include <map>
+#include <set>
 
 struct inotify_event;
 
@@ -31,28 +33,60 @@ class LocalFileSystemObserverWorker;
 class FolderWatcher_linux : public FolderWatcher {
     public:
         FolderWatcher_linux(LocalFileSystemObserverWorker *parent, const SyncPath &path);
+        ~FolderWatcher_linux() override;
 
         void startWatching() override;
         void stopWatching() override;
 
     private:
+        using ChangeList = std::list<std::pair<SyncPath, OperationType>>;
+
         std::int64_t _fileDescriptor = -1;
+        // Written by `stopWatching` to wake up the watching thread
+        int _stopEventFileDescriptor = -1;
+
+        bool initInotify();
+        // Block until events are available and process them, until the watcher is stopped.
+        void readEvents();
+        /**
+         * @brief Process the events read from the inotify file descriptor.
+         * @param changes The changes to report, in the order of the events.
+         * @param overflow Set to true if the kernel event queue overflowed.
+         * @return false if watching must be stopped.
+         */
+        bool processEvents(const char *buffer, std::size_t length, ChangeList &changes, bool &overflow);
+        // Report the moves whose destination has not been received in time as deletions.
+        void flushPendingMovesFrom(ChangeList &changes);
+        // Rescan all the watched directories when the kernel event queue overflowed.
+        bool recoverFromOverflow();
 
         bool findSubFolders(const SyncPath &dir, std::list<SyncPath> &fullList);
         ExitInfo inotifyRegisterPath(const SyncPath &path);
         ExitInfo addFolderRecursive(const SyncPath &path);
         void removeFoldersBelow(const SyncPath &dirPath);
+        // Update the paths of the watches after a directory move, the watches themselves follow the moved directories.
+        void renameFoldersBelow(const SyncPath &oldDirPath, const SyncPath &newDirPath);
+        std::list<std::map<std::string, int>::iterator> watchesBelow(const SyncPath &dirPath);
         struct AddWatchOutcome {
                 std::int64_t returnValue{0};
                 std::int64_t errorNumber{0};
         };
         virtual AddWatchOutcome inotifyAddWatch(const SyncPath &path);
 
-        ExitInfo changeDetected(const SyncPath &path, OperationType opType) const;
+        virtual ExitInfo changesDetected(const ChangeList &changes);
+        virtual ExitInfo rescanDirectories(const std::list<SyncPath> &dirPaths);
 
         std::unordered_map<int, SyncPath> _watchToPath;
         std::map<std::string, int> _pathToWatch;
 
+        struct MoveFrom {
+                SyncPath path;
+                bool isDirectory = false;
+                std::chrono::steady_clock::time_point time;
+        };
+        // Sources of the moves whose destination event has not been read yet, by cookie
+        std::map<std::uint32_t, MoveFrom> _pendingMovesFrom;
+
         static SyncPath makeSyncPath(const SyncPath &path, const char *name);
 
         friend class TestFolderWatcherLinux;
@@ -32,7 +32,11 @@
 
 #include <log4cplus/loggingmacros.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 
 namespace KDC {
 
@@ -117,6 +121,7 @@ ExitInfo LocalFileSystemObserverWorker::changesDetected(const std::list<std::pai
                     IoHelper::checkIfPathExistsWithSameNodeId(absolutePath, prevNodeId, existsWithSameId, otherNodeId, checkError,
                                                               IoHelper::PathCheckOption::Insensitive) &&
                     !existsWithSameId) {
+                    invalidateChecksumCache(prevNodeId);
                     if (!_liveSnapshot.removeItem(prevNodeId)) {
                         LOGW_SYNCPAL_WARN(_logger, L"Failed to remove item: " << Utility::formatSyncPath(absolutePath) << L" ("
                                                                               << CommonUtility::s2ws(prevNodeId) << L")");
@@ -184,6 +189,11 @@ ExitInfo LocalFileSystemObserverWorker::changesDetected(const std::list<std::pai
         const auto nodeType = itemType.nodeType;
         auto isLink = itemType.linkType != LinkType::None;
 
+        if (nodeType == NodeType::File) {
+            // The OS operation type is not reliable on all platforms, any event might hide a content change
+            invalidateChecksumCache(nodeId);
+        }
+
         // Check if the item is excluded by a file exclusion rule
         if (bool isWarning = false; ExclusionTemplateCache::instance()->isExcluded(relativePath, isWarning)) {
             if (isWarning) {
@@ -290,6 +300,7 @@ ExitInfo LocalFileSystemObserverWorker::changesDetected(const std::list<std::pai
                     return exitInfo;
                 }
 
+                invalidateChecksumCache(itemId);
                 if (!_liveSnapshot.removeItem(itemId)) {
                     LOGW_SYNCPAL_WARN(_logger, L"Failed to remove item: " << Utility::formatSyncPath(absolutePath) << L" ("
                                                                           << CommonUtility::s2ws(itemId) << L")");
@@ -447,6 +458,8 @@ void LocalFileSystemObserverWorker::execute() {
 
     // Sync loop
     for (;;) {
+        flushChecksumCacheInvalidations();
+
         if (stopAsked()) {
             exitInfo = ExitCode::Ok;
             invalidateSnapshot();
@@ -490,10 +503,14 @@ void LocalFileSystemObserverWorker::execute() {
 
                 const std::scoped_lock lock(_recursiveMutex);
                 _updating = false;
+                _syncPal->notifySyncPalWorker(); // No change for a while, a sync can start
             }
         }
 
-        if (_initializing) _initializing = false;
+        if (_initializing) {
+            _initializing = false;
+            _syncPal->notifySyncPalWorker();
+        }
         Utility::msleep(LOOP_EXEC_SLEEP_PERIOD);
     }
     LOG_SYNCPAL_DEBUG(_logger, "Worker stopped: name=" << name());
@@ -511,7 +528,17 @@ ExitInfo LocalFileSystemObserverWorker::generateInitialSnapshot() {
     _liveSnapshot.init();
     _updating = true;
 
-    if (const auto exitInfo = exploreDir(_rootFolder); exitInfo.code() == ExitCode::Ok && !stopAsked()) {
+    // The checksums of the files unchanged since they were hashed are read from the cache during the exploration
+    flushChecksumCacheInvalidations();
+    if (!_syncPal->syncDb()->selectAllChecksumCacheEntries(_checksumCache)) {
+        LOG_SYNCPAL_WARN(_logger, "Error in SyncDb::selectAllChecksumCacheEntries");
+        _checksumCache.clear();
+    }
+
+    const auto exploreExitInfo = exploreTree(_rootFolder, *_syncPal->syncDb()->rootNode().nodeIdLocal());
+    _checksumCache.clear();
+
+    if (exploreExitInfo.code() == ExitCode::Ok && !stopAsked()) {
         _liveSnapshot.setValid(true);
         LOG_SYNCPAL_INFO(_logger, "Local snapshot generated in: " << timer.elapsed<DoubleSeconds>().count() << "s for "
                                                                   << _liveSnapshot.nbItems() << " items");
@@ -520,8 +547,8 @@ ExitInfo LocalFileSystemObserverWorker::generateInitialSnapshot() {
         LOG_SYNCPAL_INFO(_logger, "Local snapshot generation stopped after: " << timer.elapsed<DoubleSeconds>().count() << "s");
     } else {
         LOG_SYNCPAL_WARN(_logger, "Local snapshot generation failed after: " << timer.elapsed<DoubleSeconds>().count()
-                                                                             << "s: " << exitInfo);
-        mainExitInfo = exitInfo;
+                                                                             << "s: " << exploreExitInfo);
+        mainExitInfo = exploreExitInfo;
     }
 
     const std::scoped_lock lock(_recursiveMutex);
@@ -536,10 +563,68 @@ ExitInfo LocalFileSystemObserverWorker::generateInitialSnapshot() {
     }
 
     _updating = false;
+    _syncPal->notifySyncPalWorker();
 
     return mainExitInfo;
 }
 
+ExitInfo LocalFileSystemObserverWorker::rescanDirectories(const std::list<SyncPath> &absoluteDirPaths) {
+    const std::scoped_lock lock(_recursiveMutex);
+
+    // All deletions are reported first so that an item moved from one rescanned folder to another is not seen as unchanged
+    std::list<std::pair<SyncPath, OperationType>> deletions;
+    std::list<std::pair<SyncPath, OperationType>> changes;
+    for (const auto &absoluteDirPath: absoluteDirPaths) {
+        if (stopAsked()) return ExitCode::Ok;
+
+        if (_liveSnapshot.isValid()) {
+            NodeId dirNodeId;
+            if (absoluteDirPath == _rootFolder) {
+                dirNodeId = _liveSnapshot.rootFolderId();
+            } else if (const auto exitInfo =
+                               _liveSnapshot.getItemId(CommonUtility::relativePath(_syncPal->localPath(), absoluteDirPath),
+                                                       dirNodeId);
+                       !exitInfo) {
+                if (exitInfo.cause() != ExitCause::NotFound) {
+                    LOGW_SYNCPAL_WARN(_logger, L"Error in Snapshot::getItemId: " << Utility::formatSyncPath(absoluteDirPath)
+                                                                                 << L" : " << exitInfo);
+                    return exitInfo;
+                }
+
+                // The folder itself is unknown, it will be explored entirely
+                (void) changes.emplace_back(absoluteDirPath, OperationType::Create);
+                continue;
+            }
+
+            NodeSet childrenIds;
+            (void) _liveSnapshot.getChildrenIds(dirNodeId, childrenIds);
+            for (const auto &childId: childrenIds) {
+                const SyncPath childPath = absoluteDirPath / _liveSnapshot.name(childId);
+                if (std::error_code ec; !std::filesystem::exists(childPath, ec) && !ec) {
+                    (void) deletions.emplace_back(childPath, OperationType::Delete);
+                }
+            }
+        }
+
+        // Items with an unchanged size and modification date are filtered out by `changesDetected`
+        std::error_code ec;
+        for (auto dirIt = std::filesystem::directory_iterator(absoluteDirPath, ec);
+             !ec && dirIt != std::filesystem::directory_iterator(); dirIt.increment(ec)) {
+            (void) changes.emplace_back(dirIt->path(), OperationType::Edit);
+        }
+
+        if (ec && ec != std::errc::no_such_file_or_directory) {
+            LOGW_SYNCPAL_WARN(_logger, L"Failed to list " << Utility::formatStdError(absoluteDirPath, ec));
+        }
+    }
+
+    LOG_SYNCPAL_DEBUG(_logger, "Rescan of " << absoluteDirPaths.size() << " folders: " << deletions.size() << " deletions and "
+                                            << changes.size() << " items to check");
+
+    deletions.splice(deletions.end(), changes);
+    return changesDetected(deletions);
+}
+
 bool LocalFileSystemObserverWorker::canComputeChecksum(const SyncPath &absolutePath) {
     VfsStatus vfsStatus;
     if (const auto exitInfo = _syncPal->vfs()->status(absolutePath, vfsStatus); !exitInfo) {
@@ -550,6 +635,34 @@ bool LocalFileSystemObserverWorker::canComputeChecksum(const SyncPath &absoluteP
     return !vfsStatus.isPlaceholder || (vfsStatus.isHydrated && !vfsStatus.isSyncing);
 }
 
+void LocalFileSystemObserverWorker::invalidateChecksumCache(const NodeId &nodeId) {
+    const std::scoped_lock lock(_checksumCacheInvalidationsMutex);
+    (void) _checksumCacheInvalidations.insert(nodeId);
+}
+
+void LocalFileSystemObserverWorker::flushChecksumCacheInvalidations() {
+    NodeSet nodeIds;
+    {
+        const std::scoped_lock lock(_checksumCacheInvalidationsMutex);
+        std::swap(nodeIds, _checksumCacheInvalidations);
+    }
+
+    if (!_syncPal->syncDb()->deleteChecksumCacheEntries(nodeIds)) {
+        LOG_SYNCPAL_WARN(_logger, "Error in SyncDb::deleteChecksumCacheEntries");
+    }
+}
+
+void LocalFileSystemObserverWorker::setCachedChecksum(SnapshotItem &item, const FileStat &fileStat) const {
+    if (item.type() != NodeType::File || item.isLink()) return;
+
+    if (const auto it = _checksumCache.find(item.id()); it != _checksumCache.end()) {
+        if (const auto &entry = it->second; entry.size == fileStat.size && entry.modificationTime == fileStat.modificationTime &&
+                                            entry.changeTime == fileStat.changeTime) {
+            item.setContentChecksum(entry.checksum);
+        }
+    }
+}
+
 #if defined(KD_MACOS)
 
 ExitCode LocalFileSystemObserverWorker::isEditValid(const NodeId &nodeId, const SyncPath &path, SyncTime lastModifiedLocal,
@@ -646,32 +759,146 @@ ExitInfo LocalFileSystemObserverWorker::handleIoError(const SyncPath &relativePa
     return ExitCode::Ok;
 }
 
-ExitInfo LocalFileSystemObserverWorker::exploreDir(const SyncPath &absoluteParentDirPath, bool fromChangeDetected) {
-    // Check if root dir exists
+ExitInfo LocalFileSystemObserverWorker::checkExplorationRoot(const SyncPath &absoluteDirPath, bool &isLink) {
+    isLink = false;
+
     ItemType itemType;
-    if (!IoHelper::getItemType(absoluteParentDirPath, itemType)) {
-        LOGW_WARN(_logger,
-                  L"Error in IoHelper::getItemType: " << Utility::formatIoError(absoluteParentDirPath, itemType.ioError));
+    if (!IoHelper::getItemType(absoluteDirPath, itemType)) {
+        LOGW_WARN(_logger, L"Error in IoHelper::getItemType: " << Utility::formatIoError(absoluteDirPath, itemType.ioError));
         return ExitCode::SystemError;
     }
 
     if (itemType.ioError == IoError::NoSuchFileOrDirectory) {
-        LOGW_SYNCPAL_WARN(_logger, L"Local " << Utility::formatSyncPath(absoluteParentDirPath) << L" doesn't exist");
-        return {ExitCode::SystemError, Utility::exitCauseFromInaccessibleSyncDirectory(absoluteParentDirPath)};
+        LOGW_SYNCPAL_WARN(_logger, L"Local " << Utility::formatSyncPath(absoluteDirPath) << L" doesn't exist");
+        return {ExitCode::SystemError, Utility::exitCauseFromInaccessibleSyncDirectory(absoluteDirPath)};
     }
 
     if (itemType.ioError == IoError::AccessDenied) {
-        LOGW_SYNCPAL_WARN(_logger, L"Local " << Utility::formatSyncPath(absoluteParentDirPath) << L" misses read permission");
+        LOGW_SYNCPAL_WARN(_logger, L"Local " << Utility::formatSyncPath(absoluteDirPath) << L" misses read permission");
         return {ExitCode::SystemError, ExitCause::SyncDirAccessError};
     }
 
-    if (itemType.linkType != LinkType::None) {
+    isLink = itemType.linkType != LinkType::None;
+    return ExitCode::Ok;
+}
+
+bool LocalFileSystemObserverWorker::checkExploredEntry(const DirectoryEntry &entry, ItemType &itemType, FileStat &fileStat) {
+    const auto &absolutePath = entry.path();
+    const auto relativePath = CommonUtility::relativePath(_syncPal->localPath(), absolutePath);
+
+    bool itemTypeFound = false;
+#if defined(KD_LINUX)
+    // The type of an item which is not a symlink is already known from the directory entry (d_type)
+    if (std::error_code ec; !entry.is_symlink(ec) && !ec) {
+        const bool isDirectory = entry.is_directory(ec);
+        if (!ec) {
+            itemType = ItemType();
+            itemType.nodeType = isDirectory ? NodeType::Directory : NodeType::File;
+            itemTypeFound = true;
+        }
+    }
+#endif
+
+    if (!itemTypeFound && !IoHelper::getItemType(absolutePath, itemType)) {
+        LOGW_SYNCPAL_DEBUG(_logger,
+                           L"Error in IoHelper::getItemType: " << Utility::formatIoError(absolutePath, itemType.ioError));
+        return false;
+    }
+
+    if (itemType.ioError == IoError::AccessDenied) {
+        LOGW_SYNCPAL_DEBUG(_logger, L"getItemType failed for item: " << Utility::formatIoError(absolutePath, itemType.ioError)
+                                                                     << L". Blacklisting it temporarily");
+        sendAccessDeniedError(relativePath);
+    }
+
+    // Check if the directory entry is managed
+    bool isManaged = false;
+    auto entryIoError = IoError::Success;
+    if (!Utility::checkIfDirEntryIsManaged(entry, isManaged, entryIoError, itemType)) {
+        LOGW_SYNCPAL_WARN(_logger, L"Error in Utility::checkIfDirEntryIsManaged: "
+                                           << Utility::formatIoError(absolutePath.parent_path(), entryIoError));
+        return false;
+    }
+    if (entryIoError == IoError::NoSuchFileOrDirectory) {
+        LOGW_SYNCPAL_DEBUG(_logger, L"Directory entry does not exist anymore: "
+                                            << Utility::formatIoError(absolutePath.parent_path(), entryIoError));
+        return false;
+    }
+    if (entryIoError == IoError::AccessDenied) {
+        LOGW_SYNCPAL_DEBUG(_logger, L"Directory misses search permission: "
+                                            << Utility::formatIoError(absolutePath.parent_path(), entryIoError));
+        sendAccessDeniedError(relativePath);
+        return false;
+    }
+
+    if (!isManaged) {
+        LOGW_SYNCPAL_DEBUG(_logger, L"Directory entry is not managed: " << Utility::formatSyncPath(absolutePath));
+        return false;
+    }
+
+    // Check template exclusion
+    if (ExclusionTemplateCache::instance()->isExcluded(relativePath)) {
+        LOGW_SYNCPAL_INFO(_logger, L"Item: " << Utility::formatSyncPath(absolutePath) << L" rejected because it is excluded");
+        return false;
+    }
+
+    if (!IoHelper::getFileStat(absolutePath, &fileStat, entryIoError, IoHelper::PathCheckOption::Insensitive)) {
+        LOGW_SYNCPAL_DEBUG(_logger, L"Error in IoHelper::getFileStat: " << Utility::formatIoError(absolutePath, entryIoError));
+        return false;
+    }
+
+    if (entryIoError == IoError::NoSuchFileOrDirectory) {
+        LOGW_SYNCPAL_DEBUG(_logger, L"Directory entry does not exist anymore: " << Utility::formatSyncPath(absolutePath));
+        return false;
+    } else if (entryIoError == IoError::AccessDenied) {
+        LOGW_SYNCPAL_INFO(_logger, L"Item: " << Utility::formatSyncPath(absolutePath) << L" rejected because access is denied");
+        sendAccessDeniedError(relativePath);
+        return false;
+    }
+
+    return true;
+}
+
+ExitInfo LocalFileSystemObserverWorker::explorationExitInfo(IoError ioError, NodeType nodeType, const SyncPath &absolutePath) {
+    ExitInfo res = ExitCode::Ok;
+    switch (ioError) {
+        case IoError::Success:
+            res = {ExitCode::Ok};
+            break;
+        case IoError::AccessDenied:
+            res = {ExitCode::SystemError, ExitCause::FileAccessError};
+            break;
+        case IoError::FileOrDirectoryCorrupted:
+            res = {ExitCode::SystemError, ExitCause::FileOrDirectoryCorrupted};
+            break;
+        default:
+            res = {ExitCode::SystemError};
+            break;
+    }
+
+    if (!res) {
+        _syncPal->addError(Error(_syncPal->syncDbId(), "", "", nodeType,
+                                 CommonUtility::relativePath(_syncPal->localPath(), absolutePath), ConflictType::None,
+                                 InconsistencyType::None, CancelType::None, "", res.code(), res.cause()));
+    }
+    return res;
+}
+
+ExitInfo LocalFileSystemObserverWorker::exploreDir(const SyncPath &absoluteParentDirPath, bool fromChangeDetected) {
+    // Check if root dir exists
+    bool isRootLink = false;
+    if (const auto exitInfo = checkExplorationRoot(absoluteParentDirPath, isRootLink); !exitInfo) {
+        return exitInfo;
+    }
+
+    if (isRootLink) {
         return ExitCode::Ok;
     }
 
     // Process all files
     auto ioError = IoError::Success;
     DirectoryEntry entry;
+    ItemType itemType;
     try {
         IoHelper::DirectoryIterator dirIt;
         if (!IoHelper::getRecursiveDirectoryIterator(absoluteParentDirPath, ioError, dirIt, false)) {
@@ -700,87 +927,15 @@ ExitInfo LocalFileSystemObserverWorker::exploreDir(const SyncPath &absoluteParen
             const auto &absolutePath = entry.path();
             const auto relativePath = CommonUtility::relativePath(_syncPal->localPath(), absolutePath);
 
-            if (!IoHelper::getItemType(absolutePath, itemType)) {
-                LOGW_SYNCPAL_DEBUG(_logger,
-                                   L"Error in IoHelper::getItemType: " << Utility::formatIoError(absolutePath, itemType.ioError));
+            FileStat fileStat;
+            if (!checkExploredEntry(entry, itemType, fileStat)) {
                 dirIt.disableRecursionPending();
                 continue;
             }
-            if (itemType.ioError == IoError::AccessDenied) {
-                LOGW_SYNCPAL_DEBUG(_logger, L"getItemType failed for item: "
-                                                    << Utility::formatIoError(absolutePath, itemType.ioError)
-                                                    << L". Blacklisting it temporarily");
-                sendAccessDeniedError(relativePath);
-            }
 
-            bool toExclude = false;
+            const NodeId nodeId = std::to_string(fileStat.inode);
             const bool isLink = itemType.linkType != LinkType::None;
-
-            // Check if the directory entry is managed
-            bool isManaged = false;
             auto entryIoError = IoError::Success;
-            if (!Utility::checkIfDirEntryIsManaged(entry, isManaged, entryIoError, itemType)) {
-                LOGW_SYNCPAL_WARN(_logger, L"Error in Utility::checkIfDirEntryIsManaged: "
-                                                   << Utility::formatIoError(absoluteParentDirPath, entryIoError));
-                dirIt.disableRecursionPending();
-                continue;
-            }
-            if (entryIoError == IoError::NoSuchFileOrDirectory) {
-                LOGW_SYNCPAL_DEBUG(_logger, L"Directory entry does not exist anymore: "
-                                                    << Utility::formatIoError(absoluteParentDirPath, entryIoError));
-                dirIt.disableRecursionPending();
-                continue;
-            }
-            if (entryIoError == IoError::AccessDenied) {
-                LOGW_SYNCPAL_DEBUG(_logger, L"Directory misses search permission: "
-                                                    << Utility::formatIoError(absoluteParentDirPath, entryIoError));
-                dirIt.disableRecursionPending();
-                sendAccessDeniedError(relativePath);
-                continue;
-            }
-
-            if (!isManaged) {
-                LOGW_SYNCPAL_DEBUG(_logger, L"Directory entry is not managed: " << Utility::formatSyncPath(absolutePath));
-                toExclude = true;
-            }
-
-            if (!toExclude) {
-                // Check template exclusion
-                if (ExclusionTemplateCache::instance()->isExcluded(relativePath)) {
-                    LOGW_SYNCPAL_INFO(_logger,
-                                      L"Item: " << Utility::formatSyncPath(absolutePath) << L" rejected because it is excluded");
-                    toExclude = true;
-                }
-            }
-
-            NodeId nodeId;
-            FileStat fileStat;
-            if (!toExclude) {
-                if (!IoHelper::getFileStat(absolutePath, &fileStat, entryIoError, IoHelper::PathCheckOption::Insensitive)) {
-                    LOGW_SYNCPAL_DEBUG(_logger,
-                                       L"Error in IoHelper::getFileStat: " << Utility::formatIoError(absolutePath, entryIoError));
-                    dirIt.disableRecursionPending();
-                    continue;
-                }
-
-                if (entryIoError == IoError::NoSuchFileOrDirectory) {
-                    LOGW_SYNCPAL_DEBUG(_logger,
-                                       L"Directory entry does not exist anymore: " << Utility::formatSyncPath(absolutePath));
-                    dirIt.disableRecursionPending();
-                    continue;
-                } else if (entryIoError == IoError::AccessDenied) {
-                    LOGW_SYNCPAL_INFO(
-                            _logger, L"Item: " << Utility::formatSyncPath(absolutePath) << L" rejected because access is denied");
-                    sendAccessDeniedError(relativePath);
-                    toExclude = true;
-                }
-                nodeId = std::to_string(fileStat.inode);
-            }
-
-            if (toExclude) {
-                dirIt.disableRecursionPending();
-                continue;
-            }
 
             // Get parent folder id
             NodeId parentNodeId;
@@ -845,29 +1000,124 @@ ExitInfo LocalFileSystemObserverWorker::exploreDir(const SyncPath &absoluteParen
         return ExitCode::SystemError;
     }
 
+    return explorationExitInfo(ioError, itemType.nodeType, entry.path());
+}
 
-    ExitInfo res = ExitCode::Ok;
-    switch (ioError) {
-        case IoError::Success:
-            res = {ExitCode::Ok};
-            break;
-        case IoError::AccessDenied:
-            res = {ExitCode::SystemError, ExitCause::FileAccessError};
-            break;
-        case IoError::FileOrDirectoryCorrupted:
-            res = {ExitCode::SystemError, ExitCause::FileOrDirectoryCorrupted};
-            break;
-        default:
-            res = {ExitCode::SystemError};
-            break;
+ExitInfo LocalFileSystemObserverWorker::exploreTree(const SyncPath &absoluteRootPath, const NodeId &rootNodeId) {
+    bool isRootLink = false;
+    if (const auto exitInfo = checkExplorationRoot(absoluteRootPath, isRootLink); !exitInfo) {
+        return exitInfo;
     }
 
-    if (!res) {
-        _syncPal->addError(Error(_syncPal->syncDbId(), "", "", itemType.nodeType,
-                                 CommonUtility::relativePath(_syncPal->localPath(), entry.path()), ConflictType::None,
-                                 InconsistencyType::None, CancelType::None, "", res.code(), res.cause()));
+    if (isRootLink) {
+        return ExitCode::Ok;
     }
-    return res;
+
+    // The folders waiting to be explored are shared by all threads. They are explored depth-first to keep this list short.
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<ExploredFolder> pendingFolders{{absoluteRootPath, rootNodeId}};
+    std::size_t busyThreadCount = 0;
+    ExitInfo mainExitInfo = ExitCode::Ok;
+
+    const std::function<void()> exploreFolders = [&]() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            cv.wait(lock, [&]() { return !pendingFolders.empty() || busyThreadCount == 0 || !mainExitInfo; });
+            if (pendingFolders.empty() || !mainExitInfo || stopAsked()) {
+                break;
+            }
+
+            const auto folder = std::move(pendingFolders.back());
+            pendingFolders.pop_back();
+            ++busyThreadCount;
+            lock.unlock();
+
+            std::vector<ExploredFolder> subFolders;
+            const auto exitInfo = exploreTreeFolder(folder, subFolders);
+
+            lock.lock();
+            --busyThreadCount;
+            if (!exitInfo) {
+                if (mainExitInfo) mainExitInfo = exitInfo;
+            } else {
+                std::move(subFolders.begin(), subFolders.end(), std::back_inserter(pendingFolders));
+            }
+            cv.notify_all();
+        }
+        cv.notify_all();
+    };
+
+    const auto threadCount =
+            std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, static_cast<int>(maxExplorationThreads));
+    std::vector<std::unique_ptr<StdLoggingThread>> threads;
+    for (int i = 1; i < threadCount; ++i) {
+        threads.push_back(std::make_unique<StdLoggingThread>(exploreFolders));
+    }
+    exploreFolders();
+    for (const auto &thread: threads) {
+        thread->join();
+    }
+
+    return mainExitInfo;
+}
+
+ExitInfo LocalFileSystemObserverWorker::exploreTreeFolder(const ExploredFolder &folder, std::vector<ExploredFolder> &subFolders) {
+    auto ioError = IoError::Success;
+    IoHelper::DirectoryIterator dirIt;
+    if (!IoHelper::getDirectoryIterator(folder.path, false, ioError, dirIt, false)) {
+        if (ioError == IoError::NoSuchFileOrDirectory && folder.path != _rootFolder) {
+            // The folder has been deleted in the meantime
+            return ExitCode::Ok;
+        }
+
+        LOGW_SYNCPAL_WARN(_logger,
+                          L"Error in IoHelper::getDirectoryIterator: Local " << Utility::formatIoError(folder.path, ioError));
+        return explorationExitInfo(ioError, NodeType::Directory, folder.path);
+    }
+
+    std::vector<SnapshotItem> items;
+    DirectoryEntry entry;
+    bool endOfDirectory = false;
+    while (dirIt.next(entry, endOfDirectory, ioError) && !endOfDirectory) {
+        if (stopAsked()) {
+            return ExitCode::Ok;
+        }
+
+        ItemType itemType;
+        FileStat fileStat;
+        if (!checkExploredEntry(entry, itemType, fileStat)) {
+            continue;
+        }
+
+        auto &item = items.emplace_back(std::to_string(fileStat.inode), folder.nodeId, entry.path().filename().native(),
+                                        fileStat.creationTime, fileStat.modificationTime, itemType.nodeType, fileStat.size,
+                                        itemType.linkType != LinkType::None, true, true);
+        setCachedChecksum(item, fileStat);
+        if (ParametersCache::isExtendedLogEnabled()) {
+            LOGW_SYNCPAL_DEBUG(_logger, L"Item found: " << Utility::formatSyncPath(entry.path()) << L" inode:"
+                                                        << CommonUtility::s2ws(item.id()) << L" parent inode:"
+                                                        << CommonUtility::s2ws(folder.nodeId));
+        }
+
+        // A link is never explored, its type is `NodeType::File`
+        if (itemType.nodeType == NodeType::Directory) {
+            subFolders.push_back({entry.path(), item.id()});
+        }
+    }
+
+    if (ioError != IoError::Success) {
+        LOGW_SYNCPAL_WARN(_logger, L"Error while iterating over " << Utility::formatIoError(folder.path, ioError));
+        return explorationExitInfo(ioError, NodeType::Directory, folder.path);
+    }
+
+    // The folder is inserted by its parent before its children are explored
+    if (!_liveSnapshot.updateItems(items)) {
+        LOGW_SYNCPAL_WARN(_logger, L"Failed to insert the children of " << Utility::formatSyncPath(folder.path)
+                                                                        << L" into local snapshot.");
+    }
+
+    return ExitCode::Ok;
 }
 
 } // namespace KDC
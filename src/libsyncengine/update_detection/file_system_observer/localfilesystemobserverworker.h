@@ -23,6 +23,9 @@
 
 namespace KDC {
 
+struct FileStat;
+class SnapshotItem;
+
 class LocalFileSystemObserverWorker : public FileSystemObserverWorker {
     public:
         LocalFileSystemObserverWorker(std::shared_ptr<SyncPal> syncPal, const std::string &name, const std::string &shortName);
@@ -32,12 +35,25 @@ class LocalFileSystemObserverWorker : public FileSystemObserverWorker {
         void stop() override;
 
         virtual ExitInfo changesDetected(const std::list<std::pair<SyncPath, OperationType>> &changes);
+        /**
+         * @brief Bring the children of the specified folders up to date in the live snapshot, when the file system events
+         * concerning them might have been lost.
+         * @param absoluteDirPaths The absolute paths of the folders to rescan. They are not rescanned recursively.
+         */
+        ExitInfo rescanDirectories(const std::list<SyncPath> &absoluteDirPaths);
         virtual void forceUpdate() override;
 
     protected:
         virtual void execute() override;
 
         ExitInfo exploreDir(const SyncPath &absoluteParentDirPath, bool fromChangeDetected = false);
+        /**
+         * @brief Explore the whole tree below `absoluteRootPath` with several threads and insert its items into the live
+         * snapshot. Unlike `exploreDir`, the ID of each folder is known when its children are listed.
+         * @param absoluteRootPath The absolute path of the root folder, which is not inserted itself.
+         * @param rootNodeId The ID of the root folder.
+         */
+        ExitInfo exploreTree(const SyncPath &absoluteRootPath, const NodeId &rootNodeId);
 
         SyncPath _rootFolder;
         //    std::unique_ptr<ContentChecksumWorker> _checksumWorker = nullptr;
@@ -47,7 +63,32 @@ class LocalFileSystemObserverWorker : public FileSystemObserverWorker {
         virtual ExitInfo generateInitialSnapshot() override;
         virtual ReplicaSide getSnapshotType() const override { return ReplicaSide::Local; }
 
+        struct ExploredFolder {
+                SyncPath path;
+                NodeId nodeId;
+        };
+        static constexpr unsigned int maxExplorationThreads = 8;
+
+        ExitInfo checkExplorationRoot(const SyncPath &absoluteDirPath, bool &isLink);
+        /**
+         * @brief Run the checks applied to each item found during an exploration.
+         * @param entry The directory entry of the item.
+         * @param itemType Set with the type of the item.
+         * @param fileStat Set with the status of the item.
+         * @return true if the item must be inserted in the snapshot, false if it must be ignored along with its content.
+         */
+        bool checkExploredEntry(const DirectoryEntry &entry, ItemType &itemType, FileStat &fileStat);
+        ExitInfo explorationExitInfo(IoError ioError, NodeType nodeType, const SyncPath &absolutePath);
+        // Insert the children of `folder` into the live snapshot and list its subfolders.
+        ExitInfo exploreTreeFolder(const ExploredFolder &folder, std::vector<ExploredFolder> &subFolders);
+
         bool canComputeChecksum(const SyncPath &absolutePath);
+        // Queue the removal of the cached content checksum of an item reported as changed by the OS.
+        void invalidateChecksumCache(const NodeId &nodeId);
+        // Remove the queued entries from the checksum cache. Called by the worker loop, not by the folder watcher thread.
+        void flushChecksumCacheInvalidations();
+        // Set the cached content checksum of an explored file if the file is unchanged since it was hashed.
+        void setCachedChecksum(SnapshotItem &item, const FileStat &fileStat) const;
 
 #if defined(KD_MACOS)
         ExitCode isEditValid(const NodeId &nodeId, const SyncPath &path, SyncTime lastModifiedLocal, int64_t sizeLocal,
@@ -62,7 +103,12 @@ class LocalFileSystemObserverWorker : public FileSystemObserverWorker {
 
         std::recursive_mutex _recursiveMutex;
 
+        std::mutex _checksumCacheInvalidationsMutex;
+        NodeSet _checksumCacheInvalidations;
+        SyncDb::ChecksumCacheMap _checksumCache; // Only loaded during the initial snapshot generation
+
         friend class TestLocalFileSystemObserverWorker;
+        friend class BenchmarkLocalExploration;
 };
 
 } // namespace KDC
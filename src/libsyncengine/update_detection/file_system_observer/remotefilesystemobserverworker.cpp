@@ -24,6 +24,7 @@
 #include "jobs/network/kDrive_API/listing/csvfullfilelistwithcursorjob.h"
 #include "jobs/network/kDrive_API/listing/longpolljob.h"
 #include "jobs/network/kDrive_API/getfileinfojob.h"
+#include "update_detection/file_system_observer/snapshot/snapshotfile.h"
 #if defined(KD_WINDOWS)
 #include "reconciliation/platform_inconsistency_checker/platforminconsistencycheckerutility.h"
 #endif
@@ -34,6 +35,7 @@
 #include "requests/parameterscache.h"
 #include "requests/exclusiontemplatecache.h"
 #include "libcommonserver/utility/jsonparserutility.h"
+#include "libcommonserver/io/iohelper.h"
 
 #if defined(KD_MACOS)
 #include "utility/utility.h"
@@ -67,6 +69,7 @@ void RemoteFileSystemObserverWorker::execute() {
     for (;;) {
         if (stopAsked()) {
             exitInfo = ExitCode::Ok;
+            saveSnapshot();
             tryToInvalidateSnapshot();
             break;
         }
@@ -83,7 +86,10 @@ void RemoteFileSystemObserverWorker::execute() {
             LOG_SYNCPAL_DEBUG(_logger, "Error in processEvents: " << exitInfo);
             break;
         }
-        _initializing = false;
+        if (_initializing) {
+            _initializing = false;
+            _syncPal->notifySyncPalWorker();
+        }
         Utility::msleep(LOOP_EXEC_SLEEP_PERIOD);
     }
     LOG_SYNCPAL_DEBUG(_logger, "Worker stopped: name=" << name());
@@ -103,17 +109,24 @@ ExitInfo RemoteFileSystemObserverWorker::generateInitialSnapshot() {
 
     _liveSnapshot.init();
     _updating = true;
-    countListingRequests();
+    _snapshotMatchesCursor = false;
+    _snapshotFingerprint = snapshotFingerprint();
 
-    exitInfo = initWithCursor();
+    bool loaded = false;
+    exitInfo = loadSavedSnapshot(loaded);
+    if (exitInfo && !loaded && !stopAsked()) {
+        countListingRequests();
+        exitInfo = initWithCursor();
+    }
 
     const auto end = std::chrono::steady_clock::now();
     const std::chrono::duration<double> elapsedSeconds = end - start;
 
     if (exitInfo && !stopAsked()) {
         _liveSnapshot.setValid(true);
-        LOG_SYNCPAL_INFO(_logger, "Remote snapshot generated in: " << elapsedSeconds.count() << "s for "
-                                                                   << _liveSnapshot.nbItems() << " items");
+        _snapshotMatchesCursor = true;
+        LOG_SYNCPAL_INFO(_logger, "Remote snapshot " << (loaded ? "loaded" : "generated") << " in: " << elapsedSeconds.count()
+                                                     << "s for " << _liveSnapshot.nbItems() << " items");
         perfMonitor.stop();
     } else {
         tryToInvalidateSnapshot();
@@ -132,6 +145,7 @@ ExitInfo RemoteFileSystemObserverWorker::generateInitialSnapshot() {
         }
     }
     _updating = false;
+    _syncPal->notifySyncPalWorker(); // A sync can start once the snapshot is up to date
 
     return exitInfo;
 }
@@ -163,6 +177,7 @@ ExitInfo RemoteFileSystemObserverWorker::processEvents() {
 
     // Retrieve changes
     _updating = true;
+    _snapshotMatchesCursor = false;
     ExitInfo exitInfo = ExitCode::Ok;
     bool hasMore = true;
     while (hasMore) {
@@ -251,10 +266,122 @@ ExitInfo RemoteFileSystemObserverWorker::processEvents() {
     }
 
     _updating = false;
+    _snapshotMatchesCursor = exitInfo && !stopAsked();
+    _syncPal->notifySyncPalWorker();
 
     return exitInfo;
 }
 
+ExitInfo RemoteFileSystemObserverWorker::loadSavedSnapshot(bool &loaded) {
+    loaded = false;
+
+    const SyncPath filePath = savedSnapshotPath();
+    bool exists = false;
+    if (IoError ioError = IoError::Success;
+        !IoHelper::checkIfPathExists(filePath, exists, ioError, IoHelper::PathCheckOption::Sensitive) || !exists) {
+        return ExitCode::Ok;
+    }
+
+    SnapshotFile::Header header;
+    std::vector<SnapshotItem> items;
+    bool usable = SnapshotFile::load(filePath, header, items);
+    if (usable && (header.rootFolderId != _liveSnapshot.rootFolderId() || header.fingerprint != _snapshotFingerprint ||
+                   header.cursor.empty())) {
+        LOG_SYNCPAL_INFO(_logger, "The saved remote snapshot does not match the current sync settings");
+        usable = false;
+    }
+    if (usable && !_liveSnapshot.updateItems(items)) {
+        LOG_SYNCPAL_WARN(_logger, "Failed to insert the saved items in the remote snapshot");
+        usable = false;
+    }
+    items.clear();
+
+    if (!usable) {
+        _liveSnapshot.init();
+        (void) IoHelper::deleteItem(filePath);
+        return ExitCode::Ok;
+    }
+
+    // Catch up with the changes made since the snapshot was saved.
+    if (const auto exitInfo = _syncPal->setListingCursor(header.cursor, static_cast<int64_t>(time(0))); !exitInfo) {
+        LOG_SYNCPAL_WARN(_logger, "Error in SyncPal::setListingCursor: " << exitInfo);
+        _liveSnapshot.init();
+        return exitInfo;
+    }
+
+    const ExitInfo exitInfo = processEvents();
+    _updating = true;
+    if (stopAsked()) {
+        // The file still matches its cursor, keep it for the next start.
+        _liveSnapshot.init();
+        return ExitCode::Ok;
+    }
+
+    switch (exitInfo.code()) {
+        case ExitCode::Ok:
+            loaded = true;
+            break;
+        case ExitCode::NetworkError:
+        case ExitCode::RateLimited:
+        case ExitCode::SystemError:
+        case ExitCode::DbError:
+            // Transient failure, the saved snapshot can be used on the next attempt.
+            _liveSnapshot.init();
+            return exitInfo;
+        default:
+            // Most likely an expired cursor.
+            LOG_SYNCPAL_INFO(_logger,
+                             "Failed to update the saved remote snapshot: " << exitInfo << ", requesting a full listing");
+            _liveSnapshot.init();
+            break;
+    }
+
+    // A saved snapshot is used only once: it is saved again when the worker stops.
+    (void) IoHelper::deleteItem(filePath);
+
+    return ExitCode::Ok;
+}
+
+void RemoteFileSystemObserverWorker::saveSnapshot() {
+    if (!_liveSnapshot.isValid() || !_snapshotMatchesCursor || _cursor.empty()) return;
+
+    if (snapshotFingerprint() != _snapshotFingerprint) {
+        LOG_SYNCPAL_INFO(_logger, "Sync settings changed since the remote snapshot generation, the snapshot is not saved");
+        return;
+    }
+
+    const TimerUtility timer;
+    const SnapshotFile::Header header{_liveSnapshot.rootFolderId(), _cursor, _snapshotFingerprint};
+    if (!SnapshotFile::save(_liveSnapshot, header, savedSnapshotPath())) {
+        LOG_SYNCPAL_WARN(_logger, "Failed to save the remote snapshot");
+        return;
+    }
+
+    LOG_SYNCPAL_INFO(_logger, "Remote snapshot saved in: " << timer.elapsed<DoubleSeconds>().count() << "s for "
+                                                           << _liveSnapshot.nbItems() << " items");
+}
+
+SyncPath RemoteFileSystemObserverWorker::savedSnapshotPath() const {
+    return SnapshotFile::path(_syncPal->syncDb()->dbPath());
+}
+
+std::string RemoteFileSystemObserverWorker::snapshotFingerprint() const {
+    // The blacklisted folders and the exclusion templates filter the items of the snapshot.
+    std::vector<NodeId> blackList(_blackList.begin(), _blackList.end());
+    std::sort(blackList.begin(), blackList.end());
+
+    std::string settings;
+    for (const auto &nodeId: blackList) {
+        (void) settings.append(nodeId).append(1, '\n');
+    }
+    (void) settings.append(1, '\n');
+    for (const auto &exclusionTemplate: ExclusionTemplateCache::instance()->exclusionTemplates()) {
+        (void) settings.append(exclusionTemplate.templ()).append(1, '\n');
+    }
+
+    return Utility::computeXxHash(settings);
+}
+
 ExitInfo RemoteFileSystemObserverWorker::initWithCursor() {
     if (stopAsked()) {
         return ExitCode::Ok;
@@ -285,40 +412,8 @@ ExitInfo RemoteFileSystemObserverWorker::getItemsInDir(const NodeId &dirId, cons
     job->setScope(Scope::Sync);
 
     SyncJobManagerSingleton::instance()->queueAsyncJob(job, Poco::Thread::PRIO_LOW);
-    while (!SyncJobManagerSingleton::instance()->isJobFinished(job->jobId())) {
-        if (stopAsked()) {
-            return ExitCode::Ok;
-        }
-
-        // Wait a little before checking again
-        Utility::msleep(100);
-    }
-
-    if (!job->exitInfo()) {
-        LOG_SYNCPAL_WARN(_logger, "Error in GetFileListWithCursorJob: " << job->exitInfo());
-        if (job->exitInfo().code() == ExitCode::RateLimited) {
-            setPauseDuration(job->sleepDuration());
-        }
-
-        return job->exitInfo();
-    }
 
-    if (saveCursor) {
-        const std::string cursor = job->getCursor();
-        if (cursor != _cursor) {
-            _cursor = cursor;
-            LOG_SYNCPAL_DEBUG(_logger, "Cursor updated: " << _cursor);
-            int64_t timestamp = static_cast<long int>(time(0));
-            const ExitInfo exitInfo = _syncPal->setListingCursor(_cursor, timestamp);
-            if (!exitInfo) {
-                LOG_SYNCPAL_WARN(_logger, "Error in SyncPal::setListingCursor");
-
-                return exitInfo;
-            }
-        }
-    }
-
-    // Parse reply
+    // Parse the reply while it is received
     LOG_SYNCPAL_DEBUG(_logger, "Begin parsing of the CSV reply");
     const TimerUtility timer;
     SnapshotItem item;
@@ -327,9 +422,16 @@ ExitInfo RemoteFileSystemObserverWorker::getItemsInDir(const NodeId &dirId, cons
     bool eof = false;
     SyncNameSet existingFiles;
     uint64_t itemCount = 0;
-    perfMonitorBackRequest.stop();
     sentry::pTraces::counterScoped::RFSOExploreItem perfMonitorExploreItem(!saveCursor, syncDbId());
-    while (job->getItem(item, error, ignore, eof)) {
+    for (;;) {
+        if (stopAsked()) {
+            job->abort();
+            return ExitCode::Ok;
+        }
+
+        if (!job->waitForItem(std::chrono::milliseconds(100))) continue;
+        if (!job->getItem(item, error, ignore, eof)) break;
+
         if (ignore) continue;
         if (eof) break;
 
@@ -338,14 +440,11 @@ ExitInfo RemoteFileSystemObserverWorker::getItemsInDir(const NodeId &dirId, cons
         itemCount++;
         if (error) {
             LOG_SYNCPAL_WARN(_logger, "Logic error: failed to parse CSV reply.");
+            job->abort();
 
             return {ExitCode::LogicError, ExitCause::FullListParsingError};
         }
 
-        if (stopAsked()) {
-            return ExitCode::Ok;
-        }
-
         bool isWarning = false;
         if (ExclusionTemplateCache::instance()->isExcluded(item.name(), isWarning)) {
             continue;
@@ -353,7 +452,10 @@ ExitInfo RemoteFileSystemObserverWorker::getItemsInDir(const NodeId &dirId, cons
 
         // Check unsupported characters
         if (const auto exitInfo = checkForUnsupportedCharacters(item.name(), item.id(), item.type()); !exitInfo) {
-            if (exitInfo.cause() == ExitCause::TmpDirAccessError) return exitInfo;
+            if (exitInfo.cause() == ExitCause::TmpDirAccessError) {
+                job->abort();
+                return exitInfo;
+            }
 
             continue;
         }
@@ -385,6 +487,27 @@ ExitInfo RemoteFileSystemObserverWorker::getItemsInDir(const NodeId &dirId, cons
         }
     }
 
+    // Wait for the end of the job to get its exit info and the cursor
+    while (!SyncJobManagerSingleton::instance()->isJobFinished(job->jobId())) {
+        if (stopAsked()) {
+            job->abort();
+            return ExitCode::Ok;
+        }
+
+        // Wait a little before checking again
+        Utility::msleep(10);
+    }
+    perfMonitorBackRequest.stop();
+
+    if (!job->exitInfo()) {
+        LOG_SYNCPAL_WARN(_logger, "Error in GetFileListWithCursorJob: " << job->exitInfo());
+        if (job->exitInfo().code() == ExitCode::RateLimited) {
+            setPauseDuration(job->sleepDuration());
+        }
+
+        return job->exitInfo();
+    }
+
     if (!eof) {
         const std::string msg = "Failed to parse CSV reply: missing EOF delimiter";
         LOG_SYNCPAL_WARN(_logger, msg);
@@ -393,6 +516,21 @@ ExitInfo RemoteFileSystemObserverWorker::getItemsInDir(const NodeId &dirId, cons
         return {ExitCode::NetworkError, ExitCause::FullListParsingError};
     }
 
+    if (saveCursor) {
+        const std::string cursor = job->getCursor();
+        if (cursor != _cursor) {
+            _cursor = cursor;
+            LOG_SYNCPAL_DEBUG(_logger, "Cursor updated: " << _cursor);
+            int64_t timestamp = static_cast<long int>(time(0));
+            const ExitInfo exitInfo = _syncPal->setListingCursor(_cursor, timestamp);
+            if (!exitInfo) {
+                LOG_SYNCPAL_WARN(_logger, "Error in SyncPal::setListingCursor");
+
+                return exitInfo;
+            }
+        }
+    }
+
     // Delete orphans
     NodeSet nodeIds;
     _liveSnapshot.ids(nodeIds);
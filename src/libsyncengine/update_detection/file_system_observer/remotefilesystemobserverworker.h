@@ -65,13 +65,24 @@ class RemoteFileSystemObserverWorker : public FileSystemObserverWorker {
 
         void countListingRequests();
 
+        // Warm start: the snapshot is saved with its cursor when the worker stops, and reloaded then brought up to date with
+        // a cursor listing on the next start. `loaded` is false if a full listing is still needed.
+        ExitInfo loadSavedSnapshot(bool &loaded);
+        void saveSnapshot();
+        [[nodiscard]] SyncPath savedSnapshotPath() const;
+        [[nodiscard]] std::string snapshotFingerprint() const;
+
         DriveDbId _driveDbId = -1;
         std::string _cursor;
         NodeSet _blackList; // A list of user-selected folders not to be synchronized.
         int _listingFullCounter = 0;
         std::chrono::steady_clock::time_point _listingFullTimer = std::chrono::steady_clock::now();
+        bool _snapshotMatchesCursor = false; // Whether the snapshot content is exactly the state described by `_cursor`.
+        std::string _snapshotFingerprint; // The fingerprint of the settings used to build the snapshot.
 
         friend class TestRemoteFileSystemObserverWorker;
+        friend class TestSnapshotFile;
+        friend class BenchmarkSnapshotFile;
 };
 
 } // namespace KDC
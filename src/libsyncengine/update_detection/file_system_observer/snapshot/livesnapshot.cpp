@@ -33,7 +33,7 @@ namespace KDC {
 LiveSnapshot::LiveSnapshot(const ReplicaSide side, const DbNode &dbNode) :
     Snapshot(side, side == ReplicaSide::Local ? dbNode.nodeIdLocal().value() : dbNode.nodeIdRemote().value()) {
     _revisionHandlder = std::make_shared<SnapshotRevisionHandler>();
-    _items.try_emplace(rootFolderId(), std::make_shared<SnapshotItem>(rootFolderId()))
+    _items->try_emplace(rootFolderId(), std::make_shared<SnapshotItem>(rootFolderId()))
             .first->second->setSnapshotRevisionHandler(_revisionHandlder);
 }
 
@@ -41,12 +41,14 @@ void LiveSnapshot::init() {
     const std::scoped_lock lock(_mutex);
     startUpdate();
 
-    _items.clear();
-    auto [res, _] = _items.try_emplace(rootFolderId(), std::make_shared<SnapshotItem>(rootFolderId()));
+    _items->clear();
+    auto [res, _] = _items->try_emplace(rootFolderId(), std::make_shared<SnapshotItem>(rootFolderId()));
     auto newItemPtr = res->second;
     newItemPtr->setSnapshotRevisionHandler(_revisionHandlder);
 
     _isValid = false;
+    _changedItemIds.clear();
+    _fullFreezeNeeded = true;
 }
 
 bool LiveSnapshot::updateItem(const SnapshotItem &newItem) {
@@ -77,21 +79,19 @@ bool LiveSnapshot::updateItem(const SnapshotItem &newItem, NodeId &removedNodeId
 
     // Check if `newItem` already exists with the same path but a different ID
     if (const auto newParent = findItem(newItem.parentId()); newParent) {
-        for (const auto &child: newParent->children()) {
-            if (child->normalizedName() == newItem.normalizedName() && child->id() != newItem.id()) {
-                LOGW_DEBUG(Log::instance()->getLogger(),
-                           L"Item: " << Utility::formatSyncName(newItem.name()) << L" (" << CommonUtility::s2ws(newItem.id())
-                                     << L") already exists in parent: " << CommonUtility::s2ws(newItem.parentId())
-                                     << L" with a different id. Removing it and adding the new one.");
-                removedNodeId = child->id();
-                auto child2 = child; // removeItem cannot be called on a const ref, we need to make a copy.
-                if (!removeItem(child2)) return false;
-                break; // There should be at most one item with the same normalized name in a folder.
-            }
+        // There should be at most one item with the same normalized name in a folder.
+        if (auto child = newParent->findChildWithNormalizedName(newItem.normalizedName(), newItem.id()); child) {
+            LOGW_DEBUG(Log::instance()->getLogger(),
+                       L"Item: " << Utility::formatSyncName(newItem.name()) << L" (" << CommonUtility::s2ws(newItem.id())
+                                 << L") already exists in parent: " << CommonUtility::s2ws(newItem.parentId())
+                                 << L" with a different id. Removing it and adding the new one.");
+            removedNodeId = child->id();
+            if (!removeItem(child)) return false;
         }
     }
 
     bool parentChanged = false;
+    std::shared_ptr<SnapshotItem> renamedItemParent;
     auto item = findItem(newItem.id());
     // Update old parent's children lists if the item already exists
     if (item) {
@@ -101,6 +101,10 @@ bool LiveSnapshot::updateItem(const SnapshotItem &newItem, NodeId &removedNodeId
             if (const auto previousParent = findItem(item->parentId()); previousParent) {
                 previousParent->removeChild(item);
             }
+        } else if (item->normalizedName() != newItem.normalizedName()) {
+            // Remove the item from its parent's name index before the rename
+            renamedItemParent = findItem(item->parentId());
+            if (renamedItemParent) renamedItemParent->removeChild(item);
         }
 
     } else {
@@ -108,11 +112,13 @@ bool LiveSnapshot::updateItem(const SnapshotItem &newItem, NodeId &removedNodeId
         parentChanged = true;
         item = std::make_shared<SnapshotItem>(newItem.id());
         item->setSnapshotRevisionHandler(_revisionHandlder);
-        (void) _items.try_emplace(newItem.id(), item);
+        (void) _items->try_emplace(newItem.id(), item);
     }
 
     // Update item
     item->copyExceptChildren(newItem);
+    (void) _changedItemIds.insert(newItem.id());
+    if (renamedItemParent) renamedItemParent->addChild(item);
 
     if (parentChanged) {
         // Add children to new parent
@@ -122,7 +128,8 @@ bool LiveSnapshot::updateItem(const SnapshotItem &newItem, NodeId &removedNodeId
                       "Parent " << newItem.parentId().c_str() << " does not exist yet, creating it");
             newParent = std::make_shared<SnapshotItem>(newItem.parentId());
             newParent->setSnapshotRevisionHandler(_revisionHandlder);
-            (void) _items.try_emplace(newItem.parentId(), newParent);
+            (void) _items->try_emplace(newItem.parentId(), newParent);
+            (void) _changedItemIds.insert(newItem.parentId());
             newParent->addChild(item);
         } else {
             newParent->addChild(item);
@@ -140,6 +147,17 @@ bool LiveSnapshot::updateItem(const SnapshotItem &newItem, NodeId &removedNodeId
     return true;
 }
 
+bool LiveSnapshot::updateItems(const std::vector<SnapshotItem> &newItems) {
+    const std::scoped_lock lock(_mutex);
+
+    bool res = true;
+    for (const auto &newItem: newItems) {
+        res &= updateItem(newItem);
+    }
+
+    return res;
+}
+
 bool LiveSnapshot::removeItem(const NodeId itemId) {
     if (itemId.empty()) {
         LOG_WARN(Log::instance()->getLogger(), "Error in LiveSnapshot::removeItem: empty item ID argument.");
@@ -177,7 +195,8 @@ bool LiveSnapshot::removeItem(std::shared_ptr<SnapshotItem> &item) {
     }
     const NodeId itemId = item->id();
     item.reset();
-    _items.erase(itemId);
+    _items->erase(itemId);
+    (void) _changedItemIds.insert(itemId);
 
     if (ParametersCache::isExtendedLogEnabled()) {
         LOG_DEBUG(Log::instance()->getLogger(), "Item " << itemId << " removed from " << side() << " snapshot.");
@@ -235,7 +254,12 @@ bool LiveSnapshot::path(const NodeId &itemId, SyncPath &path, bool &ignore) cons
 bool LiveSnapshot::setName(const NodeId &itemId, const SyncName &newName) {
     const std::scoped_lock lock(_mutex);
     if (const auto item = findItem(itemId); item) {
+        // Keep the parent's name index consistent
+        const auto parent = findItem(item->parentId());
+        if (parent) parent->removeChild(item);
         item->setName(newName);
+        if (parent) parent->addChild(item);
+        (void) _changedItemIds.insert(itemId);
         if (!isOrphan(itemId)) {
             startUpdate();
         }
@@ -248,6 +272,7 @@ bool LiveSnapshot::setCreatedAt(const NodeId &itemId, const SyncTime newTime) {
     const std::scoped_lock lock(_mutex);
     if (const auto item = findItem(itemId); item) {
         item->setCreatedAt(newTime);
+        (void) _changedItemIds.insert(itemId);
         if (!isOrphan(itemId)) {
             startUpdate();
         }
@@ -258,8 +283,9 @@ bool LiveSnapshot::setCreatedAt(const NodeId &itemId, const SyncTime newTime) {
 
 bool LiveSnapshot::setLastModified(const NodeId &itemId, const SyncTime newTime) {
     const std::scoped_lock lock(_mutex);
-    if (const auto it = _items.find(itemId); it != _items.end()) {
+    if (const auto it = _items->find(itemId); it != _items->end()) {
         it->second->setLastModified(newTime);
+        (void) _changedItemIds.insert(itemId);
 
         if (!isOrphan(itemId)) {
             startUpdate();
@@ -274,6 +300,7 @@ bool LiveSnapshot::setContentChecksum(const NodeId &itemId, const std::string &n
     // Note: do not call "startUpdate" here since the computation of content checksum is asynchronous
     if (const auto item = findItem(itemId); item) {
         item->setContentChecksum(newChecksum);
+        (void) _changedItemIds.insert(itemId);
         return true;
     }
     return false;
@@ -288,6 +315,7 @@ bool LiveSnapshot::forceUpdateLastChangeRevision(const NodeId &itemId) {
     const std::scoped_lock lock(_mutex);
     if (const auto item = findItem(itemId); item) {
         item->forceUpdateLastChangeRevision();
+        (void) _changedItemIds.insert(itemId);
         if (!isOrphan(itemId)) {
             startUpdate();
         }
@@ -311,6 +339,77 @@ SnapshotRevision LiveSnapshot::revision() const {
     return _revisionHandlder->revision();
 }
 
+std::shared_ptr<ConstSnapshot> LiveSnapshot::freeze() const {
+    const std::scoped_lock lock(_mutex);
+
+    // The frozen items can only be updated in place if they are not shared with a ConstSnapshot anymore.
+    if (_fullFreezeNeeded || !_frozenItems || _frozenItems.use_count() > 1) {
+        _frozenItems = copyItems(*_items);
+    } else {
+        applyChangesToFrozenItems();
+    }
+    _changedItemIds.clear();
+    _fullFreezeNeeded = false;
+
+    return std::shared_ptr<ConstSnapshot>(new ConstSnapshot(side(), rootFolderId(), revision(), _frozenItems));
+}
+
+void LiveSnapshot::applyChangesToFrozenItems() const {
+    auto &frozenItems = *_frozenItems;
+
+    // Update the attributes of the changed items. Existing frozen items are updated in place so that the children lists
+    // of their parents remain valid. Moved or renamed items are detached from their parent first to keep its name index
+    // consistent.
+    std::vector<std::shared_ptr<SnapshotItem>> itemsToAttach;
+    NodeSet removedItemIds;
+    for (const auto &itemId: _changedItemIds) {
+        const auto liveItemIt = _items->find(itemId);
+        const auto frozenItemIt = frozenItems.find(itemId);
+        if (liveItemIt == _items->end()) {
+            if (frozenItemIt != frozenItems.end()) (void) removedItemIds.insert(itemId);
+            continue;
+        }
+
+        if (frozenItemIt == frozenItems.end()) {
+            auto frozenItem = std::make_shared<SnapshotItem>(itemId);
+            frozenItem->copyExceptChildren(*liveItemIt->second);
+            (void) frozenItems.try_emplace(itemId, frozenItem);
+            itemsToAttach.push_back(frozenItem);
+            continue;
+        }
+
+        const auto &frozenItem = frozenItemIt->second;
+        const auto &liveItem = liveItemIt->second;
+        const bool detach = frozenItem->parentId() != liveItem->parentId() ||
+                            frozenItem->normalizedName() != liveItem->normalizedName();
+        if (detach) {
+            if (const auto parentIt = frozenItems.find(frozenItem->parentId()); parentIt != frozenItems.end()) {
+                parentIt->second->removeChild(frozenItem);
+            }
+            itemsToAttach.push_back(frozenItem);
+        }
+        frozenItem->copyExceptChildren(*liveItem);
+    }
+
+    // Remove the deleted items
+    for (const auto &itemId: removedItemIds) {
+        auto item = frozenItems.at(itemId);
+        if (const auto parentIt = frozenItems.find(item->parentId()); parentIt != frozenItems.end()) {
+            parentIt->second->removeChild(item);
+        }
+        item->removeAllChildren();
+        item.reset();
+        frozenItems.erase(itemId);
+    }
+
+    // Attach the new, moved and renamed items to their parent
+    for (const auto &item: itemsToAttach) {
+        if (const auto parentIt = frozenItems.find(item->parentId()); parentIt != frozenItems.end()) {
+            parentIt->second->addChild(item);
+        }
+    }
+}
+
 void LiveSnapshot::removeChildrenRecursively(const std::shared_ptr<SnapshotItem> parent) {
     auto it = parent->children().begin();
     while (it != parent->children().end()) {
@@ -322,7 +421,8 @@ void LiveSnapshot::removeChildrenRecursively(const std::shared_ptr<SnapshotItem>
         removeChildrenRecursively(child);
         ++it;
         parent->removeChild(child);
-        _items.erase(childId);
+        _items->erase(childId);
+        (void) _changedItemIds.insert(childId);
     }
 }
 
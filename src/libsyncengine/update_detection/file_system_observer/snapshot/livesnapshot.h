@@ -41,6 +41,8 @@ class LiveSnapshot : public Snapshot, public SharedObject {
 
         bool updateItem(const SnapshotItem &newItem);
         bool updateItem(const SnapshotItem &newItem, NodeId &removedNodeId);
+        // Insert or update several items under a single lock, typically the children of a folder.
+        bool updateItems(const std::vector<SnapshotItem> &newItems);
         bool removeItem(const NodeId itemId); // Do not pass by reference to avoid dangling references
 
         bool path(const NodeId &itemId, SyncPath &path, bool &ignore) const noexcept override;
@@ -55,12 +57,25 @@ class LiveSnapshot : public Snapshot, public SharedObject {
         void setValid(bool newIsValid);
         SnapshotRevision revision() const override;
 
+        /** @brief Returns a read-only copy of the snapshot in its current state.
+         * The items of the copy are kept between calls and only the items changed since the previous call are copied
+         * again, provided that the previously returned copy has been released. Otherwise, all items are copied.
+         */
+        std::shared_ptr<ConstSnapshot> freeze() const;
+
     private:
         std::shared_ptr<SnapshotRevisionHandler> _revisionHandlder;
         bool removeItem(std::shared_ptr<SnapshotItem> &item);
         void removeChildrenRecursively(const std::shared_ptr<SnapshotItem> parent);
+        void applyChangesToFrozenItems() const;
         bool _isValid = false;
 
+        // Items shared with the ConstSnapshot returned by the last call to `freeze`.
+        mutable std::shared_ptr<SnapshotItemUnorderedMap> _frozenItems;
+        // IDs of the items added, updated or removed since the last call to `freeze`.
+        mutable NodeSet _changedItemIds;
+        mutable bool _fullFreezeNeeded = true;
+
         friend class TestSnapshot;
 };
 
@@ -34,43 +34,54 @@ Snapshot::Snapshot(ReplicaSide side, const NodeId &rootFolderId) :
     _side(side),
     _rootFolderId(rootFolderId) {}
 
+Snapshot::Snapshot(const ReplicaSide side, const NodeId &rootFolderId, const SnapshotRevision revision,
+                   std::shared_ptr<SnapshotItemUnorderedMap> items) :
+    _items(std::move(items)),
+    _revision(revision),
+    _side(side),
+    _rootFolderId(rootFolderId) {}
+
 Snapshot::Snapshot(Snapshot const &other) {
     if (this != &other) {
         const std::scoped_lock lock(_mutex, other._mutex);
         _side = other._side;
         _rootFolderId = other._rootFolderId;
-        _items.clear();
         _revision = other.revision();
+        _items = copyItems(*other._items);
+    }
+}
 
-        for (const auto &item: other._items) {
-            _items.try_emplace(item.first, std::make_shared<SnapshotItem>(*item.second));
-        }
+std::shared_ptr<Snapshot::SnapshotItemUnorderedMap> Snapshot::copyItems(const SnapshotItemUnorderedMap &items) {
+    auto newItems = std::make_shared<SnapshotItemUnorderedMap>();
+    newItems->reserve(items.size());
+    for (const auto &[id, item]: items) {
+        auto newItem = std::make_shared<SnapshotItem>();
+        newItem->copyExceptChildren(*item);
+        (void) newItems->try_emplace(id, newItem);
+    }
 
-        // Update the child list
-        for (const auto &[_, item]: _items) {
-            NodeSet childrenIds;
-            for (const auto &child: item->children()) {
-                (void) childrenIds.insert(child->id());
-            }
-            item->removeAllChildren();
-            for (const auto &childId: childrenIds) {
-                const auto itemIt = _items.find(childId);
-                if (itemIt == _items.end()) {
-                    LOG_WARN(Log::instance()->getLogger(), "Item id=" << childId << " not found in snapshot");
-                    continue;
-                }
-
-                item->addChild(itemIt->second); // Add the new pointer
+    // Update the child list
+    for (const auto &[id, item]: items) {
+        const auto &newItem = newItems->at(id);
+        for (const auto &child: item->children()) {
+            const auto itemIt = newItems->find(child->id());
+            if (itemIt == newItems->end()) {
+                LOG_WARN(Log::instance()->getLogger(), "Item id=" << child->id() << " not found in snapshot");
+                continue;
             }
+
+            newItem->addChild(itemIt->second); // Add the new pointer
         }
     }
+
+    return newItems;
 }
 
 ExitInfo Snapshot::getItemId(const SyncPath &path, NodeId &id) const {
     const std::scoped_lock lock(_mutex);
     id = {};
-    const auto rootItemIt = _items.find(rootFolderId());
-    if (rootItemIt == _items.end()) {
+    const auto rootItemIt = _items->find(rootFolderId());
+    if (rootItemIt == _items->end()) {
         LOG_WARN(Log::instance()->getLogger(), "Root folder id not found in snapshot");
         sentry::Handler::captureMessage(sentry::Level::Error, "Root folder id not found in snapshot",
                                         "Snapshot::getItemId failed because the root node ID was not found in snapshot.");
@@ -85,18 +96,11 @@ ExitInfo Snapshot::getItemId(const SyncPath &path, NodeId &id) const {
         }
 #endif
 
-        bool idFound = false;
-        for (const auto &child: item->children()) {
-            if (child->name() == *pathIt) {
-                item = child;
-                idFound = true;
-                break;
-            }
-        }
-
-        if (!idFound) {
+        const auto child = item->findChild(pathIt->native());
+        if (!child) {
             return {ExitCode::DataError, ExitCause::NotFound};
         }
+        item = child;
     }
 
     id = item->id();
@@ -129,8 +133,8 @@ bool Snapshot::path(const NodeId &itemId, SyncPath &path, bool &ignore) const no
     NodeId id = itemId;
     while (!parentIsRoot) {
         if (const auto item = findItem(id); item) {
-            if (!item->path().empty()) {
-                path = item->path();
+            if (const auto &cachedPath = item->path(_revision); !cachedPath.empty()) {
+                path = cachedPath;
                 break;
             }
             (void) ancestors.emplace_back(item->id(), item->name());
@@ -149,7 +153,7 @@ bool Snapshot::path(const NodeId &itemId, SyncPath &path, bool &ignore) const no
         path /= ancestors.back().second;
         const auto item = findItem(ancestors.back().first);
         assert(item);
-        item->setPath(path);
+        item->setPath(path, _revision);
 
         ancestors.pop_back();
     }
@@ -277,7 +281,7 @@ bool Snapshot::getChildren(const NodeId &itemId, std::unordered_set<std::shared_
 
 std::shared_ptr<SnapshotItem> Snapshot::findItem(const NodeId &itemId) const {
     const std::scoped_lock lock(_mutex);
-    if (const auto it = _items.find(itemId); it != _items.end()) {
+    if (const auto it = _items->find(itemId); it != _items->end()) {
         return it->second;
     }
     return nullptr;
@@ -320,7 +324,7 @@ void Snapshot::getDescendantIds(const NodeId &itemId, NodeSet &descendantIds) co
 void Snapshot::ids(NodeSet &ids) const {
     const std::scoped_lock lock(_mutex);
     ids.clear();
-    for (const auto &[id, _]: _items) {
+    for (const auto &[id, _]: *_items) {
         ids.insert(id);
     }
 }
@@ -369,12 +373,12 @@ bool Snapshot::isOrphan(const NodeId &itemId) const {
 
 bool Snapshot::isEmpty() const {
     const std::scoped_lock lock(_mutex);
-    return _items.empty();
+    return _items->empty();
 }
 
 uint64_t Snapshot::nbItems() const {
     const std::scoped_lock lock(_mutex);
-    return _items.size();
+    return _items->size();
 }
 
 
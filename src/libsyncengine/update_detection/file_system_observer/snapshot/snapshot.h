@@ -70,8 +70,6 @@ class Snapshot {
         virtual SnapshotRevision revision() const;
 
     protected:
-        Snapshot(ReplicaSide side, const NodeId &rootFolderId);
-
         class SnapshotItemUnorderedMap : public std::unordered_map<NodeId, std::shared_ptr<SnapshotItem>> {
             public:
                 // To ensure the integrity of the snapshot, we need to make sure that it is not used anywhere (i.e., as a
@@ -83,7 +81,15 @@ class Snapshot {
                 }
         };
 
-        SnapshotItemUnorderedMap _items; // key: id
+        Snapshot(ReplicaSide side, const NodeId &rootFolderId);
+        // Share `items` instead of copying them. `items` must not be modified as long as this snapshot exists.
+        Snapshot(ReplicaSide side, const NodeId &rootFolderId, SnapshotRevision revision,
+                 std::shared_ptr<SnapshotItemUnorderedMap> items);
+
+        // Deep copy of `items`: the items and their children lists are duplicated.
+        static std::shared_ptr<SnapshotItemUnorderedMap> copyItems(const SnapshotItemUnorderedMap &items);
+
+        std::shared_ptr<SnapshotItemUnorderedMap> _items = std::make_shared<SnapshotItemUnorderedMap>(); // key: id
 
         std::shared_ptr<SnapshotItem> findItem(const NodeId &itemId) const;
         mutable std::recursive_mutex _mutex;
@@ -96,7 +102,7 @@ class Snapshot {
         ReplicaSide _side = ReplicaSide::Unknown;
         NodeId _rootFolderId;
 
-
+        friend class SnapshotFile;
         friend class TestSnapshot;
 };
 
@@ -106,9 +112,15 @@ class ConstSnapshot : public Snapshot {
             Snapshot(other) {}
 
     private:
+        ConstSnapshot(ReplicaSide side, const NodeId &rootFolderId, SnapshotRevision revision,
+                      std::shared_ptr<SnapshotItemUnorderedMap> items) :
+            Snapshot(side, rootFolderId, revision, std::move(items)) {}
+
         // Prevent any derived class to modify the snapshot content.
         using Snapshot::_items;
         using Snapshot::_mutex;
         using Snapshot::findItem;
+
+        friend class LiveSnapshot;
 };
 } // namespace KDC
@@ -0,0 +1,327 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "snapshotfile.h"
+#include "libcommonserver/io/iohelper.h"
+#include "libcommonserver/log/log.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <log4cplus/loggingmacros.h>
+
+#include <xxhash.h>
+
+#include <fstream>
+#include <queue>
+
+namespace KDC {
+
+namespace {
+
+constexpr std::string_view snapshotFileMagic = "KDRS";
+constexpr size_t writeBufferSize = 1024 * 1024;
+constexpr size_t checksumSize = sizeof(uint64_t);
+// id, parentId, name and checksum lengths, createdAt, lastModified, size, type and flags.
+constexpr size_t minItemSize = 4 * sizeof(uint32_t) + 3 * sizeof(int64_t) + 2;
+
+constexpr uint8_t isLinkFlag = 0x01;
+constexpr uint8_t canWriteFlag = 0x02;
+constexpr uint8_t canShareFlag = 0x04;
+
+// Buffers the serialized data and hashes it as it is written to the stream. Integers are stored in little-endian order.
+class SnapshotFileWriter {
+    public:
+        explicit SnapshotFileWriter(std::ofstream &stream) :
+            _stream(stream),
+            _state(XXH3_createState()) {
+            if (_state && XXH3_64bits_reset(_state) == XXH_ERROR) {
+                XXH3_freeState(_state);
+                _state = nullptr;
+            }
+            _buffer.reserve(writeBufferSize);
+        }
+        ~SnapshotFileWriter() { XXH3_freeState(_state); }
+
+        SnapshotFileWriter(const SnapshotFileWriter &) = delete;
+        SnapshotFileWriter &operator=(const SnapshotFileWriter &) = delete;
+
+        template<typename T>
+        void writeInteger(const T value) {
+            const auto bits = static_cast<uint64_t>(value);
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                _buffer.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+            }
+            flushIfFull();
+        }
+
+        void writeString(const std::string &value) {
+            writeInteger(static_cast<uint32_t>(value.size()));
+            (void) _buffer.append(value);
+            flushIfFull();
+        }
+
+        void writeRaw(const std::string_view value) {
+            (void) _buffer.append(value);
+            flushIfFull();
+        }
+
+        // Writes the checksum of all the data written so far. Returns false if any write failed.
+        bool finish() {
+            flush();
+            if (!_state) return false;
+
+            const XXH64_hash_t hash = XXH3_64bits_digest(_state);
+            writeInteger(static_cast<uint64_t>(hash));
+            (void) _stream.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+            _buffer.clear();
+            (void) _stream.flush();
+            return _stream.good();
+        }
+
+    private:
+        void flushIfFull() {
+            if (_buffer.size() >= writeBufferSize) flush();
+        }
+
+        void flush() {
+            if (_state && XXH3_64bits_update(_state, _buffer.data(), _buffer.size()) == XXH_ERROR) {
+                XXH3_freeState(_state);
+                _state = nullptr;
+            }
+            (void) _stream.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+            _buffer.clear();
+        }
+
+        std::ofstream &_stream;
+        XXH3_state_t *_state = nullptr;
+        std::string _buffer;
+};
+
+// Reads values from the content of a snapshot file. Any read beyond the end of the data marks the reader as failed.
+class SnapshotFileReader {
+    public:
+        explicit SnapshotFileReader(const std::string_view data) :
+            _data(data) {}
+
+        template<typename T>
+        T readInteger() {
+            if (!_ok || remaining() < sizeof(T)) {
+                _ok = false;
+                return T{};
+            }
+
+            uint64_t bits = 0;
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                bits |= static_cast<uint64_t>(static_cast<uint8_t>(_data[_pos + i])) << (8 * i);
+            }
+            _pos += sizeof(T);
+            return static_cast<T>(bits);
+        }
+
+        std::string readString() {
+            const auto size = readInteger<uint32_t>();
+            if (!_ok || remaining() < size) {
+                _ok = false;
+                return {};
+            }
+
+            std::string value(_data.substr(_pos, size));
+            _pos += size;
+            return value;
+        }
+
+        std::string_view readRaw(const size_t size) {
+            if (!_ok || remaining() < size) {
+                _ok = false;
+                return {};
+            }
+
+            const auto value = _data.substr(_pos, size);
+            _pos += size;
+            return value;
+        }
+
+        [[nodiscard]] size_t remaining() const { return _data.size() - _pos; }
+        [[nodiscard]] bool ok() const { return _ok; }
+
+    private:
+        std::string_view _data;
+        size_t _pos = 0;
+        bool _ok = true;
+};
+
+} // namespace
+
+SyncPath SnapshotFile::path(const SyncPath &syncDbPath) {
+    SyncPath filePath = syncDbPath;
+    (void) filePath.replace_extension(Str(".remote_snapshot"));
+    return filePath;
+}
+
+bool SnapshotFile::save(const Snapshot &snapshot, const Header &header, const SyncPath &filePath) {
+    SyncPath tmpPath = filePath;
+    tmpPath += Str(".tmp");
+
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            LOGW_WARN(Log::instance()->getLogger(), L"Failed to open snapshot file: " << Utility::formatSyncPath(tmpPath));
+            return false;
+        }
+
+        const std::scoped_lock lock(snapshot._mutex);
+
+        // Parents are written before their children, so that the items can be inserted back in the same order.
+        std::vector<const SnapshotItem *> orderedItems;
+        orderedItems.reserve(snapshot._items->size());
+        std::queue<const SnapshotItem *> queue;
+        if (const auto root = snapshot.findItem(snapshot.rootFolderId()); root) {
+            queue.push(root.get());
+        }
+        while (!queue.empty()) {
+            const auto *item = queue.front();
+            queue.pop();
+            if (item->id() != snapshot.rootFolderId()) {
+                orderedItems.push_back(item);
+            }
+            for (const auto &child: item->children()) {
+                queue.push(child.get());
+            }
+        }
+
+        SnapshotFileWriter writer(stream);
+        writer.writeRaw(snapshotFileMagic);
+        writer.writeInteger(formatVersion);
+        writer.writeString(header.rootFolderId);
+        writer.writeString(header.cursor);
+        writer.writeString(header.fingerprint);
+        writer.writeInteger(static_cast<uint64_t>(orderedItems.size()));
+        for (const auto *item: orderedItems) {
+            writer.writeString(item->id());
+            writer.writeString(item->parentId());
+            writer.writeString(SyncName2Str(item->name()));
+            writer.writeInteger(static_cast<int64_t>(item->createdAt()));
+            writer.writeInteger(static_cast<int64_t>(item->lastModified()));
+            writer.writeInteger(static_cast<int64_t>(item->size()));
+            writer.writeInteger(static_cast<uint8_t>(item->type()));
+            writer.writeInteger(static_cast<uint8_t>((item->isLink() ? isLinkFlag : 0) | (item->canWrite() ? canWriteFlag : 0) |
+                                                     (item->canShare() ? canShareFlag : 0)));
+            writer.writeString(item->contentChecksum());
+        }
+
+        if (!writer.finish()) {
+            LOGW_WARN(Log::instance()->getLogger(), L"Failed to write snapshot file: " << Utility::formatSyncPath(tmpPath));
+            stream.close();
+            (void) IoHelper::deleteItem(tmpPath);
+            return false;
+        }
+    }
+
+    // The file is replaced in one step so that a previous copy is never left half-written.
+    if (IoError ioError = IoError::Success; !IoHelper::renameItem(tmpPath, filePath, ioError)) {
+        LOGW_WARN(Log::instance()->getLogger(), L"Failed to rename snapshot file: " << Utility::formatIoError(tmpPath, ioError));
+        (void) IoHelper::deleteItem(tmpPath);
+        return false;
+    }
+
+    return true;
+}
+
+bool SnapshotFile::load(const SyncPath &filePath, Header &header, std::vector<SnapshotItem> &items) {
+    std::string data;
+    {
+        std::ifstream stream(filePath, std::ios::binary | std::ios::ate);
+        if (!stream) {
+            LOGW_INFO(Log::instance()->getLogger(), L"Failed to open snapshot file: " << Utility::formatSyncPath(filePath));
+            return false;
+        }
+
+        const auto size = static_cast<std::streamoff>(stream.tellg());
+        if (size < static_cast<std::streamoff>(snapshotFileMagic.size() + sizeof(uint32_t) + checksumSize)) {
+            LOGW_WARN(Log::instance()->getLogger(), L"Snapshot file is truncated: " << Utility::formatSyncPath(filePath));
+            return false;
+        }
+
+        data.resize(static_cast<size_t>(size));
+        (void) stream.seekg(0);
+        if (!stream.read(data.data(), static_cast<std::streamsize>(size))) {
+            LOGW_WARN(Log::instance()->getLogger(), L"Failed to read snapshot file: " << Utility::formatSyncPath(filePath));
+            return false;
+        }
+    }
+
+    const std::string_view content(data.data(), data.size() - checksumSize);
+    SnapshotFileReader trailerReader(std::string_view(data).substr(content.size()));
+    if (trailerReader.readInteger<uint64_t>() != static_cast<uint64_t>(XXH3_64bits(content.data(), content.size()))) {
+        LOGW_WARN(Log::instance()->getLogger(), L"Snapshot file checksum mismatch: " << Utility::formatSyncPath(filePath));
+        return false;
+    }
+
+    SnapshotFileReader reader(content);
+    if (reader.readRaw(snapshotFileMagic.size()) != snapshotFileMagic) {
+        LOGW_WARN(Log::instance()->getLogger(), L"Not a snapshot file: " << Utility::formatSyncPath(filePath));
+        return false;
+    }
+
+    if (const auto version = reader.readInteger<uint32_t>(); version != formatVersion) {
+        LOGW_INFO(Log::instance()->getLogger(),
+                  L"Unsupported snapshot file version " << version << L": " << Utility::formatSyncPath(filePath));
+        return false;
+    }
+
+    header.rootFolderId = reader.readString();
+    header.cursor = reader.readString();
+    header.fingerprint = reader.readString();
+    const auto itemCount = reader.readInteger<uint64_t>();
+    if (!reader.ok() || itemCount > reader.remaining() / minItemSize) {
+        LOGW_WARN(Log::instance()->getLogger(), L"Invalid snapshot file header: " << Utility::formatSyncPath(filePath));
+        return false;
+    }
+
+    items.clear();
+    items.reserve(static_cast<size_t>(itemCount));
+    for (uint64_t i = 0; i < itemCount; ++i) {
+        const auto id = reader.readString();
+        const auto parentId = reader.readString();
+        const auto name = Str2SyncName(reader.readString());
+        const auto createdAt = reader.readInteger<int64_t>();
+        const auto lastModified = reader.readInteger<int64_t>();
+        const auto size = reader.readInteger<int64_t>();
+        const auto type = static_cast<NodeType>(reader.readInteger<uint8_t>());
+        const auto flags = reader.readInteger<uint8_t>();
+        auto contentChecksum = reader.readString();
+        if (!reader.ok() || id.empty() || parentId.empty() || (type != NodeType::File && type != NodeType::Directory)) {
+            LOGW_WARN(Log::instance()->getLogger(), L"Invalid item in snapshot file: " << Utility::formatSyncPath(filePath));
+            return false;
+        }
+
+        auto &item = items.emplace_back(id, parentId, name, createdAt, lastModified, type, size, (flags & isLinkFlag) != 0,
+                                        (flags & canWriteFlag) != 0, (flags & canShareFlag) != 0);
+        if (!contentChecksum.empty()) item.setContentChecksum(contentChecksum);
+    }
+
+    if (reader.remaining() != 0) {
+        LOGW_WARN(Log::instance()->getLogger(),
+                  L"Unexpected data at the end of snapshot file: " << Utility::formatSyncPath(filePath));
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace KDC
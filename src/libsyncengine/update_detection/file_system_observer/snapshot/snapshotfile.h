@@ -0,0 +1,53 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "snapshot.h"
+
+#include <string>
+#include <vector>
+
+namespace KDC {
+
+/** Compact on-disk copy of a snapshot, used by the remote observer to restart from its last known state and its listing
+ * cursor instead of requesting a full listing.
+ * Layout: magic, format version, header fields, item count, items in breadth-first order (parents first), and an XXH3
+ * checksum of everything that precedes it.
+ */
+class SnapshotFile {
+    public:
+        struct Header {
+                NodeId rootFolderId;
+                std::string cursor; // The listing cursor the snapshot content corresponds to.
+                std::string fingerprint; // Hash of the settings that filter the snapshot content (blacklist, exclusions...)
+        };
+
+        static constexpr uint32_t formatVersion = 1;
+
+        // Returns the path of the snapshot file stored next to the sync database located at `syncDbPath`.
+        static SyncPath path(const SyncPath &syncDbPath);
+
+        // Writes the items of `snapshot` (except its root) to `filePath`, replacing any existing file.
+        static bool save(const Snapshot &snapshot, const Header &header, const SyncPath &filePath);
+        // Reads `filePath`. Returns false if the file cannot be read, has another format version or is corrupted.
+        static bool load(const SyncPath &filePath, Header &header, std::vector<SnapshotItem> &items);
+};
+
+} // namespace KDC
@@ -133,6 +133,7 @@ void SnapshotItem::forceUpdateLastChangeRevision() {
 SnapshotItem &SnapshotItem::operator=(const SnapshotItem &other) {
     copyExceptChildren(other);
     _children = other.children();
+    _childrenByNormalizedName = other._childrenByNormalizedName;
     _snapshotRevisionHandler = nullptr;
     return *this;
 }
@@ -151,7 +152,8 @@ void SnapshotItem::copyExceptChildren(const SnapshotItem &other) {
     _contentChecksum = other.contentChecksum();
     _canWrite = other.canWrite();
     _canShare = other.canShare();
-    _path = other.path();
+    _path = other._path;
+    _pathRevision = other._pathRevision;
     if (other.lastChangeRevision() == 0 && _snapshotRevisionHandler) {
         _lastChangeRevision = _snapshotRevisionHandler->nextVersion();
     } else {
@@ -160,15 +162,46 @@ void SnapshotItem::copyExceptChildren(const SnapshotItem &other) {
 }
 
 void SnapshotItem::addChild(const std::shared_ptr<SnapshotItem> child) {
-    _children.insert(child);
+    if (!_children.insert(child).second) return;
+    (void) _childrenByNormalizedName.emplace(child->normalizedName(), child);
 }
 
 void SnapshotItem::removeChild(const std::shared_ptr<SnapshotItem> child) {
-    _children.erase(child);
+    if (_children.erase(child) == 0) return;
+    auto [begin, end] = _childrenByNormalizedName.equal_range(child->normalizedName());
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == child) {
+            (void) _childrenByNormalizedName.erase(it);
+            break;
+        }
+    }
 }
 
 void SnapshotItem::removeAllChildren() {
     _children.clear();
+    _childrenByNormalizedName.clear();
+}
+
+std::shared_ptr<SnapshotItem> SnapshotItem::findChild(const SyncName &name) const {
+    SyncName normalizedName;
+    if (!CommonUtility::normalizedSyncName(name, normalizedName)) {
+        normalizedName = name; // Same fallback as in `setName`
+    }
+
+    auto [begin, end] = _childrenByNormalizedName.equal_range(normalizedName);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second->name() == name) return it->second;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<SnapshotItem> SnapshotItem::findChildWithNormalizedName(const SyncName &normalizedName,
+                                                                        const NodeId &excludedId) const {
+    auto [begin, end] = _childrenByNormalizedName.equal_range(normalizedName);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second->id() != excludedId) return it->second;
+    }
+    return nullptr;
 }
 
 } // namespace KDC
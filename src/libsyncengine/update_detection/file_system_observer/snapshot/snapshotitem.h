@@ -22,6 +22,7 @@
 #include "libcommonserver/utility/utility.h"
 
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include "snapshotrevisionhandler.h"
 
@@ -80,6 +81,13 @@ class SnapshotItem {
         void removeChild(const std::shared_ptr<SnapshotItem> child);
         void removeAllChildren();
 
+        // Children lookups by name, using the normalized name index. A child must be removed before its name is changed and
+        // added again afterwards to keep the index consistent.
+        [[nodiscard]] std::shared_ptr<SnapshotItem> findChild(const SyncName &name) const;
+        // Returns a child with the normalized name `normalizedName` and an ID other than `excludedId`, nullptr if none.
+        [[nodiscard]] std::shared_ptr<SnapshotItem> findChildWithNormalizedName(const SyncName &normalizedName,
+                                                                               const NodeId &excludedId) const;
+
     private:
         NodeId _id;
         NodeId _parentId;
@@ -95,12 +103,21 @@ class SnapshotItem {
         bool _canWrite = true;
         bool _canShare = true;
         std::unordered_set<std::shared_ptr<SnapshotItem>> _children;
+        std::unordered_multimap<SyncName, std::shared_ptr<SnapshotItem>> _childrenByNormalizedName;
         SnapshotRevision _lastChangeRevision = 0; // The revision of the snapshot corresponding to the last change of this item.
         std::shared_ptr<SnapshotRevisionHandler> _snapshotRevisionHandler;
         mutable SyncPath _path; // The item relative path. Cached value. To use only on a snapshot copy, not a real time one.
+        mutable SnapshotRevision _pathRevision = 0; // The revision of the snapshot in which `_path` was computed.
 
-        [[nodiscard]] SyncPath path() const { return _path; }
-        void setPath(const SyncPath &path) const { _path = path; }
+        // Returns the cached path if it was computed for the snapshot revision `revision`, an empty path otherwise.
+        [[nodiscard]] const SyncPath &path(SnapshotRevision revision) const {
+            static const SyncPath emptyPath;
+            return _pathRevision == revision ? _path : emptyPath;
+        }
+        void setPath(const SyncPath &path, SnapshotRevision revision) const {
+            _path = path;
+            _pathRevision = revision;
+        }
 
         friend class Snapshot;
         // friend bool Snapshot::path(const NodeId &, SyncPath &, bool &) const noexcept;
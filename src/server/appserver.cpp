@@ -28,6 +28,7 @@
 #endif
 #include "updater/updatemanager.h"
 
+#include "jobs/network/httpsessionpool.h"
 #include "jobs/network/kDrive_API/searchjob.h"
 #include "jobs/network/kDrive_API/upload/loguploadjob.h"
 #include "jobs/network/kDrive_API/upload/upload_session/uploadsessioncanceljob.h"
@@ -785,6 +786,7 @@ ExitInfo AppServer::updateParametersAndPropagateChanges(const ParametersInfo &ne
         pwd != newParametersInfo.proxyConfigInfo().pwd().toStdString()) {
         // Note: The parameters cache has been updated with the parameters new values.
         Proxy::instance()->setProxyConfig(ParametersCache::instance()->parameters().proxyConfig());
+        HttpSessionPool::instance()->clear();
     }
 
     // Propagate autostart change
@@ -2187,6 +2189,7 @@ void AppServer::onRequestReceived(int id, RequestNum num, const QByteArray &para
                 parameters.proxyConfig().user() != parametersInfo.proxyConfigInfo().user().toStdString() ||
                 pwd != parametersInfo.proxyConfigInfo().pwd().toStdString()) {
                 Proxy::instance()->setProxyConfig(ParametersCache::instance()->parameters().proxyConfig());
+                HttpSessionPool::instance()->clear();
             }
 
             resultStream << toInt(exitCode);
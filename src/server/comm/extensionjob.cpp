@@ -18,6 +18,7 @@
 
 #include "extensionjob.h"
 #include "commmanager.h"
+#include "syncrootindex.h"
 #include "appserver.h"
 #include "libcommon/utility/types.h"
 #include "libcommon/utility/utility_base.h"
@@ -53,21 +54,12 @@ bool syncForPath(const std::vector<Sync> &syncList, const SyncPath &path, Sync &
 }
 
 bool syncForPath(const SyncPath &path, Sync &sync) {
-    std::vector<Sync> syncList;
-    if (!ParmsDb::instance()->selectAllSyncs(syncList)) {
-        LOG_WARN(Log::instance()->getLogger(), "Error in ParmsDb::selectAllSyncs");
-        return false;
-    }
-
-    return syncForPath(syncList, path, sync);
+    return SyncRootIndex::instance()->syncForPath(path, sync);
 }
 
 bool syncForPaths(const std::vector<SyncPath> &paths, Sync &sync) {
     std::vector<Sync> syncList;
-    if (!ParmsDb::instance()->selectAllSyncs(syncList)) {
-        LOG_WARN(Log::instance()->getLogger(), "Error in ParmsDb::selectAllSyncs");
-        return false;
-    }
+    if (!SyncRootIndex::instance()->syncs(syncList)) return false;
 
     for (const auto &path: paths) {
         Sync tmpSync;
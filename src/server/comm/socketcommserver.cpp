@@ -21,32 +21,44 @@
 #include "libcommon/utility/utility.h"
 #include "libcommonserver/utility/utility.h"
 
+#include <Poco/Net/PollSet.h>
+
+#include <algorithm>
+#include <thread>
+
 namespace KDC {
 
 constexpr char host[] = "127.0.0.1";
 
+// The event loop is woken up on every request, the timeout only bounds the effect of a missed wake-up
+static const Poco::Timespan pollTimeout(1, 0);
+
+// Shared between the server and its channels, which may outlive it
+struct SocketCommReactorState {
+        Poco::Net::PollSet pollSet;
+        std::mutex mutex;
+        std::vector<std::weak_ptr<SocketCommChannel>> channelsToWatch;
+        std::vector<std::weak_ptr<SocketCommChannel>> lostChannels;
+
+        void push(std::vector<std::weak_ptr<SocketCommChannel>> &channels, const std::shared_ptr<SocketCommChannel> &channel) {
+            {
+                const std::scoped_lock lock(mutex);
+                channels.push_back(channel);
+            }
+            pollSet.wakeUp();
+        }
+};
+
 SocketCommChannel::SocketCommChannel(const Poco::Net::StreamSocket &socket) :
     AbstractCommChannel(),
     _socket(socket) {}
 
-void SocketCommChannel::startCallbackThread() {
-    auto callbackHandlerFct = std::function<void()>([this]() { callbackHandler(); });
-    _callbackThread = std::make_unique<StdLoggingThread>(callbackHandlerFct);
-}
-
 SocketCommChannel::~SocketCommChannel() {
-    _isClosing = true;
     try {
         close();
     } catch (std::exception &ex) {
         LOG_ERROR(Log::instance()->getLogger(), "Exception in SocketCommChannel::close: " << ex.what());
     }
-
-    if (joinCallbackThread()) {
-        LOG_DEBUG(Log::instance()->getLogger(), "Callback thread joined successfully");
-    } else {
-        LOG_ERROR(Log::instance()->getLogger(), "Failed to join callback thread");
-    }
 }
 
 uint64_t SocketCommChannel::readData(CommChar *data, uint64_t maxlen) {
@@ -67,7 +79,6 @@ uint64_t SocketCommChannel::readData(CommChar *data, uint64_t maxlen) {
         LOG_ERROR(Log::instance()->getLogger(), "Exception in StreamSocket::receiveBytes: " << ex.displayText());
         lostConnectionCbk();
         close();
-        _pendingRead = false;
         return 0;
     }
 
@@ -76,11 +87,16 @@ uint64_t SocketCommChannel::readData(CommChar *data, uint64_t maxlen) {
                   (lenReceived == 0 ? "Socket connection closed by peer" : "Socket connection error"));
         lostConnectionCbk();
         close();
-        _pendingRead = false;
         return 0;
     }
 
-    _pendingRead = false;
+    {
+        const std::scoped_lock lock(_readStateMutex);
+        _pendingRead = false;
+        // Otherwise, the socket is watched again when the readyRead callback returns
+        if (!_readScheduled) watchAgain();
+    }
+
     return static_cast<unsigned int>(lenReceived) / sizeof(CommChar);
 }
 
@@ -112,35 +128,29 @@ uint64_t SocketCommChannel::writeData(const CommChar *data, uint64_t len) {
     return static_cast<uint64_t>(written / commCharSize);
 }
 
-void SocketCommChannel::callbackHandler() {
-    while (!_isClosing) {
-        try {
-            if (!_socket.poll(Poco::Timespan(1, 0), Poco::Net::Socket::SELECT_READ | Poco::Net::Socket::SELECT_ERROR)) {
-                continue;
-            }
-        } catch (Poco::Exception &ex) {
-            LOG_ERROR(Log::instance()->getLogger(), "Exception in StreamSocket::poll: " << ex.displayText());
-            lostConnectionCbk();
-            break;
-        }
+bool SocketCommChannel::canBeWatched() {
+    const std::scoped_lock lock(_readStateMutex);
+    return !_pendingRead && !_readScheduled;
+}
 
-        try {
-            if (_socket.available() == 0) {
-                LOG_DEBUG(Log::instance()->getLogger(), "Socket connection closed by peer");
-                lostConnectionCbk();
-                break;
-            }
-        } catch (Poco::Exception &ex) {
-            LOG_ERROR(Log::instance()->getLogger(), "Exception in StreamSocket::available: " << ex.displayText());
-            lostConnectionCbk();
-            break;
-        }
+void SocketCommChannel::scheduleRead() {
+    const std::scoped_lock lock(_readStateMutex);
+    _pendingRead = true;
+    _readScheduled = true;
+}
 
-        _pendingRead = true;
-        readyReadCbk();
-        while (!_isClosing && _pendingRead) { // Wait until readData is called before polling again
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
+void SocketCommChannel::processReadyRead() {
+    readyReadCbk();
+
+    const std::scoped_lock lock(_readStateMutex);
+    _readScheduled = false;
+    if (!_pendingRead) watchAgain();
+}
+
+void SocketCommChannel::watchAgain() {
+    if (const auto reactorState = _reactorState.lock(); reactorState) {
+        reactorState->push(reactorState->channelsToWatch,
+                           std::static_pointer_cast<SocketCommChannel>(shared_from_this()));
     }
 }
 
@@ -161,22 +171,9 @@ void SocketCommChannel::close() {
     }
 }
 
-bool SocketCommChannel::joinCallbackThread() noexcept {
-    try {
-        if (_callbackThread && _callbackThread->joinable()) {
-            _callbackThread->join();
-            return true;
-        }
-    } catch (std::exception &ex) {
-        LOG_ERROR(Log::instance()->getLogger(), "Exception in StdLoggingThread::join: " << ex.what());
-    } catch (...) {
-        LOG_ERROR(Log::instance()->getLogger(), "Unknown exception in StdLoggingThread::join");
-    }
-    return false;
-}
-
 SocketCommServer::SocketCommServer(const std::string &name) :
-    AbstractCommServer(name) {}
+    AbstractCommServer(name),
+    _reactorState(std::make_shared<SocketCommReactorState>()) {}
 
 SocketCommServer::~SocketCommServer() {
     try {
@@ -184,14 +181,16 @@ SocketCommServer::~SocketCommServer() {
     } catch (std::exception &ex) {
         LOG_ERROR(Log::instance()->getLogger(), "Exception in SocketCommChannel::close: " << ex.what());
     }
-
-    joinAndClearPostponedLostConnectionCbks();
 }
 
 std::string SocketCommServer::getHost() {
     return host;
 }
 
+size_t SocketCommServer::workerCount() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4);
+}
+
 void SocketCommServer::close() {
     if (_stopAsked) {
         LOG_DEBUG(Log::instance()->getLogger(), name() << " is already stoping");
@@ -199,14 +198,7 @@ void SocketCommServer::close() {
     } else if (_isListening) {
         LOG_DEBUG(Log::instance()->getLogger(), name() << " is stopping");
         _stopAsked = true;
-        if (!_serverSocket.isNull()) {
-            Poco::Net::StreamSocket socket;
-            try {
-                socket.connect(Poco::Net::SocketAddress(host, getPort())); // Connect to unblock accept
-            } catch (Poco::Exception &ex) {
-                LOG_ERROR(Log::instance()->getLogger(), "Exception in StreamSocket::connect: " << ex.displayText());
-            }
-        }
+        _reactorState->pollSet.wakeUp();
 
         if (_serverSocketThread && _serverSocketThread->joinable()) {
             _serverSocketThread->join();
@@ -281,67 +273,202 @@ void SocketCommServer::execute() {
 
     LOG_DEBUG(Log::instance()->getLogger(), name() << " listening on port " << getPort());
     saveCommPort(getPort());
+    try {
+        _serverSocket.listen();
+    } catch (Poco::Exception &ex) {
+        LOG_ERROR(Log::instance()->getLogger(), "Exception in ServerSocket::listen: " << ex.displayText());
+        return;
+    }
+
+    watch(_serverSocket);
+    startWorkers();
+    _isListening = true;
+
     while (!_stopAsked) {
+        processPendingRequests();
+
+        Poco::Net::PollSet::SocketModeMap readySockets;
         try {
-            _serverSocket.listen();
+            readySockets = _reactorState->pollSet.poll(pollTimeout);
         } catch (Poco::Exception &ex) {
-            LOG_ERROR(Log::instance()->getLogger(), "Exception in ServerSocket::listen: " << ex.displayText());
-            return;
+            LOG_ERROR(Log::instance()->getLogger(), "Exception in PollSet::poll: " << ex.displayText());
+            Utility::msleep(100);
+            continue;
+        }
+
+        if (_stopAsked) break;
+
+        for (const auto &[socket, mode]: readySockets) {
+            if (socket == _serverSocket) {
+                acceptConnection();
+                continue;
+            }
+
+            const auto channelIt = _socketChannels.find(socket);
+            if (channelIt == _socketChannels.end()) continue;
+            const auto channel = channelIt->second;
+
+            // Stop watching the socket until its data has been read
+            unwatch(socket);
+
+            bool connectionLost = false;
+            try {
+                connectionLost = channel->_socket.available() == 0;
+                if (connectionLost) LOG_DEBUG(Log::instance()->getLogger(), "Socket connection closed by peer");
+            } catch (Poco::Exception &ex) {
+                LOG_ERROR(Log::instance()->getLogger(), "Exception in StreamSocket::available: " << ex.displayText());
+                connectionLost = true;
+            }
+
+            if (connectionLost) {
+                channel->lostConnectionCbk();
+                continue;
+            }
+
+            channel->scheduleRead();
+            {
+                const std::scoped_lock lock(_readyChannelsMutex);
+                _readyChannels.push_back(channel);
+            }
+            _readyChannelsCv.notify_one();
         }
+    }
 
-        _isListening = true;
-        Poco::Net::StreamSocket socket;
+    stopWorkers();
+    for (const auto &socket: _watchedSockets) {
         try {
-            socket = _serverSocket.acceptConnection();
+            _reactorState->pollSet.remove(socket);
         } catch (Poco::Exception &ex) {
-            LOG_ERROR(Log::instance()->getLogger(), "Exception in ServerSocket::acceptConnection: " << ex.displayText());
-            return;
+            LOG_ERROR(Log::instance()->getLogger(), "Exception in PollSet::remove: " << ex.displayText());
         }
+    }
+    _watchedSockets.clear();
+    _socketChannels.clear();
+    _isListening = false;
+}
 
-        if (_stopAsked) break;
+void SocketCommServer::acceptConnection() {
+    Poco::Net::StreamSocket socket;
+    try {
+        socket = _serverSocket.acceptConnection();
+    } catch (Poco::Exception &ex) {
+        LOG_ERROR(Log::instance()->getLogger(), "Exception in ServerSocket::acceptConnection: " << ex.displayText());
+        return;
+    }
 
-        const auto channel = makeCommChannel(socket);
-        channel->setLostConnectionCbk([this](std::shared_ptr<AbstractCommChannel> ch) {
-            std::function<void()> postponedLostConnectionCbk = [this, ch]() {
-                auto channelPtr = std::dynamic_pointer_cast<SocketCommChannel>(ch);
-                if (channelPtr && channelPtr->joinCallbackThread()) {
-                    const std::scoped_lock lock(_channelsMutex);
-                    (void) _channels.remove(ch);
-                    lostConnectionCbk(ch);
-                } else {
-                    LOG_WARN(Log::instance()->getLogger(),
-                             "Failed to join callback thread for channel " << ch->id() << " on lost connection");
+    const auto channel = makeCommChannel(socket);
+    channel->_reactorState = _reactorState;
+    channel->setLostConnectionCbk(
+            [reactorState = std::weak_ptr<SocketCommReactorState>(_reactorState)](std::shared_ptr<AbstractCommChannel> ch) {
+                // The channel is removed by the event loop thread, which is the only one watching the sockets
+                if (const auto state = reactorState.lock(); state) {
+                    state->push(state->lostChannels, std::static_pointer_cast<SocketCommChannel>(ch));
                 }
-            };
+            });
 
-            // Postpone _channels.remove(ch), as it may destroy the channel and its
-            // SocketCommChannel::callbackHandler thread while the current code
-            // (SocketCommChannel::lostConnectionCbk) is executing from this same callbackHandler thread.
-            (void) _postponedLostConnectionCbks.emplace_back(std::make_shared<StdLoggingThread>(postponedLostConnectionCbk));
-        });
+    _socketChannels[socket] = channel;
+    {
+        const std::scoped_lock lock(_channelsMutex);
+        _channels.push_back(channel);
+    }
+    newConnectionCbk();
+    watch(socket);
+}
 
-        {
-            const std::scoped_lock lock(_channelsMutex);
-            _channels.push_back(channel);
-        }
-        newConnectionCbk();
-        channel->startCallbackThread();
+void SocketCommServer::processPendingRequests() {
+    std::vector<std::weak_ptr<SocketCommChannel>> channelsToWatch;
+    std::vector<std::weak_ptr<SocketCommChannel>> lostChannels;
+    {
+        const std::scoped_lock lock(_reactorState->mutex);
+        channelsToWatch.swap(_reactorState->channelsToWatch);
+        lostChannels.swap(_reactorState->lostChannels);
+    }
 
-        // Clear terminated postponed lost-connection callback threads to avoid accumulating too many threads in case of many
-        // connections/disconnections (edge case as the application is not expected to handle more than one connection at a time,
-        // but better be safe)
-        joinAndClearPostponedLostConnectionCbks();
+    for (const auto &lostChannel: lostChannels) {
+        if (const auto channel = lostChannel.lock(); channel) removeChannel(channel);
+    }
+
+    for (const auto &channelToWatch: channelsToWatch) {
+        const auto channel = channelToWatch.lock();
+        if (!channel || !_socketChannels.contains(channel->_socket)) continue;
+        // A request may be outdated if the channel has been signaled again in the meantime
+        if (channel->canBeWatched()) watch(channel->_socket);
     }
-    _isListening = false;
 }
-void SocketCommServer::joinAndClearPostponedLostConnectionCbks() {
-    // Join and remove all postponed lost-connection callback threads
-    for (const auto& thread: _postponedLostConnectionCbks) {
-        if (thread->joinable()) {
-            thread->join();
-        }
+
+void SocketCommServer::watch(const Poco::Net::Socket &socket) {
+    if (_watchedSockets.contains(socket)) return;
+
+    try {
+        _reactorState->pollSet.add(socket, Poco::Net::PollSet::POLL_READ);
+        (void) _watchedSockets.insert(socket);
+    } catch (Poco::Exception &ex) {
+        LOG_ERROR(Log::instance()->getLogger(), "Exception in PollSet::add: " << ex.displayText());
     }
+}
+
+void SocketCommServer::unwatch(const Poco::Net::Socket &socket) {
+    if (!_watchedSockets.erase(socket)) return;
 
-    _postponedLostConnectionCbks.clear();
+    try {
+        _reactorState->pollSet.remove(socket);
+    } catch (Poco::Exception &ex) {
+        LOG_ERROR(Log::instance()->getLogger(), "Exception in PollSet::remove: " << ex.displayText());
+    }
 }
+
+void SocketCommServer::removeChannel(const std::shared_ptr<SocketCommChannel> &channel) {
+    const auto channelIt = _socketChannels.find(channel->_socket);
+    if (channelIt == _socketChannels.end()) return; // Already removed
+
+    unwatch(channel->_socket);
+    (void) _socketChannels.erase(channelIt);
+    {
+        const std::scoped_lock lock(_channelsMutex);
+        (void) _channels.remove(channel);
+    }
+    lostConnectionCbk(channel);
+}
+
+void SocketCommServer::startWorkers() {
+    {
+        const std::scoped_lock lock(_readyChannelsMutex);
+        _stopWorkers = false;
+    }
+
+    for (size_t index = 0; index < workerCount(); ++index) {
+        (void) _workers.emplace_back(std::make_unique<StdLoggingThread>(std::function<void()>([this]() { runWorker(); })));
+    }
+}
+
+void SocketCommServer::stopWorkers() {
+    {
+        const std::scoped_lock lock(_readyChannelsMutex);
+        _stopWorkers = true;
+        _readyChannels.clear();
+    }
+    _readyChannelsCv.notify_all();
+
+    for (const auto &worker: _workers) {
+        if (worker->joinable()) worker->join();
+    }
+    _workers.clear();
+}
+
+void SocketCommServer::runWorker() {
+    while (true) {
+        std::shared_ptr<SocketCommChannel> channel;
+        {
+            std::unique_lock lock(_readyChannelsMutex);
+            _readyChannelsCv.wait(lock, [this]() { return _stopWorkers || !_readyChannels.empty(); });
+            if (_stopWorkers) return;
+
+            channel = _readyChannels.front();
+            _readyChannels.pop_front();
+        }
+
+        channel->processReadyRead();
+    }
+}
+
 } // namespace KDC
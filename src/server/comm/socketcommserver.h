@@ -25,19 +25,25 @@
 #include <Poco/Net/Socket.h>
 #include <Poco/Net/ServerSocket.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+
 namespace KDC {
 
+struct SocketCommReactorState;
+
 class SocketCommChannel : public AbstractCommChannel {
     public:
         explicit SocketCommChannel(const Poco::Net::StreamSocket &socket);
         ~SocketCommChannel();
-        void startCallbackThread();
 
         uint64_t bytesAvailable() const override;
         void close() override;
 
-        bool joinCallbackThread() noexcept;
-
     protected:
         // Return number of CommChar (/!\ not always equal the number of bytes) read or 0 on error or closed connection
         uint64_t readData(CommChar *data, uint64_t maxlen) override;
@@ -46,14 +52,28 @@ class SocketCommChannel : public AbstractCommChannel {
         uint64_t writeData(const CommChar *data, uint64_t len) override;
 
     private:
-        bool _isClosing = false;
-        bool _pendingRead = false;
-        std::unique_ptr<StdLoggingThread> _callbackThread{nullptr};
         Poco::Net::StreamSocket _socket;
 
-        void callbackHandler();
+        // The server stops watching the socket once it has signaled that data is ready, until the data has been read.
+        // A client sending faster than its requests are handled is therefore held back by the TCP flow control.
+        std::mutex _readStateMutex;
+        bool _pendingRead = false; // Data was signaled and has not been read yet
+        bool _readScheduled = false; // The readyRead callback is queued or running
+        std::weak_ptr<SocketCommReactorState> _reactorState;
+
+        bool canBeWatched();
+        void scheduleRead();
+        void processReadyRead();
+        void watchAgain();
+
+        friend class SocketCommServer;
 };
 
+/**
+ * A single event loop thread polls the listening socket and all the connected sockets. When a connection has data to read,
+ * its readyRead callback is run by a small pool of worker threads, so the number of threads does not depend on the number
+ * of connections.
+ */
 class SocketCommServer : public AbstractCommServer {
     public:
         SocketCommServer(const std::string &name);
@@ -65,6 +85,8 @@ class SocketCommServer : public AbstractCommServer {
         std::shared_ptr<AbstractCommChannel> nextPendingConnection() override;
         std::list<std::shared_ptr<AbstractCommChannel>> connections() override;
 
+        static size_t workerCount();
+
     protected:
         virtual std::shared_ptr<SocketCommChannel> makeCommChannel(Poco::Net::StreamSocket &socket) const = 0;
 
@@ -72,12 +94,32 @@ class SocketCommServer : public AbstractCommServer {
         Poco::Net::ServerSocket _serverSocket;
         std::recursive_mutex _channelsMutex;
         std::list<std::shared_ptr<AbstractCommChannel>> _channels;
-        bool _isListening = false;
-        bool _stopAsked = false;
+        std::atomic_bool _isListening = false;
+        std::atomic_bool _stopAsked = false;
         std::unique_ptr<StdLoggingThread> _serverSocketThread{nullptr};
+        std::shared_ptr<SocketCommReactorState> _reactorState;
+
+        // Only accessed by the event loop thread
+        std::map<Poco::Net::Socket, std::shared_ptr<SocketCommChannel>> _socketChannels;
+        std::set<Poco::Net::Socket> _watchedSockets;
+
+        // Channels with data to read, waiting for a worker
+        std::mutex _readyChannelsMutex;
+        std::condition_variable _readyChannelsCv;
+        std::deque<std::shared_ptr<SocketCommChannel>> _readyChannels;
+        bool _stopWorkers = false;
+        std::vector<std::unique_ptr<StdLoggingThread>> _workers;
+
         void execute();
-        void joinAndClearPostponedLostConnectionCbks();
-        std::vector<std::shared_ptr<StdLoggingThread>> _postponedLostConnectionCbks;
+        void acceptConnection();
+        void processPendingRequests();
+        void watch(const Poco::Net::Socket &socket);
+        void unwatch(const Poco::Net::Socket &socket);
+        void removeChannel(const std::shared_ptr<SocketCommChannel> &channel);
+
+        void startWorkers();
+        void stopWorkers();
+        void runWorker();
 };
 
 } // namespace KDC
@@ -0,0 +1,92 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "syncrootindex.h"
+#include "libcommon/utility/utility.h"
+#include "libcommonserver/log/log.h"
+#include "libparms/db/parmsdb.h"
+
+#include <algorithm>
+
+#include <log4cplus/loggingmacros.h>
+
+namespace KDC {
+
+std::shared_ptr<SyncRootIndex> SyncRootIndex::_instance = nullptr;
+
+std::shared_ptr<SyncRootIndex> SyncRootIndex::instance() {
+    static std::mutex instanceMutex;
+    const std::scoped_lock lock(instanceMutex);
+    if (_instance == nullptr) {
+        _instance = std::shared_ptr<SyncRootIndex>(new SyncRootIndex());
+    }
+
+    return _instance;
+}
+
+bool SyncRootIndex::syncForPath(const SyncPath &path, Sync &sync) {
+    const std::scoped_lock lock(_mutex);
+    if (!refreshIfNeeded()) return false;
+
+    for (const Sync &tmpSync: _syncList) {
+        if (CommonUtility::isSubDir(tmpSync.localPath(), path)) {
+            sync = tmpSync;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SyncRootIndex::syncs(std::vector<Sync> &syncList) {
+    const std::scoped_lock lock(_mutex);
+    if (!refreshIfNeeded()) return false;
+
+    syncList = _syncList;
+    return true;
+}
+
+bool SyncRootIndex::refreshIfNeeded() {
+    const auto parmsDb = ParmsDb::instance();
+    if (!parmsDb) {
+        LOG_WARN(Log::instance()->getLogger(), "ParmsDb is not initialized");
+        return false;
+    }
+
+    // Read the revision before the list so that a concurrent change triggers another reload on the next call
+    const uint64_t syncsRevision = parmsDb->syncsRevision();
+    if (_parmsDb.lock() == parmsDb && _syncsRevision == syncsRevision) return true;
+
+    std::vector<Sync> syncList;
+    if (!parmsDb->selectAllSyncs(syncList)) {
+        LOG_WARN(Log::instance()->getLogger(), "Error in ParmsDb::selectAllSyncs");
+        return false;
+    }
+
+    std::ranges::stable_sort(syncList, [](const Sync &sync1, const Sync &sync2) {
+        return sync1.localPath().native().size() > sync2.localPath().native().size();
+    });
+
+    _syncList = std::move(syncList);
+    _parmsDb = parmsDb;
+    _syncsRevision = syncsRevision;
+    return true;
+}
+
+} // namespace KDC
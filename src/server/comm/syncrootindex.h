@@ -0,0 +1,61 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "libcommon/utility/types.h"
+#include "libparms/db/sync.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace KDC {
+
+class ParmsDb;
+
+/**
+ * In-memory copy of the sync list, used to find the sync containing a local path without querying ParmsDb.
+ * The list is reloaded from ParmsDb only when a sync has been added, updated, paused or removed since the last load.
+ */
+class SyncRootIndex {
+    public:
+        static std::shared_ptr<SyncRootIndex> instance();
+
+        SyncRootIndex(SyncRootIndex const &) = delete;
+        void operator=(SyncRootIndex const &) = delete;
+
+        // Returns false if the sync list cannot be loaded or if `path` is not located in a sync
+        bool syncForPath(const SyncPath &path, Sync &sync);
+        bool syncs(std::vector<Sync> &syncList);
+
+    private:
+        static std::shared_ptr<SyncRootIndex> _instance;
+
+        // Sorted by decreasing local path length so that the innermost sync root is matched first
+        std::vector<Sync> _syncList;
+        std::weak_ptr<ParmsDb> _parmsDb;
+        uint64_t _syncsRevision{0};
+        std::mutex _mutex;
+
+        SyncRootIndex() = default;
+        bool refreshIfNeeded();
+};
+
+} // namespace KDC
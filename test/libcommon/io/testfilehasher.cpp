@@ -0,0 +1,125 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testfilehasher.h"
+
+#include "libcommonserver/io/filehasher.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <xxhash.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr size_t pageSize = 4096;
+constexpr size_t readSize = 64 * 1024;
+constexpr std::array<FileHasher::Strategy, 4> strategies = {FileHasher::Strategy::Buffered, FileHasher::Strategy::LargeReads,
+                                                            FileHasher::Strategy::MemoryMapped, FileHasher::Strategy::Auto};
+
+std::string randomContent(const size_t size) {
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::string content(size, '\0');
+    for (auto &c: content) {
+        c = static_cast<char>(distribution(generator));
+    }
+    return content;
+}
+
+void writeFile(const SyncPath &path, const std::string &content) {
+    std::ofstream ofs(path, std::ios_base::binary | std::ios_base::trunc);
+    ofs << content;
+}
+
+std::string hashToStr(const FileHasher::Strategy strategy, const SyncPath &path, const size_t chunkSize = readSize) {
+    FileHasher::Settings settings;
+    settings.strategy = strategy;
+    settings.readSize = chunkSize;
+    settings.mmapThreshold = static_cast<int64_t>(chunkSize); // `Strategy::Auto` maps the files larger than a chunk
+
+    XXH64_hash_t hash = 0;
+    CPPUNIT_ASSERT_EQUAL(IoError::Success, FileHasher::xxh3(path, hash, settings));
+    return Utility::xxHashToStr(hash);
+}
+
+} // namespace
+
+void TestFileHasher::testFileSizes() {
+    const SyncPath path = _localTempDir.path() / "file.bin";
+    for (const size_t size: {size_t{0}, size_t{1}, pageSize - 1, pageSize, pageSize + 1, readSize - 1, readSize, readSize + 1,
+                             3 * readSize + 7}) {
+        const auto content = randomContent(size);
+        writeFile(path, content);
+        const auto expected = Utility::xxHashToStr(XXH3_64bits(content.data(), content.size()));
+
+        for (const auto strategy: strategies) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("size=" + std::to_string(size), expected, hashToStr(strategy, path));
+        }
+
+        // A read size which is not a multiple of the page size
+        CPPUNIT_ASSERT_EQUAL(expected, hashToStr(FileHasher::Strategy::LargeReads, path, pageSize + 1));
+        CPPUNIT_ASSERT_EQUAL(expected, hashToStr(FileHasher::Strategy::MemoryMapped, path, 1));
+    }
+}
+
+void TestFileHasher::testDefaultSettings() {
+    const SyncPath path = _localTempDir.path() / "file.bin";
+    const auto content = randomContent(FileHasher::defaultReadSize + 1);
+    writeFile(path, content);
+
+    XXH64_hash_t hash = 0;
+    CPPUNIT_ASSERT_EQUAL(IoError::Success, FileHasher::xxh3(path, hash));
+    CPPUNIT_ASSERT_EQUAL(XXH3_64bits(content.data(), content.size()), hash);
+}
+
+void TestFileHasher::testSparseFile() {
+    const SyncPath path = _localTempDir.path() / "sparse.bin";
+    const std::string head = "Lorem ipsum dolor sit amet";
+    writeFile(path, head);
+
+    // The extended part is a hole on the file systems supporting sparse files, and reads as zeros
+    constexpr uintmax_t size = 5 * readSize + 3;
+    std::filesystem::resize_file(path, size);
+    std::string content = head;
+    content.resize(size, '\0');
+    const auto expected = Utility::xxHashToStr(XXH3_64bits(content.data(), content.size()));
+
+    for (const auto strategy: strategies) {
+        CPPUNIT_ASSERT_EQUAL(expected, hashToStr(strategy, path));
+    }
+}
+
+void TestFileHasher::testMissingFile() {
+    const SyncPath path = _localTempDir.path() / "missing.bin";
+    for (const auto strategy: strategies) {
+        FileHasher::Settings settings;
+        settings.strategy = strategy;
+        XXH64_hash_t hash = 0;
+        CPPUNIT_ASSERT_EQUAL(IoError::NoSuchFileOrDirectory, FileHasher::xxh3(path, hash, settings));
+    }
+}
+
+} // namespace KDC
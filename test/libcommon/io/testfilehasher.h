@@ -0,0 +1,48 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/localtemporarydirectory.h"
+
+namespace KDC {
+
+class TestFileHasher final : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestFileHasher);
+        CPPUNIT_TEST(testFileSizes);
+        CPPUNIT_TEST(testDefaultSettings);
+        CPPUNIT_TEST(testSparseFile);
+        CPPUNIT_TEST(testMissingFile);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override { TestBase::start(); }
+        void tearDown() override { TestBase::stop(); }
+
+    private:
+        // All the strategies yield the digest of the whole content, whatever the file size compared to the page and read sizes
+        void testFileSizes();
+        void testDefaultSettings();
+        void testSparseFile();
+        void testMissingFile();
+
+        LocalTemporaryDirectory _localTempDir{"TestFileHasher"};
+};
+
+} // namespace KDC
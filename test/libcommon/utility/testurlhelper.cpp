@@ -63,4 +63,17 @@ void TestUrlHelper::testGetUrl() {
     CPPUNIT_ASSERT_EQUAL(true, CommonUtility::endsWith(UrlHelper::notifyApiUrl(123), "/123"));
 }
 
+void TestUrlHelper::testCustomApiUrl() {
+    const std::string customApiUrl = "http://127.0.0.1:8080/";
+    UrlHelper::setCustomApiUrl(customApiUrl);
+
+    CPPUNIT_ASSERT_EQUAL(customApiUrl + "2", UrlHelper::infomaniakApiUrl());
+    CPPUNIT_ASSERT_EQUAL(customApiUrl + "3", UrlHelper::kDriveApiUrl(3));
+    CPPUNIT_ASSERT_EQUAL(customApiUrl + "2", UrlHelper::notifyApiUrl());
+    CPPUNIT_ASSERT(!CommonUtility::startsWith(UrlHelper::loginApiUrl(), customApiUrl));
+
+    UrlHelper::setCustomApiUrl("");
+    CPPUNIT_ASSERT(!CommonUtility::startsWith(UrlHelper::kDriveApiUrl(), customApiUrl));
+}
+
 } // namespace KDC
@@ -25,6 +25,7 @@ namespace KDC {
 class TestUrlHelper final : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST_SUITE(TestUrlHelper);
         CPPUNIT_TEST(testGetUrl);
+        CPPUNIT_TEST(testCustomApiUrl);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -33,6 +34,7 @@ class TestUrlHelper final : public CppUnit::TestFixture, public TestBase {
 
     protected:
         void testGetUrl();
+        void testCustomApiUrl();
 };
 
 } // namespace KDC
@@ -19,10 +19,12 @@
 #include "testincludes.h"
 
 #include "utility/testutility.h"
+#include "utility/testfreediskspacetracker.h"
 #include "db/testdb.h"
 
 namespace KDC {
 CPPUNIT_TEST_SUITE_REGISTRATION(TestUtility);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFreeDiskSpaceTracker);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestDb);
 } // namespace KDC
 
@@ -0,0 +1,182 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "testfreediskspacetracker.h"
+#include "libcommonserver/utility/utility.h"
+#include "libcommon/utility/utility.h"
+
+#include <thread>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int64_t oneGB = 1000 * 1000 * 1000LL;
+constexpr int64_t oneMB = 1000 * 1000LL;
+
+const SyncPath syncRoot = SyncPath("fake") / "kDrive";
+const SyncPath otherSyncRoot = SyncPath("fake") / "external" / "kDrive";
+
+} // namespace
+
+void TestFreeDiskSpaceTracker::setUp() {
+    TestBase::start();
+    _freeSpaces.clear();
+    _queryCount = 0;
+}
+
+FreeDiskSpaceTracker::FreeDiskSpaceProvider TestFreeDiskSpaceTracker::provider() {
+    return [this](const SyncPath &path) -> int64_t {
+        ++_queryCount;
+        // The volume containing `path`
+        for (auto it = _freeSpaces.rbegin(); it != _freeSpaces.rend(); ++it) {
+            if (CommonUtility::isSubDir(it->first, path)) return it->second;
+        }
+        return -1;
+    };
+}
+
+void TestFreeDiskSpaceTracker::testCachedFreeDiskSpace() {
+    _freeSpaces[syncRoot] = 100 * oneGB;
+    FreeDiskSpaceTracker tracker(provider(), std::chrono::hours(1));
+
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt", oneMB));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _queryCount);
+
+    // Any item of the same directory, or of its subdirectories, is served from the cache
+    for (int i = 0; i < 1000; ++i) {
+        const SyncPath path = syncRoot / ("dir" + std::to_string(i % 10)) / ("file" + std::to_string(i) + ".txt");
+        CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(path, oneMB));
+    }
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _queryCount);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), tracker.queryCount());
+
+    // The free space changed, but the tracker is not aware of it until its cache is cleared
+    _freeSpaces[syncRoot] = 50 * oneGB;
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt", oneMB));
+    tracker.clear();
+    CPPUNIT_ASSERT_EQUAL(50 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt", oneMB));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _queryCount);
+}
+
+void TestFreeDiskSpaceTracker::testRefreshInterval() {
+    _freeSpaces[syncRoot] = 100 * oneGB;
+    FreeDiskSpaceTracker tracker(provider(), std::chrono::milliseconds(50));
+
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt"));
+    _freeSpaces[syncRoot] = 50 * oneGB;
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _queryCount);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    CPPUNIT_ASSERT_EQUAL(50 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _queryCount);
+}
+
+void TestFreeDiskSpaceTracker::testLowDiskSpace() {
+    _freeSpaces[syncRoot] = 100 * oneGB;
+    FreeDiskSpaceTracker tracker(provider(), std::chrono::hours(1), oneGB);
+
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt", oneMB));
+
+    // Another application fills the disk: the cached value is still far above the limit
+    _freeSpaces[syncRoot] = 1100 * oneMB;
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt", oneMB));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _queryCount);
+
+    // A large file brings the cached value close to the limit, hence a new query
+    const int64_t largeFileSize = 99 * oneGB;
+    CPPUNIT_ASSERT_EQUAL(1100 * oneMB, tracker.freeDiskSpace(syncRoot / "large.bin", largeFileSize));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _queryCount);
+
+    // From now on, every check is close to the limit and the free space is always queried again
+    _freeSpaces[syncRoot] = 200 * oneMB;
+    const int64_t freeSpace = tracker.freeDiskSpace(syncRoot / "file.txt", oneMB);
+    CPPUNIT_ASSERT_EQUAL(200 * oneMB, freeSpace);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(3), _queryCount);
+    CPPUNIT_ASSERT_MESSAGE("A download must be refused", freeSpace < oneMB + Utility::freeDiskSpaceLimit());
+
+    // Some space has been freed
+    _freeSpaces[syncRoot] = 300 * oneMB;
+    CPPUNIT_ASSERT_EQUAL(300 * oneMB, tracker.freeDiskSpace(syncRoot / "file.txt", oneMB));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), _queryCount);
+}
+
+void TestFreeDiskSpaceTracker::testReservedSpace() {
+    _freeSpaces[syncRoot] = 100 * oneGB;
+    FreeDiskSpaceTracker tracker(provider(), std::chrono::hours(1), oneGB);
+
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file1.bin", 60 * oneGB));
+    tracker.reserve(syncRoot / "file1.bin", 60 * oneGB);
+
+    // The reserved space is not available to the other downloads, even before it is actually written
+    int64_t freeSpace = tracker.freeDiskSpace(syncRoot / "file2.bin", 50 * oneGB);
+    CPPUNIT_ASSERT_EQUAL(40 * oneGB, freeSpace);
+    CPPUNIT_ASSERT_MESSAGE("A download must be refused", freeSpace < 50 * oneGB + Utility::freeDiskSpaceLimit());
+    // The estimate was too close to the space needed, so it has been checked against the file system
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _queryCount);
+
+    // The first download failed, its space is available again
+    tracker.release(syncRoot / "file1.bin", 60 * oneGB, false);
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file2.bin", 50 * oneGB));
+
+    // The second download succeeded, the cached value is updated without a new query
+    tracker.reserve(syncRoot / "file2.bin", 50 * oneGB);
+    _freeSpaces[syncRoot] = 50 * oneGB;
+    tracker.release(syncRoot / "file2.bin", 50 * oneGB, true);
+    const auto queryCount = _queryCount;
+    CPPUNIT_ASSERT_EQUAL(50 * oneGB, tracker.freeDiskSpace(syncRoot / "file3.bin", oneMB));
+    CPPUNIT_ASSERT_EQUAL(queryCount, _queryCount);
+}
+
+void TestFreeDiskSpaceTracker::testSeveralVolumes() {
+    _freeSpaces[syncRoot] = 100 * oneGB;
+    _freeSpaces[otherSyncRoot] = 10 * oneGB;
+    FreeDiskSpaceTracker tracker(provider(), std::chrono::hours(1));
+
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(10 * oneGB, tracker.freeDiskSpace(otherSyncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _queryCount);
+
+    // A reservation only applies to its own volume
+    tracker.reserve(otherSyncRoot / "file.txt", 5 * oneGB);
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(5 * oneGB, tracker.freeDiskSpace(otherSyncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _queryCount);
+}
+
+void TestFreeDiskSpaceTracker::testQueryError() {
+    FreeDiskSpaceTracker tracker(provider(), std::chrono::hours(1));
+
+    // Errors are not cached
+    CPPUNIT_ASSERT_EQUAL(int64_t(-1), tracker.freeDiskSpace(syncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(int64_t(-1), tracker.freeDiskSpace(syncRoot / "file.txt"));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _queryCount);
+
+    _freeSpaces[syncRoot] = 100 * oneGB;
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt"));
+
+    // Reserving space on an unknown volume has no effect
+    tracker.reserve(otherSyncRoot / "file.txt", oneGB);
+    CPPUNIT_ASSERT_EQUAL(100 * oneGB, tracker.freeDiskSpace(syncRoot / "file.txt"));
+}
+
+} // namespace KDC
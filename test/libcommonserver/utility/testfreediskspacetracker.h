@@ -0,0 +1,59 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+#include "libcommonserver/utility/freediskspacetracker.h"
+
+#include <map>
+
+namespace KDC {
+
+class TestFreeDiskSpaceTracker : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestFreeDiskSpaceTracker);
+        CPPUNIT_TEST(testCachedFreeDiskSpace);
+        CPPUNIT_TEST(testRefreshInterval);
+        CPPUNIT_TEST(testLowDiskSpace);
+        CPPUNIT_TEST(testReservedSpace);
+        CPPUNIT_TEST(testSeveralVolumes);
+        CPPUNIT_TEST(testQueryError);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override { TestBase::stop(); }
+
+    protected:
+        void testCachedFreeDiskSpace();
+        void testRefreshInterval();
+        void testLowDiskSpace();
+        void testReservedSpace();
+        void testSeveralVolumes();
+        void testQueryError();
+
+    private:
+        // Fake file system: free space of each volume, identified by a root directory
+        std::map<SyncPath, int64_t> _freeSpaces;
+        uint64_t _queryCount{0};
+
+        FreeDiskSpaceTracker::FreeDiskSpaceProvider provider();
+};
+
+} // namespace KDC
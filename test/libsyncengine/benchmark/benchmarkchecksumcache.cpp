@@ -0,0 +1,119 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkchecksumcache.h"
+
+#include "db/syncdb.h"
+#include "update_detection/file_system_observer/checksum/computechecksumjob.h"
+#include "update_detection/file_system_observer/snapshot/livesnapshot.h"
+#include "libcommonserver/io/iohelper.h"
+#include "libcommonserver/utility/utility.h"
+#include "utility/timerutility.h"
+
+#include <version.h>
+#include <mocks/libcommonserver/db/mockdb.h>
+
+#include <fstream>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 100;
+constexpr int filesPerDir = 1000;
+constexpr int fileSize = 4096;
+
+} // namespace
+
+void BenchmarkChecksumCache::setUp() {
+    TestBase::start();
+
+    const DbNode dummyRootNode(0, std::nullopt, SyncName(), SyncName(), "1", "1", std::nullopt, std::nullopt, std::nullopt,
+                               NodeType::Directory, 0, std::nullopt);
+    _liveSnapshot = std::make_shared<LiveSnapshot>(ReplicaSide::Local, dummyRootNode);
+
+    // Generate the tree
+    const TimerUtility timer;
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const SyncPath dirPath = _localTempDir.path() / ("dir_" + std::to_string(dirIndex));
+        (void) std::filesystem::create_directory(dirPath);
+        for (int fileIndex = 0; fileIndex < filesPerDir; ++fileIndex) {
+            const SyncPath filePath = dirPath / ("file_" + std::to_string(fileIndex));
+            std::string content = std::to_string(dirIndex * filesPerDir + fileIndex);
+            content.resize(fileSize, 'a');
+            std::ofstream(filePath, std::ios_base::binary) << content;
+
+            NodeId nodeId;
+            CPPUNIT_ASSERT(IoHelper::getNodeId(filePath, nodeId));
+            const SnapshotItem item(nodeId, "1", filePath.filename().native(), 0, 0, NodeType::File, fileSize, false, true,
+                                    true);
+            CPPUNIT_ASSERT(_liveSnapshot->updateItem(item));
+            (void) _files.emplace_back(nodeId, filePath);
+        }
+    }
+    std::cout << std::endl;
+    std::cout << "Tree of " << _files.size() << " files generated in " << timer.elapsed<DoubleSeconds>().count() << "s"
+              << std::endl;
+
+    // Checksums of files whose status changed during the current second are not cached
+    Utility::msleep(1100);
+}
+
+void BenchmarkChecksumCache::tearDown() {
+    _liveSnapshot.reset();
+    _files.clear();
+    TestBase::stop();
+}
+
+double BenchmarkChecksumCache::computeAllChecksums(const std::shared_ptr<SyncDb> &syncDb) {
+    const TimerUtility timer;
+    for (const auto &[nodeId, filePath]: _files) {
+        ComputeChecksumJob job(nodeId, filePath, _liveSnapshot, syncDb);
+        (void) job.runSynchronously();
+    }
+    return timer.elapsed<DoubleSeconds>().count();
+}
+
+void BenchmarkChecksumCache::benchmarkRestart() {
+    bool alreadyExists = false;
+    const std::filesystem::path syncDbPath = MockDb::makeDbName(alreadyExists);
+
+    auto syncDb = std::make_shared<SyncDb>(syncDbPath.string());
+    CPPUNIT_ASSERT(syncDb->init(KDRIVE_VERSION_STRING));
+
+    const double noCacheDuration = computeAllChecksums(nullptr);
+    std::cout << "Without cache: " << noCacheDuration << "s" << std::endl;
+
+    const double coldCacheDuration = computeAllChecksums(syncDb);
+    std::cout << "Cold cache: " << coldCacheDuration << "s" << std::endl;
+
+    // Restart
+    syncDb->close();
+    syncDb = std::make_shared<SyncDb>(syncDbPath.string());
+    CPPUNIT_ASSERT(syncDb->init(KDRIVE_VERSION_STRING));
+    syncDb->setAutoDelete(true);
+
+    const double warmCacheDuration = computeAllChecksums(syncDb);
+    std::cout << "Warm cache after restart: " << warmCacheDuration << "s" << std::endl;
+
+    syncDb->close();
+}
+
+} // namespace KDC
@@ -0,0 +1,49 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/localtemporarydirectory.h"
+
+namespace KDC {
+
+class SyncDb;
+class LiveSnapshot;
+
+class BenchmarkChecksumCache : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkChecksumCache);
+        CPPUNIT_TEST(benchmarkRestart);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // Compare the checksum computation of a 100k files tree with a cold cache and after a restart.
+        void benchmarkRestart();
+
+        double computeAllChecksums(const std::shared_ptr<SyncDb> &syncDb);
+
+        LocalTemporaryDirectory _localTempDir{"BenchmarkChecksumCache"};
+        std::vector<std::pair<NodeId, SyncPath>> _files;
+        std::shared_ptr<LiveSnapshot> _liveSnapshot;
+};
+
+} // namespace KDC
@@ -0,0 +1,170 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkcsvlisting.h"
+
+#include "db/parmsdb.h"
+#include "jobs/syncjobmanager.h"
+#include "jobs/network/httpsessionpool.h"
+#include "jobs/network/kDrive_API/listing/csvfullfilelistwithcursorjob.h"
+#include "keychainmanager/keychainmanager.h"
+#include "network/proxy.h"
+#include "utility/timerutility.h"
+#include "libcommon/utility/urlhelper.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <Poco/DeflatingStream.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(KD_LINUX)
+#include <unistd.h>
+#endif
+
+#include <version.h>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 5000;
+constexpr int filesPerDir = 1000;
+constexpr size_t sliceSize = 64 * 1024;
+
+// Resident memory of the process in MB, 0 if not available.
+double residentMemory() {
+#if defined(KD_LINUX)
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    statm >> size >> resident;
+    return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+void BenchmarkCsvListing::setUp() {
+    TestBase::start();
+
+    // One line per directory and per file, compressed on the fly to keep the uncompressed listing out of memory
+    std::ostringstream zippedCsv;
+    {
+        Poco::DeflatingOutputStream deflater(zippedCsv, Poco::DeflatingStreamBuf::STREAM_GZIP);
+        deflater << "id,parent_id,name,type,size,created_at,last_modified_at,can_write,is_link\n";
+        int64_t id = 2;
+        for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+            const int64_t dirId = id++;
+            deflater << dirId << ",1,dir" << dirIndex << ",dir,0,1700000000,1700000000,1,0\n";
+            for (int index = 0; index < filesPerDir - 1; ++index) {
+                deflater << id++ << "," << dirId << ",file" << index << ".txt,file,1024,1700000000,1700000000,1,0\n";
+            }
+        }
+        deflater << "#EOF\n";
+        deflater.close();
+    }
+    _zippedCsv = zippedCsv.str();
+
+    _server = std::make_unique<LocalHttpServer>([this](Poco::Net::HTTPServerRequest &, Poco::Net::HTTPServerResponse &response) {
+        response.setContentType("text/csv");
+        response.set("X-kDrive-Cursor", "1");
+        response.setContentLength64(static_cast<Poco::Int64>(_zippedCsv.size()));
+        std::ostream &stream = response.send();
+        for (size_t offset = 0; offset < _zippedCsv.size() && stream; offset += sliceSize) {
+            (void) stream.write(_zippedCsv.data() + offset,
+                                static_cast<std::streamsize>(std::min(sliceSize, _zippedCsv.size() - offset)));
+        }
+        (void) stream.flush();
+    });
+    UrlHelper::setCustomApiUrl(_server->url());
+
+    // The token is never checked by the local server
+    ApiToken apiToken;
+    apiToken.setAccessToken("benchmarkToken");
+
+    const std::string keychainKey("123");
+    (void) KeyChainManager::instance(true);
+    (void) KeyChainManager::instance()->writeToken(keychainKey, apiToken.reconstructJsonString());
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, keychainKey);
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    (void) Proxy::instance(ProxyConfig());
+}
+
+void BenchmarkCsvListing::tearDown() {
+    _server.reset();
+    UrlHelper::setCustomApiUrl("");
+
+    HttpSessionPool::instance()->clear();
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    SyncJobManagerSingleton::instance()->stop();
+    SyncJobManagerSingleton::clear();
+    TestBase::stop();
+}
+
+void BenchmarkCsvListing::benchmarkFullListing() {
+    std::cout << std::endl;
+
+    const double initialMemory = residentMemory();
+    double peakMemory = initialMemory;
+
+    const auto job = std::make_shared<CsvFullFileListWithCursorJob>(1, "1");
+    TimerUtility timer;
+    SyncJobManagerSingleton::instance()->queueAsyncJob(job);
+
+    SnapshotItem item;
+    bool error = false;
+    bool ignore = false;
+    bool eof = false;
+    uint64_t itemCount = 0;
+    while (job->getItem(item, error, ignore, eof)) {
+        CPPUNIT_ASSERT(!error);
+        CPPUNIT_ASSERT(!ignore);
+        if (itemCount == 0) {
+            std::cout << "First item received in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+        }
+        if (++itemCount % 100000 == 0) {
+            peakMemory = std::max(peakMemory, residentMemory());
+        }
+    }
+    std::cout << itemCount << " items received and parsed in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+    std::cout << "Peak resident memory increase: " << peakMemory - initialMemory << "MB (compressed listing: "
+              << static_cast<double>(_zippedCsv.size()) / (1024.0 * 1024.0) << "MB)" << std::endl;
+
+    CPPUNIT_ASSERT(eof);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(dirCount) * filesPerDir, itemCount);
+}
+
+} // namespace KDC
@@ -0,0 +1,130 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkdownload.h"
+
+#include "db/parmsdb.h"
+#include "io/cachedirectory.h"
+#include "jobs/network/httpsessionpool.h"
+#include "jobs/network/kDrive_API/downloadjob.h"
+#include "keychainmanager/keychainmanager.h"
+#include "network/proxy.h"
+#include "utility/timerutility.h"
+#include "libcommon/utility/urlhelper.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <version.h>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int64_t fileSize = 1024LL * 1024 * 1024;
+constexpr size_t sliceSize = 64 * 1024;
+
+} // namespace
+
+void BenchmarkDownload::setUp() {
+    TestBase::start();
+
+    // The file content is a repeated slice, so that the server never becomes the bottleneck
+    _pattern.resize(sliceSize);
+    for (size_t index = 0; index < _pattern.size(); ++index) {
+        _pattern[index] = static_cast<char>(index % 251);
+    }
+
+    _server = std::make_unique<LocalHttpServer>([this](Poco::Net::HTTPServerRequest &, Poco::Net::HTTPServerResponse &response) {
+        response.setContentType("application/octet-stream");
+        response.setContentLength64(fileSize);
+        std::ostream &stream = response.send();
+        for (int64_t offset = 0; offset < fileSize && stream; offset += static_cast<int64_t>(sliceSize)) {
+            (void) stream.write(_pattern.data(), static_cast<std::streamsize>(std::min<int64_t>(sliceSize, fileSize - offset)));
+        }
+        (void) stream.flush();
+    });
+    UrlHelper::setCustomApiUrl(_server->url());
+
+    // The token is never checked by the local server
+    ApiToken apiToken;
+    apiToken.setAccessToken("benchmarkToken");
+
+    const std::string keychainKey("123");
+    (void) KeyChainManager::instance(true);
+    (void) KeyChainManager::instance()->writeToken(keychainKey, apiToken.reconstructJsonString());
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, keychainKey);
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    (void) Proxy::instance(ProxyConfig());
+}
+
+void BenchmarkDownload::tearDown() {
+    _server.reset();
+    UrlHelper::setCustomApiUrl("");
+
+    HttpSessionPool::instance()->clear();
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    TestBase::stop();
+}
+
+void BenchmarkDownload::benchmarkLargeFile() {
+    std::cout << std::endl;
+
+    const SyncPath localPath = _localTempDir.path() / "largeFile";
+    const auto cacheDirectory = std::make_shared<CacheDirectory>(_localTempDir.path());
+
+    TimerUtility timer;
+    {
+        DownloadJob job(nullptr, cacheDirectory, DownloadJob::FileDownloadInfo{1, "1", localPath, fileSize, 0, 0, true},
+                        DownloadJob::DateTimePolicy::IgnoreDateTime);
+        CPPUNIT_ASSERT(job.runSynchronously());
+        CPPUNIT_ASSERT_EQUAL(fileSize, job.size());
+    }
+    const double duration = timer.elapsed<DoubleSeconds>().count();
+    std::cout << fileSize / (1024 * 1024) << "MB downloaded in " << duration << "s ("
+              << static_cast<double>(fileSize) / (1024.0 * 1024.0) / duration << "MB/s) into " << _localTempDir.path()
+              << std::endl;
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::uintmax_t>(fileSize), std::filesystem::file_size(localPath));
+
+    // Spot check the content at the end of the file
+    std::ifstream ifs(localPath, std::ios::binary);
+    (void) ifs.seekg(fileSize - static_cast<int64_t>(sliceSize));
+    std::string tail(sliceSize, '\0');
+    (void) ifs.read(tail.data(), static_cast<std::streamsize>(tail.size()));
+    CPPUNIT_ASSERT(tail == _pattern);
+}
+
+} // namespace KDC
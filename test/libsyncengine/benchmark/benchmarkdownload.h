@@ -0,0 +1,47 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/localhttpserver.h"
+#include "test_utility/localtemporarydirectory.h"
+
+namespace KDC {
+
+class BenchmarkDownload : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkDownload);
+        CPPUNIT_TEST(benchmarkLargeFile);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // Throughput of a 1GB download from a local server. The file is written in TMPDIR, point it to a tmpfs or an ext4 mount
+        // to compare the file systems.
+        void benchmarkLargeFile();
+
+        std::string _pattern;
+        std::unique_ptr<LocalHttpServer> _server;
+        LocalTemporaryDirectory _localTempDir{"benchmarkDownload"};
+};
+
+} // namespace KDC
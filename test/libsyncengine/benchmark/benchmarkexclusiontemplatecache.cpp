@@ -0,0 +1,101 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkexclusiontemplatecache.h"
+
+#include "libparms/db/parmsdb.h"
+#include "requests/exclusiontemplatecache.h"
+#include "requests/parameterscache.h"
+#include "utility/timerutility.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <thread>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr uint64_t lookupCount = 10'000'000;
+constexpr unsigned threadCount = 8;
+
+// Typical names of a synchronized folder, a few of them being excluded by the default templates
+const std::vector<SyncPath> fileNames = {"report 2024.docx",
+                                         "IMG_20240824_081432.jpg",
+                                         "src/main.cpp",
+                                         "notes.txt~",
+                                         "~$budget.xlsx",
+                                         "photo_conflict_20240824_081432_s2L5tFynHP.jpg",
+                                         ".DS_Store",
+                                         "archive.tar.gz",
+                                         "download.crdownload",
+                                         "Documents/Projects/kDrive/README.md"};
+
+// Returns the number of excluded names among `count` lookups.
+uint64_t lookUp(const uint64_t count) {
+    uint64_t excludedCount = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        excludedCount += ExclusionTemplateCache::instance()->isExcluded(fileNames[i % fileNames.size()]) ? 1 : 0;
+    }
+    return excludedCount;
+}
+
+} // namespace
+
+void BenchmarkExclusionTemplateCache::setUp() {
+    TestBase::start();
+    bool alreadyExists = false;
+    (void) ParmsDb::instance(MockDb::makeDbName(alreadyExists), KDRIVE_VERSION_STRING, true, true);
+}
+
+void BenchmarkExclusionTemplateCache::tearDown() {
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    ParametersCache::reset();
+    ExclusionTemplateCache::reset();
+    TestBase::stop();
+}
+
+void BenchmarkExclusionTemplateCache::benchmarkIsExcluded() {
+    CPPUNIT_ASSERT(ExclusionTemplateCache::instance());
+    std::cout << std::endl;
+
+    TimerUtility timer;
+    const uint64_t sequentialExcludedCount = lookUp(lookupCount);
+    std::cout << lookupCount << " lookups from 1 thread in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    std::vector<uint64_t> excludedCounts(threadCount, 0);
+    std::vector<std::thread> threads;
+    timer.restart();
+    for (unsigned i = 0; i < threadCount; ++i) {
+        // Each thread checks a multiple of the name count, hence the same names as the sequential run
+        threads.emplace_back([&excludedCounts, i]() { excludedCounts[i] = lookUp(lookupCount / threadCount); });
+    }
+    for (auto &thread: threads) thread.join();
+    std::cout << lookupCount << " lookups from " << threadCount << " threads in " << timer.elapsed<DoubleSeconds>().count()
+              << "s" << std::endl;
+
+    uint64_t parallelExcludedCount = 0;
+    for (const auto count: excludedCounts) parallelExcludedCount += count;
+    CPPUNIT_ASSERT_EQUAL(sequentialExcludedCount, parallelExcludedCount);
+}
+
+} // namespace KDC
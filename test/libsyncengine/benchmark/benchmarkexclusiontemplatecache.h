@@ -0,0 +1,40 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+
+namespace KDC {
+
+class BenchmarkExclusionTemplateCache : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkExclusionTemplateCache);
+        CPPUNIT_TEST(benchmarkIsExcluded);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // 10M calls to `ExclusionTemplateCache::isExcluded` with the default templates, from 1 and then 8 threads.
+        void benchmarkIsExcluded();
+};
+
+} // namespace KDC
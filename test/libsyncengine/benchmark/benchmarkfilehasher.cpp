@@ -0,0 +1,101 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkfilehasher.h"
+
+#include "libcommonserver/io/filehasher.h"
+#include "utility/timerutility.h"
+#include "test_utility/localtemporarydirectory.h"
+
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr size_t fileSize = 1024 * 1024 * 1024; // 1GB
+constexpr size_t writeChunkSize = 8 * 1024 * 1024;
+
+void writeFile(const SyncPath &path) {
+    std::mt19937_64 generator(42);
+    std::vector<uint64_t> chunk(writeChunkSize / sizeof(uint64_t));
+    std::ofstream ofs(path, std::ios_base::binary | std::ios_base::trunc);
+    for (size_t written = 0; written < fileSize; written += writeChunkSize) {
+        for (auto &value: chunk) {
+            value = generator();
+        }
+        (void) ofs.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(writeChunkSize));
+    }
+}
+
+XXH64_hash_t hashAndReport(const SyncPath &path, const FileHasher::Settings &settings, const std::string &label) {
+    const TimerUtility timer;
+    XXH64_hash_t hash = 0;
+    CPPUNIT_ASSERT_EQUAL(IoError::Success, FileHasher::xxh3(path, hash, settings));
+    const double seconds = timer.elapsed<DoubleSeconds>().count();
+    std::cout << "  " << label << ": " << seconds << "s, " << static_cast<double>(fileSize) / (1024 * 1024) / seconds << "MB/s"
+              << std::endl;
+    return hash;
+}
+
+} // namespace
+
+void BenchmarkFileHasher::benchmarkLargeFile() {
+    std::cout << std::endl;
+    hashInDirectory({});
+#if defined(KD_LINUX)
+    if (std::error_code ec; std::filesystem::is_directory("/dev/shm", ec)) {
+        hashInDirectory("/dev/shm");
+    }
+#endif
+}
+
+void BenchmarkFileHasher::hashInDirectory(const SyncPath &directory) {
+    const LocalTemporaryDirectory tempDir("benchmarkFileHasher", directory);
+    const SyncPath path = tempDir.path() / "large.bin";
+    writeFile(path);
+    std::cout << "File in " << tempDir.path().parent_path() << std::endl;
+
+    // The page cache is kept so that all the strategies read from memory
+    FileHasher::Settings settings;
+    settings.dropPageCache = false;
+
+    settings.strategy = FileHasher::Strategy::Buffered;
+    const auto expected = hashAndReport(path, settings, "BUFSIZ reads");
+    for (const size_t readSize: {size_t{1024 * 1024}, FileHasher::defaultReadSize, size_t{4 * 1024 * 1024}}) {
+        settings.strategy = FileHasher::Strategy::LargeReads;
+        settings.readSize = readSize;
+        CPPUNIT_ASSERT_EQUAL(expected,
+                             hashAndReport(path, settings, std::to_string(readSize / (1024 * 1024)) + "MB aligned reads"));
+    }
+    settings.strategy = FileHasher::Strategy::MemoryMapped;
+    settings.readSize = FileHasher::defaultReadSize;
+    CPPUNIT_ASSERT_EQUAL(expected, hashAndReport(path, settings, "Memory mapped"));
+
+    // The first run drops the file from the page cache, the second one reads it from the disk
+    settings.strategy = FileHasher::Strategy::LargeReads;
+    settings.dropPageCache = true;
+    CPPUNIT_ASSERT_EQUAL(expected, hashAndReport(path, settings, "2MB aligned reads, dropping the cache"));
+    CPPUNIT_ASSERT_EQUAL(expected, hashAndReport(path, settings, "2MB aligned reads, not cached"));
+}
+
+} // namespace KDC
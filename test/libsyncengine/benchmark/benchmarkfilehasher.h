@@ -0,0 +1,42 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "libcommon/utility/types.h"
+
+namespace KDC {
+
+class BenchmarkFileHasher : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkFileHasher);
+        CPPUNIT_TEST(benchmarkLargeFile);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override { TestBase::start(); }
+        void tearDown() override { TestBase::stop(); }
+
+    private:
+        // Hashing throughput of a 1GB file with each strategy, in the temporary directory and, on Linux, in /dev/shm (tmpfs).
+        // The file is in the page cache after it is written, then a last run reads it from the disk.
+        void benchmarkLargeFile();
+        void hashInDirectory(const SyncPath &directory);
+};
+
+} // namespace KDC
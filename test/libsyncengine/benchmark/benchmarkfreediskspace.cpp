@@ -0,0 +1,90 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkfreediskspace.h"
+
+#include "libcommonserver/io/iohelper.h"
+#include "libcommonserver/utility/freediskspacetracker.h"
+#include "libcommonserver/utility/utility.h"
+#include "utility/timerutility.h"
+
+#include <algorithm>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr uint64_t downloadCount = 50'000;
+constexpr int64_t fileSize = 10 * 1000;
+
+} // namespace
+
+void BenchmarkFreeDiskSpace::benchmarkSmallDownloads() {
+    const SyncPath syncRoot = _localTempDir.path() / "sync";
+    const SyncPath cacheDir = _localTempDir.path() / "cache";
+    for (const auto &dir: {syncRoot, cacheDir, syncRoot / "dir"}) {
+        auto ioError = IoError::Unknown;
+        CPPUNIT_ASSERT(IoHelper::createDirectory(dir, false, ioError) && ioError == IoError::Success);
+    }
+    std::cout << std::endl;
+
+    TimerUtility timer;
+    uint64_t refusedCount = 0;
+    for (uint64_t index = 0; index < downloadCount; ++index) {
+        const SyncPath name = "file" + std::to_string(index) + ".txt";
+        const int64_t neededSpace = fileSize + Utility::freeDiskSpaceLimit();
+        const int64_t syncFreeSpace = Utility::getFreeDiskSpace(syncRoot);
+        const int64_t tmpFreeSpace = Utility::getFreeDiskSpace(cacheDir / name);
+        const int64_t destFreeSpace = Utility::getFreeDiskSpace(syncRoot / "dir" / name);
+        refusedCount += std::min({syncFreeSpace, tmpFreeSpace, destFreeSpace}) < neededSpace ? 1 : 0;
+    }
+    std::cout << downloadCount << " downloads checked with " << 3 * downloadCount << " queries in "
+              << timer.elapsed<DoubleSeconds>().count() << "s, " << refusedCount << " refused" << std::endl;
+
+    uint64_t queryCount = 0;
+    FreeDiskSpaceTracker tracker([&queryCount](const SyncPath &path) {
+        ++queryCount;
+        return Utility::getFreeDiskSpace(path);
+    });
+
+    timer.restart();
+    uint64_t trackerRefusedCount = 0;
+    for (uint64_t index = 0; index < downloadCount; ++index) {
+        const SyncPath name = "file" + std::to_string(index) + ".txt";
+        const int64_t neededSpace = fileSize + Utility::freeDiskSpaceLimit();
+        const int64_t syncFreeSpace = tracker.freeDiskSpace(syncRoot, fileSize);
+        const int64_t tmpFreeSpace = tracker.freeDiskSpace(cacheDir / name, fileSize);
+        const int64_t destFreeSpace = tracker.freeDiskSpace(syncRoot / "dir" / name, fileSize);
+        trackerRefusedCount += std::min({syncFreeSpace, tmpFreeSpace, destFreeSpace}) < neededSpace ? 1 : 0;
+
+        tracker.reserve(cacheDir / name, fileSize);
+        tracker.reserve(syncRoot / "dir" / name, fileSize);
+        tracker.release(cacheDir / name, fileSize, true);
+        tracker.release(syncRoot / "dir" / name, fileSize, true);
+    }
+    std::cout << downloadCount << " downloads checked with " << queryCount << " queries (" << 3 * downloadCount - queryCount
+              << " avoided) in " << timer.elapsed<DoubleSeconds>().count() << "s, " << trackerRefusedCount << " refused"
+              << std::endl;
+
+    CPPUNIT_ASSERT_EQUAL(refusedCount, trackerRefusedCount);
+}
+
+} // namespace KDC
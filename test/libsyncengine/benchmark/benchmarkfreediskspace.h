@@ -0,0 +1,45 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/localtemporarydirectory.h"
+
+namespace KDC {
+
+class BenchmarkFreeDiskSpace : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkFreeDiskSpace);
+        CPPUNIT_TEST(benchmarkSmallDownloads);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override { TestBase::start(); }
+        void tearDown() override { TestBase::stop(); }
+
+    private:
+        // Free disk space checks of 50k small downloads (1 in the executor and 2 in the download job for each of them), with
+        // direct queries to the file system and then with `FreeDiskSpaceTracker`. The disk needs more than 1.25GB of free space
+        // for the cache to be used.
+        void benchmarkSmallDownloads();
+
+        LocalTemporaryDirectory _localTempDir{"benchmarkFreeDiskSpace"};
+};
+
+} // namespace KDC
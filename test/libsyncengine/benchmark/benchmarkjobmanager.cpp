@@ -0,0 +1,159 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkjobmanager.h"
+
+#include "jobs/jobmanager.h"
+#include "requests/parameterscache.h"
+#include "libcommon/utility/utility.h"
+#include "libcommonserver/utility/utility.h"
+#include "utility/timerutility.h"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+class NoOpJob final : public AbstractJob {
+    public:
+        NoOpJob() :
+            _queueTime(std::chrono::steady_clock::now()) {}
+
+        ExitInfo runJob() override {
+            _startTime = std::chrono::steady_clock::now();
+            return ExitCode::Ok;
+        }
+
+        DoubleSeconds dispatchDelay() const { return _startTime - _queueTime; }
+
+    private:
+        std::chrono::steady_clock::time_point _queueTime;
+        std::chrono::steady_clock::time_point _startTime;
+};
+
+bool waitForAllJobs(const JobManager &jobManager, const std::vector<std::shared_ptr<NoOpJob>> &jobs) {
+    const TimerUtility timer;
+    for (const auto &job: jobs) {
+        while (!jobManager.isJobFinished(job->jobId())) {
+            if (timer.elapsed<DoubleSeconds>().count() > 60.0) return false;
+            Utility::msleep(1);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void BenchmarkJobManager::setUp() {
+    TestBase::start();
+    (void) ParametersCache::instance(true);
+}
+
+void BenchmarkJobManager::tearDown() {
+    ParametersCache::reset();
+    TestBase::stop();
+}
+
+void BenchmarkJobManager::benchmarkDispatchLatency() {
+    std::cout << std::endl;
+    constexpr size_t nbJobs = 5000;
+
+    for (const auto nbThreads: {3, 5, 10}) {
+        JobManager jobManager;
+        jobManager.setPoolCapacity(nbThreads);
+
+        std::vector<std::shared_ptr<NoOpJob>> jobs;
+        jobs.reserve(nbJobs);
+        const TimerUtility timer;
+        for (size_t i = 0; i < nbJobs; i++) {
+            const auto job = std::make_shared<NoOpJob>();
+            jobs.push_back(job);
+            jobManager.queueAsyncJob(job);
+        }
+        CPPUNIT_ASSERT(waitForAllJobs(jobManager, jobs));
+        const auto totalDuration = timer.elapsed<DoubleSeconds>();
+
+        std::vector<double> delays;
+        delays.reserve(nbJobs);
+        for (const auto &job: jobs) {
+            delays.push_back(job->dispatchDelay().count());
+        }
+        std::ranges::sort(delays);
+
+        std::cout << nbJobs << " jobs with " << nbThreads << " threads executed in " << totalDuration.count()
+                  << "s - enqueue-to-start delay: median=" << delays[nbJobs / 2] * 1000
+                  << "ms, p99=" << delays[nbJobs * 99 / 100] * 1000 << "ms, max=" << delays.back() * 1000 << "ms" << std::endl;
+
+        jobManager.stop();
+        jobManager.clear();
+    }
+
+    // A single job queued on an idle job manager must start without waiting for a polling period.
+    JobManager jobManager;
+    const std::vector<std::shared_ptr<NoOpJob>> warmUpJobs = {std::make_shared<NoOpJob>()};
+    jobManager.queueAsyncJob(warmUpJobs.front());
+    CPPUNIT_ASSERT(waitForAllJobs(jobManager, warmUpJobs));
+    Utility::msleep(200); // Let the job manager become idle
+
+    const std::vector<std::shared_ptr<NoOpJob>> jobs = {std::make_shared<NoOpJob>()};
+    jobManager.queueAsyncJob(jobs.front());
+    CPPUNIT_ASSERT(waitForAllJobs(jobManager, jobs));
+    std::cout << "Single job enqueue-to-start delay on idle job manager: " << jobs.front()->dispatchDelay().count() * 1000
+              << "ms" << std::endl;
+    CPPUNIT_ASSERT(jobs.front()->dispatchDelay() < std::chrono::milliseconds(50));
+
+    jobManager.stop();
+    jobManager.clear();
+}
+
+void BenchmarkJobManager::benchmarkIdleWakeUps() {
+    JobManager jobManager;
+    std::vector<std::shared_ptr<NoOpJob>> jobs;
+    for (auto i = 0; i < 100; i++) {
+        const auto job = std::make_shared<NoOpJob>();
+        jobs.push_back(job);
+        jobManager.queueAsyncJob(job);
+    }
+    CPPUNIT_ASSERT(waitForAllJobs(jobManager, jobs));
+    Utility::msleep(100); // Let the last wake-ups be processed
+
+    uint64_t wakeUpCountBefore = 0;
+    {
+        const std::scoped_lock lock(jobManager._wakeUpMutex);
+        wakeUpCountBefore = jobManager._wakeUpCount;
+    }
+
+    Utility::msleep(2000);
+
+    uint64_t wakeUpCountAfter = 0;
+    {
+        const std::scoped_lock lock(jobManager._wakeUpMutex);
+        wakeUpCountAfter = jobManager._wakeUpCount;
+    }
+    std::cout << std::endl << "Job manager wake-ups while idle for 2s: " << wakeUpCountAfter - wakeUpCountBefore << std::endl;
+    CPPUNIT_ASSERT_EQUAL(wakeUpCountBefore, wakeUpCountAfter);
+
+    jobManager.stop();
+    jobManager.clear();
+}
+
+} // namespace KDC
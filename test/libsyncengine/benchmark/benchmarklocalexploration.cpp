@@ -0,0 +1,122 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarklocalexploration.h"
+#include "test_classes/syncpaltest.h"
+
+#include "config.h"
+#if defined(KD_WINDOWS)
+#include "update_detection/file_system_observer/localfilesystemobserverworker_win.h"
+#else
+#include "update_detection/file_system_observer/localfilesystemobserverworker_unix.h"
+#endif
+#include "utility/timerutility.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+#include "test_utility/testhelpers.h"
+
+#include <fstream>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+// 100 folders with 10 subfolders of 1000 files each
+constexpr int topFolderCount = 100;
+constexpr int subFolderCount = 10;
+constexpr int fileCount = 1000;
+
+} // namespace
+
+void BenchmarkLocalExploration::setUp() {
+    TestBase::start();
+
+    _syncPath = _localTempDir.path() / "sync_folder";
+    std::cout << std::endl;
+    const TimerUtility timer;
+    for (int i = 0; i < topFolderCount; ++i) {
+        for (int j = 0; j < subFolderCount; ++j) {
+            const auto dirPath = _syncPath / ("dir" + std::to_string(i)) / ("dir" + std::to_string(j));
+            (void) std::filesystem::create_directories(dirPath);
+            for (int k = 0; k < fileCount; ++k) {
+                std::ofstream(dirPath / ("file" + std::to_string(k) + ".txt")) << k;
+            }
+        }
+    }
+    std::cout << "Tree generated in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    const testhelpers::TestVariables testVariables;
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, atoi(testVariables.userId.c_str()), "123");
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, atoi(testVariables.accountId.c_str()), user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, atoi(testVariables.driveId.c_str()), account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    Sync sync(1, drive.dbId(), _syncPath, "", testVariables.remotePath);
+    sync.setDbPath(MockDb::makeDbName(user.userId(), account.accountId(), drive.driveId(), sync.dbId()));
+    (void) ParmsDb::instance()->insertSync(sync);
+
+    _syncPal = std::make_shared<SyncPalTest>(1, KDRIVE_VERSION_STRING);
+    _syncPal->syncDb()->setAutoDelete(true);
+    _syncPal->createSharedObjects();
+}
+
+void BenchmarkLocalExploration::tearDown() {
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    if (_syncPal && _syncPal->syncDb()) {
+        _syncPal->syncDb()->close();
+    }
+    _syncPal.reset();
+    TestBase::stop();
+}
+
+void BenchmarkLocalExploration::benchmarkInitialSnapshot() {
+#if defined(KD_WINDOWS)
+    LocalFileSystemObserverWorker_win sequentialWorker(_syncPal, "Local File System Observer", "LFSO");
+    LocalFileSystemObserverWorker_win parallelWorker(_syncPal, "Local File System Observer", "LFSO");
+#else
+    LocalFileSystemObserverWorker_unix sequentialWorker(_syncPal, "Local File System Observer", "LFSO");
+    LocalFileSystemObserverWorker_unix parallelWorker(_syncPal, "Local File System Observer", "LFSO");
+#endif
+
+    sequentialWorker._liveSnapshot.init();
+    TimerUtility timer;
+    CPPUNIT_ASSERT_EQUAL(ExitInfo{ExitCode::Ok}, sequentialWorker.exploreDir(_syncPath));
+    std::cout << "Sequential exploration: " << sequentialWorker._liveSnapshot.nbItems() << " items in "
+              << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    parallelWorker._liveSnapshot.init();
+    timer.restart();
+    CPPUNIT_ASSERT_EQUAL(ExitInfo{ExitCode::Ok},
+                         parallelWorker.exploreTree(_syncPath, *_syncPal->syncDb()->rootNode().nodeIdLocal()));
+    std::cout << "Parallel exploration: " << parallelWorker._liveSnapshot.nbItems() << " items in "
+              << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    CPPUNIT_ASSERT_EQUAL(sequentialWorker._liveSnapshot.nbItems(), parallelWorker._liveSnapshot.nbItems());
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(topFolderCount * (1 + subFolderCount * (1 + fileCount)) + 1),
+                         parallelWorker._liveSnapshot.nbItems());
+}
+
+} // namespace KDC
@@ -0,0 +1,47 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/localtemporarydirectory.h"
+
+namespace KDC {
+
+class SyncPal;
+
+class BenchmarkLocalExploration : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkLocalExploration);
+        CPPUNIT_TEST(benchmarkInitialSnapshot);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // Generation of the local snapshot of a tree of 1M files, by the sequential and the multi-threaded explorations.
+        void benchmarkInitialSnapshot();
+
+        LocalTemporaryDirectory _localTempDir{"benchmarkLocalExploration"};
+        SyncPath _syncPath;
+        std::shared_ptr<SyncPal> _syncPal;
+};
+
+} // namespace KDC
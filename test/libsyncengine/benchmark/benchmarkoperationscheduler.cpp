@@ -0,0 +1,220 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkoperationscheduler.h"
+
+#include "jobs/jobmanager.h"
+#include "propagation/executor/operationscheduler.h"
+#include "requests/parameterscache.h"
+#include "update_detection/update_detector/node.h"
+#include "utility/timerutility.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 1000;
+constexpr int deletesPerDir = 10;
+constexpr int movesPerDir = 10;
+// Every `renamedDirInterval` directory is renamed once the operations on its files are done
+constexpr int renamedDirInterval = 10;
+constexpr int nbThreads = 10;
+constexpr std::chrono::microseconds jobDuration(500);
+
+// Stand-in for a move or delete job, records when it ran
+class MockOperationJob final : public AbstractJob {
+    public:
+        ExitInfo runJob() override {
+            _startTime = std::chrono::steady_clock::now();
+            std::this_thread::sleep_for(jobDuration);
+            _endTime = std::chrono::steady_clock::now();
+            return ExitCode::Ok;
+        }
+
+        std::chrono::steady_clock::time_point startTime() const { return _startTime; }
+        std::chrono::steady_clock::time_point endTime() const { return _endTime; }
+
+    private:
+        std::chrono::steady_clock::time_point _startTime;
+        std::chrono::steady_clock::time_point _endTime;
+};
+
+using MockJobMap = std::unordered_map<UniqueId, std::shared_ptr<MockOperationJob>>;
+
+std::shared_ptr<Node> makeNode(const NodeId &id, const NodeType type, const std::shared_ptr<Node> &parentNode) {
+    return std::make_shared<Node>(ReplicaSide::Remote, Str2SyncName(id), type, OperationType::None, id, 0, 0, 0, parentNode);
+}
+
+SyncOpPtr makeOp(const OperationType type, const std::shared_ptr<Node> &node) {
+    const auto op = std::make_shared<SyncOperation>();
+    op->setType(type);
+    op->setAffectedNode(node);
+    op->setTargetSide(ReplicaSide::Local);
+    return op;
+}
+
+std::list<SyncOpPtr> generateOperations() {
+    std::list<SyncOpPtr> ops;
+    const auto rootNode = makeNode("root", NodeType::Directory, nullptr);
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const NodeId dirId = "d" + std::to_string(dirIndex);
+        const auto dirNode = makeNode(dirId, NodeType::Directory, rootNode);
+        for (int fileIndex = 0; fileIndex < deletesPerDir; ++fileIndex) {
+            const NodeId fileId = dirId + "f" + std::to_string(fileIndex);
+            ops.push_back(makeOp(OperationType::Delete, makeNode(fileId, NodeType::File, dirNode)));
+        }
+        for (int fileIndex = deletesPerDir; fileIndex < deletesPerDir + movesPerDir; ++fileIndex) {
+            const NodeId fileId = dirId + "f" + std::to_string(fileIndex);
+            const auto fileNode = makeNode(fileId + "_renamed", NodeType::File, dirNode);
+            fileNode->setMoveOriginInfos({SyncPath(dirId) / fileId, dirId});
+            ops.push_back(makeOp(OperationType::Move, fileNode));
+        }
+    }
+    for (auto opIt = ops.begin(); opIt != ops.end();) {
+        const auto dirNode = (*opIt)->affectedNode()->parentNode();
+        std::advance(opIt, deletesPerDir + movesPerDir);
+        if (std::stoi(dirNode->id()->substr(1)) % renamedDirInterval) continue;
+
+        const NodeId dirId = *dirNode->id();
+        const auto renamedDirNode = makeNode(dirId + "_renamed", NodeType::Directory, dirNode->parentNode());
+        renamedDirNode->setMoveOriginInfos({SyncPath(dirId), "root"});
+        (void) ops.insert(opIt, makeOp(OperationType::Move, renamedDirNode));
+    }
+    return ops;
+}
+
+void runSequentially(const std::list<SyncOpPtr> &ops, MockJobMap &jobs) {
+    for (const auto &op: ops) {
+        const auto job = std::make_shared<MockOperationJob>();
+        (void) job->runSynchronously();
+        jobs[op->id()] = job;
+    }
+}
+
+void runScheduled(const std::list<SyncOpPtr> &ops, MockJobMap &jobs) {
+    OperationScheduler scheduler;
+    scheduler.init(ops);
+
+    JobManager jobManager;
+    jobManager.setPoolCapacity(nbThreads);
+
+    std::mutex terminatedOpsMutex;
+    std::condition_variable terminatedOpsCv;
+    std::queue<UniqueId> terminatedOpIds;
+
+    size_t doneCount = 0;
+    while (doneCount < ops.size()) {
+        while (const UniqueId opId = scheduler.popReadyOp()) {
+            const auto job = std::make_shared<MockOperationJob>();
+            job->setAdditionalCallback([opId, &terminatedOpsMutex, &terminatedOpsCv, &terminatedOpIds](UniqueId) {
+                {
+                    const std::scoped_lock lock(terminatedOpsMutex);
+                    terminatedOpIds.push(opId);
+                }
+                terminatedOpsCv.notify_one();
+            });
+            jobs[opId] = job;
+            jobManager.queueAsyncJob(job);
+        }
+
+        std::unique_lock lock(terminatedOpsMutex);
+        terminatedOpsCv.wait(lock, [&terminatedOpIds] { return !terminatedOpIds.empty(); });
+        while (!terminatedOpIds.empty()) {
+            scheduler.release(terminatedOpIds.front());
+            terminatedOpIds.pop();
+            ++doneCount;
+        }
+    }
+
+    jobManager.stop();
+    jobManager.clear();
+
+    // No operation started before the end of its prerequisites
+    for (const auto &op: ops) {
+        const auto &job = jobs.at(op->id());
+        for (const auto prerequisiteId: scheduler.prerequisites(op->id())) {
+            CPPUNIT_ASSERT(jobs.at(prerequisiteId)->endTime() <= job->startTime());
+        }
+    }
+}
+
+} // namespace
+
+void BenchmarkOperationScheduler::setUp() {
+    TestBase::start();
+    (void) ParametersCache::instance(true);
+}
+
+void BenchmarkOperationScheduler::tearDown() {
+    ParametersCache::reset();
+    TestBase::stop();
+}
+
+void BenchmarkOperationScheduler::benchmarkIndependentOperations() {
+    const auto ops = generateOperations();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(dirCount * (deletesPerDir + movesPerDir) + dirCount / renamedDirInterval),
+                         ops.size());
+
+    const TimerUtility initTimer;
+    OperationScheduler scheduler;
+    scheduler.init(ops);
+    const auto initDuration = initTimer.elapsed<DoubleSeconds>();
+
+    MockJobMap sequentialJobs;
+    const TimerUtility sequentialTimer;
+    runSequentially(ops, sequentialJobs);
+    const auto sequentialDuration = sequentialTimer.elapsed<DoubleSeconds>();
+
+    MockJobMap scheduledJobs;
+    const TimerUtility scheduledTimer;
+    runScheduled(ops, scheduledJobs);
+    const auto scheduledDuration = scheduledTimer.elapsed<DoubleSeconds>();
+
+    std::vector<std::pair<std::chrono::steady_clock::time_point, int>> jobEvents;
+    for (const auto &[opId, job]: scheduledJobs) {
+        jobEvents.emplace_back(job->startTime(), 1);
+        jobEvents.emplace_back(job->endTime(), -1);
+    }
+    std::ranges::sort(jobEvents); // At equal times, the ends come before the starts
+    int concurrentJobs = 0;
+    int maxConcurrentJobs = 0;
+    for (const auto &[time, delta]: jobEvents) {
+        concurrentJobs += delta;
+        maxConcurrentJobs = std::max(maxConcurrentJobs, concurrentJobs);
+    }
+
+    std::cout << std::endl;
+    std::cout << "Scheduling of " << ops.size() << " operations computed in " << initDuration.count() << "s" << std::endl;
+    std::cout << "Executed one by one in " << sequentialDuration.count() << "s" << std::endl;
+    std::cout << "Executed with the operation scheduler and " << nbThreads << " threads in " << scheduledDuration.count()
+              << "s (speedup x" << sequentialDuration.count() / scheduledDuration.count() << ", up to " << maxConcurrentJobs
+              << " concurrent jobs)" << std::endl;
+
+    CPPUNIT_ASSERT(maxConcurrentJobs > 1);
+    CPPUNIT_ASSERT(scheduledDuration < sequentialDuration);
+}
+
+} // namespace KDC
@@ -0,0 +1,166 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkoperationsorter.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+#include "propagation/operation_sorter/operationsorterworker.h"
+#include "utility/timerutility.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 1000;
+constexpr int filesPerDir = 20;
+// With the operations on the existing files, 100 operations per directory
+constexpr int newFilesPerDir = 73;
+
+NodeId dirId(const int dirIndex) {
+    return "d" + std::to_string(dirIndex);
+}
+
+NodeId fileId(const int dirIndex, const int fileIndex) {
+    return dirId(dirIndex) + "f" + std::to_string(fileIndex);
+}
+
+} // namespace
+
+void BenchmarkOperationSorter::setUp() {
+    TestBase::start();
+    bool alreadyExists = false;
+    const auto parmsDbPath = MockDb::makeDbName(alreadyExists);
+    (void) ParmsDb::instance(parmsDbPath, KDRIVE_VERSION_STRING, true, true);
+
+    SyncPath syncDbPath = Db::makeDbName(1, 1, 1, 1, alreadyExists);
+    (void) IoHelper::deleteItem(syncDbPath);
+    _syncPal = std::make_shared<SyncPal>(std::make_shared<VfsOff>(VfsSetupParams(Log::instance()->getLogger())), syncDbPath,
+                                         KDRIVE_VERSION_STRING, true);
+    _syncPal->syncDb()->setAutoDelete(true);
+    _syncPal->createSharedObjects();
+    _syncPal->createWorkers();
+    _syncPal->_operationsSorterWorker = std::make_shared<OperationSorterWorker>(_syncPal, "Operation Sorter", "OPSO");
+    _testSituationGenerator.setSyncpal(_syncPal);
+}
+
+void BenchmarkOperationSorter::tearDown() {
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    _syncPal->syncDb()->close();
+    TestBase::stop();
+}
+
+void BenchmarkOperationSorter::benchmarkSortOperations() {
+    // Initial situation: `dirCount` directories of `filesPerDir` files
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        _testSituationGenerator.addItem(NodeType::Directory, dirId(dirIndex), "");
+        for (int fileIndex = 0; fileIndex < filesPerDir; ++fileIndex) {
+            _testSituationGenerator.addItem(NodeType::File, fileId(dirIndex, fileIndex), dirId(dirIndex));
+        }
+    }
+    (void) _syncPal->syncDb()->cache().reloadIfNeeded();
+
+    std::vector<SyncOpPtr> ops;
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        // A new directory full of new files
+        const NodeId newDirId = "n" + std::to_string(dirIndex);
+        const auto newDirNode = _testSituationGenerator.createNode(ReplicaSide::Local, NodeType::Directory, newDirId, "");
+        ops.push_back(generateSyncOperation(OperationType::Create, newDirNode));
+        for (int fileIndex = 0; fileIndex < newFilesPerDir; ++fileIndex) {
+            const auto node = _testSituationGenerator.createNode(ReplicaSide::Local, NodeType::File,
+                                                                 newDirId + "f" + std::to_string(fileIndex), newDirNode);
+            ops.push_back(generateSyncOperation(OperationType::Create, node));
+        }
+
+        // Files moved into the new directory, then edited
+        for (int fileIndex = 0; fileIndex < 5; ++fileIndex) {
+            const auto node = _testSituationGenerator.moveNode(ReplicaSide::Local, fileId(dirIndex, fileIndex), newDirId);
+            ops.push_back(generateSyncOperation(OperationType::Move, node));
+            (void) _testSituationGenerator.editNode(ReplicaSide::Local, *node->id());
+            ops.push_back(generateSyncOperation(OperationType::Edit, node));
+        }
+
+        // Files edited in place
+        for (int fileIndex = 5; fileIndex < 10; ++fileIndex) {
+            const auto node = _testSituationGenerator.editNode(ReplicaSide::Local, fileId(dirIndex, fileIndex));
+            ops.push_back(generateSyncOperation(OperationType::Edit, node));
+        }
+
+        // Files deleted and replaced by new files with the same names
+        for (int fileIndex = 10; fileIndex < 15; ++fileIndex) {
+            const auto node = _testSituationGenerator.deleteNode(ReplicaSide::Local, fileId(dirIndex, fileIndex));
+            ops.push_back(generateSyncOperation(OperationType::Delete, node));
+            const auto newNode = _testSituationGenerator.createNode(ReplicaSide::Local, NodeType::File,
+                                                                    fileId(dirIndex, fileIndex) + "n", dirId(dirIndex));
+            newNode->setName(node->name());
+            ops.push_back(generateSyncOperation(OperationType::Create, newNode));
+        }
+
+        // The directory itself renamed
+        const auto dirNode =
+                _testSituationGenerator.moveNode(ReplicaSide::Local, dirId(dirIndex), {}, Str2SyncName(dirId(dirIndex) + "r"));
+        ops.push_back(generateSyncOperation(OperationType::Move, dirNode));
+    }
+
+    std::shuffle(ops.begin(), ops.end(), std::mt19937(0));
+    _syncPal->syncOps()->setOpList(std::list<SyncOpPtr>(ops.begin(), ops.end()));
+
+    TimerUtility timer;
+    _syncPal->_operationsSorterWorker->_filter.filterOperations();
+    const double filteringTime = timer.lap<DoubleSeconds>().count();
+    _syncPal->_operationsSorterWorker->sortOperations();
+    const double sortingTime = timer.elapsed<DoubleSeconds>().count();
+
+    // No cycle, and every dependency satisfied
+    CPPUNIT_ASSERT_EQUAL(ops.size(), _syncPal->syncOps()->size());
+    std::unordered_map<UniqueId, size_t> positions;
+    for (const auto opId: _syncPal->syncOps()->opSortedList()) (void) positions.try_emplace(opId, positions.size());
+    size_t dependencyCount = 0;
+    for (const auto &[opId, prerequisiteIds]: _syncPal->_operationsSorterWorker->_dependencyGraph.prerequisites()) {
+        for (const auto prerequisiteId: prerequisiteIds) {
+            CPPUNIT_ASSERT_LESS(positions.at(opId), positions.at(prerequisiteId));
+            ++dependencyCount;
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << ops.size() << " operations, " << dependencyCount << " dependencies: filtering " << filteringTime
+              << "s, sorting " << sortingTime << "s" << std::endl;
+}
+
+SyncOpPtr BenchmarkOperationSorter::generateSyncOperation(const OperationType opType,
+                                                          const std::shared_ptr<Node> affectedNode) const {
+    const auto op = std::make_shared<SyncOperation>();
+    op->setType(opType);
+    op->setAffectedNode(affectedNode);
+    const auto targetSide = otherSide(affectedNode->side());
+    if (opType != OperationType::Create) {
+        op->setCorrespondingNode(_testSituationGenerator.getNode(targetSide, *affectedNode->id()));
+    }
+    op->setNewName(affectedNode->name());
+    op->setTargetSide(targetSide);
+    op->setNewParentNode(affectedNode->parentNode());
+    return op;
+}
+
+} // namespace KDC
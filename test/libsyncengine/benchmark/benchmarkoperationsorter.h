@@ -0,0 +1,45 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_classes/testsituationgenerator.h"
+
+namespace KDC {
+
+class BenchmarkOperationSorter : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkOperationSorter);
+        CPPUNIT_TEST(benchmarkSortOperations);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // Sorting of 100k mixed operations (creations, moves, edits and deletions) listed in a random order.
+        void benchmarkSortOperations();
+
+        SyncOpPtr generateSyncOperation(OperationType opType, const std::shared_ptr<Node> affectedNode) const;
+
+        std::shared_ptr<SyncPal> _syncPal;
+        TestSituationGenerator _testSituationGenerator;
+};
+
+} // namespace KDC
@@ -0,0 +1,118 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkprogressinfo.h"
+#include "test_classes/syncpaltest.h"
+
+#include "progress/progressinfo.h"
+#include "utility/timerutility.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+#include "test_utility/testhelpers.h"
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int itemCount = 100000;
+constexpr int tickCount = 10;
+constexpr int64_t itemSize = 4096;
+
+} // namespace
+
+void BenchmarkProgressInfo::setUp() {
+    TestBase::start();
+
+    const testhelpers::TestVariables testVariables;
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, atoi(testVariables.userId.c_str()), "123");
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, atoi(testVariables.accountId.c_str()), user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, atoi(testVariables.driveId.c_str()), account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    Sync sync(1, drive.dbId(), _localTempDir.path(), "", testVariables.remotePath);
+    sync.setDbPath(MockDb::makeDbName(user.userId(), account.accountId(), drive.driveId(), sync.dbId()));
+    (void) ParmsDb::instance()->insertSync(sync);
+
+    _syncPal = std::make_shared<SyncPalTest>(1, KDRIVE_VERSION_STRING);
+    _syncPal->syncDb()->setAutoDelete(true);
+}
+
+void BenchmarkProgressInfo::tearDown() {
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    if (_syncPal && _syncPal->syncDb()) {
+        _syncPal->syncDb()->close();
+    }
+    _syncPal.reset();
+    TestBase::stop();
+}
+
+void BenchmarkProgressInfo::benchmarkProgressTicks() {
+    uint64_t notificationCount = 0;
+    _syncPal->setAddCompletedItemCallback([&notificationCount](int, const SyncFileItem &, bool) { ++notificationCount; });
+
+    const auto progressInfo = std::make_shared<ProgressInfo>(_syncPal);
+    std::vector<SyncPath> paths;
+    paths.reserve(itemCount);
+    std::cout << std::endl;
+
+    TimerUtility timer;
+    for (int i = 0; i < itemCount; ++i) {
+        paths.emplace_back(SyncPath("dir" + std::to_string(i / 1000)) / ("file" + std::to_string(i) + ".txt"));
+        SyncFileItem item;
+        item.setType(NodeType::File);
+        item.setPath(paths.back());
+        item.setInstruction(SyncFileInstruction::Put);
+        item.setSize(itemSize);
+        CPPUNIT_ASSERT(progressInfo->initProgress(item));
+    }
+    std::cout << itemCount << " items initialized in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    // A full computation of the completed size, as previously done on every progress tick
+    timer.restart();
+    constexpr int fullComputationCount = 100;
+    for (int i = 0; i < fullComputationCount; ++i) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64_t>(0), progressInfo->computeCompletedSize());
+    }
+    std::cout << "Full computation of the completed size with " << itemCount << " items in progress: "
+              << timer.elapsed<DoubleSeconds>().count() / fullComputationCount << "s" << std::endl;
+
+    timer.restart();
+    for (const auto &path: paths) {
+        for (int tick = 1; tick <= tickCount; ++tick) {
+            CPPUNIT_ASSERT(progressInfo->setProgress(path, tick * 100 / (tickCount + 1)));
+        }
+        CPPUNIT_ASSERT(progressInfo->setProgressComplete(path, SyncFileStatus::Success));
+    }
+    progressInfo->flushCompletedItems();
+    std::cout << itemCount * (tickCount + 1) << " progress updates in " << timer.elapsed<DoubleSeconds>().count() << "s, "
+              << notificationCount << " notifications sent" << std::endl;
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<int64_t>(itemCount), progressInfo->completedFiles());
+    CPPUNIT_ASSERT_EQUAL(itemCount * itemSize, progressInfo->completedSize());
+    _syncPal->setAddCompletedItemCallback(nullptr);
+}
+
+} // namespace KDC
@@ -0,0 +1,145 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarksnapshotfile.h"
+#include "update_detection/file_system_observer/remotefilesystemobserverworker.h"
+#include "update_detection/file_system_observer/snapshot/snapshotfile.h"
+
+#include "db/parmsdb.h"
+#include "jobs/syncjobmanager.h"
+#include "jobs/network/httpsessionpool.h"
+#include "keychainmanager/keychainmanager.h"
+#include "network/proxy.h"
+#include "utility/timerutility.h"
+
+#include "libcommon/utility/urlhelper.h"
+#include "libcommonserver/io/iohelper.h"
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <version.h>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 100;
+constexpr int filesPerDir = 1000;
+constexpr int changeCount = 100; // Per kind of change
+
+} // namespace
+
+void BenchmarkSnapshotFile::setUp() {
+    TestBase::start();
+
+    MockKDriveServer::Settings settings;
+    settings.latency = std::chrono::milliseconds(30);
+    settings.bandwidth = 20 * 1024 * 1024; // 20MB/s
+    _server = std::make_unique<MockKDriveServer>(settings);
+    UrlHelper::setCustomApiUrl(_server->apiUrl());
+
+    _remoteSyncDirId = _server->createDirectory(MockKDriveServer::rootId, "benchmarkSnapshotFile");
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const NodeId dirId = _server->createDirectory(_remoteSyncDirId, "dir" + std::to_string(dirIndex));
+        for (int index = 0; index < filesPerDir; ++index) {
+            (void) _server->createFile(dirId, "file" + std::to_string(index) + ".txt", "content");
+        }
+    }
+
+    // The token is never checked by the mock server
+    ApiToken apiToken;
+    apiToken.setAccessToken("benchmarkToken");
+
+    const std::string keychainKey("123");
+    (void) KeyChainManager::instance(true);
+    (void) KeyChainManager::instance()->writeToken(keychainKey, apiToken.reconstructJsonString());
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, keychainKey);
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    (void) Proxy::instance(ProxyConfig());
+
+    Sync sync(1, drive.dbId(), _localTempDir.path(), "", "benchmarkSnapshotFile", _remoteSyncDirId);
+    sync.setDbPath(MockDb::makeDbName(1, 1, 1, 1));
+    (void) ParmsDb::instance()->insertSync(sync);
+
+    _syncPal = std::make_shared<SyncPalTest>(sync.dbId(), KDRIVE_VERSION_STRING);
+    _syncPal->syncDb()->setAutoDelete(true);
+    _syncPal->createSharedObjects();
+}
+
+void BenchmarkSnapshotFile::tearDown() {
+    if (_syncPal && _syncPal->syncDb()) {
+        (void) IoHelper::deleteItem(SnapshotFile::path(_syncPal->syncDb()->dbPath()));
+        _syncPal->syncDb()->close();
+    }
+    _syncPal.reset();
+    _server.reset();
+    UrlHelper::setCustomApiUrl("");
+
+    HttpSessionPool::instance()->clear();
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    SyncJobManagerSingleton::instance()->stop();
+    SyncJobManagerSingleton::clear();
+    TestBase::stop();
+}
+
+void BenchmarkSnapshotFile::benchmarkStartup() {
+    std::cout << std::endl;
+
+    TimerUtility timer;
+    uint64_t itemCount = 0;
+    {
+        const auto observer = std::make_shared<RemoteFileSystemObserverWorker>(_syncPal, "Remote File System Observer", "RFSO");
+        CPPUNIT_ASSERT(observer->generateInitialSnapshot());
+        itemCount = observer->liveSnapshot().nbItems();
+        std::cout << "Cold start with " << itemCount << " items: " << timer.elapsed<DoubleSeconds>().count() << "s"
+                  << std::endl;
+
+        timer.restart();
+        observer->saveSnapshot();
+        std::cout << "Snapshot saved in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+    }
+
+    const NodeId dirId = _server->childId(_remoteSyncDirId, "dir0");
+    for (int index = 0; index < changeCount; ++index) {
+        const std::string name = "file" + std::to_string(index) + ".txt";
+        CPPUNIT_ASSERT(!_server->createFile(dirId, "new" + std::to_string(index) + ".txt", "new").empty());
+        CPPUNIT_ASSERT(_server->editFile(_server->childId(dirId, name), "edited"));
+        CPPUNIT_ASSERT(_server->rename(_server->childId(dirId, "file" + std::to_string(changeCount + index) + ".txt"),
+                                       "renamed" + std::to_string(index) + ".txt"));
+    }
+
+    timer.restart();
+    const auto observer = std::make_shared<RemoteFileSystemObserverWorker>(_syncPal, "Remote File System Observer", "RFSO");
+    CPPUNIT_ASSERT(observer->generateInitialSnapshot());
+    std::cout << "Warm start with " << 3 * changeCount << " changes: " << timer.elapsed<DoubleSeconds>().count() << "s"
+              << std::endl;
+    CPPUNIT_ASSERT_EQUAL(itemCount + changeCount, observer->liveSnapshot().nbItems());
+}
+
+} // namespace KDC
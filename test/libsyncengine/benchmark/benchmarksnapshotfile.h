@@ -0,0 +1,49 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_classes/syncpaltest.h"
+#include "test_utility/localtemporarydirectory.h"
+#include "test_utility/mockkdriveserver.h"
+
+namespace KDC {
+
+class BenchmarkSnapshotFile : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkSnapshotFile);
+        CPPUNIT_TEST(benchmarkStartup);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // Remote snapshot generation of a 100k items drive with a full listing, then from the snapshot saved on stop with a
+        // few hundred changes to catch up on.
+        void benchmarkStartup();
+
+        std::unique_ptr<MockKDriveServer> _server;
+        std::shared_ptr<SyncPalTest> _syncPal;
+        NodeId _remoteSyncDirId;
+        LocalTemporaryDirectory _localTempDir{"benchmarkSnapshotFile"};
+};
+
+} // namespace KDC
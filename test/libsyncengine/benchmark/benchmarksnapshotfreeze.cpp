@@ -0,0 +1,135 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarksnapshotfreeze.h"
+
+#include "update_detection/file_system_observer/snapshot/livesnapshot.h"
+#include "utility/timerutility.h"
+
+#include <fstream>
+
+#if defined(KD_LINUX)
+#include <unistd.h>
+#endif
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 1000;
+constexpr int filesPerDir = 1000;
+constexpr int changedItemsCount = 1000;
+
+// Resident memory of the process in MB, 0 if not available.
+double residentMemory() {
+#if defined(KD_LINUX)
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    statm >> size >> resident;
+    return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+void BenchmarkSnapshotFreeze::setUp() {
+    TestBase::start();
+}
+
+void BenchmarkSnapshotFreeze::tearDown() {
+    TestBase::stop();
+}
+
+void BenchmarkSnapshotFreeze::benchmarkFreeze() {
+    const NodeId rootNodeId = "1";
+    const DbNode dummyRootNode(0, std::nullopt, SyncName(), SyncName(), rootNodeId, rootNodeId, std::nullopt, std::nullopt,
+                               std::nullopt, NodeType::Directory, 0, std::nullopt);
+    LiveSnapshot liveSnapshot(ReplicaSide::Local, dummyRootNode);
+
+    TimerUtility timer;
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const NodeId dirId = "d" + std::to_string(dirIndex);
+        (void) liveSnapshot.updateItem(
+                SnapshotItem(dirId, rootNodeId, Str2SyncName(dirId), 0, 0, NodeType::Directory, 0, false, true, true));
+        for (int fileIndex = 0; fileIndex < filesPerDir; ++fileIndex) {
+            const NodeId fileId = dirId + "f" + std::to_string(fileIndex);
+            (void) liveSnapshot.updateItem(
+                    SnapshotItem(fileId, dirId, Str2SyncName(fileId), 0, 0, NodeType::File, 100, false, true, true));
+        }
+    }
+    std::cout << std::endl;
+    std::cout << "Live snapshot of " << liveSnapshot.nbItems() << " items generated in " << timer.elapsed<DoubleSeconds>().count()
+              << "s, resident memory: " << residentMemory() << "MB" << std::endl;
+
+    // Deep copy
+    double memoryBefore = residentMemory();
+    timer.restart();
+    auto deepCopy = std::make_shared<ConstSnapshot>(liveSnapshot);
+    std::cout << "Deep copy: " << timer.elapsed<DoubleSeconds>().count() << "s, +" << residentMemory() - memoryBefore << "MB"
+              << std::endl;
+    deepCopy.reset();
+
+    // First freeze: full copy
+    memoryBefore = residentMemory();
+    timer.restart();
+    auto constSnapshot = liveSnapshot.freeze();
+    std::cout << "First freeze: " << timer.elapsed<DoubleSeconds>().count() << "s, +" << residentMemory() - memoryBefore << "MB"
+              << std::endl;
+    constSnapshot.reset();
+
+    // Freeze without changes
+    timer.restart();
+    constSnapshot = liveSnapshot.freeze();
+    std::cout << "Freeze without changes: " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+    constSnapshot.reset();
+
+    // Freeze after a few changes
+    for (int index = 0; index < changedItemsCount; ++index) {
+        const NodeId dirId = "d" + std::to_string(index % dirCount);
+        const NodeId fileId = dirId + "f" + std::to_string(index);
+        switch (index % 4) {
+            case 0:
+                (void) liveSnapshot.setName(fileId, Str2SyncName(fileId + "_renamed"));
+                break;
+            case 1:
+                (void) liveSnapshot.setLastModified(fileId, index);
+                break;
+            case 2:
+                (void) liveSnapshot.updateItem(SnapshotItem(fileId, "d0", Str2SyncName(fileId), 0, 0, NodeType::File, 100, false,
+                                                            true, true));
+                break;
+            default:
+                (void) liveSnapshot.removeItem(fileId);
+                break;
+        }
+    }
+    memoryBefore = residentMemory();
+    timer.restart();
+    constSnapshot = liveSnapshot.freeze();
+    std::cout << "Freeze after " << changedItemsCount << " changes: " << timer.elapsed<DoubleSeconds>().count() << "s, +"
+              << residentMemory() - memoryBefore << "MB" << std::endl;
+
+    CPPUNIT_ASSERT_EQUAL(liveSnapshot.nbItems(), constSnapshot->nbItems());
+}
+
+} // namespace KDC
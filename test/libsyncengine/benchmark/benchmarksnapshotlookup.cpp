@@ -0,0 +1,78 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarksnapshotlookup.h"
+
+#include "update_detection/file_system_observer/snapshot/livesnapshot.h"
+#include "utility/timerutility.h"
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int itemCount = 200000;
+constexpr int renamedItemCount = 10000;
+
+} // namespace
+
+void BenchmarkSnapshotLookup::setUp() {
+    TestBase::start();
+}
+
+void BenchmarkSnapshotLookup::tearDown() {
+    TestBase::stop();
+}
+
+void BenchmarkSnapshotLookup::benchmarkFlatDirectory() {
+    const NodeId rootNodeId = "1";
+    const DbNode dummyRootNode(0, std::nullopt, SyncName(), SyncName(), rootNodeId, rootNodeId, std::nullopt, std::nullopt,
+                               std::nullopt, NodeType::Directory, 0, std::nullopt);
+    LiveSnapshot liveSnapshot(ReplicaSide::Local, dummyRootNode);
+    (void) liveSnapshot.updateItem(
+            SnapshotItem("dir", rootNodeId, Str("dir"), 0, 0, NodeType::Directory, 0, false, true, true));
+
+    TimerUtility timer;
+    for (int index = 0; index < itemCount; ++index) {
+        const NodeId id = std::to_string(index);
+        (void) liveSnapshot.updateItem(
+                SnapshotItem(id, "dir", Str2SyncName("file_" + id), 0, 0, NodeType::File, 100, false, true, true));
+    }
+    std::cout << std::endl;
+    std::cout << itemCount << " items inserted in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    timer.restart();
+    NodeId nodeId;
+    for (int index = 0; index < itemCount; ++index) {
+        CPPUNIT_ASSERT(liveSnapshot.getItemId(SyncPath("dir") / Str2SyncName("file_" + std::to_string(index)), nodeId));
+    }
+    std::cout << itemCount << " path lookups: " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    timer.restart();
+    for (int index = 0; index < renamedItemCount; ++index) {
+        const NodeId id = std::to_string(index);
+        CPPUNIT_ASSERT(liveSnapshot.setName(id, Str2SyncName("renamed_" + id)));
+    }
+    std::cout << renamedItemCount << " renames: " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    CPPUNIT_ASSERT(liveSnapshot.getItemId(SyncPath("dir") / Str2SyncName("renamed_0"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("0"), nodeId);
+}
+
+} // namespace KDC
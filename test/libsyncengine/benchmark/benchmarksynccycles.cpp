@@ -0,0 +1,314 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarksynccycles.h"
+
+#include "db/parmsdb.h"
+#include "jobs/syncjobmanager.h"
+#include "jobs/network/httpsessionpool.h"
+#include "jobs/network/networkjobsparams.h"
+#include "keychainmanager/keychainmanager.h"
+#include "mocks/libcommonserver/db/mockdb.h"
+#include "network/proxy.h"
+#include "requests/parameterscache.h"
+#include "syncpal/syncpal.h"
+
+#include "libcommonserver/io/filestat.h"
+#include "libcommonserver/io/iohelper.h"
+#include "libcommonserver/utility/utility.h"
+#include "libcommon/utility/urlhelper.h"
+#include "test_utility/localtemporarydirectory.h"
+
+#include <version.h>
+
+#include <fstream>
+
+using namespace CppUnit;
+using namespace std::chrono;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 10;
+constexpr int filesPerDir = 100;
+constexpr size_t fileSize = 4 * 1024; // 4KB
+constexpr int changeCount = 10; // Per directory and per kind of change
+constexpr int64_t bigFileSize = bigFileThreshold + 10 * 1024 * 1024; // Uploaded through an upload session
+constexpr auto idleDuration = milliseconds(3000);
+constexpr auto syncTimeout = minutes(30);
+
+std::string numberedName(const std::string &prefix, const int dirIndex, const int index) {
+    return prefix + std::to_string(dirIndex) + "_" + std::to_string(index) + ".txt";
+}
+
+void writeFile(const SyncPath &path, const int64_t size, const char c) {
+    std::ofstream file(path, std::ios::binary);
+    const std::string buffer(static_cast<size_t>(std::min<int64_t>(size, 1024 * 1024)), c);
+    for (int64_t written = 0; written < size; written += static_cast<int64_t>(buffer.size())) {
+        (void) file.write(buffer.data(), std::min<std::streamsize>(static_cast<std::streamsize>(buffer.size()), size - written));
+    }
+}
+
+uint64_t localFileCount(const SyncPath &dirPath) {
+    uint64_t count = 0;
+    for (const auto &entry: std::filesystem::recursive_directory_iterator(dirPath)) {
+        if (entry.is_regular_file()) ++count;
+    }
+    return count;
+}
+
+void createRemoteFiles(MockKDriveServer &server, const NodeId &syncDirId, const std::string &prefix) {
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const NodeId dirId = server.childId(syncDirId, "remoteDir" + std::to_string(dirIndex));
+        for (int index = 0; index < changeCount; ++index) {
+            CPPUNIT_ASSERT(!server.createFile(dirId, numberedName(prefix, dirIndex, index), std::string(fileSize, 'n')).empty());
+        }
+    }
+}
+
+void createLocalFiles(const SyncPath &syncPath, const std::string &prefix) {
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const SyncPath dirPath = syncPath / ("localDir" + std::to_string(dirIndex));
+        for (int index = 0; index < changeCount; ++index) {
+            writeFile(dirPath / numberedName(prefix, dirIndex, index), fileSize, 'n');
+        }
+    }
+}
+
+// Edit, rename, move and delete files in each directory, as another client would do.
+void changeRemoteFiles(MockKDriveServer &server, const NodeId &syncDirId) {
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const NodeId dirId = server.childId(syncDirId, "remoteDir" + std::to_string(dirIndex));
+        const NodeId nextDirId = server.childId(syncDirId, "remoteDir" + std::to_string((dirIndex + 1) % dirCount));
+        for (int index = 0; index < changeCount; ++index) {
+            const auto fileId = [&server, &dirId](const int fileIndex) {
+                return server.childId(dirId, numberedName("remoteFile", 0, fileIndex));
+            };
+            CPPUNIT_ASSERT(server.editFile(fileId(index), std::string(fileSize + 1, 'e')));
+            CPPUNIT_ASSERT(server.rename(fileId(changeCount + index), numberedName("remoteRenamed", dirIndex, index)));
+            const NodeId movedFileId = fileId(2 * changeCount + index);
+            CPPUNIT_ASSERT(server.rename(movedFileId, numberedName("remoteMoved", dirIndex, index)));
+            CPPUNIT_ASSERT(server.move(movedFileId, nextDirId));
+            CPPUNIT_ASSERT(server.remove(fileId(3 * changeCount + index)));
+        }
+    }
+    createRemoteFiles(server, syncDirId, "remoteNew");
+}
+
+void changeLocalFiles(const SyncPath &syncPath) {
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const SyncPath dirPath = syncPath / ("localDir" + std::to_string(dirIndex));
+        const SyncPath nextDirPath = syncPath / ("localDir" + std::to_string((dirIndex + 1) % dirCount));
+        for (int index = 0; index < changeCount; ++index) {
+            const auto filePath = [&dirPath](const int fileIndex) { return dirPath / numberedName("localFile", 0, fileIndex); };
+            writeFile(filePath(index), fileSize + 1, 'e');
+            std::filesystem::rename(filePath(changeCount + index), dirPath / numberedName("localRenamed", dirIndex, index));
+            std::filesystem::rename(filePath(2 * changeCount + index), nextDirPath / numberedName("localMoved", dirIndex, index));
+            (void) std::filesystem::remove(filePath(3 * changeCount + index));
+        }
+    }
+    createLocalFiles(syncPath, "localNew");
+}
+
+} // namespace
+
+void BenchmarkSyncCycles::setUp() {
+    TestBase::start();
+
+    // The token is never checked by the mock server
+    ApiToken apiToken;
+    apiToken.setAccessToken("benchmarkToken");
+
+    const std::string keychainKey("123");
+    (void) KeyChainManager::instance(true);
+    (void) KeyChainManager::instance()->writeToken(keychainKey, apiToken.reconstructJsonString());
+
+    bool alreadyExists = false;
+    (void) ParmsDb::instance(MockDb::makeDbName(alreadyExists), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, keychainKey);
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(_driveDbId, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    (void) Proxy::instance(ProxyConfig());
+}
+
+void BenchmarkSyncCycles::tearDown() {
+    if (_syncPal) _syncPal->stop(SyncPal::PauseCaller::Sync, SyncPal::DbBehaviorAfterStop::Remove);
+    _syncPal.reset();
+    _server.reset();
+    UrlHelper::setCustomApiUrl("");
+
+    HttpSessionPool::instance()->clear();
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    SyncJobManagerSingleton::instance()->stop();
+    SyncJobManagerSingleton::clear();
+    TestBase::stop();
+}
+
+void BenchmarkSyncCycles::benchmarkSyncCycles() {
+    std::cout << std::endl;
+    const SyncPath homePath = CommonUtility::envVarValue("HOME");
+    DataExtractor dataExtractor(homePath / "benchSyncCycles.csv");
+    for (const auto &header: {"seconds", "files", "requests", "injected errors", "MB sent", "MB received", "MB/s"}) {
+        dataExtractor.addColumHeader(header);
+    }
+
+    runProfile("loopback", {}, 1, dataExtractor);
+
+    MockKDriveServer::Settings wanSettings;
+    wanSettings.latency = milliseconds(30);
+    wanSettings.bandwidth = 20 * 1024 * 1024; // 20MB/s
+    runProfile("wan", wanSettings, 2, dataExtractor);
+
+    MockKDriveServer::Settings flakySettings = wanSettings;
+    flakySettings.errorRate = 0.01;
+    runProfile("flaky wan", flakySettings, 3, dataExtractor);
+
+    dataExtractor.print();
+}
+
+void BenchmarkSyncCycles::runProfile(const std::string &profileName, const MockKDriveServer::Settings &settings,
+                                     const SyncDbId syncDbId, DataExtractor &dataExtractor) {
+    _server = std::make_unique<MockKDriveServer>(settings);
+    UrlHelper::setCustomApiUrl(_server->apiUrl());
+
+    const std::string syncDirName = "benchSyncCycles";
+    const NodeId remoteSyncDirId = _server->createDirectory(MockKDriveServer::rootId, syncDirName);
+    const LocalTemporaryDirectory localSyncDir(syncDirName);
+    const SyncPath &localSyncPath = localSyncDir.path();
+
+    // As many files on both replicas
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const NodeId remoteDirId = _server->createDirectory(remoteSyncDirId, "remoteDir" + std::to_string(dirIndex));
+        const SyncPath localDirPath = localSyncPath / ("localDir" + std::to_string(dirIndex));
+        (void) std::filesystem::create_directory(localDirPath);
+        for (int index = 0; index < filesPerDir; ++index) {
+            (void) _server->createFile(remoteDirId, numberedName("remoteFile", 0, index), std::string(fileSize, 'r'));
+            writeFile(localDirPath / numberedName("localFile", 0, index), fileSize, 'l');
+        }
+    }
+
+    FileStat fileStat;
+    IoError ioError = IoError::Unknown;
+    CPPUNIT_ASSERT(IoHelper::getFileStat(localSyncPath, &fileStat, ioError, IoHelper::PathCheckOption::Insensitive) &&
+                   ioError == IoError::Success);
+    Sync sync(syncDbId, _driveDbId, localSyncPath, std::to_string(fileStat.inode), syncDirName, remoteSyncDirId);
+    sync.setDbPath(MockDb::makeDbName(1, 1, 1, syncDbId));
+    CPPUNIT_ASSERT(ParmsDb::instance()->insertSync(sync));
+
+    _syncPal = std::make_shared<SyncPal>(std::make_shared<VfsOff>(VfsSetupParams(Log::instance()->getLogger())), syncDbId,
+                                         KDRIVE_VERSION_STRING);
+    _syncPal->createSharedObjects();
+    _syncPal->syncDb()->setAutoDelete(true);
+
+    TimerUtility phaseTimer;
+    _server->resetStats();
+    _syncPal->start();
+    completePhase(profileName, "initial sync", phaseTimer, localSyncPath, remoteSyncDirId, dataExtractor);
+
+    phaseTimer.restart();
+    _server->resetStats();
+    changeRemoteFiles(*_server, remoteSyncDirId);
+    completePhase(profileName, "remote changes", phaseTimer, localSyncPath, remoteSyncDirId, dataExtractor);
+
+    phaseTimer.restart();
+    _server->resetStats();
+    changeLocalFiles(localSyncPath);
+    completePhase(profileName, "local changes", phaseTimer, localSyncPath, remoteSyncDirId, dataExtractor);
+
+    phaseTimer.restart();
+    _server->resetStats();
+    CPPUNIT_ASSERT(!_server->createFile(remoteSyncDirId, "remoteBig.bin", std::string(bigFileSize, 'r')).empty());
+    writeFile(localSyncPath / "localBig.bin", bigFileSize, 'l');
+    completePhase(profileName, "big file transfers", phaseTimer, localSyncPath, remoteSyncDirId, dataExtractor);
+
+    // Changes on both sides while the sync is paused
+    _syncPal->pause();
+    const TimerUtility pauseTimer;
+    while (!_syncPal->isPaused()) {
+        CPPUNIT_ASSERT(pauseTimer.elapsed<minutes>() < minutes(1));
+        Utility::msleep(10);
+    }
+    createRemoteFiles(*_server, remoteSyncDirId, "remoteResumed");
+    createLocalFiles(localSyncPath, "localResumed");
+    phaseTimer.restart();
+    _server->resetStats();
+    _syncPal->unpause();
+    completePhase(profileName, "resumption", phaseTimer, localSyncPath, remoteSyncDirId, dataExtractor);
+
+    _syncPal->stop(SyncPal::PauseCaller::Sync, SyncPal::DbBehaviorAfterStop::Remove);
+    _syncPal.reset();
+    _server.reset();
+}
+
+void BenchmarkSyncCycles::completePhase(const std::string &profileName, const std::string &phaseName,
+                                        const TimerUtility &phaseTimer, const SyncPath &localSyncPath,
+                                        const NodeId &remoteSyncDirId, DataExtractor &dataExtractor) {
+    const double seconds = waitForSyncToBeIdle(phaseTimer);
+    const MockKDriveServer::Stats stats = _server->stats();
+
+    const uint64_t fileCount = localFileCount(localSyncPath);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(profileName + ", " + phaseName, _server->fileCount(remoteSyncDirId), fileCount);
+
+    constexpr double megabyte = 1024. * 1024.;
+    const double megabytesSent = static_cast<double>(stats.bytesSent) / megabyte;
+    const double megabytesReceived = static_cast<double>(stats.bytesReceived) / megabyte;
+
+    dataExtractor.addRow(profileName + " - " + phaseName);
+    dataExtractor.push(std::to_string(seconds));
+    dataExtractor.push(std::to_string(fileCount));
+    dataExtractor.push(std::to_string(stats.requestCount));
+    dataExtractor.push(std::to_string(stats.injectedErrorCount));
+    dataExtractor.push(std::to_string(megabytesSent));
+    dataExtractor.push(std::to_string(megabytesReceived));
+    dataExtractor.push(std::to_string((megabytesSent + megabytesReceived) / seconds));
+
+    std::cout << profileName << " - " << phaseName << ": " << seconds << "s, " << stats.requestCount << " requests, "
+              << stats.injectedErrorCount << " injected errors" << std::endl;
+}
+
+double BenchmarkSyncCycles::waitForSyncToBeIdle(const TimerUtility &phaseTimer) const {
+    // The sync is over once it stays idle for `idleDuration`. The phase ends when this last idle period has begun.
+    while (phaseTimer.elapsed<minutes>() < syncTimeout) {
+        if (isSyncIdle()) {
+            const double idleStart = phaseTimer.elapsed<DoubleSeconds>().count();
+            const TimerUtility idleTimer;
+            while (isSyncIdle() && idleTimer.elapsed<milliseconds>() < idleDuration) {
+                Utility::msleep(5);
+            }
+            if (idleTimer.elapsed<milliseconds>() >= idleDuration) return idleStart;
+        }
+        Utility::msleep(10);
+    }
+
+    CPPUNIT_FAIL("The sync is still running after " + std::to_string(syncTimeout.count()) + " minutes");
+    return 0.;
+}
+
+bool BenchmarkSyncCycles::isSyncIdle() const {
+    return _syncPal->isIdle() && !_syncPal->_localFSObserverWorker->updating() &&
+           !_syncPal->_remoteFSObserverWorker->updating();
+}
+
+} // namespace KDC
@@ -0,0 +1,59 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/dataextractor.h"
+#include "test_utility/mockkdriveserver.h"
+#include "utility/timerutility.h"
+
+namespace KDC {
+
+class SyncPal;
+
+class BenchmarkSyncCycles : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkSyncCycles);
+        CPPUNIT_TEST(benchmarkSyncCycles);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // Full sync cycles of a SyncPal against a local mock of the kDrive API, under several network profiles: initial sync,
+        // incremental syncs of remote and local changes, transfers of big files, and resumption after a pause. The timings are
+        // written as CSV in $HOME/benchSyncCycles.csv.
+        void benchmarkSyncCycles();
+
+        void runProfile(const std::string &profileName, const MockKDriveServer::Settings &settings, SyncDbId syncDbId,
+                        DataExtractor &dataExtractor);
+        // Wait for the end of the sync, check that both replicas hold the same files and record the timings of the phase.
+        void completePhase(const std::string &profileName, const std::string &phaseName, const TimerUtility &phaseTimer,
+                           const SyncPath &localSyncPath, const NodeId &remoteSyncDirId, DataExtractor &dataExtractor);
+        // Return the time elapsed on `phaseTimer` when the sync became idle for good.
+        double waitForSyncToBeIdle(const TimerUtility &phaseTimer) const;
+        [[nodiscard]] bool isSyncIdle() const;
+
+        std::unique_ptr<MockKDriveServer> _server;
+        std::shared_ptr<SyncPal> _syncPal;
+        DriveDbId _driveDbId = 1;
+};
+
+} // namespace KDC
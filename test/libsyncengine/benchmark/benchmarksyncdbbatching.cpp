@@ -0,0 +1,100 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarksyncdbbatching.h"
+
+#include "db/syncdb.h"
+#include "utility/timerutility.h"
+
+#include <version.h>
+#include <mocks/libcommonserver/db/mockdb.h>
+
+#include <vector>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int fileCount = 50000;
+
+// Same writes as the executor for each created file: the node insertion once the job is done, then the status update. For
+// each edited file: the node update, then the status update. Only the updates can be batched.
+double propagateFiles(const bool withBatching, const bool creations) {
+    bool alreadyExists = false;
+    const SyncPath syncDbPath = MockDb::makeDbName(alreadyExists);
+    SyncDb syncDb(syncDbPath.string());
+    syncDb.init(KDRIVE_VERSION_STRING);
+    syncDb.setAutoDelete(true);
+
+    std::vector<DbNode> nodes;
+    nodes.reserve(fileCount);
+    for (int index = 0; index < fileCount; ++index) {
+        const std::string name = "f" + std::to_string(index);
+        (void) nodes.emplace_back(syncDb.rootNode().nodeId(), Str2SyncName(name), Str2SyncName(name), "l" + name, "r" + name, 0,
+                                  0, 0, NodeType::File, 100, std::nullopt);
+        if (creations) continue;
+
+        DbNodeId dbNodeId = 0;
+        bool constraintError = false;
+        CPPUNIT_ASSERT(syncDb.insertNode(nodes.back(), dbNodeId, constraintError));
+        nodes.back().setNodeId(dbNodeId);
+        nodes.back().setSize(200);
+    }
+
+    TimerUtility timer;
+    if (withBatching) syncDb.enableWriteBatching();
+    for (const auto &node: nodes) {
+        DbNodeId dbNodeId = node.nodeId();
+        bool found = false;
+        if (creations) {
+            bool constraintError = false;
+            CPPUNIT_ASSERT(syncDb.insertNode(node, dbNodeId, constraintError));
+        } else {
+            CPPUNIT_ASSERT(syncDb.updateNode(node, found) && found);
+        }
+        CPPUNIT_ASSERT(syncDb.updateNodeStatus(dbNodeId, SyncFileStatus::Success, found) && found);
+        CPPUNIT_ASSERT(syncDb.commitWriteBatchIfExpired());
+    }
+    CPPUNIT_ASSERT(syncDb.disableWriteBatching());
+    const double elapsed = timer.elapsed<DoubleSeconds>().count();
+
+    syncDb.close();
+    return elapsed;
+}
+
+} // namespace
+
+void BenchmarkSyncDbBatching::setUp() {
+    TestBase::start();
+}
+
+void BenchmarkSyncDbBatching::tearDown() {
+    TestBase::stop();
+}
+
+void BenchmarkSyncDbBatching::benchmarkPropagationWrites() {
+    std::cout << std::endl;
+    std::cout << fileCount << " file creations, one transaction per write: " << propagateFiles(false, true) << "s" << std::endl;
+    std::cout << fileCount << " file creations, batched writes: " << propagateFiles(true, true) << "s" << std::endl;
+    std::cout << fileCount << " file edits, one transaction per write: " << propagateFiles(false, false) << "s" << std::endl;
+    std::cout << fileCount << " file edits, batched writes: " << propagateFiles(true, false) << "s" << std::endl;
+}
+
+} // namespace KDC
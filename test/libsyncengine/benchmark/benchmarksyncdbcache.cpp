@@ -0,0 +1,119 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarksyncdbcache.h"
+
+#include "db/syncdb.h"
+#include "utility/timerutility.h"
+
+#include <version.h>
+#include <mocks/libcommonserver/db/mockdb.h>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 1000;
+constexpr int filesPerDir = 1000;
+constexpr int updateCount = 10000;
+
+// Inserting 1M nodes without a transaction would take too long
+class TransactionalSyncDb : public SyncDb {
+    public:
+        using SyncDb::SyncDb;
+        using Db::commitTransaction;
+        using Db::startTransaction;
+};
+
+} // namespace
+
+void BenchmarkSyncDbCache::setUp() {
+    TestBase::start();
+}
+
+void BenchmarkSyncDbCache::tearDown() {
+    TestBase::stop();
+}
+
+void BenchmarkSyncDbCache::benchmarkRefresh() {
+    bool alreadyExists = false;
+    const SyncPath syncDbPath = MockDb::makeDbName(alreadyExists);
+    const auto syncDb = std::make_shared<TransactionalSyncDb>(syncDbPath.string());
+    syncDb->init(KDRIVE_VERSION_STRING);
+    syncDb->setAutoDelete(true);
+
+    TimerUtility timer;
+    std::vector<DbNodeId> fileDbNodeIds;
+    fileDbNodeIds.reserve(static_cast<size_t>(dirCount) * filesPerDir);
+    syncDb->startTransaction();
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const std::string dirName = "d" + std::to_string(dirIndex);
+        const DbNode dirNode(syncDb->rootNode().nodeId(), Str2SyncName(dirName), Str2SyncName(dirName), "l" + dirName,
+                             "r" + dirName, 0, 0, 0, NodeType::Directory, 0, std::nullopt);
+        DbNodeId dirDbNodeId = 0;
+        bool constraintError = false;
+        CPPUNIT_ASSERT(syncDb->insertNode(dirNode, dirDbNodeId, constraintError));
+        for (int fileIndex = 0; fileIndex < filesPerDir; ++fileIndex) {
+            const std::string fileName = dirName + "f" + std::to_string(fileIndex);
+            const DbNode fileNode(dirDbNodeId, Str2SyncName(fileName), Str2SyncName(fileName), "l" + fileName, "r" + fileName, 0,
+                                  0, 0, NodeType::File, 100, std::nullopt);
+            DbNodeId fileDbNodeId = 0;
+            CPPUNIT_ASSERT(syncDb->insertNode(fileNode, fileDbNodeId, constraintError));
+            fileDbNodeIds.push_back(fileDbNodeId);
+        }
+    }
+    syncDb->commitTransaction();
+    std::cout << std::endl;
+    std::cout << fileDbNodeIds.size() + dirCount << " nodes inserted in " << timer.elapsed<DoubleSeconds>().count() << "s"
+              << std::endl;
+
+    SyncDbReadOnlyCache &cache = syncDb->cache();
+    timer.restart();
+    CPPUNIT_ASSERT(cache.reloadIfNeeded());
+    std::cout << "Initial load: " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+    cache.suspend();
+
+    const auto updateNodes = [&]() {
+        syncDb->startTransaction();
+        for (int index = 0; index < updateCount; ++index) {
+            bool found = false;
+            const auto dbNodeId = fileDbNodeIds[static_cast<size_t>(index) * fileDbNodeIds.size() / updateCount];
+            CPPUNIT_ASSERT(syncDb->updateNodeStatus(dbNodeId, SyncFileStatus::Success, found) && found);
+        }
+        syncDb->commitTransaction();
+    };
+
+    // Incremental refresh
+    updateNodes();
+    timer.restart();
+    CPPUNIT_ASSERT(cache.reloadIfNeeded());
+    std::cout << "Incremental refresh after " << updateCount << " updates: " << timer.elapsed<DoubleSeconds>().count() << "s"
+              << std::endl;
+
+    // Full reload, as before
+    updateNodes();
+    cache.clear();
+    timer.restart();
+    CPPUNIT_ASSERT(cache.reloadIfNeeded());
+    std::cout << "Full reload after " << updateCount << " updates: " << timer.elapsed<DoubleSeconds>().count() << "s"
+              << std::endl;
+}
+
+} // namespace KDC
@@ -0,0 +1,143 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarktmpblacklist.h"
+
+#include "db/parmsdb.h"
+#include "keychainmanager/keychainmanager.h"
+#include "network/proxy.h"
+#include "syncpal/tmpblacklistmanager.h"
+#include "utility/timerutility.h"
+
+#include "libcommon/utility/utility.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <version.h>
+
+#include <algorithm>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int itemCount = 50'000;
+constexpr int itemsPerDir = 500;
+constexpr int scanLookupCount = 1000;
+
+SyncPath itemPath(const int index) {
+    return SyncPath("dir" + std::to_string(index / itemsPerDir)) / ("file" + std::to_string(index) + ".txt");
+}
+
+// Half of the looked up paths are below a blacklisted item
+SyncPath lookupPath(const int index) {
+    return index % 2 ? itemPath(index) / "child" : SyncPath("dir" + std::to_string(index / itemsPerDir)) / "other.txt";
+}
+
+} // namespace
+
+void BenchmarkTmpBlacklist::setUp() {
+    TestBase::start();
+
+    ApiToken apiToken;
+    apiToken.setAccessToken("benchmarkToken");
+
+    const std::string keychainKey("123");
+    (void) KeyChainManager::instance(true);
+    (void) KeyChainManager::instance()->writeToken(keychainKey, apiToken.reconstructJsonString());
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, keychainKey);
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    (void) Proxy::instance(ProxyConfig());
+
+    Sync sync(1, drive.dbId(), _localTempDir.path(), "", "benchmarkTmpBlacklist");
+    sync.setDbPath(MockDb::makeDbName(1, 1, 1, 1));
+    (void) ParmsDb::instance()->insertSync(sync);
+
+    _syncPal = std::make_shared<SyncPalTest>(sync.dbId(), KDRIVE_VERSION_STRING);
+    _syncPal->syncDb()->setAutoDelete(true);
+    _syncPal->createSharedObjects();
+    _syncPal->createWorkers();
+}
+
+void BenchmarkTmpBlacklist::tearDown() {
+    if (_syncPal && _syncPal->syncDb()) {
+        _syncPal->syncDb()->close();
+    }
+    _syncPal.reset();
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    TestBase::stop();
+}
+
+void BenchmarkTmpBlacklist::benchmarkLargeBlacklist() {
+    std::cout << std::endl;
+    TmpBlacklistManager manager(_syncPal);
+
+    TimerUtility timer;
+    for (int index = 0; index < itemCount; ++index) {
+        manager.blacklistItem("id" + std::to_string(index), itemPath(index), ReplicaSide::Local);
+    }
+    std::cout << itemCount << " items blacklisted in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    timer.restart();
+    int blacklistedCount = 0;
+    for (int index = 0; index < itemCount; ++index) {
+        blacklistedCount += manager.isTmpBlacklisted(lookupPath(index), ReplicaSide::Local) ? 1 : 0;
+    }
+    std::cout << itemCount << " lookups in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+    CPPUNIT_ASSERT_EQUAL(itemCount / 2, blacklistedCount);
+
+    // What each lookup costs when all the blacklisted paths are compared with the looked up one
+    std::vector<SyncPath> paths;
+    paths.reserve(itemCount);
+    for (int index = 0; index < itemCount; ++index) {
+        paths.push_back(itemPath(index));
+    }
+    timer.restart();
+    int scanBlacklistedCount = 0;
+    for (int index = 0; index < scanLookupCount; ++index) {
+        const auto path = lookupPath(index);
+        scanBlacklistedCount += std::ranges::any_of(paths, [&path](const SyncPath &blacklistedPath) {
+            return CommonUtility::isDescendantOrEqual(path, blacklistedPath);
+        });
+    }
+    std::cout << scanLookupCount << " lookups with a full scan in " << timer.elapsed<DoubleSeconds>().count() << "s"
+              << std::endl;
+    CPPUNIT_ASSERT_EQUAL(scanLookupCount / 2, scanBlacklistedCount);
+
+    timer.restart();
+    for (int index = 0; index < itemCount; index += 2) {
+        manager.removeItemFromTmpBlacklist("id" + std::to_string(index), ReplicaSide::Local);
+    }
+    std::cout << itemCount / 2 << " items removed in " << timer.elapsed<DoubleSeconds>().count() << "s" << std::endl;
+
+    CPPUNIT_ASSERT(!manager.isTmpBlacklisted(itemPath(0), ReplicaSide::Local));
+    CPPUNIT_ASSERT(manager.isTmpBlacklisted(itemPath(1), ReplicaSide::Local));
+}
+
+} // namespace KDC
@@ -0,0 +1,45 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_classes/syncpaltest.h"
+#include "test_utility/localtemporarydirectory.h"
+
+namespace KDC {
+
+class BenchmarkTmpBlacklist : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkTmpBlacklist);
+        CPPUNIT_TEST(benchmarkLargeBlacklist);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // 50k items blacklisted, then path lookups as done for every item of the update trees and removal of half of the items.
+        // The lookups are compared with a scan of all the blacklisted paths.
+        void benchmarkLargeBlacklist();
+
+        std::shared_ptr<SyncPalTest> _syncPal;
+        LocalTemporaryDirectory _localTempDir{"benchmarkTmpBlacklist"};
+};
+
+} // namespace KDC
@@ -25,6 +25,8 @@
 #include "mocks/libcommonserver/db/mockdb.h"
 
 #include <algorithm>
+#include <random>
+#include <thread>
 #include <time.h>
 
 using namespace CppUnit;
@@ -1022,4 +1024,415 @@ void TestSyncDb::testCorrespondingNodeIdTemplate(SyncDb &db, T &testObj) {
     CPPUNIT_ASSERT(!testObj.correspondingNodeId(ReplicaSide::Unknown, "id dir loc 1", correspondingNodeId, found));
     CPPUNIT_ASSERT(!found);
 }
+
+void TestSyncDb::testChecksumCache() {
+    _testObj->enablePrepare(true);
+    _testObj->prepare();
+
+    const NodeId nodeId = "123";
+    const int64_t size = 1024;
+    const SyncTime modificationTime = testhelpers::defaultTime;
+    const SyncTime changeTime = testhelpers::defaultTime + 1;
+
+    // Empty cache
+    std::string checksum;
+    bool found = true;
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+
+    // Hit
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry(nodeId, size, modificationTime, changeTime, "checksum1"));
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(found);
+    CPPUNIT_ASSERT_EQUAL(std::string("checksum1"), checksum);
+
+    // Any change of the file status is a miss
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry("456", size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size + 1, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime + 1, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime, changeTime + 1, checksum, found));
+    CPPUNIT_ASSERT(!found);
+
+    // A new entry replaces the previous one
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry(nodeId, size, modificationTime, changeTime + 1, "checksum2"));
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime, changeTime + 1, checksum, found));
+    CPPUNIT_ASSERT(found);
+    CPPUNIT_ASSERT_EQUAL(std::string("checksum2"), checksum);
+
+    // Invalidation
+    CPPUNIT_ASSERT(_testObj->deleteChecksumCacheEntry(nodeId));
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime, changeTime + 1, checksum, found));
+    CPPUNIT_ASSERT(!found);
+    CPPUNIT_ASSERT(_testObj->deleteChecksumCacheEntry(nodeId)); // Deleting a missing entry is not an error
+
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry("1", size, modificationTime, changeTime, "checksum1"));
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry("2", size, modificationTime, changeTime, "checksum2"));
+    CPPUNIT_ASSERT(_testObj->deleteAllChecksumCacheEntries());
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry("1", size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry("2", size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+
+    // Batch invalidation
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry("1", size, modificationTime, changeTime, "checksum1"));
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry("2", size, modificationTime, changeTime, "checksum2"));
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry("3", size, modificationTime, changeTime, "checksum3"));
+    CPPUNIT_ASSERT(_testObj->deleteChecksumCacheEntries({"1", "3", "4"}));
+    SyncDb::ChecksumCacheMap entries;
+    CPPUNIT_ASSERT(_testObj->selectAllChecksumCacheEntries(entries));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), entries.size());
+    const auto &entry = entries.at("2");
+    CPPUNIT_ASSERT_EQUAL(size, entry.size);
+    CPPUNIT_ASSERT_EQUAL(modificationTime, entry.modificationTime);
+    CPPUNIT_ASSERT_EQUAL(changeTime, entry.changeTime);
+    CPPUNIT_ASSERT_EQUAL(std::string("checksum2"), entry.checksum);
+    CPPUNIT_ASSERT(_testObj->deleteAllChecksumCacheEntries());
+
+    // The entries of a deleted node and of its descendants are deleted with them
+    const DbNode dirNode(0, _testObj->rootNode().nodeId(), Str("Dir loc"), Str("Dir drive"), "id dir loc", "id dir drive",
+                         modificationTime, modificationTime, modificationTime, NodeType::Directory, 0, std::nullopt);
+    DbNodeId dirNodeDbId = 0;
+    bool constraintError = false;
+    CPPUNIT_ASSERT(_testObj->insertNode(dirNode, dirNodeDbId, constraintError));
+    const DbNode fileNode(0, dirNodeDbId, Str("File loc"), Str("File drive"), "id file loc", "id file drive", modificationTime,
+                          modificationTime, modificationTime, NodeType::File, size, std::nullopt);
+    DbNodeId fileNodeDbId = 0;
+    CPPUNIT_ASSERT(_testObj->insertNode(fileNode, fileNodeDbId, constraintError));
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry("id file loc", size, modificationTime, changeTime, "checksum1"));
+    CPPUNIT_ASSERT(_testObj->insertChecksumCacheEntry(nodeId, size, modificationTime, changeTime, "checksum2"));
+
+    CPPUNIT_ASSERT(_testObj->deleteNode(dirNodeDbId, found) && found);
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry("id file loc", size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(!found);
+    CPPUNIT_ASSERT(_testObj->selectChecksumCacheEntry(nodeId, size, modificationTime, changeTime, checksum, found));
+    CPPUNIT_ASSERT(found);
+}
+
+void TestSyncDb::testTakeNodeChanges() {
+    _testObj->enablePrepare(true);
+    _testObj->prepare();
+
+    std::unordered_set<DbNodeId> changedDbNodeIds;
+    SyncDbRevision revision = 0;
+    CPPUNIT_ASSERT(_testObj->takeNodeChanges(_testObj->revision(), changedDbNodeIds, revision));
+    CPPUNIT_ASSERT_EQUAL(_testObj->revision(), revision);
+    const SyncDbRevision initialRevision = revision;
+
+    DbNode nodeDir(_testObj->rootNode().nodeId(), Str("Dir"), Str("Dir"), "l_dir", "r_dir", testhelpers::defaultTime,
+                   testhelpers::defaultTime, testhelpers::defaultTime, NodeType::Directory, 0, std::nullopt);
+    DbNodeId dbNodeIdDir = 0;
+    bool constraintError = false;
+    CPPUNIT_ASSERT(_testObj->insertNode(nodeDir, dbNodeIdDir, constraintError));
+    const DbNode nodeFile(dbNodeIdDir, Str("File"), Str("File"), "l_file", "r_file", testhelpers::defaultTime,
+                          testhelpers::defaultTime, testhelpers::defaultTime, NodeType::File, 0, std::nullopt);
+    DbNodeId dbNodeIdFile = 0;
+    CPPUNIT_ASSERT(_testObj->insertNode(nodeFile, dbNodeIdFile, constraintError));
+    bool found = false;
+    CPPUNIT_ASSERT(_testObj->updateNodeStatus(dbNodeIdFile, SyncFileStatus::Success, found) && found);
+
+    CPPUNIT_ASSERT(_testObj->takeNodeChanges(initialRevision, changedDbNodeIds, revision));
+    CPPUNIT_ASSERT_EQUAL(_testObj->revision(), revision);
+    CPPUNIT_ASSERT(changedDbNodeIds == std::unordered_set<DbNodeId>({dbNodeIdDir, dbNodeIdFile}));
+
+    // The changes have been consumed
+    CPPUNIT_ASSERT(_testObj->takeNodeChanges(revision, changedDbNodeIds, revision));
+    CPPUNIT_ASSERT(changedDbNodeIds.empty());
+
+    // A change on all nodes cannot be applied incrementally
+    const SyncDbRevision revisionBeforeBulkUpdate = revision;
+    CPPUNIT_ASSERT(_testObj->updateNodesSyncing(false));
+    CPPUNIT_ASSERT(!_testObj->takeNodeChanges(revisionBeforeBulkUpdate, changedDbNodeIds, revision));
+    CPPUNIT_ASSERT(_testObj->takeNodeChanges(revision, changedDbNodeIds, revision));
+    CPPUNIT_ASSERT(changedDbNodeIds.empty());
+}
+
+namespace {
+
+void checkCacheEquivalence(SyncDb &db, SyncDbReadOnlyCache &cache) {
+    SyncDbReadOnlyCache expectedCache(db);
+    CPPUNIT_ASSERT(expectedCache.reloadIfNeeded());
+    CPPUNIT_ASSERT_EQUAL(expectedCache.revision(), cache.revision());
+
+    bool found = false;
+    std::unordered_set<NodeIds, NodeIds::HashFunction> expectedIds;
+    std::unordered_set<NodeIds, NodeIds::HashFunction> actualIds;
+    CPPUNIT_ASSERT(expectedCache.ids(expectedIds, found));
+    CPPUNIT_ASSERT(cache.ids(actualIds, found));
+    CPPUNIT_ASSERT(expectedIds == actualIds);
+
+    for (const auto &nodeIds: expectedIds) {
+        DbNode expectedNode;
+        DbNode actualNode;
+        CPPUNIT_ASSERT(expectedCache.node(nodeIds.dbNodeId, expectedNode, found) && found);
+        CPPUNIT_ASSERT(cache.node(nodeIds.dbNodeId, actualNode, found) && found);
+        CPPUNIT_ASSERT(expectedNode == actualNode);
+
+        SyncPath expectedLocalPath;
+        SyncPath expectedRemotePath;
+        SyncPath actualLocalPath;
+        SyncPath actualRemotePath;
+        CPPUNIT_ASSERT(expectedCache.path(nodeIds.dbNodeId, expectedLocalPath, expectedRemotePath, found) && found);
+        CPPUNIT_ASSERT(cache.path(nodeIds.dbNodeId, actualLocalPath, actualRemotePath, found) && found);
+        CPPUNIT_ASSERT_EQUAL(expectedLocalPath, actualLocalPath);
+        CPPUNIT_ASSERT_EQUAL(expectedRemotePath, actualRemotePath);
+
+        std::optional<NodeId> nodeIdFromPath;
+        CPPUNIT_ASSERT(cache.id(ReplicaSide::Remote, actualRemotePath, nodeIdFromPath, found) && found);
+        CPPUNIT_ASSERT_EQUAL(nodeIds.remoteNodeId, nodeIdFromPath.value());
+
+        NodeId expectedParentId;
+        NodeId actualParentId;
+        bool expectedFound = false;
+        CPPUNIT_ASSERT(expectedCache.parentId(ReplicaSide::Local, nodeIds.localNodeId, expectedParentId, expectedFound));
+        CPPUNIT_ASSERT(cache.parentId(ReplicaSide::Local, nodeIds.localNodeId, actualParentId, found));
+        CPPUNIT_ASSERT_EQUAL(expectedFound, found);
+        CPPUNIT_ASSERT_EQUAL(expectedParentId, actualParentId);
+    }
+}
+
+} // namespace
+
+void TestSyncDb::testCacheIncrementalReload() {
+    _testObj->enablePrepare(true);
+    _testObj->prepare();
+
+    std::mt19937 generator(42); // NOLINT(cert-msc51-cpp): the sequence must be reproducible
+    const auto randomIndex = [&generator](const size_t size) {
+        return std::uniform_int_distribution<size_t>(0, size - 1)(generator);
+    };
+    const auto existingDbNodeIds = [this]() {
+        std::unordered_set<DbNodeId> dbNodeIds;
+        bool found = false;
+        CPPUNIT_ASSERT(_testObj->dbIds(dbNodeIds, found));
+        std::vector<DbNodeId> sortedDbNodeIds(dbNodeIds.begin(), dbNodeIds.end());
+        std::sort(sortedDbNodeIds.begin(), sortedDbNodeIds.end());
+        return sortedDbNodeIds;
+    };
+    const auto isAncestor = [this](const DbNodeId ancestorDbNodeId, DbNodeId dbNodeId) {
+        for (;;) {
+            if (dbNodeId == ancestorDbNodeId) return true;
+            DbNode dbNode;
+            bool found = false;
+            CPPUNIT_ASSERT(_testObj->node(dbNodeId, dbNode, found) && found);
+            if (!dbNode.parentNodeId()) return false;
+            dbNodeId = dbNode.parentNodeId().value();
+        }
+    };
+
+    SyncDbReadOnlyCache &cache = _testObj->cache();
+    CPPUNIT_ASSERT(cache.reloadIfNeeded());
+
+    const DbNodeId rootDbNodeId = _testObj->rootNode().nodeId();
+    int nextIndex = 0;
+    for (int round = 0; round < 50; ++round) {
+        for (int opIndex = 0; opIndex < 20; ++opIndex) {
+            const auto dbNodeIds = existingDbNodeIds();
+            const DbNodeId dbNodeId = dbNodeIds[randomIndex(dbNodeIds.size())];
+            DbNode dbNode;
+            bool found = false;
+            CPPUNIT_ASSERT(_testObj->node(dbNodeId, dbNode, found) && found);
+
+            switch (randomIndex(6)) {
+                case 0:
+                case 1: {
+                    // Insert a node
+                    if (dbNode.type() != NodeType::Directory) break;
+                    const std::string suffix = std::to_string(nextIndex++);
+                    const NodeType type = randomIndex(3) == 0 ? NodeType::Directory : NodeType::File;
+                    const DbNode newNode(dbNodeId, Str2SyncName("l" + suffix), Str2SyncName("r" + suffix), "l" + suffix,
+                                         "r" + suffix, testhelpers::defaultTime, testhelpers::defaultTime,
+                                         testhelpers::defaultTime, type, 0, std::nullopt);
+                    CPPUNIT_ASSERT(_testObj->insertNode(newNode));
+                    break;
+                }
+                case 2: {
+                    // Rename a node
+                    if (dbNodeId == rootDbNodeId) break;
+                    const std::string suffix = std::to_string(nextIndex++);
+                    dbNode.setNameLocal(Str2SyncName("l" + suffix));
+                    dbNode.setNameRemote(Str2SyncName("r" + suffix));
+                    CPPUNIT_ASSERT(_testObj->updateNode(dbNode, found) && found);
+                    break;
+                }
+                case 3: {
+                    // Move a node
+                    const DbNodeId newParentDbNodeId = dbNodeIds[randomIndex(dbNodeIds.size())];
+                    DbNode newParentNode;
+                    CPPUNIT_ASSERT(_testObj->node(newParentDbNodeId, newParentNode, found) && found);
+                    if (dbNodeId == rootDbNodeId || newParentNode.type() != NodeType::Directory ||
+                        isAncestor(dbNodeId, newParentDbNodeId)) {
+                        break;
+                    }
+                    dbNode.setParentNodeId(newParentDbNodeId);
+                    CPPUNIT_ASSERT(_testObj->updateNode(dbNode, found) && found);
+                    break;
+                }
+                case 4: {
+                    // Update the status
+                    CPPUNIT_ASSERT(_testObj->updateNodeStatus(dbNodeId, SyncFileStatus::Success, found) && found);
+                    CPPUNIT_ASSERT(_testObj->updateNodeSyncing(dbNodeId, true, found) && found);
+                    break;
+                }
+                default: {
+                    // Delete a node and its descendants
+                    if (dbNodeId == rootDbNodeId) break;
+                    CPPUNIT_ASSERT(_testObj->deleteNode(dbNodeId, found) && found);
+                    break;
+                }
+            }
+
+            // Cache reads in between
+            if (randomIndex(5) == 0) {
+                CPPUNIT_ASSERT(cache.reloadIfNeeded());
+                DbNode cachedNode;
+                CPPUNIT_ASSERT(_testObj->node(dbNodeId, dbNode, found));
+                bool cachedFound = false;
+                CPPUNIT_ASSERT(cache.node(dbNodeId, cachedNode, cachedFound));
+                CPPUNIT_ASSERT_EQUAL(found, cachedFound);
+                if (found) CPPUNIT_ASSERT(dbNode == cachedNode);
+            }
+        }
+
+        // A change on all nodes from time to time to exercise the full reload
+        if (round % 10 == 9) {
+            CPPUNIT_ASSERT(_testObj->updateNodesSyncing(false));
+        }
+
+        CPPUNIT_ASSERT(cache.reloadIfNeeded());
+        CPPUNIT_ASSERT_EQUAL(_testObj->revision(), cache.revision());
+        checkCacheEquivalence(*_testObj, cache);
+
+        // As at the end of a sync, the cached nodes are kept for the next reload
+        cache.suspend();
+    }
+}
+
+namespace {
+
+// Simulates a crash: the DB files are copied as they are on disk, then the copy is opened, which triggers the SQLite recovery.
+size_t nodeCountAfterCrash(const SyncDb &db, const std::optional<SyncFileStatus> status = std::nullopt) {
+    const LocalTemporaryDirectory temporaryDirectory("testWriteBatching");
+    const SyncPath copyPath = temporaryDirectory.path() / db.dbPath().filename();
+    for (const std::string suffix: {"", "-wal", "-journal"}) {
+        SyncPath sourcePath = db.dbPath();
+        sourcePath += suffix;
+        if (!std::filesystem::exists(sourcePath)) continue;
+        SyncPath destinationPath = copyPath;
+        destinationPath += suffix;
+        CPPUNIT_ASSERT(std::filesystem::copy_file(sourcePath, destinationPath));
+    }
+
+    SyncDb copiedDb(copyPath.string());
+    CPPUNIT_ASSERT(copiedDb.init(KDRIVE_VERSION_STRING));
+    std::unordered_set<DbNodeId> dbNodeIds;
+    bool found = false;
+    CPPUNIT_ASSERT(copiedDb.dbIds(dbNodeIds, found));
+    const auto count = std::ranges::count_if(dbNodeIds, [&copiedDb, &status](const DbNodeId dbNodeId) {
+        auto nodeStatus = SyncFileStatus::Unknown;
+        bool nodeFound = false;
+        CPPUNIT_ASSERT(copiedDb.selectStatus(dbNodeId, nodeStatus, nodeFound) && nodeFound);
+        return !status || nodeStatus == *status;
+    });
+    copiedDb.close();
+    return static_cast<size_t>(count);
+}
+
+} // namespace
+
+void TestSyncDb::testWriteBatching() {
+    _testObj->enablePrepare(true);
+    _testObj->prepare();
+
+    int nextIndex = 0;
+    const auto insertNode = [this, &nextIndex]() {
+        const std::string suffix = std::to_string(nextIndex++);
+        const DbNode node(_testObj->rootNode().nodeId(), Str2SyncName("l" + suffix), Str2SyncName("r" + suffix), "l" + suffix,
+                          "r" + suffix, testhelpers::defaultTime, testhelpers::defaultTime, testhelpers::defaultTime,
+                          NodeType::File, 0, std::nullopt);
+        DbNodeId dbNodeId = 0;
+        bool constraintError = false;
+        CPPUNIT_ASSERT(_testObj->insertNode(node, dbNodeId, constraintError));
+        return dbNodeId;
+    };
+    std::vector<DbNodeId> dbNodeIds;
+    for (int i = 0; i < 40; ++i) {
+        dbNodeIds.push_back(insertNode());
+    }
+    size_t updatedCount = 0;
+    const auto updateStatuses = [this, &dbNodeIds, &updatedCount](const size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            bool found = false;
+            CPPUNIT_ASSERT(_testObj->updateNodeStatus(dbNodeIds[updatedCount++], SyncFileStatus::Success, found) && found);
+        }
+    };
+    const auto successCount = [this, &dbNodeIds]() {
+        return static_cast<size_t>(std::ranges::count_if(dbNodeIds, [this](const DbNodeId dbNodeId) {
+            auto status = SyncFileStatus::Unknown;
+            bool found = false;
+            CPPUNIT_ASSERT(_testObj->selectStatus(dbNodeId, status, found));
+            return found && status == SyncFileStatus::Success;
+        }));
+    };
+
+    const size_t initialNodeCount = nodeCountAfterCrash(*_testObj);
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+
+    // Batches of 10 updates
+    _testObj->enableWriteBatching(10, std::chrono::hours(1));
+    CPPUNIT_ASSERT(_testObj->writeBatchingEnabled());
+    updateStatuses(25);
+    CPPUNIT_ASSERT_EQUAL(size_t{25}, successCount()); // The pending writes are visible
+    // Only the full batches are committed
+    CPPUNIT_ASSERT_EQUAL(size_t{20}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+
+    // An upload session token is committed immediately, along with the pending writes
+    int64_t uploadSessionTokenDbId = 0;
+    CPPUNIT_ASSERT(_testObj->insertUploadSessionToken(UploadSessionToken("token"), uploadSessionTokenDbId));
+    CPPUNIT_ASSERT_EQUAL(size_t{25}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+
+    // Node insertions and deletions are committed immediately, along with the pending writes
+    updateStatuses(2);
+    (void) insertNode();
+    CPPUNIT_ASSERT_EQUAL(initialNodeCount + 1, nodeCountAfterCrash(*_testObj));
+    CPPUNIT_ASSERT_EQUAL(size_t{27}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+    updateStatuses(1);
+    bool found = false;
+    CPPUNIT_ASSERT(_testObj->deleteNode(dbNodeIds.back(), found) && found);
+    dbNodeIds.pop_back();
+    CPPUNIT_ASSERT_EQUAL(initialNodeCount, nodeCountAfterCrash(*_testObj));
+    CPPUNIT_ASSERT_EQUAL(size_t{28}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+
+    // The writes of another thread are committed immediately
+    std::thread otherThread([&updateStatuses]() { updateStatuses(1); });
+    otherThread.join();
+    CPPUNIT_ASSERT_EQUAL(size_t{29}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+
+    // The pending writes are committed once the latency limit is exceeded
+    updateStatuses(3);
+    CPPUNIT_ASSERT(_testObj->commitWriteBatchIfExpired());
+    CPPUNIT_ASSERT_EQUAL(size_t{29}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+    _testObj->enableWriteBatching(10, std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CPPUNIT_ASSERT(_testObj->commitWriteBatchIfExpired());
+    CPPUNIT_ASSERT_EQUAL(size_t{32}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+
+    // Disabling the batching commits the pending writes
+    _testObj->enableWriteBatching(10, std::chrono::hours(1));
+    updateStatuses(2);
+    CPPUNIT_ASSERT_EQUAL(size_t{32}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+    CPPUNIT_ASSERT(_testObj->disableWriteBatching());
+    CPPUNIT_ASSERT(!_testObj->writeBatchingEnabled());
+    CPPUNIT_ASSERT_EQUAL(size_t{34}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+
+    // Without batching, each write is committed immediately
+    updateStatuses(1);
+    CPPUNIT_ASSERT_EQUAL(size_t{35}, nodeCountAfterCrash(*_testObj, SyncFileStatus::Success));
+    CPPUNIT_ASSERT_EQUAL(size_t{35}, successCount());
+}
+
 } // namespace KDC
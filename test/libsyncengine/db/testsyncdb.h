@@ -51,6 +51,10 @@ class TestSyncDb : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST(testDummyUpgrade);
         CPPUNIT_TEST(testDbNode);
         CPPUNIT_TEST(testTryToFixDbNodeIdsAfterSyncDirChange);
+        CPPUNIT_TEST(testChecksumCache);
+        CPPUNIT_TEST(testTakeNodeChanges);
+        CPPUNIT_TEST(testCacheIncrementalReload);
+        CPPUNIT_TEST(testWriteBatching);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -81,6 +85,12 @@ class TestSyncDb : public CppUnit::TestFixture, public TestBase {
         void testDummyUpgrade();
         void testDbNode();
         void testTryToFixDbNodeIdsAfterSyncDirChange();
+        void testChecksumCache();
+        void testTakeNodeChanges();
+        // Random interleaving of DB writes and incremental cache reloads, checked against a fully reloaded cache.
+        void testCacheIncrementalReload();
+        // The DB files are copied while a write batch is pending to check what a crash would leave.
+        void testWriteBatching();
 
     private:
         SyncDbMock *_testObj;
@@ -0,0 +1,225 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testchunkbufferpool.h"
+
+#include "jobs/network/abstractnetworkjob.h"
+#include "jobs/network/httpsessionpool.h"
+#include "jobs/network/kDrive_API/upload/upload_session/chunkbufferpool.h"
+#include "network/proxy.h"
+#include "requests/parameterscache.h"
+#include "test_utility/localhttpserver.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <Poco/Net/HTTPRequest.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr size_t bufferSize = 1024 * 1024;
+
+class PooledBufferJob final : public AbstractNetworkJob {
+    public:
+        PooledBufferJob(const std::string &url, ChunkBufferPool::BufferPtr buffer) :
+            _url(url),
+            _buffer(std::move(buffer)) {
+            _httpMethod = Poco::Net::HTTPRequest::HTTP_POST;
+        }
+
+    protected:
+        ExitInfo handleResponse(std::istream &inputStream) override {
+            std::string body;
+            getStringFromStream(inputStream, body);
+            return ExitCode::Ok;
+        }
+        ExitInfo handleError(const std::string &, const Poco::URI &) override { return ExitCode::BackError; }
+        std::string getSpecificUrl() override { return {}; }
+        std::string getUrl() override { return _url; }
+        std::string contentType() override { return mimeTypeOctetStream; }
+        std::string_view requestBody() const override { return _buffer->content(); }
+
+    private:
+        std::string _url;
+        ChunkBufferPool::BufferPtr _buffer;
+};
+
+void fillBuffer(ChunkBufferPool::Buffer &buffer, const int seed) {
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer.data()[i] = static_cast<char>((i * 31 + static_cast<size_t>(seed)) % 251);
+    }
+}
+
+} // namespace
+
+void TestChunkBufferPool::setUp() {
+    TestBase::start();
+    (void) ParametersCache::instance(true);
+    (void) Proxy::instance(ProxyConfig());
+}
+
+void TestChunkBufferPool::tearDown() {
+    HttpSessionPool::instance()->clear();
+    ParametersCache::reset();
+    TestBase::stop();
+}
+
+void TestChunkBufferPool::testBufferReuse() {
+    const auto pool = std::make_shared<ChunkBufferPool>(4 * bufferSize);
+
+    const char *data = nullptr;
+    {
+        const auto buffer = pool->acquire(bufferSize);
+        CPPUNIT_ASSERT(buffer);
+        CPPUNIT_ASSERT_EQUAL(bufferSize, buffer->size());
+        data = buffer->data();
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t{1}, pool->idleBuffersCount());
+    CPPUNIT_ASSERT_EQUAL(bufferSize, pool->totalSize());
+
+    // A smaller chunk reuses the idle buffer
+    const auto buffer = pool->acquire(bufferSize / 2);
+    CPPUNIT_ASSERT(buffer->data() == data);
+    CPPUNIT_ASSERT_EQUAL(bufferSize / 2, buffer->size());
+    CPPUNIT_ASSERT_EQUAL(bufferSize, buffer->capacity());
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, pool->idleBuffersCount());
+    CPPUNIT_ASSERT_EQUAL(bufferSize, pool->totalSize());
+
+    // A bigger chunk needs a new buffer
+    const auto biggerBuffer = pool->acquire(2 * bufferSize);
+    CPPUNIT_ASSERT_EQUAL(3 * bufferSize, pool->totalSize());
+
+    pool->clear(); // Buffers in use are not freed
+    CPPUNIT_ASSERT_EQUAL(3 * bufferSize, pool->totalSize());
+}
+
+void TestChunkBufferPool::testMaxTotalSize() {
+    const auto pool = std::make_shared<ChunkBufferPool>(3 * bufferSize);
+
+    std::vector<ChunkBufferPool::BufferPtr> buffers;
+    for (int i = 0; i < 3; ++i) {
+        buffers.push_back(pool->acquire(bufferSize));
+    }
+
+    // The cap is reached, the next acquisition waits for a buffer to be given back
+    std::atomic_bool acquired = false;
+    std::thread thread([&pool, &acquired] {
+        const auto buffer = pool->acquire(bufferSize);
+        acquired = buffer != nullptr;
+    });
+    Utility::msleep(300);
+    CPPUNIT_ASSERT(!acquired);
+
+    buffers.pop_back();
+    thread.join();
+    CPPUNIT_ASSERT(acquired);
+    CPPUNIT_ASSERT_EQUAL(3 * bufferSize, pool->peakTotalSize());
+
+    // Idle buffers that are too small are freed to make room for a bigger one
+    buffers.clear();
+    const auto bigBuffer = pool->acquire(3 * bufferSize);
+    CPPUNIT_ASSERT_EQUAL(3 * bufferSize, pool->totalSize());
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, pool->idleBuffersCount());
+}
+
+void TestChunkBufferPool::testAbortWait() {
+    const auto pool = std::make_shared<ChunkBufferPool>(bufferSize);
+    const auto buffer = pool->acquire(bufferSize);
+
+    std::atomic_bool abort = false;
+    std::atomic_bool waitEnded = false;
+    ChunkBufferPool::BufferPtr otherBuffer;
+    std::thread thread([&] {
+        otherBuffer = pool->acquire(bufferSize, [&abort] { return abort.load(); });
+        waitEnded = true;
+    });
+    Utility::msleep(300);
+    CPPUNIT_ASSERT(!waitEnded);
+
+    abort = true;
+    thread.join();
+    CPPUNIT_ASSERT(!otherBuffer);
+    CPPUNIT_ASSERT_EQUAL(bufferSize, pool->totalSize());
+}
+
+void TestChunkBufferPool::testBufferBiggerThanMaxTotalSize() {
+    const auto pool = std::make_shared<ChunkBufferPool>(bufferSize);
+
+    // Lent only when no other buffer is allocated, otherwise an upload of a big chunk would wait forever
+    {
+        const auto buffer = pool->acquire(bufferSize / 2);
+        CPPUNIT_ASSERT(!pool->acquire(2 * bufferSize, [] { return true; }));
+    }
+    const auto buffer = pool->acquire(2 * bufferSize, [] { return true; });
+    CPPUNIT_ASSERT(buffer);
+    CPPUNIT_ASSERT_EQUAL(2 * bufferSize, pool->totalSize());
+}
+
+void TestChunkBufferPool::testSendPooledBuffers() {
+    std::mutex receivedBodiesMutex;
+    std::map<std::string, std::string, std::less<>> receivedBodies;
+    const LocalHttpServer server([&](Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+        std::string body{std::istreambuf_iterator<char>(request.stream()), std::istreambuf_iterator<char>()};
+        {
+            const std::scoped_lock lock(receivedBodiesMutex);
+            receivedBodies[request.getURI()] = std::move(body);
+        }
+        response.setContentLength(0);
+        response.send();
+    });
+
+    constexpr int nbUploads = 10;
+    constexpr int nbChunksPerUpload = 8;
+    const auto pool = std::make_shared<ChunkBufferPool>(4 * bufferSize);
+    std::atomic_int nbErrors = 0;
+    std::vector<std::thread> threads;
+    for (int upload = 0; upload < nbUploads; ++upload) {
+        threads.emplace_back([&, upload] {
+            for (int chunk = 0; chunk < nbChunksPerUpload; ++chunk) {
+                auto buffer = pool->acquire(bufferSize - static_cast<size_t>(chunk));
+                fillBuffer(*buffer, upload * nbChunksPerUpload + chunk);
+                PooledBufferJob job(server.url("/" + std::to_string(upload) + "/" + std::to_string(chunk)), std::move(buffer));
+                if (!job.runSynchronously()) nbErrors++;
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, nbErrors.load());
+    CPPUNIT_ASSERT(pool->peakTotalSize() <= pool->maxTotalSize());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(nbUploads * nbChunksPerUpload), receivedBodies.size());
+    for (int upload = 0; upload < nbUploads; ++upload) {
+        for (int chunk = 0; chunk < nbChunksPerUpload; ++chunk) {
+            ChunkBufferPool::Buffer expected(bufferSize - static_cast<size_t>(chunk));
+            fillBuffer(expected, upload * nbChunksPerUpload + chunk);
+            const auto &received = receivedBodies["/" + std::to_string(upload) + "/" + std::to_string(chunk)];
+            CPPUNIT_ASSERT(received == expected.content());
+        }
+    }
+}
+
+} // namespace KDC
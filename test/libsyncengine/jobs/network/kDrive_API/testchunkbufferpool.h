@@ -0,0 +1,47 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+
+namespace KDC {
+
+class TestChunkBufferPool : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestChunkBufferPool);
+        CPPUNIT_TEST(testBufferReuse);
+        CPPUNIT_TEST(testMaxTotalSize);
+        CPPUNIT_TEST(testAbortWait);
+        CPPUNIT_TEST(testBufferBiggerThanMaxTotalSize);
+        CPPUNIT_TEST(testSendPooledBuffers);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    protected:
+        void testBufferReuse();
+        void testMaxTotalSize();
+        void testAbortWait();
+        void testBufferBiggerThanMaxTotalSize();
+        // Concurrent jobs send their body from pooled buffers to a local server, which must receive the exact bytes.
+        void testSendPooledBuffers();
+};
+
+} // namespace KDC
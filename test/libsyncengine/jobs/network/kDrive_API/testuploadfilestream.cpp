@@ -0,0 +1,265 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testuploadfilestream.h"
+
+#include "jobs/network/abstractnetworkjob.h"
+#include "jobs/network/httpsessionpool.h"
+#include "jobs/network/kDrive_API/upload/uploadfilestream.h"
+#include "network/proxy.h"
+#include "requests/parameterscache.h"
+#include "test_utility/localhttpserver.h"
+#include "test_utility/localtemporarydirectory.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <Poco/Net/HTTPRequest.h>
+
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr size_t sliceSize = 64 * 1024;
+
+std::string makeContent(const size_t size, const int seed) {
+    std::string content(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        content[i] = static_cast<char>((i * 7 + static_cast<size_t>(seed)) % 253);
+    }
+    return content;
+}
+
+void writeFile(const SyncPath &path, const std::string &content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+    CPPUNIT_ASSERT(file.good());
+}
+
+std::string readAllSlices(UploadFileStream &stream, ExitInfo &exitInfo) {
+    std::string content;
+    std::string_view slice;
+    while ((exitInfo = stream.readSlice(content.size(), sliceSize, slice)) && !slice.empty()) {
+        content.append(slice);
+    }
+    return content;
+}
+
+class StreamingJob final : public AbstractNetworkJob {
+    public:
+        using SliceCallback = std::function<void(uint64_t offset)>;
+
+        StreamingJob(const std::string &url, const SyncPath &path, const SliceCallback &sliceCallback = {}) :
+            _url(url),
+            _fileStream(path),
+            _sliceCallback(sliceCallback) {
+            _httpMethod = Poco::Net::HTTPRequest::HTTP_POST;
+        }
+
+    protected:
+        ExitInfo handleResponse(std::istream &inputStream) override {
+            std::string body;
+            getStringFromStream(inputStream, body);
+            return ExitCode::Ok;
+        }
+        ExitInfo handleError(const std::string &, const Poco::URI &) override { return ExitCode::BackError; }
+        std::string getSpecificUrl() override { return {}; }
+        std::string getUrl() override { return _url; }
+        std::string contentType() override { return mimeTypeOctetStream; }
+        uint64_t requestBodySize() const override { return _fileStream.size(); }
+        ExitInfo readRequestBodySlice(const uint64_t offset, const size_t maxLength, std::string_view &slice) override {
+            if (_sliceCallback) _sliceCallback(offset);
+            return _fileStream.readSlice(offset, maxLength, slice);
+        }
+
+    private:
+        ExitInfo setData() override { return _fileStream.open(); }
+
+        std::string _url;
+        UploadFileStream _fileStream;
+        SliceCallback _sliceCallback;
+};
+
+// Records the bodies that have been completely received, by URI
+class RecordingServer {
+    public:
+        RecordingServer() :
+            _server([this](Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+                std::string body;
+                try {
+                    body.assign(std::istreambuf_iterator<char>(request.stream()), std::istreambuf_iterator<char>());
+                } catch (...) {
+                    return; // Connection closed by the client
+                }
+                if (static_cast<std::streamsize>(body.size()) != request.getContentLength()) return;
+
+                {
+                    const std::scoped_lock lock(_mutex);
+                    _bodies[request.getURI()].push_back(std::move(body));
+                }
+                response.setContentLength(0);
+                response.send();
+            }) {}
+
+        [[nodiscard]] std::string url(const std::string &path) const { return _server.url(path); }
+        [[nodiscard]] std::vector<std::string> bodies(const std::string &path) {
+            const std::scoped_lock lock(_mutex);
+            return _bodies[path];
+        }
+
+    private:
+        std::mutex _mutex;
+        std::map<std::string, std::vector<std::string>, std::less<>> _bodies;
+        LocalHttpServer _server; // Last, so that it is stopped first
+};
+
+} // namespace
+
+void TestUploadFileStream::setUp() {
+    TestBase::start();
+    (void) ParametersCache::instance(true);
+    (void) Proxy::instance(ProxyConfig());
+}
+
+void TestUploadFileStream::tearDown() {
+    HttpSessionPool::instance()->clear();
+    ParametersCache::reset();
+    TestBase::stop();
+}
+
+void TestUploadFileStream::testReadSlices() {
+    const LocalTemporaryDirectory temporaryDirectory("testReadSlices");
+    const SyncPath path = temporaryDirectory.path() / "file.bin";
+    const std::string content = makeContent(3 * sliceSize + 123, 1);
+    writeFile(path, content);
+
+    UploadFileStream stream(path);
+    CPPUNIT_ASSERT(stream.open());
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(content.size()), stream.size());
+    CPPUNIT_ASSERT_EQUAL(Utility::computeXxHash(content), stream.contentHash());
+
+    ExitInfo exitInfo;
+    CPPUNIT_ASSERT(readAllSlices(stream, exitInfo) == content);
+    CPPUNIT_ASSERT(exitInfo);
+
+    // A retry of the request starts over
+    CPPUNIT_ASSERT(readAllSlices(stream, exitInfo) == content);
+    CPPUNIT_ASSERT(exitInfo);
+
+    // The slices must be read in order
+    std::string_view slice;
+    CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::LogicError), stream.readSlice(sliceSize, sliceSize, slice));
+
+    // Empty file
+    const SyncPath emptyPath = temporaryDirectory.path() / "empty.bin";
+    writeFile(emptyPath, {});
+    UploadFileStream emptyStream(emptyPath);
+    CPPUNIT_ASSERT(emptyStream.open());
+    CPPUNIT_ASSERT_EQUAL(uint64_t{0}, emptyStream.size());
+    CPPUNIT_ASSERT_EQUAL(Utility::computeXxHash(std::string()), emptyStream.contentHash());
+}
+
+void TestUploadFileStream::testFileChanged() {
+    const LocalTemporaryDirectory temporaryDirectory("testFileChanged");
+    const SyncPath path = temporaryDirectory.path() / "file.bin";
+    const std::string content = makeContent(3 * sliceSize, 1);
+    const ExitInfo fileChangedExitInfo(ExitCode::SystemError, ExitCause::FileAccessError);
+
+    const auto readAfterChange = [&](const std::string &newContent) {
+        writeFile(path, content);
+        UploadFileStream stream(path);
+        CPPUNIT_ASSERT(stream.open());
+        writeFile(path, newContent);
+        ExitInfo exitInfo;
+        const std::string readContent = readAllSlices(stream, exitInfo);
+        CPPUNIT_ASSERT(readContent.size() < content.size()); // The last slice is never returned
+        return exitInfo;
+    };
+
+    // Same size, modified content
+    CPPUNIT_ASSERT_EQUAL(fileChangedExitInfo, readAfterChange(makeContent(content.size(), 2)));
+    // Shrunk
+    CPPUNIT_ASSERT_EQUAL(fileChangedExitInfo, readAfterChange(content.substr(0, content.size() - 1)));
+    // Grown
+    CPPUNIT_ASSERT_EQUAL(fileChangedExitInfo, readAfterChange(content + "x"));
+}
+
+void TestUploadFileStream::testConcurrentUploads() {
+    const LocalTemporaryDirectory temporaryDirectory("testConcurrentUploads");
+    RecordingServer server;
+
+    constexpr int nbUploads = 20;
+    std::vector<std::string> contents;
+    for (int i = 0; i < nbUploads; ++i) {
+        contents.push_back(makeContent(2 * 1024 * 1024 + static_cast<size_t>(i), i));
+        writeFile(temporaryDirectory.path() / std::to_string(i), contents.back());
+    }
+
+    std::atomic_int nbErrors = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nbUploads; ++i) {
+        threads.emplace_back([&, i] {
+            StreamingJob job(server.url("/" + std::to_string(i)), temporaryDirectory.path() / std::to_string(i));
+            if (!job.runSynchronously()) nbErrors++;
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, nbErrors.load());
+    for (int i = 0; i < nbUploads; ++i) {
+        const auto bodies = server.bodies("/" + std::to_string(i));
+        CPPUNIT_ASSERT_EQUAL(size_t{1}, bodies.size());
+        CPPUNIT_ASSERT(bodies.front() == contents[static_cast<size_t>(i)]);
+    }
+}
+
+void TestUploadFileStream::testFileChangedDuringUpload() {
+    const LocalTemporaryDirectory temporaryDirectory("testFileChangedDuringUpload");
+    const SyncPath path = temporaryDirectory.path() / "file.bin";
+    const std::string content = makeContent(10 * sliceSize, 1);
+    const std::string newContent = makeContent(10 * sliceSize, 2);
+    writeFile(path, content);
+    RecordingServer server;
+
+    // The file is modified once, in the middle of the first try. The next try uploads the new content.
+    std::atomic_bool modified = false;
+    StreamingJob job(server.url("/file"), path, [&](const uint64_t offset) {
+        if (offset == 5 * sliceSize && !modified) {
+            writeFile(path, newContent);
+            modified = true;
+        }
+    });
+    CPPUNIT_ASSERT(job.runSynchronously());
+    CPPUNIT_ASSERT(modified);
+
+    // The first try has been interrupted before its last slice, only the second one has been received
+    const auto bodies = server.bodies("/file");
+    CPPUNIT_ASSERT_EQUAL(size_t{1}, bodies.size());
+    CPPUNIT_ASSERT(bodies.front() == newContent);
+}
+
+} // namespace KDC
@@ -0,0 +1,46 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+
+namespace KDC {
+
+class TestUploadFileStream : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestUploadFileStream);
+        CPPUNIT_TEST(testReadSlices);
+        CPPUNIT_TEST(testFileChanged);
+        CPPUNIT_TEST(testConcurrentUploads);
+        CPPUNIT_TEST(testFileChangedDuringUpload);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    protected:
+        void testReadSlices();
+        void testFileChanged();
+        // Files streamed to a local server by concurrent jobs must be received intact.
+        void testConcurrentUploads();
+        // The server must never receive a complete body mixing the old and the new content.
+        void testFileChangedDuringUpload();
+};
+
+} // namespace KDC
@@ -0,0 +1,315 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testhttpsessionpool.h"
+
+#include "jobs/network/abstractnetworkjob.h"
+#include "jobs/network/httpsessionpool.h"
+#include "network/proxy.h"
+#include "requests/parameterscache.h"
+#include "test_utility/localhttpserver.h"
+#include "libcommonserver/utility/utility.h"
+
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+class LocalServerJob final : public AbstractNetworkJob {
+    public:
+        explicit LocalServerJob(const std::string &url, const bool readBody = true) :
+            _url(url),
+            _readBody(readBody) {
+            _httpMethod = Poco::Net::HTTPRequest::HTTP_GET;
+        }
+
+        const std::string &body() const { return _body; }
+
+    protected:
+        ExitInfo handleResponse(std::istream &inputStream) override {
+            if (!_readBody) return ExitCode::Ok;
+            _body.assign(std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>());
+            return ExitCode::Ok;
+        }
+        ExitInfo handleError(const std::string &, const Poco::URI &) override { return ExitCode::BackError; }
+        std::string getSpecificUrl() override { return {}; }
+        std::string getUrl() override { return _url; }
+
+    private:
+        std::string _url;
+        bool _readBody{true};
+        std::string _body;
+};
+
+const std::string replyBody = "{\"result\":\"success\"}";
+
+void replyOk(Poco::Net::HTTPServerRequest &, Poco::Net::HTTPServerResponse &response) {
+    response.setContentType("application/json");
+    response.setContentLength(static_cast<std::streamsize>(replyBody.size()));
+    response.send() << replyBody;
+}
+
+} // namespace
+
+void TestHttpSessionPool::setUp() {
+    TestBase::start();
+    (void) ParametersCache::instance(true);
+    (void) Proxy::instance(ProxyConfig());
+    HttpSessionPool::instance()->clear();
+}
+
+void TestHttpSessionPool::tearDown() {
+    HttpSessionPool::instance()->clear();
+    ParametersCache::reset();
+    TestBase::stop();
+}
+
+void TestHttpSessionPool::testSequentialJobsReuseConnection() {
+    const LocalHttpServer server(replyOk);
+
+    constexpr int nbJobs = 300;
+    for (int i = 0; i < nbJobs; i++) {
+        LocalServerJob job(server.url("/job/" + std::to_string(i)));
+        CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::Ok), job.runSynchronously());
+        CPPUNIT_ASSERT_EQUAL(replyBody, job.body());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(1, server.totalConnections());
+    CPPUNIT_ASSERT_EQUAL(size_t{1}, HttpSessionPool::instance()->idleSessionsCount());
+}
+
+void TestHttpSessionPool::testConcurrentJobsReuseConnections() {
+    const LocalHttpServer server(replyOk, 32);
+
+    constexpr int nbThreads = 8;
+    constexpr int nbJobsPerThread = 50;
+    std::atomic_int nbErrors = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nbThreads; t++) {
+        threads.emplace_back([&server, &nbErrors] {
+            for (int i = 0; i < nbJobsPerThread; i++) {
+                LocalServerJob job(server.url());
+                if (!job.runSynchronously() || job.body() != replyBody) nbErrors++;
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, nbErrors.load());
+    // At most one connection per concurrent job
+    CPPUNIT_ASSERT(server.totalConnections() <= nbThreads);
+    CPPUNIT_ASSERT(HttpSessionPool::instance()->idleSessionsCount() <= static_cast<size_t>(nbThreads));
+}
+
+void TestHttpSessionPool::testConnectionClosedByServer() {
+    const LocalHttpServer server([](Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+        if (request.getURI() == "/close") response.setKeepAlive(false);
+        replyOk(request, response);
+    });
+
+    LocalServerJob job1(server.url("/close"));
+    CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::Ok), job1.runSynchronously());
+    Utility::msleep(100); // Let the server close the connection
+
+    // The closed session must be evicted and a new connection opened
+    LocalServerJob job2(server.url());
+    CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::Ok), job2.runSynchronously());
+    CPPUNIT_ASSERT_EQUAL(replyBody, job2.body());
+    CPPUNIT_ASSERT_EQUAL(2, server.totalConnections());
+
+    LocalServerJob job3(server.url());
+    CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::Ok), job3.runSynchronously());
+    CPPUNIT_ASSERT_EQUAL(2, server.totalConnections());
+}
+
+void TestHttpSessionPool::testUnreadResponseNotReused() {
+    const std::string bigBody(1024 * 1024, 'a');
+    const LocalHttpServer server([&bigBody](Poco::Net::HTTPServerRequest &, Poco::Net::HTTPServerResponse &response) {
+        response.setContentLength(static_cast<std::streamsize>(bigBody.size()));
+        response.send() << bigBody;
+    });
+
+    const auto pool = HttpSessionPool::instance();
+
+    // The body has not been read, the session cannot be reused
+    LocalServerJob job1(server.url(), false);
+    CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::Ok), job1.runSynchronously());
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, pool->idleSessionsCount());
+
+    // Jobs whose response is fully read give their session back
+    LocalServerJob job2(server.url());
+    CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::Ok), job2.runSynchronously());
+    CPPUNIT_ASSERT_EQUAL(bigBody.size(), job2.body().size());
+    CPPUNIT_ASSERT_EQUAL(size_t{1}, pool->idleSessionsCount());
+    CPPUNIT_ASSERT_EQUAL(2, server.totalConnections());
+}
+
+void TestHttpSessionPool::testSessionsCap() {
+    const LocalHttpServer server(replyOk, 64);
+
+    const auto pool = HttpSessionPool::instance();
+    const auto sendRequest = [](Poco::Net::HTTPClientSession &session) {
+        Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_GET, "/", Poco::Net::HTTPMessage::HTTP_1_1);
+        (void) session.sendRequest(request);
+        Poco::Net::HTTPResponse response;
+        std::istream &stream = session.receiveResponse(response);
+        return std::string{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    };
+
+    std::vector<std::unique_ptr<Poco::Net::HTTPClientSession>> sessions;
+    for (size_t i = 0; i < HttpSessionPool::maxSessionsPerHost; i++) {
+        ExitInfo exitInfo;
+        auto session = pool->acquire(Poco::URI(server.url()), ProxyConfig(), nullptr, exitInfo);
+        CPPUNIT_ASSERT(session);
+        CPPUNIT_ASSERT_EQUAL(replyBody, sendRequest(*session));
+        sessions.push_back(std::move(session));
+    }
+    CPPUNIT_ASSERT_EQUAL(HttpSessionPool::maxSessionsPerHost, pool->lentSessionsCount());
+
+    // The host has reached the cap: the next acquisition waits for a session to be given back
+    std::atomic_bool acquired = false;
+    std::unique_ptr<Poco::Net::HTTPClientSession> waitingSession;
+    std::thread waitingThread([&] {
+        ExitInfo exitInfo;
+        waitingSession = pool->acquire(Poco::URI(server.url()), ProxyConfig(), nullptr, exitInfo);
+        acquired = true;
+    });
+    Utility::msleep(200);
+    CPPUNIT_ASSERT(!acquired);
+
+    const Poco::Net::HTTPClientSession *releasedSession = sessions.back().get();
+    pool->release(std::move(sessions.back()), true);
+    sessions.pop_back();
+    waitingThread.join();
+    CPPUNIT_ASSERT(acquired);
+    CPPUNIT_ASSERT_EQUAL(releasedSession, static_cast<const Poco::Net::HTTPClientSession *>(waitingSession.get()));
+    sessions.push_back(std::move(waitingSession));
+
+    for (auto &session: sessions) {
+        pool->release(std::move(session), true);
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, pool->lentSessionsCount());
+    CPPUNIT_ASSERT_EQUAL(HttpSessionPool::maxSessionsPerHost, pool->idleSessionsCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(HttpSessionPool::maxSessionsPerHost), server.totalConnections());
+}
+
+void TestHttpSessionPool::testAbortedWait() {
+    const LocalHttpServer server(replyOk, 32);
+
+    const auto pool = HttpSessionPool::instance();
+    std::vector<std::unique_ptr<Poco::Net::HTTPClientSession>> sessions;
+    ExitInfo exitInfo;
+    for (size_t i = 0; i < HttpSessionPool::maxSessionsPerHost; i++) {
+        sessions.push_back(pool->acquire(Poco::URI(server.url()), ProxyConfig(), nullptr, exitInfo));
+        CPPUNIT_ASSERT(sessions.back());
+    }
+
+    // A job waiting for a session gives up as soon as it is aborted
+    std::atomic_bool aborted = false;
+    std::unique_ptr<Poco::Net::HTTPClientSession> waitingSession;
+    ExitInfo waitingExitInfo;
+    std::thread waitingThread([&] {
+        waitingSession = pool->acquire(Poco::URI(server.url()), ProxyConfig(), nullptr, waitingExitInfo,
+                                       [&aborted]() { return aborted.load(); });
+    });
+    Utility::msleep(200);
+    aborted = true;
+    waitingThread.join();
+    CPPUNIT_ASSERT(!waitingSession);
+    CPPUNIT_ASSERT_EQUAL(ExitCode::OperationCanceled, waitingExitInfo.code());
+
+    for (auto &session: sessions) {
+        pool->release(std::move(session), true);
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, pool->lentSessionsCount());
+}
+
+void TestHttpSessionPool::testClearKeepsLentSessions() {
+    const LocalHttpServer server(replyOk, 32);
+
+    const auto pool = HttpSessionPool::instance();
+    const auto sendRequest = [](Poco::Net::HTTPClientSession &session) {
+        Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_GET, "/", Poco::Net::HTTPMessage::HTTP_1_1);
+        (void) session.sendRequest(request);
+        Poco::Net::HTTPResponse response;
+        std::istream &stream = session.receiveResponse(response);
+        return std::string{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    };
+
+    std::vector<std::unique_ptr<Poco::Net::HTTPClientSession>> sessions;
+    ExitInfo exitInfo;
+    for (size_t i = 0; i < HttpSessionPool::maxSessionsPerHost; i++) {
+        auto session = pool->acquire(Poco::URI(server.url()), ProxyConfig(), nullptr, exitInfo);
+        CPPUNIT_ASSERT(session);
+        CPPUNIT_ASSERT_EQUAL(replyBody, sendRequest(*session));
+        sessions.push_back(std::move(session));
+    }
+
+    // The sessions lent before the pool is cleared still count towards the cap
+    pool->clear();
+    CPPUNIT_ASSERT_EQUAL(HttpSessionPool::maxSessionsPerHost, pool->lentSessionsCount());
+    std::atomic_bool acquired = false;
+    std::unique_ptr<Poco::Net::HTTPClientSession> waitingSession;
+    std::thread waitingThread([&] {
+        ExitInfo waitingExitInfo;
+        waitingSession = pool->acquire(Poco::URI(server.url()), ProxyConfig(), nullptr, waitingExitInfo);
+        acquired = true;
+    });
+    Utility::msleep(200);
+    CPPUNIT_ASSERT(!acquired);
+
+    // They are closed when given back, and their slot is used by a new session
+    pool->release(std::move(sessions.back()), true);
+    sessions.pop_back();
+    waitingThread.join();
+    CPPUNIT_ASSERT(waitingSession);
+    CPPUNIT_ASSERT_EQUAL(replyBody, sendRequest(*waitingSession));
+    pool->release(std::move(waitingSession), true);
+
+    for (auto &session: sessions) {
+        pool->release(std::move(session), true);
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, pool->lentSessionsCount());
+    CPPUNIT_ASSERT_EQUAL(size_t{1}, pool->idleSessionsCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(HttpSessionPool::maxSessionsPerHost) + 1, server.totalConnections());
+}
+
+void TestHttpSessionPool::testPlainHttpRefused() {
+    // No local test server is running: plain HTTP is refused so that the access token is never sent in clear text
+    const auto pool = HttpSessionPool::instance();
+    ExitInfo exitInfo;
+    CPPUNIT_ASSERT(!pool->acquire(Poco::URI("http://127.0.0.1:8080/"), ProxyConfig(), nullptr, exitInfo));
+    CPPUNIT_ASSERT_EQUAL(ExitCode::DataError, exitInfo.code());
+    CPPUNIT_ASSERT(!pool->acquire(Poco::URI("ftp://127.0.0.1:8080/"), ProxyConfig(), nullptr, exitInfo));
+    CPPUNIT_ASSERT_EQUAL(ExitCode::DataError, exitInfo.code());
+    CPPUNIT_ASSERT_EQUAL(size_t{0}, pool->lentSessionsCount());
+
+    LocalServerJob job("http://127.0.0.1:8080/");
+    CPPUNIT_ASSERT_EQUAL(ExitCode::DataError, job.runSynchronously().code());
+}
+
+} // namespace KDC
@@ -0,0 +1,52 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+
+namespace KDC {
+
+class TestHttpSessionPool : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestHttpSessionPool);
+        CPPUNIT_TEST(testSequentialJobsReuseConnection);
+        CPPUNIT_TEST(testConcurrentJobsReuseConnections);
+        CPPUNIT_TEST(testConnectionClosedByServer);
+        CPPUNIT_TEST(testUnreadResponseNotReused);
+        CPPUNIT_TEST(testSessionsCap);
+        CPPUNIT_TEST(testAbortedWait);
+        CPPUNIT_TEST(testClearKeepsLentSessions);
+        CPPUNIT_TEST(testPlainHttpRefused);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    protected:
+        void testSequentialJobsReuseConnection();
+        void testConcurrentJobsReuseConnections();
+        void testConnectionClosedByServer();
+        void testUnreadResponseNotReused();
+        void testSessionsCap();
+        void testAbortedWait();
+        void testClearKeepsLentSessions();
+        void testPlainHttpRefused();
+};
+
+} // namespace KDC
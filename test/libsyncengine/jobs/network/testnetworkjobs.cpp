@@ -49,6 +49,7 @@
 
 #include "libcommonserver/keychainmanager/keychainmanager.h"
 #include "libcommonserver/utility/utility.h"
+#include "libcommon/utility/urlhelper.h"
 #include "libcommonserver/io/filestat.h"
 #include "libcommonserver/io/iohelper.h"
 #include "libcommonserver/utility/jsonparserutility.h"
@@ -58,12 +59,18 @@
 #include "mocks/libsyncengine/vfs/mockvfs.h"
 #include "mocks/libcommonserver/db/mockdb.h"
 
+#include "test_utility/localhttpserver.h"
 #include "test_utility/localtemporarydirectory.h"
 #include "test_utility/remotetemporarydirectory.h"
 #include "test_utility/testhelpers.h"
 #include "test_utility/iohelpertestutilities.h"
 #include "update_detection/file_system_observer/snapshot/snapshotitem.h"
 
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+
+#include <atomic>
+#include <limits>
 #include <sstream>
 
 using namespace CppUnit;
@@ -183,6 +190,8 @@ void TestNetworkJobs::tearDown() {
     }
     if (!_dummyLocalFilePath.empty()) (void) IoHelper::deleteItem(_dummyLocalFilePath);
 
+    UrlHelper::setCustomApiUrl("");
+
     ParmsDb::instance()->close();
     ParmsDb::reset();
     ParametersCache::reset();
@@ -855,6 +864,79 @@ void TestNetworkJobs::testDownloadAborted() {
     CPPUNIT_ASSERT(!std::filesystem::exists(localDestFilePath));
 }
 
+void TestNetworkJobs::testDownloadInterrupted() {
+    // Several buffers, so that the network reads and the disk writes overlap
+    std::string content(10 * 1024 * 1024, '\0');
+    for (size_t index = 0; index < content.size(); ++index) {
+        content[index] = static_cast<char>('a' + index % 26);
+    }
+
+    // The connection is closed in the middle of the body
+    std::atomic_int requestCount = 0;
+    std::atomic_int truncatedRequestCount = std::numeric_limits<int>::max();
+    const LocalHttpServer server([&](Poco::Net::HTTPServerRequest &, Poco::Net::HTTPServerResponse &response) {
+        const bool truncated = requestCount++ < truncatedRequestCount;
+        response.setContentType("application/octet-stream");
+        response.setContentLength64(static_cast<Poco::Int64>(content.size()));
+        response.setKeepAlive(false);
+        std::ostream &stream = response.send();
+        (void) stream.write(content.data(), static_cast<std::streamsize>(truncated ? content.size() / 2 : content.size()));
+        (void) stream.flush();
+    });
+    UrlHelper::setCustomApiUrl(server.url());
+
+    const LocalTemporaryDirectory temporaryDirectory("testDownloadInterrupted");
+    const SyncPath localDestFilePath = temporaryDirectory.path() / "test_download";
+    {
+        std::ofstream ofs(localDestFilePath, std::ios::binary);
+        ofs << "previous content";
+    }
+    NodeId nodeId;
+    CPPUNIT_ASSERT(IoHelper::getNodeId(localDestFilePath, nodeId));
+
+    const auto checkNoTmpFile = [this]() {
+        SyncPath cacheDirectoryPath;
+        CPPUNIT_ASSERT(_cacheDirectory->path(cacheDirectoryPath));
+        CPPUNIT_ASSERT(std::filesystem::is_empty(cacheDirectoryPath));
+    };
+    const auto readLocalFile = [&localDestFilePath]() {
+        std::ifstream ifs(localDestFilePath, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    };
+
+    // Every trial is interrupted: the local file is left untouched
+    {
+        DownloadJob job(nullptr, _cacheDirectory,
+                        DownloadJob::FileDownloadInfo{_driveDbId, "1", localDestFilePath, static_cast<int64_t>(content.size()),
+                                                      0, 0, false},
+                        DownloadJob::DateTimePolicy::IgnoreDateTime);
+        CPPUNIT_ASSERT(!job.runSynchronously());
+        CPPUNIT_ASSERT(requestCount > 1);
+    }
+    CPPUNIT_ASSERT_EQUAL(std::string("previous content"), readLocalFile());
+    checkNoTmpFile();
+
+    // The first trial is interrupted, the next one succeeds
+    requestCount = 0;
+    truncatedRequestCount = 1;
+    {
+        DownloadJob job(nullptr, _cacheDirectory,
+                        DownloadJob::FileDownloadInfo{_driveDbId, "1", localDestFilePath, static_cast<int64_t>(content.size()),
+                                                      0, 0, false},
+                        DownloadJob::DateTimePolicy::IgnoreDateTime);
+        CPPUNIT_ASSERT(job.runSynchronously());
+        CPPUNIT_ASSERT_EQUAL(2, requestCount.load());
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64_t>(content.size()), job.size());
+    }
+    CPPUNIT_ASSERT(content == readLocalFile());
+    checkNoTmpFile();
+
+    // EDIT propagation: the node id is preserved
+    NodeId nodeId2;
+    CPPUNIT_ASSERT(IoHelper::getNodeId(localDestFilePath, nodeId2));
+    CPPUNIT_ASSERT_EQUAL(nodeId, nodeId2);
+}
+
 void TestNetworkJobs::testGetAvatar() {
     GetInfoUserJob job(_userDbId);
     ExitCode exitCode = job.runSynchronously();
@@ -38,6 +38,7 @@ class TestNetworkJobs : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST(testDelete);
         CPPUNIT_TEST(testDownload);
         CPPUNIT_TEST(testDownloadAborted);
+        CPPUNIT_TEST(testDownloadInterrupted);
         CPPUNIT_TEST(testGetAvatar);
         CPPUNIT_TEST(testGetDriveList);
         CPPUNIT_TEST(testGetFileInfo);
@@ -85,6 +86,7 @@ class TestNetworkJobs : public CppUnit::TestFixture, public TestBase {
         void testDelete();
         void testDownload();
         void testDownloadAborted();
+        void testDownloadInterrupted();
         void testGetAvatar();
         void testGetDriveList();
         void testGetFileInfo();
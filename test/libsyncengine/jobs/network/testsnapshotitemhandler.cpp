@@ -25,6 +25,8 @@
 
 #include "libcommon/utility/utility.h"
 
+#include <numeric>
+
 using namespace CppUnit;
 
 namespace KDC {
@@ -513,4 +515,100 @@ void TestSnapshotItemHandler::testGetItem() {
     }
 }
 
+namespace {
+struct ParsedItem {
+        SnapshotItem item;
+        bool error = false;
+        bool ignore = false;
+};
+
+struct ParsingResult {
+        std::vector<ParsedItem> items;
+        bool eof = false;
+};
+
+ParsingResult parseStream(const std::string &csv) {
+    ParsingResult result;
+    std::stringstream ss;
+    ss << csv;
+    SnapshotItemHandler handler(Log::instance()->getLogger());
+    SnapshotItem item;
+    bool error = false;
+    bool ignore = false;
+    while (handler.getItem(item, ss, error, ignore, result.eof)) {
+        result.items.push_back({item, error, ignore});
+    }
+
+    return result;
+}
+
+ParsingResult parseChunks(const std::string &csv, const std::vector<size_t> &chunkEnds) {
+    ParsingResult result;
+    SnapshotItemHandler handler(Log::instance()->getLogger());
+    const auto onItem = [&result](const SnapshotItem &item, const bool error, const bool ignore) {
+        result.items.push_back({item, error, ignore});
+    };
+
+    size_t begin = 0;
+    for (const auto end: chunkEnds) {
+        (void) handler.parseChunk(std::string_view(csv).substr(begin, end - begin), onItem);
+        begin = end;
+    }
+    (void) handler.parseChunk(std::string_view(csv).substr(begin), onItem);
+    handler.finishParsing(onItem);
+    result.eof = handler.eofReached();
+
+    return result;
+}
+
+void checkSameResult(const ParsingResult &expected, const ParsingResult &actual, const std::string &context) {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(context, expected.eof, actual.eof);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(context, expected.items.size(), actual.items.size());
+    for (size_t i = 0; i < expected.items.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(context, expected.items[i].error, actual.items[i].error);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(context, expected.items[i].ignore, actual.items[i].ignore);
+        if (expected.items[i].error || expected.items[i].ignore) continue;
+
+        const auto [success, message] = snapshotitem_checker::compare(expected.items[i].item, actual.items[i].item);
+        CPPUNIT_ASSERT_MESSAGE(context + " " + message, success);
+    }
+}
+} // namespace
+
+void TestSnapshotItemHandler::testParseChunk() {
+    const std::string header = "id,parent_id,name,type,size,created_at,last_modified_at,can_write,is_link\n";
+    const std::vector<std::string> listings = {
+            header,
+            header + "1,0,test,dir,1000,123,124,0,1\n" + endOfFileDelimiter,
+            header + "1,0,test,dir,1000,123,124,0,1\n" + endOfFileDelimiter + "\n",
+            header + "1,0,test,dir,1000,123,124,0,1\n",
+            header + "1,0,test,dir,1000,123,124,0,1\n" + endOfFileDelimiter + "\n2,0,test2,dir,1000,123,124,0,1",
+            header + "2,1," + toCsvString(R"("kDrive2")") + ",file,1000,123,124,0,1\n" + "3,1," +
+                    toCsvString(R"(te,st)") + ",dir,1000,123,124,1,0\n" + endOfFileDelimiter,
+            header + "2,1," + toCsvString("kDrive\n\n2") + ",dir,1000,123,124,1,0,\n" + "3,1,test3,file,10,123,124,1,0\n" +
+                    endOfFileDelimiter,
+            header + "2,1," + toCsvString(R"(test\"test)") + ",dir,1000,123,124,0,1\n" + "3,1," +
+                    toCsvString(R"(""coucou"")") + ",dir,1000,123,124,0,1\n" + "4,1,test4,dir,1000,123,124,\n" +
+                    "5,1,test5,file,abc,123,124,0,1\n" + endOfFileDelimiter,
+            header + "2,1,test2,dir,1000,123,124,0,1\n\n3,1,test3,dir,1000,123,124,0,1\n" + endOfFileDelimiter,
+            header + "2,1," + toCsvString("\"kDrive\n    "),
+    };
+
+    for (size_t listingIndex = 0; listingIndex < listings.size(); ++listingIndex) {
+        const auto &csv = listings[listingIndex];
+        const auto expected = parseStream(csv);
+        const std::string context = "listing " + std::to_string(listingIndex);
+
+        // Split the listing in two chunks at every position
+        for (size_t split = 0; split <= csv.size(); ++split) {
+            checkSameResult(expected, parseChunks(csv, {split}), context + " split at " + std::to_string(split));
+        }
+
+        // One byte at a time
+        std::vector<size_t> chunkEnds(csv.size());
+        std::iota(chunkEnds.begin(), chunkEnds.end(), size_t{1});
+        checkSameResult(expected, parseChunks(csv, chunkEnds), context + " byte per byte");
+    }
+}
+
 } // namespace KDC
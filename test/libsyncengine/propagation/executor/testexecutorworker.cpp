@@ -714,7 +714,7 @@ void TestExecutorWorker::testRemoveDependentOps() {
         _syncPal->_syncOps->pushOp(op2Create);
         _syncPal->_syncOps->pushOp(op3Create);
 
-        _executorWorker->_opList = _syncPal->_syncOps->opSortedList();
+        _executorWorker->setOpList(_syncPal->_syncOps->opSortedList());
         _executorWorker->removeDependentOps(op1Create); // op1Create failed, we should remove op2Create and op3Create.
 
         CPPUNIT_ASSERT(opsExist(op1Create));
@@ -746,7 +746,7 @@ void TestExecutorWorker::testRemoveDependentOps() {
         _syncPal->_syncOps->pushOp(op1Create);
         _syncPal->_syncOps->pushOp(op2Move);
 
-        _executorWorker->_opList = _syncPal->_syncOps->opSortedList();
+        _executorWorker->setOpList(_syncPal->_syncOps->opSortedList());
         _executorWorker->removeDependentOps(op1Create); // op2Move failed, we should remove op2Edit.
         CPPUNIT_ASSERT(opsExist(op1Create));
         CPPUNIT_ASSERT(!opsExist(op2Move));
@@ -780,10 +780,12 @@ void TestExecutorWorker::testRemoveDependentOps() {
         _syncPal->_syncOps->pushOp(op1Move);
         _syncPal->_syncOps->pushOp(op2Move);
 
-        _executorWorker->_opList = _syncPal->_syncOps->opSortedList();
+        _executorWorker->setOpList(_syncPal->_syncOps->opSortedList());
         _executorWorker->removeDependentOps(op1Move); // op2Move failed, we should remove op2Edit.
         CPPUNIT_ASSERT(opsExist(op1Move));
         CPPUNIT_ASSERT(!opsExist(op2Move));
+        CPPUNIT_ASSERT(!_executorWorker->_opListIndex.contains(op2Move->id()));
+        CPPUNIT_ASSERT_EQUAL(_executorWorker->_opList.size(), _executorWorker->_opListIndex.size());
     }
 }
 
@@ -0,0 +1,154 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testoperationscheduler.h"
+#include "update_detection/update_detector/node.h"
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+std::shared_ptr<Node> makeNode(const NodeId &id, const NodeType type, const std::shared_ptr<Node> &parentNode) {
+    return std::make_shared<Node>(ReplicaSide::Local, Str2SyncName(id), type, OperationType::None, id, 0, 0, 0, parentNode);
+}
+
+std::list<SyncOpPtr> toList(const std::vector<SyncOpPtr> &ops) {
+    return {ops.begin(), ops.end()};
+}
+
+std::set<UniqueId> prerequisiteSet(const OperationScheduler &scheduler, const SyncOpPtr &op) {
+    const auto &prerequisites = scheduler.prerequisites(op->id());
+    return {prerequisites.begin(), prerequisites.end()};
+}
+} // namespace
+
+void TestOperationScheduler::setUp() {
+    TestBase::start();
+
+    // Initial situation:
+    // .
+    // ├── A
+    // │   └── a1
+    // ├── B
+    // │   └── b1
+    // └── C
+    const auto rootNode = makeNode("root", NodeType::Directory, nullptr);
+    const auto nodeB = makeNode("B", NodeType::Directory, rootNode);
+    const auto nodeC = makeNode("C", NodeType::Directory, rootNode);
+    // A has been moved into C
+    const auto nodeA = makeNode("A", NodeType::Directory, nodeC);
+    nodeA->setMoveOriginInfos({"A", "root"});
+
+    (void) addOp(OperationType::Delete, makeNode("a1", NodeType::File, nodeA)); // 0
+    (void) addOp(OperationType::Delete, makeNode("b1", NodeType::File, nodeB)); // 1
+    (void) addOp(OperationType::Move, nodeA); // 2: A -> C/A
+    const auto nodeB2 = makeNode("b2", NodeType::File, nodeB);
+    (void) addOp(OperationType::Create, nodeB2); // 3
+    (void) addOp(OperationType::Delete, nodeC); // 4
+    addOp(OperationType::Move, nodeB)->setIsBreakingCycleOp(true); // 5
+    (void) addOp(OperationType::Delete, nodeB2); // 6
+}
+
+void TestOperationScheduler::tearDown() {
+    _ops.clear();
+    TestBase::stop();
+}
+
+SyncOpPtr TestOperationScheduler::addOp(const OperationType type, const std::shared_ptr<Node> &node) {
+    const auto op = std::make_shared<SyncOperation>();
+    op->setType(type);
+    op->setAffectedNode(node);
+    op->setTargetSide(ReplicaSide::Remote);
+    _ops.push_back(op);
+    return op;
+}
+
+void TestOperationScheduler::testPrerequisites() {
+    OperationScheduler scheduler;
+    scheduler.init(toList(_ops));
+
+    // Operations in disjoint subtrees do not wait for each other
+    CPPUNIT_ASSERT(scheduler.prerequisites(_ops[0]->id()).empty());
+    CPPUNIT_ASSERT(scheduler.prerequisites(_ops[1]->id()).empty());
+    CPPUNIT_ASSERT(scheduler.prerequisites(_ops[3]->id()).empty());
+    // The move of A waits for the operations in A
+    CPPUNIT_ASSERT((std::set<UniqueId>{_ops[0]->id()} == prerequisiteSet(scheduler, _ops[2])));
+    // The deletion of C waits for the move of A into C, not for the operations in B
+    const auto deleteCPrerequisites = prerequisiteSet(scheduler, _ops[4]);
+    CPPUNIT_ASSERT(deleteCPrerequisites.contains(_ops[2]->id()));
+    CPPUNIT_ASSERT(!deleteCPrerequisites.contains(_ops[1]->id()));
+    CPPUNIT_ASSERT(!deleteCPrerequisites.contains(_ops[3]->id()));
+    // A cycle breaking operation waits for all the previous operations, and all the next ones wait for it
+    CPPUNIT_ASSERT((std::set<UniqueId>{_ops[0]->id(), _ops[1]->id(), _ops[2]->id(), _ops[3]->id(), _ops[4]->id()} ==
+                    prerequisiteSet(scheduler, _ops[5])));
+    CPPUNIT_ASSERT((std::set<UniqueId>{_ops[3]->id(), _ops[5]->id()} == prerequisiteSet(scheduler, _ops[6])));
+}
+
+void TestOperationScheduler::testPopAndRelease() {
+    OperationScheduler scheduler;
+    scheduler.init(toList(_ops));
+
+    // The ready operations are popped in their sorted order
+    CPPUNIT_ASSERT_EQUAL(_ops[0]->id(), scheduler.popReadyOp());
+    CPPUNIT_ASSERT_EQUAL(_ops[1]->id(), scheduler.popReadyOp());
+    CPPUNIT_ASSERT_EQUAL(_ops[3]->id(), scheduler.popReadyOp());
+    CPPUNIT_ASSERT_EQUAL(UniqueId(0), scheduler.popReadyOp());
+
+    scheduler.release(_ops[0]->id());
+    CPPUNIT_ASSERT_EQUAL(_ops[2]->id(), scheduler.popReadyOp());
+    CPPUNIT_ASSERT(!scheduler.hasReadyOp());
+    scheduler.release(_ops[2]->id());
+    CPPUNIT_ASSERT_EQUAL(_ops[4]->id(), scheduler.popReadyOp());
+
+    scheduler.release(_ops[1]->id());
+    scheduler.release(_ops[3]->id());
+    CPPUNIT_ASSERT(!scheduler.hasReadyOp());
+    scheduler.release(_ops[4]->id());
+    CPPUNIT_ASSERT_EQUAL(_ops[5]->id(), scheduler.popReadyOp());
+    CPPUNIT_ASSERT(!scheduler.hasReadyOp());
+    scheduler.release(_ops[5]->id());
+    CPPUNIT_ASSERT_EQUAL(_ops[6]->id(), scheduler.popReadyOp());
+    scheduler.release(_ops[6]->id());
+    CPPUNIT_ASSERT_EQUAL(UniqueId(0), scheduler.popReadyOp());
+
+    // Releasing an operation twice has no effect
+    scheduler.release(_ops[6]->id());
+    CPPUNIT_ASSERT(!scheduler.hasReadyOp());
+}
+
+void TestOperationScheduler::testReleaseDroppedOp() {
+    OperationScheduler scheduler;
+    scheduler.init(toList(_ops));
+
+    // The move of A is dropped before being executed
+    scheduler.release(_ops[2]->id());
+
+    std::list<UniqueId> poppedOpIds;
+    while (const UniqueId opId = scheduler.popReadyOp()) {
+        poppedOpIds.push_back(opId);
+    }
+    CPPUNIT_ASSERT((std::list<UniqueId>{_ops[0]->id(), _ops[1]->id(), _ops[3]->id()} == poppedOpIds));
+
+    // Once the deletion of a1 is done, the deletion of C does not wait for the dropped move and the move is never popped
+    scheduler.release(_ops[0]->id());
+    CPPUNIT_ASSERT_EQUAL(_ops[4]->id(), scheduler.popReadyOp());
+    CPPUNIT_ASSERT_EQUAL(UniqueId(0), scheduler.popReadyOp());
+}
+
+} // namespace KDC
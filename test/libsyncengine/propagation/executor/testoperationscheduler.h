@@ -0,0 +1,50 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "propagation/executor/operationscheduler.h"
+
+namespace KDC {
+
+class Node;
+
+class TestOperationScheduler final : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestOperationScheduler);
+        CPPUNIT_TEST(testPrerequisites);
+        CPPUNIT_TEST(testPopAndRelease);
+        CPPUNIT_TEST(testReleaseDroppedOp);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        void testPrerequisites();
+        void testPopAndRelease();
+        void testReleaseDroppedOp();
+
+        SyncOpPtr addOp(OperationType type, const std::shared_ptr<Node> &node);
+
+        // The operations of the test situation, in their sorted order
+        std::vector<SyncOpPtr> _ops;
+};
+
+} // namespace KDC
@@ -17,7 +17,7 @@
  */
 
 #include "testoperationsorterworker.h"
-#include "propagation/operation_sorter/cyclefinder.h"
+#include "propagation/operation_sorter/operationdependencygraph.h"
 #include "mocks/libcommonserver/db/mockdb.h"
 
 #include "test_classes/testsituationgenerator.h"
@@ -64,7 +64,7 @@ void TestOperationSorterWorker::tearDown() {
     TestBase::stop();
 }
 
-void TestOperationSorterWorker::testMoveFirstAfterSecond() {
+void TestOperationSorterWorker::testAddDependency() {
     const auto nodeA = _testSituationGenerator.getNode(ReplicaSide::Local, "a");
     const auto nodeB = _testSituationGenerator.getNode(ReplicaSide::Local, "b");
     const auto nodeC = _testSituationGenerator.getNode(ReplicaSide::Local, "c");
@@ -78,13 +78,16 @@ void TestOperationSorterWorker::testMoveFirstAfterSecond() {
     (void) _syncPal->syncOps()->pushOp(opB);
     (void) _syncPal->syncOps()->pushOp(opC);
 
-    // Move opB after opA -> nothing happens, opB is already after opA.
-    _syncPal->_operationsSorterWorker->moveFirstAfterSecond(opB, opA);
+    // opB after opA -> nothing happens, opB is already after opA.
+    _syncPal->_operationsSorterWorker->addDependency(opB, opA);
+    sortByDependencies();
     CPPUNIT_ASSERT_EQUAL(opA->id(), _syncPal->syncOps()->opSortedList().front());
     CPPUNIT_ASSERT_EQUAL(false, _syncPal->_operationsSorterWorker->hasOrderChanged());
 
-    // Move opA after opB.
-    _syncPal->_operationsSorterWorker->moveFirstAfterSecond(opA, opB);
+    // opA after opB.
+    _syncPal->_operationsSorterWorker->_dependencyGraph.clear();
+    _syncPal->_operationsSorterWorker->addDependency(opA, opB);
+    sortByDependencies();
     CPPUNIT_ASSERT_EQUAL(opB->id(), _syncPal->syncOps()->opSortedList().front());
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     CPPUNIT_ASSERT_EQUAL(opC->id(), _syncPal->syncOps()->opSortedList().back());
@@ -112,6 +115,7 @@ void TestOperationSorterWorker::testFixDeleteBeforeMove() {
         (void) _syncPal->syncOps()->pushOp(deleteOp);
         _syncPal->_operationsSorterWorker->_filter.filterOperations();
         _syncPal->_operationsSorterWorker->fixDeleteBeforeMove();
+        sortByDependencies();
 
         CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
         std::unordered_map<UniqueId, uint32_t> mapIndex = {{moveOp->id(), 0}, {deleteOp->id(), 0}};
@@ -136,6 +140,7 @@ void TestOperationSorterWorker::testFixDeleteBeforeMove() {
 
         _syncPal->_operationsSorterWorker->_filter.filterOperations();
         _syncPal->_operationsSorterWorker->fixDeleteBeforeMove();
+        sortByDependencies();
 
         CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
         CPPUNIT_ASSERT_EQUAL(deleteOp->id(), _syncPal->_syncOps->opSortedList().front());
@@ -161,6 +166,7 @@ void TestOperationSorterWorker::testFixMoveBeforeCreate() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixMoveBeforeCreate();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{moveOp->id(), 0}, {createOp->id(), 0}};
@@ -185,6 +191,7 @@ void TestOperationSorterWorker::testFixMoveBeforeDelete() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixMoveBeforeDelete();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{deleteOp->id(), 0}, {moveOp->id(), 0}};
@@ -209,6 +216,7 @@ void TestOperationSorterWorker::testFixCreateBeforeMove() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixCreateBeforeMove();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{createOp->id(), 0}, {moveOp->id(), 0}};
@@ -234,6 +242,7 @@ void TestOperationSorterWorker::testFixDeleteBeforeCreate() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixDeleteBeforeCreate();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{createOp->id(), 0}, {deleteOp->id(), 0}};
@@ -258,6 +267,7 @@ void TestOperationSorterWorker::testFixMoveBeforeMoveOccupied() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixMoveBeforeMoveOccupied();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{moveOp2->id(), 0}, {moveOp->id(), 0}};
@@ -306,28 +316,16 @@ void TestOperationSorterWorker::testFixCreateBeforeCreate() {
         (void) _syncPal->syncOps()->pushOp(opDB);
         (void) _syncPal->syncOps()->pushOp(opD);
 
-        // Test hasAncestorWithHigherIndex
-        std::unordered_map<UniqueId, int32_t> opIdToIndexMap;
-        _syncPal->syncOps()->getOpIdToIndexMap(opIdToIndexMap, OperationType::Create);
-        int32_t depth = 0;
-        auto ancestorOpWithHighestIndex =
-                _syncPal->_operationsSorterWorker->getAncestorOpWithHighestIndex(opIdToIndexMap, opDAA, depth);
-        CPPUNIT_ASSERT(ancestorOpWithHighestIndex);
-        CPPUNIT_ASSERT_EQUAL(opD->id(), ancestorOpWithHighestIndex->id());
-        CPPUNIT_ASSERT_EQUAL(3, depth);
-
-        ancestorOpWithHighestIndex =
-                _syncPal->_operationsSorterWorker->getAncestorOpWithHighestIndex(opIdToIndexMap, opDA, depth);
-        CPPUNIT_ASSERT(ancestorOpWithHighestIndex);
-        CPPUNIT_ASSERT_EQUAL(opD->id(), ancestorOpWithHighestIndex->id());
-        CPPUNIT_ASSERT_EQUAL(2, depth);
-
-        ancestorOpWithHighestIndex = _syncPal->_operationsSorterWorker->getAncestorOpWithHighestIndex(opIdToIndexMap, opD, depth);
-        CPPUNIT_ASSERT(!ancestorOpWithHighestIndex);
-        CPPUNIT_ASSERT_EQUAL(1, depth);
-
         _syncPal->_operationsSorterWorker->fixCreateBeforeCreate();
 
+        // Only the closest created ancestor is a prerequisite
+        const auto &prerequisites = _syncPal->_operationsSorterWorker->_dependencyGraph.prerequisites();
+        CPPUNIT_ASSERT(prerequisites.at(opDAA->id()) == std::unordered_set<UniqueId>{opDA->id()});
+        CPPUNIT_ASSERT(prerequisites.at(opDA->id()) == std::unordered_set<UniqueId>{opD->id()});
+        CPPUNIT_ASSERT(!prerequisites.contains(opD->id()));
+
+        sortByDependencies();
+
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDA));
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDB));
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opDA, opDAA));
@@ -344,6 +342,7 @@ void TestOperationSorterWorker::testFixCreateBeforeCreate() {
         (void) _syncPal->syncOps()->pushOp(opDB);
 
         _syncPal->_operationsSorterWorker->fixCreateBeforeCreate();
+        sortByDependencies();
 
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDA));
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDB));
@@ -361,6 +360,7 @@ void TestOperationSorterWorker::testFixCreateBeforeCreate() {
         (void) _syncPal->syncOps()->pushOp(opDB);
 
         _syncPal->_operationsSorterWorker->fixCreateBeforeCreate();
+        sortByDependencies();
 
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDA));
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDB));
@@ -378,6 +378,7 @@ void TestOperationSorterWorker::testFixCreateBeforeCreate() {
         (void) _syncPal->syncOps()->pushOp(opDAB);
 
         _syncPal->_operationsSorterWorker->fixCreateBeforeCreate();
+        sortByDependencies();
 
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDA));
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opD, opDB));
@@ -420,6 +421,7 @@ void TestOperationSorterWorker::testFixCreateBeforeCreateComplexOrdering() {
         (void) _syncPal->syncOps()->pushOp(opC);
 
         _syncPal->_operationsSorterWorker->fixCreateBeforeCreate();
+        sortByDependencies();
 
         // Expected fixed re-ordering: A, A/B, A/B/C, A/B/C/D, A/B/C/D/E, A/B/C/D/F
         CPPUNIT_ASSERT(isFirstBeforeSecond(_syncPal->syncOps(), opA, opB));
@@ -484,6 +486,7 @@ void TestOperationSorterWorker::testFixCreateBeforeCreateSameIdOnBothSide() {
     (void) _syncPal->syncOps()->pushOp(opBA);
 
     _syncPal->_operationsSorterWorker->fixCreateBeforeCreate();
+    sortByDependencies();
 
     CPPUNIT_ASSERT(!_syncPal->_operationsSorterWorker->hasOrderChanged());
 }
@@ -505,6 +508,7 @@ void TestOperationSorterWorker::testFixEditBeforeMove() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixEditBeforeMove();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{editOp->id(), 0}, {moveOp->id(), 0}};
@@ -529,6 +533,7 @@ void TestOperationSorterWorker::testFixEditBeforeMove2() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixEditBeforeMove();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{editOp->id(), 0}, {moveOp->id(), 0}};
@@ -554,6 +559,7 @@ void TestOperationSorterWorker::testFixMoveBeforeMoveParentChildFlip() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixMoveBeforeMoveHierarchyFlip();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     std::unordered_map<UniqueId, uint32_t> mapIndex = {{moveOp2->id(), 0}, {moveOp1->id(), 0}};
@@ -576,6 +582,7 @@ void TestOperationSorterWorker::testFixMoveBeforeMoveParentChildFlip2() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixMoveBeforeMoveHierarchyFlip();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     CPPUNIT_ASSERT_EQUAL(moveOp1->id(), _syncPal->syncOps()->opSortedList().front());
@@ -601,6 +608,7 @@ void TestOperationSorterWorker::testFixMoveBeforeMoveParentChildFlip3() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixMoveBeforeMoveHierarchyFlip();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     CPPUNIT_ASSERT_EQUAL(moveOp1->id(), _syncPal->syncOps()->opSortedList().front());
@@ -632,6 +640,7 @@ void TestOperationSorterWorker::testCheckAllMethods() {
     _syncPal->_operationsSorterWorker->fixCreateBeforeCreate();
     _syncPal->_operationsSorterWorker->fixEditBeforeMove();
     _syncPal->_operationsSorterWorker->fixMoveBeforeMoveHierarchyFlip();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     CPPUNIT_ASSERT_EQUAL(moveOp->id(), _syncPal->syncOps()->opSortedList().front());
@@ -658,6 +667,7 @@ void TestOperationSorterWorker::testDifferentEncodings() {
 
     _syncPal->_operationsSorterWorker->_filter.filterOperations();
     _syncPal->_operationsSorterWorker->fixMoveBeforeCreate();
+    sortByDependencies();
 
     CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
     CPPUNIT_ASSERT_EQUAL(moveOp->id(), _syncPal->syncOps()->opSortedList().front());
@@ -719,7 +729,7 @@ void TestOperationSorterWorker::testFixImpossibleFirstMoveOp() {
     CPPUNIT_ASSERT(reshuffledOps._opSortedList.back() == rMoveOpA->id());
 }
 
-void TestOperationSorterWorker::testFindCompleteCycles() {
+void TestOperationSorterWorker::testFindDependencyCycles() {
     const auto nodeA = _testSituationGenerator.renameNode(ReplicaSide::Local, "a", Str("A*"));
     const auto opA = generateSyncOperation(OperationType::Move, nodeA);
 
@@ -738,102 +748,159 @@ void TestOperationSorterWorker::testFindCompleteCycles() {
     const auto nodeAAA = _testSituationGenerator.renameNode(ReplicaSide::Local, "aaa", Str("AAA*"));
     const auto opAAA = generateSyncOperation(OperationType::Move, nodeAAA);
 
+    // The operations are listed in this order. Dependencies are given as pairs (op, prerequisiteOp).
+    const std::list<UniqueId> opIds = {opA->id(), opB->id(), opC->id(), opD->id(), opAA->id(), opAAA->id()};
+    const auto findCycle = [&opIds](const std::list<std::pair<SyncOpPtr, SyncOpPtr>> &dependencies,
+                                    std::list<UniqueId> &sortedOpIds, std::list<UniqueId> &cycle) {
+        OperationDependencyGraph graph;
+        for (const auto &[op, prerequisiteOp]: dependencies) (void) graph.addDependency(op, prerequisiteOp);
+        return graph.sort(opIds, sortedOpIds, cycle);
+    };
+    const auto toIds = [](const std::list<SyncOpPtr> &ops) {
+        std::list<UniqueId> ids;
+        for (const auto &op: ops) ids.push_back(op->id());
+        return ids;
+    };
+
     {
         // No cycle
-        _syncPal->_operationsSorterWorker->_reorderings = {{opA, opB}, {opB, opC}, {opC, opD}};
-        CycleFinder cycleFinder(_syncPal->_operationsSorterWorker->_reorderings);
-        cycleFinder.findCompleteCycle();
+        std::list<UniqueId> sortedOpIds;
+        std::list<UniqueId> cycle;
+        CPPUNIT_ASSERT(findCycle({{opA, opB}, {opB, opC}, {opC, opD}}, sortedOpIds, cycle));
 
-        CPPUNIT_ASSERT_EQUAL(false, cycleFinder.hasCompleteCycle());
-        CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(cycleFinder.completeCycle().opSortedList().size()));
+        CPPUNIT_ASSERT(cycle.empty());
+        CPPUNIT_ASSERT(toIds({opD, opC, opB, opA, opAA, opAAA}) == sortedOpIds);
     }
 
     {
-        // A cycle, the order in which reorderings are found follow the order of the operations in the cycle
-        _syncPal->_operationsSorterWorker->_reorderings = {{opA, opB}, {opB, opC}, {opC, opD}, {opD, opA}};
-        CycleFinder cycleFinder(_syncPal->_operationsSorterWorker->_reorderings);
-        cycleFinder.findCompleteCycle();
-
-        CPPUNIT_ASSERT_EQUAL(true, cycleFinder.hasCompleteCycle());
-        CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(cycleFinder.completeCycle().opSortedList().size()));
-        const std::vector expectedOpIdsInCycle = {opA->id(), opB->id(), opC->id(), opD->id()};
-        for (size_t i = 0; const auto &id: cycleFinder.completeCycle().opSortedList()) {
-            CPPUNIT_ASSERT_EQUAL(expectedOpIdsInCycle[i++], id);
-        }
+        // A cycle, the order in which dependencies are found follow the order of the operations in the cycle
+        std::list<UniqueId> sortedOpIds;
+        std::list<UniqueId> cycle;
+        CPPUNIT_ASSERT(!findCycle({{opA, opB}, {opB, opC}, {opC, opD}, {opD, opA}}, sortedOpIds, cycle));
+
+        CPPUNIT_ASSERT(toIds({opA, opB, opC, opD}) == cycle);
+        CPPUNIT_ASSERT(toIds({opAA, opAAA}) == sortedOpIds);
     }
 
     {
-        // A cycle, the order in which reorderings are found follow the order of the operations in the cycle but with other
+        // A cycle, the order in which dependencies are found follow the order of the operations in the cycle but with other
         // operations that are not in the cycle chain.
-        _syncPal->_operationsSorterWorker->_reorderings = {{opA, opB},   {opB, opAA},  {opB, opAAA}, {opB, opC},
-                                                           {opC, opAA},  {opC, opAAA}, {opC, opD},   {opD, opAA},
-                                                           {opA, opAAA}, {opD, opA},   {opA, opAA},  {opA, opAAA}};
-        CycleFinder cycleFinder(_syncPal->_operationsSorterWorker->_reorderings);
-        cycleFinder.findCompleteCycle();
-
-        CPPUNIT_ASSERT_EQUAL(true, cycleFinder.hasCompleteCycle());
-        CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(cycleFinder.completeCycle().opSortedList().size()));
-        const std::vector expectedOpIdsInCycle = {opA->id(), opB->id(), opC->id(), opD->id()};
-        for (size_t i = 0; const auto &id: cycleFinder.completeCycle().opSortedList()) {
-            CPPUNIT_ASSERT_EQUAL(expectedOpIdsInCycle[i++], id);
-        }
+        std::list<UniqueId> sortedOpIds;
+        std::list<UniqueId> cycle;
+        CPPUNIT_ASSERT(!findCycle({{opA, opB},
+                                   {opB, opAA},
+                                   {opB, opAAA},
+                                   {opB, opC},
+                                   {opC, opAA},
+                                   {opC, opAAA},
+                                   {opC, opD},
+                                   {opD, opAA},
+                                   {opA, opAAA},
+                                   {opD, opA},
+                                   {opA, opAA},
+                                   {opA, opAAA}},
+                                  sortedOpIds, cycle));
+
+        CPPUNIT_ASSERT(toIds({opA, opB, opC, opD}) == cycle);
     }
 
     {
-        // Cycle, the order in which reorderings are found DO NOT follow the order of the operations in the cycle.
-        _syncPal->_operationsSorterWorker->_reorderings = {{opB, opC}, {opD, opA}, {opA, opB}, {opC, opD}};
-        CycleFinder cycleFinder(_syncPal->_operationsSorterWorker->_reorderings);
-        cycleFinder.findCompleteCycle();
-
-        CPPUNIT_ASSERT_EQUAL(true, cycleFinder.hasCompleteCycle());
-        CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(cycleFinder.completeCycle().opSortedList().size()));
-        const std::vector expectedOpIdsInCycle = {opB->id(), opC->id(), opD->id(), opA->id()};
-        for (size_t i = 0; const auto &id: cycleFinder.completeCycle().opSortedList()) {
-            CPPUNIT_ASSERT_EQUAL(expectedOpIdsInCycle[i++], id);
-        }
+        // Cycle, the order in which dependencies are found DO NOT follow the order of the operations in the cycle. The cycle
+        // starts from the first operation of the list.
+        std::list<UniqueId> sortedOpIds;
+        std::list<UniqueId> cycle;
+        CPPUNIT_ASSERT(!findCycle({{opB, opC}, {opD, opA}, {opA, opB}, {opC, opD}}, sortedOpIds, cycle));
+
+        CPPUNIT_ASSERT(toIds({opA, opB, opC, opD}) == cycle);
     }
 
     {
-        // Cycle, the order in which reorderings are found DO NOT follow the order of the operations in the cycle and with
+        // Cycle, the order in which dependencies are found DO NOT follow the order of the operations in the cycle and with
         // other operations that are not in the cycle chain.
-        _syncPal->_operationsSorterWorker->_reorderings = {{opB, opC},   {opD, opA}, {opA, opAA},
-                                                           {opA, opAAA}, {opA, opB}, {opC, opD}};
-        CycleFinder cycleFinder(_syncPal->_operationsSorterWorker->_reorderings);
-        cycleFinder.findCompleteCycle();
-
-        CPPUNIT_ASSERT_EQUAL(true, cycleFinder.hasCompleteCycle());
-        CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(cycleFinder.completeCycle().opSortedList().size()));
-        const std::vector expectedOpIdsInCycle = {opB->id(), opC->id(), opD->id(), opA->id()};
-        for (size_t i = 0; const auto &id: cycleFinder.completeCycle().opSortedList()) {
-            CPPUNIT_ASSERT_EQUAL(expectedOpIdsInCycle[i++], id);
-        }
+        std::list<UniqueId> sortedOpIds;
+        std::list<UniqueId> cycle;
+        CPPUNIT_ASSERT(!findCycle({{opB, opC}, {opD, opA}, {opA, opAA}, {opA, opAAA}, {opA, opB}, {opC, opD}}, sortedOpIds,
+                                  cycle));
+
+        CPPUNIT_ASSERT(toIds({opA, opB, opC, opD}) == cycle);
     }
 
     {
         // A cycle hidden within a chain
-        _syncPal->_operationsSorterWorker->_reorderings = {{opB, opA}, {opA, opC}, {opC, opA}};
-        CycleFinder cycleFinder(_syncPal->_operationsSorterWorker->_reorderings);
-        cycleFinder.findCompleteCycle();
-
-        CPPUNIT_ASSERT_EQUAL(true, cycleFinder.hasCompleteCycle());
-        CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(cycleFinder.completeCycle().opSortedList().size()));
-        const std::vector expectedOpIdsInCycle = {opA->id(), opC->id()};
-        for (size_t i = 0; const auto &id: cycleFinder.completeCycle().opSortedList()) {
-            CPPUNIT_ASSERT_EQUAL(expectedOpIdsInCycle[i++], id);
-        }
+        std::list<UniqueId> sortedOpIds;
+        std::list<UniqueId> cycle;
+        CPPUNIT_ASSERT(!findCycle({{opB, opA}, {opA, opC}, {opC, opA}}, sortedOpIds, cycle));
+
+        CPPUNIT_ASSERT(toIds({opA, opC}) == cycle);
+        CPPUNIT_ASSERT(toIds({opD, opAA, opAAA}) == sortedOpIds);
     }
 
     {
         // 2 cycles
-        _syncPal->_operationsSorterWorker->_reorderings = {{opA, opB}, {opB, opA}, {opB, opC}, {opC, opD}, {opD, opA}};
-        CycleFinder cycleFinder(_syncPal->_operationsSorterWorker->_reorderings);
-        cycleFinder.findCompleteCycle();
-
-        CPPUNIT_ASSERT_EQUAL(true, cycleFinder.hasCompleteCycle());
-        CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(cycleFinder.completeCycle().opSortedList().size()));
-        const std::vector expectedOpIdsInCycle = {opA->id(), opB->id()};
-        for (size_t i = 0; const auto &id: cycleFinder.completeCycle().opSortedList()) {
-            CPPUNIT_ASSERT_EQUAL(expectedOpIdsInCycle[i++], id);
+        std::list<UniqueId> sortedOpIds;
+        std::list<UniqueId> cycle;
+        CPPUNIT_ASSERT(!findCycle({{opA, opB}, {opB, opA}, {opB, opC}, {opC, opD}, {opD, opA}}, sortedOpIds, cycle));
+
+        CPPUNIT_ASSERT(toIds({opA, opB}) == cycle);
+    }
+}
+
+// All the ordering rules at once, with the operations initially listed in an order that breaks every one of them.
+void TestOperationSorterWorker::testSortSatisfiesAllDependencies() {
+    // Rename C to D after deleting D (delete before move)
+    const auto nodeD = _testSituationGenerator.deleteNode(ReplicaSide::Local, "d");
+    const auto deleteOpD = generateSyncOperation(OperationType::Delete, nodeD);
+    const auto nodeC = _testSituationGenerator.moveNode(ReplicaSide::Local, "c", {}, Str("D"));
+    const auto moveOpC = generateSyncOperation(OperationType::Move, nodeC);
+
+    // Create another C (move before create)
+    const auto nodeC2 = _testSituationGenerator.createNode(ReplicaSide::Local, NodeType::File, "c2", "");
+    nodeC2->setName(Str("C"));
+    const auto createOpC2 = generateSyncOperation(OperationType::Create, nodeC2);
+
+    // Move A/AA/AAA to AAA and edit it (edit before move), then delete A (move before delete)
+    const auto nodeAAA = _testSituationGenerator.moveNode(ReplicaSide::Local, "aaa", {});
+    const auto moveOpAAA = generateSyncOperation(OperationType::Move, nodeAAA);
+    (void) _testSituationGenerator.editNode(ReplicaSide::Local, *nodeAAA->id());
+    const auto editOpAAA = generateSyncOperation(OperationType::Edit, nodeAAA);
+    const auto nodeA = _testSituationGenerator.deleteNode(ReplicaSide::Local, "a");
+    const auto deleteOpA = generateSyncOperation(OperationType::Delete, nodeA);
+
+    // Create E/EA (create before create) and move B into E (create before move)
+    const auto nodeE = _testSituationGenerator.createNode(ReplicaSide::Local, NodeType::Directory, "e", "");
+    const auto createOpE = generateSyncOperation(OperationType::Create, nodeE);
+    const auto nodeEA = _testSituationGenerator.createNode(ReplicaSide::Local, NodeType::File, "ea", nodeE);
+    const auto createOpEA = generateSyncOperation(OperationType::Create, nodeEA);
+    const auto nodeB = _testSituationGenerator.moveNode(ReplicaSide::Local, "b", *nodeE->id());
+    const auto moveOpB = generateSyncOperation(OperationType::Move, nodeB);
+
+    _syncPal->syncOps()->setOpList(
+            {createOpC2, moveOpC, deleteOpD, editOpAAA, deleteOpA, moveOpAAA, createOpEA, moveOpB, createOpE});
+
+    _syncPal->_operationsSorterWorker->_filter.filterOperations();
+    _syncPal->_operationsSorterWorker->sortOperations();
+
+    CPPUNIT_ASSERT_EQUAL(true, _syncPal->_operationsSorterWorker->hasOrderChanged());
+    CPPUNIT_ASSERT_EQUAL(size_t{9}, _syncPal->syncOps()->size());
+
+    const std::list<std::pair<SyncOpPtr, SyncOpPtr>> expectedDependencies = {
+            {moveOpC, deleteOpD},   {createOpC2, moveOpC},  {editOpAAA, moveOpAAA},
+            {deleteOpA, moveOpAAA}, {createOpEA, createOpE}, {moveOpB, createOpE}};
+    const auto &prerequisites = _syncPal->_operationsSorterWorker->_dependencyGraph.prerequisites();
+    for (const auto &[op, prerequisiteOp]: expectedDependencies) {
+        CPPUNIT_ASSERT(prerequisites.contains(op->id()) && prerequisites.at(op->id()).contains(prerequisiteOp->id()));
+    }
+
+    // Every recorded dependency is satisfied by the final order
+    std::unordered_map<UniqueId, uint32_t> mapIndex;
+    for (const auto &[opId, prerequisiteIds]: prerequisites) {
+        (void) mapIndex.try_emplace(opId, 0);
+        for (const auto prerequisiteId: prerequisiteIds) (void) mapIndex.try_emplace(prerequisiteId, 0);
+    }
+    findIndexesInOpList(mapIndex);
+    for (const auto &[opId, prerequisiteIds]: prerequisites) {
+        for (const auto prerequisiteId: prerequisiteIds) {
+            CPPUNIT_ASSERT_LESS(mapIndex[opId], mapIndex[prerequisiteId]);
         }
     }
 }
@@ -997,6 +1064,11 @@ void TestOperationSorterWorker::generateLotsOfDummySyncOperations(const Operatio
     }
 }
 
+void TestOperationSorterWorker::sortByDependencies() const {
+    SyncOperationList cycle;
+    CPPUNIT_ASSERT(_syncPal->_operationsSorterWorker->sortByDependencies(cycle));
+}
+
 void TestOperationSorterWorker::findIndexesInOpList(std::unordered_map<UniqueId, uint32_t> &mapIndex) const {
     uint32_t index = 0;
     uint32_t counter = 0;
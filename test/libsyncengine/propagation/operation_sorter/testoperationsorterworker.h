@@ -27,7 +27,7 @@ namespace KDC {
 
 class TestOperationSorterWorker final : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST_SUITE(TestOperationSorterWorker);
-        CPPUNIT_TEST(testMoveFirstAfterSecond);
+        CPPUNIT_TEST(testAddDependency);
         CPPUNIT_TEST(testFixDeleteBeforeMove);
         CPPUNIT_TEST(testFixMoveBeforeCreate);
         CPPUNIT_TEST(testFixMoveBeforeDelete);
@@ -45,7 +45,8 @@ class TestOperationSorterWorker final : public CppUnit::TestFixture, public Test
         CPPUNIT_TEST(testCheckAllMethods);
         CPPUNIT_TEST(testDifferentEncodings);
         CPPUNIT_TEST(testFixImpossibleFirstMoveOp);
-        CPPUNIT_TEST(testFindCompleteCycles);
+        CPPUNIT_TEST(testFindDependencyCycles);
+        CPPUNIT_TEST(testSortSatisfiesAllDependencies);
         CPPUNIT_TEST(testBreakCycle);
         CPPUNIT_TEST(testBreakCycle2);
         CPPUNIT_TEST(testSwapNames);
@@ -56,7 +57,7 @@ class TestOperationSorterWorker final : public CppUnit::TestFixture, public Test
         void setUp() override;
         void tearDown() override;
 
-        void testMoveFirstAfterSecond();
+        void testAddDependency();
         void testFixDeleteBeforeMove();
         void testFixMoveBeforeCreate();
         void testFixMoveBeforeDelete();
@@ -75,7 +76,8 @@ class TestOperationSorterWorker final : public CppUnit::TestFixture, public Test
         void testCheckAllMethods();
         void testDifferentEncodings();
         void testFixImpossibleFirstMoveOp();
-        void testFindCompleteCycles();
+        void testFindDependencyCycles();
+        void testSortSatisfiesAllDependencies();
         void testBreakCycle();
         void testBreakCycle2();
         void testSwapNames();
@@ -86,6 +88,8 @@ class TestOperationSorterWorker final : public CppUnit::TestFixture, public Test
         void generateLotsOfDummySyncOperations(OperationType opType1, OperationType opType2 = OperationType::None,
                                                NodeType nodeType = NodeType::File) const;
 
+        // Apply the dependencies recorded by the fix* methods to the operation list.
+        void sortByDependencies() const;
         void findIndexesInOpList(std::unordered_map<UniqueId, uint32_t> &mapIndex) const;
 
         std::shared_ptr<SyncPal> _syncPal = nullptr;
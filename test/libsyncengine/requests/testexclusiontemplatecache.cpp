@@ -26,6 +26,8 @@
 #include "test_utility/testhelpers.h"
 
 #include <filesystem>
+#include <random>
+#include <thread>
 
 using namespace CppUnit;
 
@@ -81,6 +83,40 @@ static const std::vector<std::string> acceptedFiles = {"~test",
 #endif
 };
 
+// Returns the first template matching `fileName`, checked the way `ExclusionTemplateCache::isExcluded` did before the
+// templates were compiled into an `ExclusionTemplateMatcher`.
+static const ExclusionTemplate *matchWithRegexes(const std::vector<std::pair<std::regex, ExclusionTemplate>> &regexPatterns,
+                                                 const std::string &fileName) {
+    for (const auto &[regex, exclusionTemplate]: regexPatterns) {
+        bool exclude = false;
+        switch (exclusionTemplate.complexity()) {
+            case ExclusionTemplateComplexity::Simplest:
+                exclude = fileName == exclusionTemplate.templ();
+                break;
+            case ExclusionTemplateComplexity::Simple: {
+                std::string literal = exclusionTemplate.templ();
+                const bool atBeginning = literal.front() == '*';
+                const bool atEnd = literal.back() == '*';
+                std::erase(literal, '*');
+                if (atBeginning && atEnd) {
+                    exclude = fileName.find(literal) != std::string::npos;
+                } else if (atBeginning) {
+                    exclude = CommonUtility::endsWith(fileName, literal);
+                } else {
+                    exclude = CommonUtility::startsWith(fileName, literal);
+                }
+                break;
+            }
+            case ExclusionTemplateComplexity::Complex:
+            default:
+                exclude = std::regex_match(fileName, regex);
+                break;
+        }
+        if (exclude) return &exclusionTemplate;
+    }
+    return nullptr;
+}
+
 void TestExclusionTemplateCache::setUp() {
     TestBase::start();
     // Create parmsDb
@@ -234,5 +270,77 @@ void TestExclusionTemplateCache::testaddRegexForAllNormalizationForms() {
     CPPUNIT_ASSERT_EQUAL(size_t(2), ExclusionTemplateCache::instance()->_regexPatterns.size());
 }
 
+void TestExclusionTemplateCache::testMatcherAgreesWithRegexes() {
+    // Add user templates with wildcards in the middle and characters that the wildcards do not match
+    const std::vector<ExclusionTemplate> userTemplates = {ExclusionTemplate("a*b*a"), ExclusionTemplate("*ab*ab*", true),
+                                                          ExclusionTemplate("x*\r*y"), ExclusionTemplate("*.bak*", true),
+                                                          ExclusionTemplate("~*~")};
+    CPPUNIT_ASSERT_EQUAL(ExitCode::Ok, ExclusionTemplateCache::instance()->update(false, userTemplates));
+
+    const auto &regexPatterns = ExclusionTemplateCache::instance()->_regexPatterns;
+    const auto &matcher = ExclusionTemplateCache::instance()->matcher();
+    CPPUNIT_ASSERT_EQUAL(regexPatterns.size(), matcher.exclusionTemplates().size());
+
+    const auto checkName = [&regexPatterns, &matcher](const std::string &fileName) {
+        const ExclusionTemplate *expected = matchWithRegexes(regexPatterns, fileName);
+        const ExclusionTemplate *actual = matcher.match(fileName);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(fileName, expected != nullptr, actual != nullptr);
+        if (expected) CPPUNIT_ASSERT_EQUAL_MESSAGE(fileName, expected->templ(), actual->templ());
+    };
+
+    for (const auto &fileName: rejectedFiles) checkName(fileName);
+    for (const auto &fileName: acceptedFiles) checkName(fileName);
+
+    // Build random names from pieces of the templates, so that many of them are close to being excluded
+    std::vector<std::string> pieces = {"a", "b", "x", "y", "~", ".", "_", "\r", "\n", "*", "tmp", "2024"};
+    for (const auto &[regex, exclusionTemplate]: regexPatterns) {
+        for (const auto &piece: Utility::splitStr(exclusionTemplate.templ(), '*')) {
+            if (!piece.empty()) pieces.push_back(piece);
+        }
+    }
+    pieces.push_back(SyncName2Str(testhelpers::makeNfcSyncName()));
+    pieces.push_back(SyncName2Str(testhelpers::makeNfdSyncName()));
+
+    std::mt19937 generator(42); // Fixed seed, so that a failure can be reproduced
+    std::uniform_int_distribution<size_t> pieceDistribution(0, pieces.size() - 1);
+    std::uniform_int_distribution<int> lengthDistribution(1, 6);
+    for (int i = 0; i < 20000; ++i) {
+        std::string fileName;
+        for (int length = lengthDistribution(generator); length > 0; --length) {
+            fileName += pieces[pieceDistribution(generator)];
+        }
+        checkName(fileName);
+    }
+}
+
+void TestExclusionTemplateCache::testConcurrentIsExcluded() {
+    const auto exclusionCacheUsr = ExclusionTemplateCache::instance()->exclusionTemplates(false);
+    std::atomic<bool> stop = false;
+    std::atomic<int> errors = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&stop, &errors]() {
+            while (!stop) {
+                // Default templates are excluded whatever the user templates are
+                if (!ExclusionTemplateCache::instance()->isExcluded("test.~test")) ++errors;
+                if (ExclusionTemplateCache::instance()->isExcluded("test.test~test")) ++errors;
+            }
+        });
+    }
+
+    bool updatesApplied = true;
+    for (int i = 0; i < 50; ++i) {
+        auto templates = exclusionCacheUsr;
+        templates.emplace_back("user_template_" + std::to_string(i) + "*");
+        updatesApplied &= ExclusionTemplateCache::instance()->update(false, templates) == ExitCode::Ok &&
+                          ExclusionTemplateCache::instance()->isExcluded("user_template_" + std::to_string(i) + ".txt");
+    }
+
+    stop = true;
+    for (auto &reader: readers) reader.join();
+    CPPUNIT_ASSERT(updatesApplied);
+    CPPUNIT_ASSERT_EQUAL(0, errors.load());
+}
 
 } // namespace KDC
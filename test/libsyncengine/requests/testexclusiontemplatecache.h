@@ -32,6 +32,8 @@ class TestExclusionTemplateCache : public CppUnit::TestFixture, public TestBase
         CPPUNIT_TEST(testRescueFolderIsExcluded);
         CPPUNIT_TEST(testNFCNFDExclusion);
         CPPUNIT_TEST(testaddRegexForAllNormalizationForms);
+        CPPUNIT_TEST(testMatcherAgreesWithRegexes);
+        CPPUNIT_TEST(testConcurrentIsExcluded);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -44,6 +46,8 @@ class TestExclusionTemplateCache : public CppUnit::TestFixture, public TestBase
         void testRescueFolderIsExcluded();
         void testNFCNFDExclusion();
         void testaddRegexForAllNormalizationForms();
+        void testMatcherAgreesWithRegexes();
+        void testConcurrentIsExcluded();
 
     private:
         LocalTemporaryDirectory _localTempDir{"TestExeclusionTemplateCache"};
@@ -97,4 +97,32 @@ void TestSyncNodeCache::testDeleteSyncNode() {
     CPPUNIT_ASSERT_EQUAL(size_t{0}, nodeIdSet.size());
 }
 
+void TestSyncNodeCache::testInsertAndDeleteSyncNodeByType() {
+    CPPUNIT_ASSERT_EQUAL(ExitCode::Ok, SyncNodeCache::instance()->initCache(1, _testObj));
+
+    // The same node ID in another list
+    CPPUNIT_ASSERT_EQUAL(ExitCode::Ok, SyncNodeCache::instance()->insertSyncNode(1, SyncNodeType::TmpRemoteBlacklist, "1"));
+    CPPUNIT_ASSERT_EQUAL(ExitCode::Ok, SyncNodeCache::instance()->insertSyncNode(1, SyncNodeType::TmpRemoteBlacklist, "3"));
+    CPPUNIT_ASSERT_EQUAL(ExitCode::Ok, SyncNodeCache::instance()->insertSyncNode(1, SyncNodeType::TmpRemoteBlacklist, "3"));
+    CPPUNIT_ASSERT(SyncNodeCache::instance()->contains(1, SyncNodeType::TmpRemoteBlacklist, "1"));
+    CPPUNIT_ASSERT(SyncNodeCache::instance()->contains(1, SyncNodeType::TmpRemoteBlacklist, "3"));
+
+    // Only the given list is changed
+    CPPUNIT_ASSERT_EQUAL(ExitCode::Ok, SyncNodeCache::instance()->deleteSyncNode(1, SyncNodeType::TmpRemoteBlacklist, "1"));
+    CPPUNIT_ASSERT(!SyncNodeCache::instance()->contains(1, SyncNodeType::TmpRemoteBlacklist, "1"));
+    CPPUNIT_ASSERT(SyncNodeCache::instance()->contains(1, SyncNodeType::BlackList, "1"));
+    CPPUNIT_ASSERT_EQUAL(ExitCode::Ok,
+                         SyncNodeCache::instance()->deleteSyncNode(1, SyncNodeType::TmpRemoteBlacklist, "non-existing-sync-node-id"));
+
+    // The DB is kept in sync with the cache
+    NodeSet nodeIdSet;
+    CPPUNIT_ASSERT(_testObj->selectAllSyncNodes(SyncNodeType::TmpRemoteBlacklist, nodeIdSet));
+    CPPUNIT_ASSERT_EQUAL(size_t{1}, nodeIdSet.size());
+    CPPUNIT_ASSERT(nodeIdSet.contains("3"));
+
+    nodeIdSet.clear();
+    CPPUNIT_ASSERT(_testObj->selectAllSyncNodes(SyncNodeType::BlackList, nodeIdSet));
+    CPPUNIT_ASSERT_EQUAL(size_t{2}, nodeIdSet.size());
+}
+
 } // namespace KDC
@@ -27,6 +27,7 @@ class TestSyncNodeCache : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST_SUITE(TestSyncNodeCache);
         CPPUNIT_TEST(testContainsSyncNode);
         CPPUNIT_TEST(testDeleteSyncNode);
+        CPPUNIT_TEST(testInsertAndDeleteSyncNodeByType);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -36,6 +37,7 @@ class TestSyncNodeCache : public CppUnit::TestFixture, public TestBase {
     protected:
         void testContainsSyncNode();
         void testDeleteSyncNode();
+        void testInsertAndDeleteSyncNodeByType();
 
     private:
         std::shared_ptr<SyncDb> _testObj;
@@ -30,6 +30,7 @@
 #include "test_utility/testhelpers.h"
 
 #include <cstdlib>
+#include <random>
 
 using namespace CppUnit;
 
@@ -197,9 +198,143 @@ void TestSyncPal::testSyncFileItem() {
     CPPUNIT_ASSERT_EQUAL(static_cast<int64_t>(1), _syncPal->_progressInfo->totalFiles());
 }
 
+void TestSyncPal::testProgressInfoCompletedSize() {
+    const auto progressInfo = std::make_shared<ProgressInfo>(_syncPal);
+
+    // Items of every kind, some of them with names in NFD and the last one sharing the path of the first one
+    const std::vector<SyncFileInstruction> instructions = {SyncFileInstruction::Put,    SyncFileInstruction::Get,
+                                                           SyncFileInstruction::Update, SyncFileInstruction::Move,
+                                                           SyncFileInstruction::Remove, SyncFileInstruction::Ignore};
+    constexpr int itemCount = 200;
+    std::vector<SyncPath> nfcPaths;
+    std::vector<SyncPath> nfdPaths;
+    for (int i = 0; i < itemCount; ++i) {
+        const SyncName suffix = Str2SyncName(std::to_string(i == itemCount - 1 ? 0 : i));
+        nfcPaths.emplace_back(SyncPath(Str("dir")) / (testhelpers::makeNfcSyncName() + suffix));
+        nfdPaths.emplace_back(SyncPath(Str("dir")) / (testhelpers::makeNfdSyncName() + suffix));
+
+        SyncFileItem item;
+        item.setType(i % 10 == 0 ? NodeType::Directory : NodeType::File);
+        item.setPath(i % 2 == 0 ? nfcPaths.back() : nfdPaths.back());
+        item.setInstruction(instructions[static_cast<size_t>(i) % instructions.size()]);
+        item.setSize(1000 + i);
+        item.setDehydrated(i % 7 == 0);
+        CPPUNIT_ASSERT(progressInfo->initProgress(item));
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<int64_t>(itemCount), progressInfo->totalFiles());
+
+    std::mt19937 generator(1234); // Fixed seed, so that a failure can be reproduced
+    std::uniform_int_distribution<int> itemDistribution(0, itemCount - 1);
+    std::uniform_int_distribution<int> progressDistribution(0, 100);
+    for (int i = 0; i < 5000; ++i) {
+        const int itemIndex = itemDistribution(generator);
+        const SyncPath &path = i % 2 == 0 ? nfcPaths[static_cast<size_t>(itemIndex)] : nfdPaths[static_cast<size_t>(itemIndex)];
+        if (i % 5 == 0) {
+            CPPUNIT_ASSERT(progressInfo->setProgressComplete(path, SyncFileStatus::Success));
+        } else {
+            CPPUNIT_ASSERT(progressInfo->setProgress(path, progressDistribution(generator)));
+        }
+        CPPUNIT_ASSERT_EQUAL(progressInfo->computeCompletedSize(), progressInfo->completedSize());
+    }
+
+    for (int i = 0; i < itemCount; ++i) {
+        CPPUNIT_ASSERT(progressInfo->setProgressComplete(nfcPaths[static_cast<size_t>(i)], SyncFileStatus::Success));
+        CPPUNIT_ASSERT_EQUAL(progressInfo->computeCompletedSize(), progressInfo->completedSize());
+    }
+    // Ignored items are never completed
+    for (const auto &[path, progressItems]: progressInfo->_currentItems) {
+        CPPUNIT_ASSERT_EQUAL(SyncFileInstruction::Ignore, progressItems.front().item().instruction());
+    }
+}
+
+void TestSyncPal::testProgressInfoCompletedItemsBatches() {
+    std::vector<SyncFileItem> notifiedItems;
+    _syncPal->setAddCompletedItemCallback(
+            [&notifiedItems](int, const SyncFileItem &item, bool) { notifiedItems.push_back(item); });
+
+    const auto progressInfo = std::make_shared<ProgressInfo>(_syncPal);
+    progressInfo->_completedItemsFlushDelay = std::chrono::hours(1); // Flush explicitly only
+
+    const SyncPath pathA = "a.txt";
+    const SyncPath pathB = "b.txt";
+    for (const auto &path: {pathA, pathB}) {
+        SyncFileItem item;
+        item.setType(NodeType::File);
+        item.setPath(path);
+        item.setInstruction(SyncFileInstruction::Put);
+        item.setSize(100);
+        CPPUNIT_ASSERT(progressInfo->initProgress(item));
+    }
+
+    CPPUNIT_ASSERT(progressInfo->setProgress(pathA, 10));
+    CPPUNIT_ASSERT(progressInfo->setProgress(pathA, 50));
+    CPPUNIT_ASSERT(progressInfo->setProgress(pathB, 20));
+    CPPUNIT_ASSERT(progressInfo->setProgressComplete(pathA, SyncFileStatus::Success));
+    CPPUNIT_ASSERT(progressInfo->setProgress(pathB, 70));
+    CPPUNIT_ASSERT(notifiedItems.empty());
+
+    // Only the last state of each item is sent, in the order of their first notification
+    progressInfo->flushCompletedItems();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), notifiedItems.size());
+    CPPUNIT_ASSERT_EQUAL(pathA, notifiedItems[0].path());
+    CPPUNIT_ASSERT_EQUAL(SyncFileStatus::Success, notifiedItems[0].status());
+    CPPUNIT_ASSERT_EQUAL(100, notifiedItems[0].progress());
+    CPPUNIT_ASSERT_EQUAL(pathB, notifiedItems[1].path());
+    CPPUNIT_ASSERT_EQUAL(SyncFileStatus::Syncing, notifiedItems[1].status());
+    CPPUNIT_ASSERT_EQUAL(70, notifiedItems[1].progress());
+
+    CPPUNIT_ASSERT(progressInfo->setProgressComplete(pathB, SyncFileStatus::Error));
+    progressInfo->flushCompletedItems();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), notifiedItems.size());
+    CPPUNIT_ASSERT_EQUAL(SyncFileStatus::Error, notifiedItems[2].status());
+
+    // Without delay, every notification is sent right away
+    progressInfo->_completedItemsFlushDelay = std::chrono::milliseconds(0);
+    SyncFileItem item;
+    item.setType(NodeType::File);
+    item.setPath("c.txt");
+    item.setInstruction(SyncFileInstruction::Get);
+    item.setSize(100);
+    CPPUNIT_ASSERT(progressInfo->initProgress(item));
+    CPPUNIT_ASSERT(progressInfo->setProgress("c.txt", 10));
+    CPPUNIT_ASSERT_EQUAL(size_t(4), notifiedItems.size());
+
+    _syncPal->setAddCompletedItemCallback(nullptr);
+}
+
 void TestSyncPal::testCheckIfExistsOnServer() {
-    // bool exists = false;
-    //  CPPUNIT_ASSERT(!_syncPal->checkIfExistsOnServer(SyncPath("dummy"), exists));
+    auto &remoteSnapshot = _syncPal->_remoteFSObserverWorker->_liveSnapshot;
+    const NodeId remoteRootId = _syncPal->syncDb()->rootNode().nodeIdRemote().value();
+    (void) remoteSnapshot.updateItem(SnapshotItem("ra", remoteRootId, Str("A"), testhelpers::defaultTime,
+                                                  testhelpers::defaultTime, NodeType::Directory, 0, false, true, true));
+    (void) remoteSnapshot.updateItem(SnapshotItem("raa", "ra", Str("AA"), testhelpers::defaultTime, testhelpers::defaultTime,
+                                                  NodeType::File, 123, false, true, true));
+
+    const SyncPath pathA("A");
+    const SyncPath pathAA = pathA / "AA";
+    const SyncPath pathAB = pathA / "AB";
+
+    bool exists = false;
+    CPPUNIT_ASSERT(_syncPal->checkIfExistsOnServer(pathAA, exists));
+    CPPUNIT_ASSERT(exists);
+    CPPUNIT_ASSERT(_syncPal->checkIfExistsOnServer(pathAB, exists));
+    CPPUNIT_ASSERT(!exists);
+
+    // The answers follow the changes of the remote snapshot
+    (void) remoteSnapshot.updateItem(SnapshotItem("rab", "ra", Str("AB"), testhelpers::defaultTime, testhelpers::defaultTime,
+                                                  NodeType::File, 123, false, true, true));
+    CPPUNIT_ASSERT(_syncPal->checkIfExistsOnServer(pathAB, exists));
+    CPPUNIT_ASSERT(exists);
+
+    (void) remoteSnapshot.removeItem("raa");
+    CPPUNIT_ASSERT(_syncPal->checkIfExistsOnServer(pathAA, exists));
+    CPPUNIT_ASSERT(!exists);
+
+    CPPUNIT_ASSERT(_syncPal->checkIfExistsOnServer(pathA, exists));
+    CPPUNIT_ASSERT(exists);
+    remoteSnapshot.init();
+    CPPUNIT_ASSERT(_syncPal->checkIfExistsOnServer(pathA, exists));
+    CPPUNIT_ASSERT(!exists);
 }
 
 void TestSyncPal::testBlacklist() {
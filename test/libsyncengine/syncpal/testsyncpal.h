@@ -32,6 +32,8 @@ class TestSyncPal : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST(testCopySnapshots);
         CPPUNIT_TEST(testOperationSet);
         CPPUNIT_TEST(testSyncFileItem);
+        CPPUNIT_TEST(testProgressInfoCompletedSize);
+        CPPUNIT_TEST(testProgressInfoCompletedItemsBatches);
         CPPUNIT_TEST(testCheckIfExistsOnServer);
         CPPUNIT_TEST(testBlacklist);
         CPPUNIT_TEST(testWipeVirtualFiles);
@@ -56,6 +58,8 @@ class TestSyncPal : public CppUnit::TestFixture, public TestBase {
         void testOperationSet();
         void testCopySnapshots();
         void testSyncFileItem();
+        void testProgressInfoCompletedSize();
+        void testProgressInfoCompletedItemsBatches();
         void testCheckIfExistsOnServer();
         void testBlacklist();
         void testWipeVirtualFiles();
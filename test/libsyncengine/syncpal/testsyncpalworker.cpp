@@ -31,9 +31,11 @@
 
 #include "test_utility/testhelpers.h"
 #include "test_utility/timeouthelper.h"
+#include "utility/timerutility.h"
 
 #include <cstdlib>
 #include <atomic>
+#include <fstream>
 
 
 using namespace CppUnit;
@@ -340,6 +342,50 @@ void TestSyncPalWorker::testInternalPause3() {
     CPPUNIT_ASSERT(!mockLfso->liveSnapshot().updated());
 }
 
+void TestSyncPalWorker::testLocalChangeLatency() {
+    setUpTestInternalPause(std::chrono::seconds(1));
+
+    // Constants
+    constexpr auto testTimeout = std::chrono::seconds(20);
+    constexpr auto loopWait = std::chrono::milliseconds(5);
+    // The local observer waits 1s without changes before letting a sync start
+    constexpr auto maxLatency = std::chrono::milliseconds(2000);
+    const auto mockSyncPal = std::dynamic_pointer_cast<MockSyncPal>(_syncPal);
+    const auto mockExecutorWorker = mockSyncPal->getMockExecutorWorker();
+
+    // The executor would queue the upload job
+    std::atomic_bool uploadQueued = false;
+    mockExecutorWorker->setMockExecuteCallback([&uploadQueued]() -> ExitInfo {
+        uploadQueued = true;
+        return ExitCode::Ok;
+    });
+
+    const TimerUtility timer;
+    {
+        std::ofstream ofs(_localPath / "testLocalChangeLatency.txt");
+        ofs << "Some content";
+    }
+    CPPUNIT_ASSERT(TimeoutHelper::waitFor([&uploadQueued]() { return uploadQueued.load(); }, testTimeout, loopWait));
+    const auto latency = timer.elapsed<std::chrono::milliseconds>();
+    CPPUNIT_ASSERT_MESSAGE("Latency: " + std::to_string(latency.count()) + "ms", latency < maxLatency);
+
+    CPPUNIT_ASSERT(TimeoutHelper::waitFor([this]() { return _syncPal->step() == SyncStep::Idle; }, testTimeout, loopWait));
+}
+
+void TestSyncPalWorker::testIdleWakeUps() {
+    setUpTestInternalPause(std::chrono::seconds(1));
+
+    const auto syncpalWorker = std::dynamic_pointer_cast<MockSyncPal>(_syncPal)->getSyncPalWorker();
+    CPPUNIT_ASSERT_EQUAL(SyncStep::Idle, syncpalWorker->step());
+
+    // With a 100ms tick, the sync loop would run about 30 times
+    const uint64_t initialWakeUpCount = syncpalWorker->_wakeUpCount;
+    Utility::msleep(3000);
+    const uint64_t wakeUpCount = syncpalWorker->_wakeUpCount - initialWakeUpCount;
+    CPPUNIT_ASSERT_MESSAGE("Wake-ups: " + std::to_string(wakeUpCount), wakeUpCount <= 6);
+    CPPUNIT_ASSERT_EQUAL(SyncStep::Idle, syncpalWorker->step());
+}
+
 // Mocks
 std::shared_ptr<TestSyncPalWorker::MockLFSO> TestSyncPalWorker::MockSyncPal::getMockLFSOWorker() {
     return std::dynamic_pointer_cast<MockLFSO>(_localFSObserverWorker);
@@ -48,6 +48,8 @@ class TestSyncPalWorker : public CppUnit::TestFixture {
         CPPUNIT_TEST(testInternalPause1);
         CPPUNIT_TEST(testInternalPause2);
         CPPUNIT_TEST(testInternalPause3);
+        CPPUNIT_TEST(testLocalChangeLatency);
+        CPPUNIT_TEST(testIdleWakeUps);
         CPPUNIT_TEST(testHandleBackError);
         CPPUNIT_TEST(testEnsureBlackListIsPropagatedIgnoresMissingNode);
         CPPUNIT_TEST(testEnsureBlackListIsPropagated);
@@ -84,6 +86,15 @@ class TestSyncPalWorker : public CppUnit::TestFixture {
          */
         void testInternalPause3();
 
+        /* This test ensures that a local change reaches the propagation step right after the local observer has stopped
+         * waiting for further changes, without paying a delay at each step transition.
+         */
+        void testLocalChangeLatency();
+
+        /* This test ensures that an idle synchronization is not woken up periodically when nothing happens.
+         */
+        void testIdleWakeUps();
+
         /* This test verifies that consecutive BackError exits produce an exponentially increasing pause duration (capped at
          * maxDelay), and that the counter resets when the sync reaches the Idle step.
          */
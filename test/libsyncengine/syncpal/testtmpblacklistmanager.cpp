@@ -0,0 +1,240 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testtmpblacklistmanager.h"
+
+#include "db/parmsdb.h"
+#include "keychainmanager/keychainmanager.h"
+#include "network/proxy.h"
+#include "requests/syncnodecache.h"
+#include "syncpal/pathtrie.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <version.h>
+
+#include <algorithm>
+
+namespace KDC {
+
+void TestTmpBlacklistManager::setUp() {
+    TestBase::start();
+
+    ApiToken apiToken;
+    apiToken.setAccessToken("testToken");
+
+    const std::string keychainKey("123");
+    (void) KeyChainManager::instance(true);
+    (void) KeyChainManager::instance()->writeToken(keychainKey, apiToken.reconstructJsonString());
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, keychainKey);
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    (void) Proxy::instance(ProxyConfig());
+
+    Sync sync(1, drive.dbId(), _localTempDir.path(), "", "TestTmpBlacklistManager");
+    sync.setDbPath(MockDb::makeDbName(1, 1, 1, 1));
+    (void) ParmsDb::instance()->insertSync(sync);
+
+    _syncPal = std::make_shared<SyncPalTest>(sync.dbId(), KDRIVE_VERSION_STRING);
+    _syncPal->syncDb()->setAutoDelete(true);
+    _syncPal->createSharedObjects();
+    _syncPal->createWorkers();
+    _manager = std::make_unique<TmpBlacklistManager>(_syncPal);
+}
+
+void TestTmpBlacklistManager::tearDown() {
+    _manager.reset();
+    if (_syncPal && _syncPal->syncDb()) {
+        _syncPal->syncDb()->close();
+    }
+    _syncPal.reset();
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    TestBase::stop();
+}
+
+bool TestTmpBlacklistManager::isInSyncNodeCache(const NodeId &nodeId, const ReplicaSide side) const {
+    const auto type = side == ReplicaSide::Local ? SyncNodeType::TmpLocalBlacklist : SyncNodeType::TmpRemoteBlacklist;
+    return SyncNodeCache::instance()->contains(_syncPal->syncDbId(), type, nodeId);
+}
+
+void TestTmpBlacklistManager::age(const NodeId &nodeId, const ReplicaSide side, const std::chrono::seconds duration) {
+    auto &errors = side == ReplicaSide::Local ? _manager->_localErrors : _manager->_remoteErrors;
+    CPPUNIT_ASSERT(errors.contains(nodeId));
+    errors.at(nodeId).lastErrorTime -= duration;
+}
+
+void TestTmpBlacklistManager::testPathTrie() {
+    PathTrie trie;
+    CPPUNIT_ASSERT(trie.empty());
+    CPPUNIT_ASSERT(!trie.containsAncestorOrEqual("A"));
+
+    trie.insert("A/AA", "1");
+    trie.insert("A/AA/AAA", "2");
+    trie.insert("A/AB", "3");
+    trie.insert("AB", "4");
+    trie.insert("A/AA", "5"); // Several node IDs can share a path
+    CPPUNIT_ASSERT_EQUAL(size_t{5}, trie.size());
+
+    CPPUNIT_ASSERT(trie.containsAncestorOrEqual("A/AA"));
+    CPPUNIT_ASSERT(trie.containsAncestorOrEqual("A/AA/AAB/AABA"));
+    CPPUNIT_ASSERT(!trie.containsAncestorOrEqual("A"));
+    CPPUNIT_ASSERT(!trie.containsAncestorOrEqual("A/A"));
+    CPPUNIT_ASSERT(!trie.containsAncestorOrEqual("A/AAA"));
+    CPPUNIT_ASSERT(!trie.containsAncestorOrEqual("B"));
+
+    // Descendants are returned the shallowest first, and items sharing a name prefix are not descendants
+    const auto descendants = trie.descendantsOrEqual("A");
+    CPPUNIT_ASSERT_EQUAL(size_t{4}, descendants.size());
+    CPPUNIT_ASSERT_EQUAL(NodeId("2"), descendants.back());
+    CPPUNIT_ASSERT(std::ranges::find(descendants, "4") == descendants.end());
+    CPPUNIT_ASSERT(trie.descendantsOrEqual("A/AC").empty());
+    CPPUNIT_ASSERT_EQUAL(size_t{5}, trie.descendantsOrEqual(SyncPath()).size());
+    CPPUNIT_ASSERT(trie.firstDescendantOrEqual("A/AA/AAA") == std::optional<NodeId>("2"));
+    CPPUNIT_ASSERT(!trie.firstDescendantOrEqual("A/AC"));
+
+    CPPUNIT_ASSERT(!trie.erase("A/AB", "1"));
+    CPPUNIT_ASSERT(trie.erase("A/AA", "1"));
+    CPPUNIT_ASSERT(trie.containsAncestorOrEqual("A/AA"));
+    CPPUNIT_ASSERT(trie.erase("A/AA", "5"));
+    CPPUNIT_ASSERT(!trie.containsAncestorOrEqual("A/AA"));
+    CPPUNIT_ASSERT(trie.containsAncestorOrEqual("A/AA/AAA"));
+    CPPUNIT_ASSERT_EQUAL(size_t{3}, trie.size());
+
+    trie.clear();
+    CPPUNIT_ASSERT(trie.empty());
+    CPPUNIT_ASSERT(!trie.containsAncestorOrEqual("A/AA/AAA"));
+}
+
+void TestTmpBlacklistManager::testRetryCount() {
+    // The first error is only recorded, the item is not blacklisted yet
+    _manager->increaseErrorCount("l1", NodeType::File, "A/AA", ReplicaSide::Local);
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l1", ReplicaSide::Local));
+    CPPUNIT_ASSERT(_manager->isTmpBlacklisted("A/AA", ReplicaSide::Local));
+    CPPUNIT_ASSERT(_manager->isTmpBlacklisted("A/AA/AAA", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("A", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("A/AAB", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("A/AA", ReplicaSide::Remote));
+
+    // The second one blacklists it
+    _manager->increaseErrorCount("l1", NodeType::File, "A/AA", ReplicaSide::Local);
+    CPPUNIT_ASSERT(isInSyncNodeCache("l1", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l1", ReplicaSide::Remote));
+    CPPUNIT_ASSERT(_manager->isTmpBlacklisted("A/AA", ReplicaSide::Local));
+
+    // Another item does not inherit the error count
+    _manager->increaseErrorCount("l2", NodeType::File, "A/AB", ReplicaSide::Local);
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l2", ReplicaSide::Local));
+}
+
+void TestTmpBlacklistManager::testExpiry() {
+    using namespace std::chrono_literals;
+    _manager->blacklistItem("l1", "A", ReplicaSide::Local);
+    _manager->blacklistItem("l2", "B", ReplicaSide::Local);
+    _manager->blacklistItem("r1", "A", ReplicaSide::Remote);
+    CPPUNIT_ASSERT(isInSyncNodeCache("l1", ReplicaSide::Local));
+
+    age("l1", ReplicaSide::Local, 2h);
+    age("l2", ReplicaSide::Local, 30min);
+    _manager->refreshBlacklist();
+
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l1", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("A/AA", ReplicaSide::Local));
+    CPPUNIT_ASSERT(isInSyncNodeCache("l2", ReplicaSide::Local));
+    CPPUNIT_ASSERT(_manager->isTmpBlacklisted("B", ReplicaSide::Local));
+    CPPUNIT_ASSERT(isInSyncNodeCache("r1", ReplicaSide::Remote));
+    CPPUNIT_ASSERT(_manager->isTmpBlacklisted("A/AA", ReplicaSide::Remote));
+
+    // A new error resets the timer
+    age("l2", ReplicaSide::Local, 50min);
+    _manager->increaseErrorCount("l2", NodeType::File, "B", ReplicaSide::Local);
+    age("l2", ReplicaSide::Local, 50min);
+    _manager->refreshBlacklist();
+    CPPUNIT_ASSERT(isInSyncNodeCache("l2", ReplicaSide::Local));
+
+    // An expired error is forgotten, so the next error is a first one again
+    age("l2", ReplicaSide::Local, 2h);
+    _manager->refreshBlacklist();
+    _manager->increaseErrorCount("l2", NodeType::File, "B", ReplicaSide::Local);
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l2", ReplicaSide::Local));
+}
+
+void TestTmpBlacklistManager::testBlacklistItemRemovesDescendants() {
+    _manager->blacklistItem("l2", "A/AA/AAA", ReplicaSide::Local);
+    _manager->blacklistItem("l3", "A/AB", ReplicaSide::Local);
+    _manager->blacklistItem("l4", "AB", ReplicaSide::Local);
+    _manager->blacklistItem("r2", "A/AB", ReplicaSide::Remote);
+
+    // Blacklisting an ancestor replaces the entries of its descendants on the same side
+    _manager->blacklistItem("l1", "A", ReplicaSide::Local);
+    CPPUNIT_ASSERT(isInSyncNodeCache("l1", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l2", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l3", ReplicaSide::Local));
+    CPPUNIT_ASSERT(isInSyncNodeCache("l4", ReplicaSide::Local));
+    CPPUNIT_ASSERT(isInSyncNodeCache("r2", ReplicaSide::Remote));
+    CPPUNIT_ASSERT_EQUAL(size_t{2}, _manager->_localErrors.size());
+    CPPUNIT_ASSERT_EQUAL(size_t{2}, _manager->_localErrorPaths.size());
+}
+
+void TestTmpBlacklistManager::testRemoveItem() {
+    _manager->blacklistItem("l1", "A/AA", ReplicaSide::Local);
+    _manager->blacklistItem("r1", "A/AA", ReplicaSide::Remote);
+    _manager->blacklistItem("l2", "AB", ReplicaSide::Local);
+
+    // Removing by node ID removes the item from both sides
+    _manager->removeItemFromTmpBlacklist("r1", ReplicaSide::Remote);
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l1", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!isInSyncNodeCache("r1", ReplicaSide::Remote));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("A/AA", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("A/AA", ReplicaSide::Remote));
+    CPPUNIT_ASSERT(isInSyncNodeCache("l2", ReplicaSide::Local));
+
+    // Removing an ancestor path removes the item blacklisted below it
+    _manager->blacklistItem("l3", "C/CA", ReplicaSide::Local);
+    _manager->removeItemFromTmpBlacklist(SyncPath("C"));
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l3", ReplicaSide::Local));
+    CPPUNIT_ASSERT(_manager->_localErrorPaths.descendantsOrEqual("C").empty());
+
+    // Unknown items are ignored
+    _manager->removeItemFromTmpBlacklist("unknown", ReplicaSide::Local);
+    _manager->removeItemFromTmpBlacklist(SyncPath("D"));
+    CPPUNIT_ASSERT_EQUAL(size_t{1}, _manager->_localErrors.size());
+}
+
+void TestTmpBlacklistManager::testClear() {
+    _manager->blacklistItem("l1", "A", ReplicaSide::Local);
+    _manager->blacklistItem("r1", "B", ReplicaSide::Remote);
+    _manager->increaseErrorCount("l2", NodeType::File, "C", ReplicaSide::Local);
+
+    _manager->clear();
+    CPPUNIT_ASSERT(!isInSyncNodeCache("l1", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!isInSyncNodeCache("r1", ReplicaSide::Remote));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("A", ReplicaSide::Local));
+    CPPUNIT_ASSERT(!_manager->isTmpBlacklisted("C", ReplicaSide::Local));
+    CPPUNIT_ASSERT(_manager->_localErrorPaths.empty());
+    CPPUNIT_ASSERT(_manager->_remoteErrorPaths.empty());
+}
+
+} // namespace KDC
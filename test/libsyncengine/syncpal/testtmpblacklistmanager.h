@@ -0,0 +1,62 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#include "testincludes.h"
+#include "test_classes/syncpaltest.h"
+#include "test_utility/localtemporarydirectory.h"
+
+#include "syncpal/tmpblacklistmanager.h"
+
+using namespace CppUnit;
+
+namespace KDC {
+
+class TestTmpBlacklistManager final : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestTmpBlacklistManager);
+        CPPUNIT_TEST(testPathTrie);
+        CPPUNIT_TEST(testRetryCount);
+        CPPUNIT_TEST(testExpiry);
+        CPPUNIT_TEST(testBlacklistItemRemovesDescendants);
+        CPPUNIT_TEST(testRemoveItem);
+        CPPUNIT_TEST(testClear);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    protected:
+        void testPathTrie();
+        void testRetryCount();
+        void testExpiry();
+        void testBlacklistItemRemovesDescendants();
+        void testRemoveItem();
+        void testClear();
+
+    private:
+        bool isInSyncNodeCache(const NodeId &nodeId, ReplicaSide side) const;
+        // Moves the last error time of an item back in time
+        void age(const NodeId &nodeId, ReplicaSide side, std::chrono::seconds duration);
+
+        std::shared_ptr<SyncPalTest> _syncPal;
+        std::unique_ptr<TmpBlacklistManager> _manager;
+        LocalTemporaryDirectory _localTempDir{"TestTmpBlacklistManager"};
+};
+
+} // namespace KDC
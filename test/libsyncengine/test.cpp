@@ -18,16 +18,37 @@
 
 #include "testincludes.h"
 #include "benchmark/benchmarkparalleljobs.h"
+#include "benchmark/benchmarkjobmanager.h"
+#include "benchmark/benchmarkchecksumcache.h"
+#include "benchmark/benchmarksnapshotfreeze.h"
+#include "benchmark/benchmarksnapshotlookup.h"
+#include "benchmark/benchmarksyncdbcache.h"
+#include "benchmark/benchmarksyncdbbatching.h"
+#include "benchmark/benchmarksynccycles.h"
+#include "benchmark/benchmarkoperationsorter.h"
+#include "benchmark/benchmarkoperationscheduler.h"
+#include "benchmark/benchmarklocalexploration.h"
+#include "benchmark/benchmarkexclusiontemplatecache.h"
+#include "benchmark/benchmarkprogressinfo.h"
+#include "benchmark/benchmarksnapshotfile.h"
+#include "benchmark/benchmarkcsvlisting.h"
+#include "benchmark/benchmarkdownload.h"
+#include "benchmark/benchmarkfreediskspace.h"
+#include "benchmark/benchmarktmpblacklist.h"
+#include "benchmark/benchmarkfilehasher.h"
 #include "db/testsyncdb.h"
 #include "syncpal/testsyncpal.h"
 #include "syncpal/testsyncpalworker.h"
 #include "syncpal/testoperationprocessor.h"
+#include "syncpal/testtmpblacklistmanager.h"
 #include "update_detection/file_system_observer/testfsoperation.h"
 #include "update_detection/file_system_observer/testfsoperationset.h"
 #include "update_detection/file_system_observer/testremotefilesystemobserverworker.h"
 #include "update_detection/file_system_observer/testlocalfilesystemobserverworker.h"
 #include "update_detection/file_system_observer/testsnapshot.h"
+#include "update_detection/file_system_observer/testsnapshotfile.h"
 #include "update_detection/file_system_observer/testcomputefsoperationworker.h"
+#include "update_detection/file_system_observer/checksum/testcomputechecksumjob.h"
 #include "update_detection/update_detector/testupdatetree.h"
 #include "update_detection/update_detector/testnode.h"
 #include "update_detection/update_detector/testupdatetreeworker.h"
@@ -40,14 +61,18 @@
 #include "integration/testintegration.h"
 #include "propagation/executor/testexecutorworker.h"
 #include "jobs/network/testnetworkjobs.h"
+#include "jobs/network/testhttpsessionpool.h"
 #include "jobs/network/kDrive_API/testapitranslator.h"
 #include "jobs/network/kDrive_API/testloguploadjob.h"
 #include "jobs/network/kDrive_API/testsearchjob.h"
+#include "jobs/network/kDrive_API/testchunkbufferpool.h"
+#include "jobs/network/kDrive_API/testuploadfilestream.h"
 #include "jobs/network/testsnapshotitemhandler.h"
 #include "jobs/local/testlocaljobs.h"
 #include "jobs/testabstractjob.h"
 #include "jobs/testsyncjobmanagersingleton.h"
 #include "propagation/executor/testfilerescuer.h"
+#include "propagation/executor/testoperationscheduler.h"
 #include "requests/testexclusiontemplatecache.h"
 #include "requests/testsyncnodecache.h"
 
@@ -63,9 +88,12 @@ namespace KDC {
 CPPUNIT_TEST_SUITE_REGISTRATION(TestOperationProcessor);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestExclusionTemplateCache);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestNetworkJobs);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestHttpSessionPool);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestApiTranslator);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestLogUploadJob);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSearchJob);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestChunkBufferPool);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestUploadFileStream);
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSyncDb);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSyncNodeCache);
@@ -74,6 +102,7 @@ CPPUNIT_TEST_SUITE_REGISTRATION(TestLocalJobs);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestAbstractJob);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSyncJobManagerSingleton);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSnapshot);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSnapshotFile);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFsOperation);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFsOperationSet);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestLocalFileSystemObserverWorker);
@@ -85,6 +114,7 @@ CPPUNIT_TEST_SUITE_REGISTRATION(TestFolderWatcherLinux);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSnapshotItemHandler);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestRemoteFileSystemObserverWorker);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestComputeFSOperationWorker);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestComputeChecksumJob);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestNode);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestUpdateTree);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestUpdateTreeWorker);
@@ -97,10 +127,30 @@ CPPUNIT_TEST_SUITE_REGISTRATION(TestOperationGeneratorWorker);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestOperationSorterWorker);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestExecutorWorker);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFileRescuer);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestOperationScheduler);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSyncPal);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSyncPalWorker);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTmpBlacklistManager);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestIntegration);
 // CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkParallelJobs);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkJobManager);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkChecksumCache);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkSnapshotFreeze);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkSnapshotLookup);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkSyncDbCache);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkSyncDbBatching);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkSyncCycles);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkOperationSorter);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkOperationScheduler);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkLocalExploration);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkExclusionTemplateCache);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkProgressInfo);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkSnapshotFile);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkCsvListing);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkDownload);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkFreeDiskSpace);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkTmpBlacklist);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkFileHasher);
 } // namespace KDC
 
 int main(int, char **) {
@@ -0,0 +1,193 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testcomputechecksumjob.h"
+
+#include "update_detection/file_system_observer/checksum/computechecksumjob.h"
+#include "libcommonserver/io/iohelper.h"
+#include "libcommonserver/utility/utility.h"
+#include "test_utility/testhelpers.h"
+
+#include <version.h>
+#include <mocks/libcommonserver/db/mockdb.h>
+
+#include <xxhash.h>
+
+#include <fstream>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+std::string expectedChecksum(const std::string &content) {
+    return Utility::xxHashToStr(XXH3_64bits(content.data(), content.size()));
+}
+
+void writeFile(const SyncPath &path, const std::string &content) {
+    std::ofstream ofs(path, std::ios_base::binary | std::ios_base::trunc);
+    ofs << content;
+}
+
+FileStat getFileStat(const SyncPath &path) {
+    FileStat fileStat;
+    bool exists = false;
+    IoHelper::getFileStat(path, &fileStat, exists, IoHelper::PathCheckOption::Insensitive);
+    CPPUNIT_ASSERT(exists);
+    return fileStat;
+}
+
+// Timestamps have a one second resolution: a checksum is only cached once the status of the file is older than the
+// current second.
+void waitForNextSecond() {
+    Utility::msleep(1100);
+}
+
+} // namespace
+
+void TestComputeChecksumJob::setUp() {
+    TestBase::start();
+
+    bool alreadyExists = false;
+    const std::filesystem::path syncDbPath = MockDb::makeDbName(alreadyExists);
+    _syncDb = std::make_shared<SyncDb>(syncDbPath.string());
+    (void) _syncDb->init(KDRIVE_VERSION_STRING);
+    _syncDb->setAutoDelete(true);
+
+    const DbNode dummyRootNode(0, std::nullopt, SyncName(), SyncName(), "1", "1", std::nullopt, std::nullopt, std::nullopt,
+                               NodeType::Directory, 0, std::nullopt);
+    _liveSnapshot = std::make_shared<LiveSnapshot>(ReplicaSide::Local, dummyRootNode);
+}
+
+void TestComputeChecksumJob::tearDown() {
+    _liveSnapshot.reset();
+    if (_syncDb) {
+        _syncDb->close();
+        _syncDb.reset();
+    }
+    TestBase::stop();
+}
+
+NodeId TestComputeChecksumJob::createFile(const SyncPath &path, const std::string &content) {
+    writeFile(path, content);
+    const auto fileStat = getFileStat(path);
+    const NodeId nodeId = std::to_string(fileStat.inode);
+    const SnapshotItem item(nodeId, "1", path.filename().native(), fileStat.creationTime, fileStat.modificationTime,
+                            NodeType::File, fileStat.size, false, true, true);
+    CPPUNIT_ASSERT(_liveSnapshot->updateItem(item));
+    waitForNextSecond();
+    return nodeId;
+}
+
+std::string TestComputeChecksumJob::computeChecksum(const NodeId &nodeId, const SyncPath &path, bool withCache /*= true*/) {
+    (void) _liveSnapshot->clearContentChecksum(nodeId);
+    ComputeChecksumJob job(nodeId, path, _liveSnapshot, withCache ? _syncDb : nullptr);
+    CPPUNIT_ASSERT_EQUAL(ExitInfo(ExitCode::Ok), job.runSynchronously());
+    return _liveSnapshot->contentChecksum(nodeId);
+}
+
+void TestComputeChecksumJob::testChecksumWithoutCache() {
+    const SyncPath path = _localTempDir.path() / "file.txt";
+    const std::string content = "Lorem ipsum dolor sit amet";
+    const auto nodeId = createFile(path, content);
+
+    CPPUNIT_ASSERT_EQUAL(expectedChecksum(content), computeChecksum(nodeId, path, false));
+
+    const auto fileStat = getFileStat(path);
+    std::string checksum;
+    bool found = true;
+    CPPUNIT_ASSERT(_syncDb->selectChecksumCacheEntry(nodeId, fileStat.size, fileStat.modificationTime, fileStat.changeTime,
+                                                     checksum, found));
+    CPPUNIT_ASSERT(!found);
+}
+
+void TestComputeChecksumJob::testCacheHit() {
+    const SyncPath path = _localTempDir.path() / "file.txt";
+    const std::string content = "Lorem ipsum dolor sit amet";
+    const auto nodeId = createFile(path, content);
+
+    // The first computation fills the cache
+    CPPUNIT_ASSERT_EQUAL(expectedChecksum(content), computeChecksum(nodeId, path));
+    const auto fileStat = getFileStat(path);
+    std::string checksum;
+    bool found = false;
+    CPPUNIT_ASSERT(_syncDb->selectChecksumCacheEntry(nodeId, fileStat.size, fileStat.modificationTime, fileStat.changeTime,
+                                                     checksum, found));
+    CPPUNIT_ASSERT(found);
+    CPPUNIT_ASSERT_EQUAL(expectedChecksum(content), checksum);
+
+    // The second one does not read the file: tamper with the cached value to check it is the one returned
+    CPPUNIT_ASSERT(_syncDb->insertChecksumCacheEntry(nodeId, fileStat.size, fileStat.modificationTime, fileStat.changeTime,
+                                                     "cached"));
+    CPPUNIT_ASSERT_EQUAL(std::string("cached"), computeChecksum(nodeId, path));
+}
+
+void TestComputeChecksumJob::testCacheInvalidatedByModification() {
+    const SyncPath path = _localTempDir.path() / "file.txt";
+    const auto nodeId = createFile(path, "Lorem ipsum dolor sit amet");
+    (void) computeChecksum(nodeId, path);
+
+    const std::string newContent = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+    writeFile(path, newContent);
+    CPPUNIT_ASSERT_EQUAL(expectedChecksum(newContent), computeChecksum(nodeId, path));
+}
+
+void TestComputeChecksumJob::testCacheInvalidatedBySameSizeRewrite() {
+    const SyncPath path = _localTempDir.path() / "file.txt";
+    const std::string content = "Lorem ipsum dolor sit amet";
+    const auto nodeId = createFile(path, content);
+    const auto fileStat = getFileStat(path);
+    (void) computeChecksum(nodeId, path);
+
+    // Same size, and the modification date is restored: only the status change time differs
+    const std::string newContent = "LOREM IPSUM DOLOR SIT AMET";
+    CPPUNIT_ASSERT_EQUAL(content.size(), newContent.size());
+    writeFile(path, newContent);
+    testhelpers::setModificationDate(path, std::chrono::system_clock::from_time_t(fileStat.modificationTime));
+    const auto newFileStat = getFileStat(path);
+    CPPUNIT_ASSERT_EQUAL(fileStat.size, newFileStat.size);
+    CPPUNIT_ASSERT_EQUAL(fileStat.modificationTime, newFileStat.modificationTime);
+
+    CPPUNIT_ASSERT_EQUAL(expectedChecksum(newContent), computeChecksum(nodeId, path));
+}
+
+void TestComputeChecksumJob::testCacheSurvivesRestart() {
+    const SyncPath path = _localTempDir.path() / "file.txt";
+    const std::string content = "Lorem ipsum dolor sit amet";
+    const auto nodeId = createFile(path, content);
+    (void) computeChecksum(nodeId, path);
+
+    // Reopen the DB
+    const auto dbPath = _syncDb->dbPath();
+    _syncDb->setAutoDelete(false);
+    _syncDb->close();
+    _syncDb = std::make_shared<SyncDb>(dbPath.string());
+    CPPUNIT_ASSERT(_syncDb->init(KDRIVE_VERSION_STRING));
+    _syncDb->setAutoDelete(true);
+
+    const auto fileStat = getFileStat(path);
+    std::string checksum;
+    bool found = false;
+    CPPUNIT_ASSERT(_syncDb->selectChecksumCacheEntry(nodeId, fileStat.size, fileStat.modificationTime, fileStat.changeTime,
+                                                     checksum, found));
+    CPPUNIT_ASSERT(found);
+    CPPUNIT_ASSERT_EQUAL(expectedChecksum(content), checksum);
+}
+
+} // namespace KDC
@@ -0,0 +1,59 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "testincludes.h"
+#include "db/syncdb.h"
+#include "update_detection/file_system_observer/snapshot/livesnapshot.h"
+#include "test_utility/localtemporarydirectory.h"
+
+using namespace CppUnit;
+
+namespace KDC {
+
+class TestComputeChecksumJob : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestComputeChecksumJob);
+        CPPUNIT_TEST(testChecksumWithoutCache);
+        CPPUNIT_TEST(testCacheHit);
+        CPPUNIT_TEST(testCacheInvalidatedByModification);
+        CPPUNIT_TEST(testCacheInvalidatedBySameSizeRewrite);
+        CPPUNIT_TEST(testCacheSurvivesRestart);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        void testChecksumWithoutCache();
+        void testCacheHit();
+        void testCacheInvalidatedByModification();
+        void testCacheInvalidatedBySameSizeRewrite();
+        void testCacheSurvivesRestart();
+
+        // Create a file with the given content, insert it in the snapshot and wait until its status can be cached.
+        NodeId createFile(const SyncPath &path, const std::string &content);
+        std::string computeChecksum(const NodeId &nodeId, const SyncPath &path, bool withCache = true);
+
+        LocalTemporaryDirectory _localTempDir{"TestComputeChecksumJob"};
+        std::shared_ptr<SyncDb> _syncDb;
+        std::shared_ptr<LiveSnapshot> _liveSnapshot;
+};
+
+} // namespace KDC
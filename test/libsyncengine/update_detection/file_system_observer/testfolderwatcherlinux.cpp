@@ -25,8 +25,84 @@
 #include <Poco/File.h>
 #include <sys/inotify.h>
 
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
+
 namespace KDC {
 
+namespace {
+
+// Records the changes reported by the watcher instead of forwarding them to a LocalFileSystemObserverWorker
+class FolderWatcherLinuxRecorderMock : public FolderWatcher_linux {
+    public:
+        FolderWatcherLinuxRecorderMock() :
+            FolderWatcher_linux(nullptr, "") {}
+
+        // Block the first call to `changesDetected` until `release` is called, the kernel queues the events in the meantime
+        void holdFirstBatch() { _held = true; }
+        void release() {
+            const std::scoped_lock lock(_mutex);
+            _held = false;
+            _cv.notify_all();
+        }
+
+        template<class Predicate>
+        bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(10)) {
+            std::unique_lock lock(_mutex);
+            return _cv.wait_for(lock, timeout, [&]() { return predicate(*this); });
+        }
+
+        std::list<std::pair<SyncPath, OperationType>> changes;
+        std::list<std::chrono::steady_clock::time_point> batchTimes;
+        std::list<SyncPath> rescannedDirPaths;
+        bool firstBatchReceived = false;
+
+    private:
+        ExitInfo changesDetected(const std::list<std::pair<SyncPath, OperationType>> &batch) override {
+            std::unique_lock lock(_mutex);
+            batchTimes.push_back(std::chrono::steady_clock::now());
+            changes.insert(changes.end(), batch.begin(), batch.end());
+            firstBatchReceived = true;
+            _cv.notify_all();
+            _cv.wait(lock, [this]() { return !_held; });
+            return ExitCode::Ok;
+        }
+
+        ExitInfo rescanDirectories(const std::list<SyncPath> &dirPaths) override {
+            const std::scoped_lock lock(_mutex);
+            rescannedDirPaths.insert(rescannedDirPaths.end(), dirPaths.begin(), dirPaths.end());
+            _cv.notify_all();
+            return ExitCode::Ok;
+        }
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        bool _held = false;
+};
+
+// Event storms are faster on a memory file system
+SyncPath temporaryDirectoryDestination() {
+    std::error_code ec;
+    return std::filesystem::is_directory("/dev/shm", ec) ? SyncPath("/dev/shm") : SyncPath();
+}
+
+} // namespace
+
+void TestFolderWatcherLinux::startReading(FolderWatcher_linux &folderWatcher, const SyncPath &path, std::thread &thread) {
+    CPPUNIT_ASSERT(folderWatcher.initInotify());
+    CPPUNIT_ASSERT_EQUAL(ExitInfo{ExitCode::Ok}, folderWatcher.addFolderRecursive(path));
+    thread = std::thread([&folderWatcher]() { folderWatcher.readEvents(); });
+}
+
+void TestFolderWatcherLinux::stopReading(FolderWatcher_linux &folderWatcher, std::thread &thread) {
+    folderWatcher._stop = true;
+    folderWatcher.stopWatching();
+    thread.join();
+}
+
 void TestFolderWatcherLinux::testMakeSyncPath() {
     CPPUNIT_ASSERT(!FolderWatcher_linux::makeSyncPath("/A/B", "file.txt").filename().empty());
     CPPUNIT_ASSERT(!FolderWatcher_linux::makeSyncPath("/A/B", "").filename().empty());
@@ -134,4 +210,124 @@ void TestFolderWatcherLinux::testFindSubFolders() {
     CPPUNIT_ASSERT(fullList.back() == dir1Path);
 }
 
+void TestFolderWatcherLinux::testEventLatency() {
+    const LocalTemporaryDirectory tempDir("testEventLatency", temporaryDirectoryDestination());
+
+    FolderWatcherLinuxRecorderMock testObj;
+    std::thread thread;
+    startReading(testObj, tempDir.path(), thread);
+
+    const auto filePath = tempDir.path() / "file.txt";
+    const auto start = std::chrono::steady_clock::now();
+    { std::ofstream file(filePath); }
+
+    const bool received = testObj.waitFor([](const auto &mock) { return mock.firstBatchReceived; });
+    stopReading(testObj, thread);
+
+    CPPUNIT_ASSERT(received);
+    CPPUNIT_ASSERT_EQUAL(filePath, testObj.changes.front().first);
+    CPPUNIT_ASSERT_EQUAL(OperationType::Create, testObj.changes.front().second);
+    // The events used to be polled every 100ms
+    CPPUNIT_ASSERT(testObj.batchTimes.front() - start < std::chrono::milliseconds(100));
+}
+
+void TestFolderWatcherLinux::testMoveCoalescing() {
+    const LocalTemporaryDirectory tempDir("testMoveCoalescing", temporaryDirectoryDestination());
+    const auto pathA = tempDir.path() / "A";
+    const auto pathB = tempDir.path() / "B";
+    CPPUNIT_ASSERT(std::filesystem::create_directories(pathA / "AA"));
+
+    FolderWatcherLinuxRecorderMock testObj;
+    std::thread thread;
+    startReading(testObj, tempDir.path(), thread);
+
+    std::filesystem::rename(pathA, pathB);
+
+    const bool received = testObj.waitFor([](const auto &mock) { return mock.firstBatchReceived; });
+    // Leave time to an unpaired IN_MOVED_FROM event to be reported
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stopReading(testObj, thread);
+
+    CPPUNIT_ASSERT(received);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), testObj.changes.size());
+    CPPUNIT_ASSERT_EQUAL(pathB, testObj.changes.front().first);
+    CPPUNIT_ASSERT_EQUAL(OperationType::Move, testObj.changes.front().second);
+
+    // The watches follow the moved folder
+    CPPUNIT_ASSERT(!testObj._pathToWatch.contains(pathA.native()));
+    CPPUNIT_ASSERT(!testObj._pathToWatch.contains((pathA / "AA").native()));
+    CPPUNIT_ASSERT(testObj._pathToWatch.contains(pathB.native()));
+    CPPUNIT_ASSERT(testObj._pathToWatch.contains((pathB / "AA").native()));
+    CPPUNIT_ASSERT_EQUAL(pathB / "AA", testObj._watchToPath[testObj._pathToWatch[(pathB / "AA").native()]]);
+}
+
+void TestFolderWatcherLinux::testQueueOverflowRecovery() {
+    const LocalTemporaryDirectory tempDir("testQueueOverflowRecovery", temporaryDirectoryDestination());
+    const auto busyDirPath = tempDir.path() / "busy";
+    const auto quietDirPath = tempDir.path() / "quiet";
+    const auto untouchedDirPath = tempDir.path() / "untouched";
+    for (const auto &path: {busyDirPath, quietDirPath, untouchedDirPath}) {
+        CPPUNIT_ASSERT(std::filesystem::create_directories(path));
+    }
+    const auto quietFilePath = quietDirPath / "old.txt";
+    { std::ofstream file(quietFilePath); }
+    const auto untouchedFilePath = untouchedDirPath / "edited.txt";
+    { std::ofstream file(untouchedFilePath); }
+
+    // Each file creation queues an IN_CREATE and an IN_CLOSE_WRITE event
+    std::uint64_t maxQueuedEvents = 16384;
+    std::ifstream("/proc/sys/fs/inotify/max_queued_events") >> maxQueuedEvents;
+    const auto fileCount = maxQueuedEvents / 2 + 1000;
+
+    FolderWatcherLinuxRecorderMock testObj;
+    testObj.holdFirstBatch();
+    std::thread thread;
+    startReading(testObj, tempDir.path(), thread);
+
+    { std::ofstream file(tempDir.path() / "trigger.txt"); }
+    CPPUNIT_ASSERT(testObj.waitFor([](const auto &mock) { return mock.firstBatchReceived; }));
+
+    // Storm of events while the watcher is busy
+    std::list<SyncPath> createdPaths;
+    for (std::uint64_t i = 0; i < fileCount; ++i) {
+        createdPaths.push_back(busyDirPath / ("file" + std::to_string(i) + ".txt"));
+        std::ofstream file(createdPaths.back());
+    }
+    const auto newDirPath = busyDirPath / "newDir";
+    CPPUNIT_ASSERT(std::filesystem::create_directories(newDirPath / "subDir"));
+    createdPaths.push_back(newDirPath);
+    // Lost events in folders which received no other event
+    CPPUNIT_ASSERT(std::filesystem::remove(quietFilePath));
+    {
+        // An in-place edit changes neither the folder nor its change time
+        std::ofstream file(untouchedFilePath, std::ios::app);
+        file << "edited";
+    }
+
+    testObj.release();
+    const bool rescanned = testObj.waitFor([](const auto &mock) { return !mock.rescannedDirPaths.empty(); });
+    stopReading(testObj, thread);
+
+    CPPUNIT_ASSERT(rescanned);
+
+    const std::set<SyncPath> rescannedDirPaths(testObj.rescannedDirPaths.begin(), testObj.rescannedDirPaths.end());
+    CPPUNIT_ASSERT(rescannedDirPaths.contains(quietDirPath));
+    CPPUNIT_ASSERT(rescannedDirPaths.contains(untouchedDirPath));
+    CPPUNIT_ASSERT(rescannedDirPaths.contains(busyDirPath));
+    CPPUNIT_ASSERT(rescannedDirPaths.contains(tempDir.path()));
+
+    // No change is missed: every item is either reported or located in a rescanned folder
+    std::set<SyncPath> reportedPaths;
+    for (const auto &[path, opType]: testObj.changes) {
+        (void) reportedPaths.insert(path);
+    }
+    for (const auto &path: createdPaths) {
+        CPPUNIT_ASSERT(reportedPaths.contains(path) || rescannedDirPaths.contains(path.parent_path()));
+    }
+
+    // The folders created during the overflow are watched
+    CPPUNIT_ASSERT(testObj._pathToWatch.contains(newDirPath.native()));
+    CPPUNIT_ASSERT(testObj._pathToWatch.contains((newDirPath / "subDir").native()));
+}
+
 } // namespace KDC
@@ -29,6 +29,9 @@ class TestFolderWatcherLinux final : public CppUnit::TestFixture, public TestBas
         CPPUNIT_TEST(testRemoveFoldersBelow);
         CPPUNIT_TEST(testInotifyRegisterPath);
         CPPUNIT_TEST(testFindSubFolders);
+        CPPUNIT_TEST(testEventLatency);
+        CPPUNIT_TEST(testMoveCoalescing);
+        CPPUNIT_TEST(testQueueOverflowRecovery);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -41,6 +44,12 @@ class TestFolderWatcherLinux final : public CppUnit::TestFixture, public TestBas
         void testRemoveFoldersBelow();
         void testInotifyRegisterPath();
         void testFindSubFolders();
+        void testEventLatency();
+        void testMoveCoalescing();
+        void testQueueOverflowRecovery();
+
+        static void startReading(FolderWatcher_linux &folderWatcher, const SyncPath &path, std::thread &thread);
+        static void stopReading(FolderWatcher_linux &folderWatcher, std::thread &thread);
 };
 
 } // namespace KDC
@@ -198,11 +198,25 @@ void TestLocalFileSystemObserverWorker::testLFSOWithFiles() {
         /// Edit file
         LOGW_DEBUG(_logger, L"***** test edit file *****");
         const SyncTime prevModTime = _syncPal->liveSnapshot(ReplicaSide::Local).lastModified(itemId);
+
+        FileStat fileStat;
+        bool exists = false;
+        IoHelper::getFileStat(testAbsolutePath, &fileStat, exists, IoHelper::PathCheckOption::Insensitive);
+        CPPUNIT_ASSERT(_syncPal->syncDb()->insertChecksumCacheEntry(itemId, fileStat.size, fileStat.modificationTime,
+                                                                    fileStat.changeTime, "checksum"));
+
         testhelpers::generateOrEditTestFile(testAbsolutePath);
 
         Utility::msleep(1000); // Wait 1sec
         _syncPal->copySnapshots();
         CPPUNIT_ASSERT(_syncPal->liveSnapshot(ReplicaSide::Local).lastModified(itemId) > prevModTime);
+
+        // The cached checksum has been invalidated
+        std::string checksum;
+        bool found = true;
+        CPPUNIT_ASSERT(_syncPal->syncDb()->selectChecksumCacheEntry(itemId, fileStat.size, fileStat.modificationTime,
+                                                                    fileStat.changeTime, checksum, found));
+        CPPUNIT_ASSERT(!found);
     }
 
     {
@@ -682,6 +696,84 @@ void TestLocalFileSystemObserverWorker::testInvalidateCounter() {
     CPPUNIT_ASSERT_EQUAL(false, _syncPal->liveSnapshot(ReplicaSide::Local).isValid()); // Snapshot has been invalidated.
 }
 
+void TestLocalFileSystemObserverWorker::testExploreTree() {
+    // Nested folders, links and hidden items
+    const auto treePath = _rootFolderPath / "tree";
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            const auto dirPath = treePath / ("dir" + std::to_string(i)) / ("dir" + std::to_string(j));
+            CPPUNIT_ASSERT(std::filesystem::create_directories(dirPath));
+            for (int k = 0; k < 5; ++k) {
+                testhelpers::generateOrEditTestFile(dirPath / ("file" + std::to_string(k) + ".txt"));
+            }
+        }
+    }
+    testhelpers::generateOrEditTestFile(treePath / ".hidden.txt");
+    std::filesystem::create_directory_symlink(treePath / "dir0", treePath / "dirSymlink");
+    std::filesystem::create_symlink(treePath / "dir0/dir0/file0.txt", treePath / "fileSymlink");
+    std::filesystem::create_symlink(treePath / "missing.txt", treePath / "danglingSymlink");
+
+    // Workers which are not started, with their own live snapshot
+    const auto makeWorker = [this]() {
+#if defined(KD_WINDOWS)
+        return std::make_shared<LocalFileSystemObserverWorker_win>(_syncPal, "Local File System Observer", "LFSO");
+#else
+        return std::make_shared<LocalFileSystemObserverWorker_unix>(_syncPal, "Local File System Observer", "LFSO");
+#endif
+    };
+    const auto sequentialWorker = makeWorker();
+    sequentialWorker->_liveSnapshot.init();
+    CPPUNIT_ASSERT_EQUAL(ExitInfo{ExitCode::Ok}, sequentialWorker->exploreDir(_rootFolderPath));
+
+    // The checksum of an unchanged file is read from the cache
+    Utility::msleep(1000); // Wait for the running worker to invalidate the cache entries of the created files
+    FileStat cachedFileStat;
+    bool exists = false;
+    IoHelper::getFileStat(treePath / "dir0/dir0/file0.txt", &cachedFileStat, exists, IoHelper::PathCheckOption::Insensitive);
+    const NodeId cachedFileId = std::to_string(cachedFileStat.inode);
+    CPPUNIT_ASSERT(_syncPal->syncDb()->insertChecksumCacheEntry(cachedFileId, cachedFileStat.size,
+                                                                cachedFileStat.modificationTime, cachedFileStat.changeTime,
+                                                                "checksum"));
+    FileStat changedFileStat;
+    IoHelper::getFileStat(treePath / "dir0/dir0/file1.txt", &changedFileStat, exists, IoHelper::PathCheckOption::Insensitive);
+    const NodeId changedFileId = std::to_string(changedFileStat.inode);
+    CPPUNIT_ASSERT(_syncPal->syncDb()->insertChecksumCacheEntry(changedFileId, changedFileStat.size + 1,
+                                                                changedFileStat.modificationTime, changedFileStat.changeTime,
+                                                                "checksum"));
+
+    const auto parallelWorker = makeWorker();
+    parallelWorker->_liveSnapshot.init();
+    CPPUNIT_ASSERT(_syncPal->syncDb()->selectAllChecksumCacheEntries(parallelWorker->_checksumCache));
+    CPPUNIT_ASSERT_EQUAL(ExitInfo{ExitCode::Ok},
+                         parallelWorker->exploreTree(_rootFolderPath, *_syncPal->syncDb()->rootNode().nodeIdLocal()));
+
+    const auto &expected = sequentialWorker->_liveSnapshot;
+    const auto &actual = parallelWorker->_liveSnapshot;
+    NodeSet expectedIds;
+    expected.ids(expectedIds);
+    NodeSet actualIds;
+    actual.ids(actualIds);
+    CPPUNIT_ASSERT_EQUAL(expectedIds.size(), actualIds.size());
+
+    FileStat fileStat;
+    IoHelper::getFileStat(treePath / "dir3/dir3/file4.txt", &fileStat, exists, IoHelper::PathCheckOption::Insensitive);
+    CPPUNIT_ASSERT(actual.exists(std::to_string(fileStat.inode)));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("checksum"), actual.contentChecksum(cachedFileId));
+    CPPUNIT_ASSERT(actual.contentChecksum(changedFileId).empty());
+
+    for (const auto &id: expectedIds) {
+        CPPUNIT_ASSERT(actual.exists(id));
+        CPPUNIT_ASSERT_EQUAL(expected.parentId(id), actual.parentId(id));
+        CPPUNIT_ASSERT(expected.name(id) == actual.name(id));
+        CPPUNIT_ASSERT_EQUAL(expected.type(id), actual.type(id));
+        CPPUNIT_ASSERT_EQUAL(expected.size(id), actual.size(id));
+        CPPUNIT_ASSERT_EQUAL(expected.createdAt(id), actual.createdAt(id));
+        CPPUNIT_ASSERT_EQUAL(expected.lastModified(id), actual.lastModified(id));
+        CPPUNIT_ASSERT_EQUAL(expected.isLink(id), actual.isLink(id));
+    }
+}
+
 void MockLocalFileSystemObserverWorker::waitForUpdate(SnapshotRevision previousRevision,
                                                       const std::chrono::milliseconds timeoutMs) const {
     using namespace std::chrono;
@@ -78,6 +78,7 @@ class TestLocalFileSystemObserverWorker final : public CppUnit::TestFixture, pub
         CPPUNIT_TEST(testLFSODirReplacement);
         CPPUNIT_TEST(testInvalidateCounter);
         CPPUNIT_TEST(testInvalidateSnapshot);
+        CPPUNIT_TEST(testExploreTree);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -106,6 +107,7 @@ class TestLocalFileSystemObserverWorker final : public CppUnit::TestFixture, pub
         void testLFSODirReplacement();
         void testInvalidateCounter();
         void testInvalidateSnapshot();
+        void testExploreTree();
         void testSyncDirChange();
         static bool vfsStatus(int, const SyncPath &, bool &, bool &, bool &, int &) { return true; }
         static bool vfsPinState(int, const SyncPath &, PinState &) { return true; }
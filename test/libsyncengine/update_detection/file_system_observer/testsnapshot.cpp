@@ -21,10 +21,57 @@
 #include "db/syncdb.h"
 #include "requests/parameterscache.h"
 
+#include <random>
+
 using namespace CppUnit;
 
 namespace KDC {
 
+namespace {
+
+void checkSnapshotsEqual(const Snapshot &expected, const Snapshot &actual) {
+    CPPUNIT_ASSERT_EQUAL(expected.revision(), actual.revision());
+    CPPUNIT_ASSERT_EQUAL(expected.nbItems(), actual.nbItems());
+
+    NodeSet expectedIds;
+    expected.ids(expectedIds);
+    NodeSet actualIds;
+    actual.ids(actualIds);
+    CPPUNIT_ASSERT(expectedIds == actualIds);
+
+    for (const auto &id: expectedIds) {
+        CPPUNIT_ASSERT_EQUAL(expected.parentId(id), actual.parentId(id));
+        CPPUNIT_ASSERT(expected.name(id) == actual.name(id));
+        CPPUNIT_ASSERT_EQUAL(expected.createdAt(id), actual.createdAt(id));
+        CPPUNIT_ASSERT_EQUAL(expected.lastModified(id), actual.lastModified(id));
+        CPPUNIT_ASSERT_EQUAL(expected.type(id), actual.type(id));
+        CPPUNIT_ASSERT_EQUAL(expected.size(id), actual.size(id));
+        CPPUNIT_ASSERT_EQUAL(expected.contentChecksum(id), actual.contentChecksum(id));
+        CPPUNIT_ASSERT_EQUAL(expected.canWrite(id), actual.canWrite(id));
+        CPPUNIT_ASSERT_EQUAL(expected.isLink(id), actual.isLink(id));
+        CPPUNIT_ASSERT_EQUAL(expected.lastChangeRevision(id), actual.lastChangeRevision(id));
+        CPPUNIT_ASSERT_EQUAL(expected.exists(id), actual.exists(id));
+
+        NodeSet expectedChildrenIds;
+        NodeSet actualChildrenIds;
+        CPPUNIT_ASSERT_EQUAL(expected.getChildrenIds(id, expectedChildrenIds), actual.getChildrenIds(id, actualChildrenIds));
+        CPPUNIT_ASSERT(expectedChildrenIds == actualChildrenIds);
+
+        if (id == expected.rootFolderId()) continue;
+        SyncPath expectedPath;
+        SyncPath actualPath;
+        bool ignore = false;
+        CPPUNIT_ASSERT_EQUAL(expected.path(id, expectedPath, ignore), actual.path(id, actualPath, ignore));
+        CPPUNIT_ASSERT_EQUAL(expectedPath, actualPath);
+
+        NodeId actualId;
+        CPPUNIT_ASSERT(actual.getItemId(actualPath, actualId));
+        CPPUNIT_ASSERT_EQUAL(id, actualId);
+    }
+}
+
+} // namespace
+
 
 /**
  * Tree:
@@ -113,6 +160,82 @@ void TestSnapshot::testGetItemId() {
     CPPUNIT_ASSERT_EQUAL(NodeId(""), nodeId);
 }
 
+void TestSnapshot::testGetItemIdAfterRenameAndMove() {
+    NodeId nodeId;
+
+    // Rename with `updateItem`
+    _liveSnapshot->updateItem(SnapshotItem("aa", "a", Str("AA*"), testhelpers::defaultTime, testhelpers::defaultTime,
+                                           NodeType::Directory, testhelpers::defaultFileSize, false, true, true));
+    CPPUNIT_ASSERT(!_liveSnapshot->getItemId(SyncPath("A/AA/AAA"), nodeId));
+    CPPUNIT_ASSERT(_liveSnapshot->getItemId(SyncPath("A/AA*/AAA"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("aaa"), nodeId);
+
+    // Rename with `setName`
+    CPPUNIT_ASSERT(_liveSnapshot->setName("aaa", Str("AAA*")));
+    CPPUNIT_ASSERT(!_liveSnapshot->getItemId(SyncPath("A/AA*/AAA"), nodeId));
+    CPPUNIT_ASSERT(_liveSnapshot->getItemId(SyncPath("A/AA*/AAA*"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("aaa"), nodeId);
+
+    // Move and rename
+    _liveSnapshot->updateItem(SnapshotItem("aa", "b", Str("BB"), testhelpers::defaultTime, testhelpers::defaultTime,
+                                           NodeType::Directory, testhelpers::defaultFileSize, false, true, true));
+    CPPUNIT_ASSERT(!_liveSnapshot->getItemId(SyncPath("A/AA*"), nodeId));
+    CPPUNIT_ASSERT(_liveSnapshot->getItemId(SyncPath("B/BB/AAA*"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("aaa"), nodeId);
+
+    // Swap the names of two siblings
+    const SnapshotItem itemC("c", _rootNodeId, Str("C"), testhelpers::defaultTime, testhelpers::defaultTime, NodeType::Directory,
+                             testhelpers::defaultFileSize, false, true, true);
+    _liveSnapshot->updateItem(itemC);
+    CPPUNIT_ASSERT(_liveSnapshot->setName("a", Str("tmp")));
+    CPPUNIT_ASSERT(_liveSnapshot->setName("c", Str("A")));
+    CPPUNIT_ASSERT(_liveSnapshot->setName("a", Str("C")));
+    CPPUNIT_ASSERT(_liveSnapshot->getItemId(SyncPath("A"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("c"), nodeId);
+    CPPUNIT_ASSERT(_liveSnapshot->getItemId(SyncPath("C"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("a"), nodeId);
+    CPPUNIT_ASSERT(!_liveSnapshot->getItemId(SyncPath("tmp"), nodeId));
+
+    // A new item with the same normalized name replaces the existing one
+    SyncName nfcName;
+    Utility::normalizedSyncName(Str("à"), nfcName);
+    SyncName nfdName;
+    Utility::normalizedSyncName(Str("à"), nfdName, UnicodeNormalization::NFD);
+    _liveSnapshot->updateItem(SnapshotItem("d", _rootNodeId, nfcName, testhelpers::defaultTime, testhelpers::defaultTime,
+                                           NodeType::File, testhelpers::defaultFileSize, false, true, true));
+    NodeId removedNodeId;
+    _liveSnapshot->updateItem(SnapshotItem("e", _rootNodeId, nfdName, testhelpers::defaultTime, testhelpers::defaultTime,
+                                           NodeType::File, testhelpers::defaultFileSize, false, true, true),
+                              removedNodeId);
+    CPPUNIT_ASSERT_EQUAL(NodeId("d"), removedNodeId);
+    CPPUNIT_ASSERT(!_liveSnapshot->exists("d"));
+    CPPUNIT_ASSERT(!_liveSnapshot->getItemId(SyncPath(nfcName), nodeId));
+    CPPUNIT_ASSERT(_liveSnapshot->getItemId(SyncPath(nfdName), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("e"), nodeId);
+
+    // Removal
+    CPPUNIT_ASSERT(_liveSnapshot->removeItem("aa"));
+    CPPUNIT_ASSERT(!_liveSnapshot->getItemId(SyncPath("B/BB"), nodeId));
+    CPPUNIT_ASSERT(_liveSnapshot->getItemId(SyncPath("B"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("b"), nodeId);
+
+    // The frozen copies are indexed the same way, including after an incremental freeze
+    auto constSnapshot = _liveSnapshot->freeze();
+    CPPUNIT_ASSERT(constSnapshot->getItemId(SyncPath("C"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("a"), nodeId);
+    constSnapshot.reset();
+
+    CPPUNIT_ASSERT(_liveSnapshot->setName("a", Str("A")));
+    _liveSnapshot->updateItem(SnapshotItem("c", "b", Str("C"), testhelpers::defaultTime, testhelpers::defaultTime,
+                                           NodeType::Directory, testhelpers::defaultFileSize, false, true, true));
+    constSnapshot = _liveSnapshot->freeze();
+    CPPUNIT_ASSERT(constSnapshot->getItemId(SyncPath("A"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("a"), nodeId);
+    CPPUNIT_ASSERT(!constSnapshot->getItemId(SyncPath("C"), nodeId));
+    CPPUNIT_ASSERT(constSnapshot->getItemId(SyncPath("B/C"), nodeId));
+    CPPUNIT_ASSERT_EQUAL(NodeId("c"), nodeId);
+}
+
 void TestSnapshot::testSnapshot() {
     CPPUNIT_ASSERT(_liveSnapshot->exists("a"));
     CPPUNIT_ASSERT_EQUAL(std::string("A"), SyncName2Str(_liveSnapshot->name("a")));
@@ -498,4 +621,157 @@ void TestSnapshot::testSnapshotRevision() {
     lastRevision = liveSnapshot.revision();
 }
 
+void TestSnapshot::testFreezeSnapshot() {
+    // First freeze: all items are copied
+    auto constSnapshot = _liveSnapshot->freeze();
+    checkSnapshotsEqual(ConstSnapshot(*_liveSnapshot), *constSnapshot);
+
+    SyncPath path;
+    bool ignore = false;
+    CPPUNIT_ASSERT(constSnapshot->path("aaa", path, ignore));
+    CPPUNIT_ASSERT_EQUAL(SyncPath("A/AA/AAA"), path);
+
+    // The frozen copy is not affected by later changes
+    _liveSnapshot->setName("aa", Str("AA2"));
+    const SnapshotItem itemBA("ba", "b", Str("BA"), testhelpers::defaultTime, testhelpers::defaultTime, NodeType::File,
+                              testhelpers::defaultFileSize, false, true, true);
+    _liveSnapshot->updateItem(itemBA);
+    CPPUNIT_ASSERT(SyncName(Str("AA")) == constSnapshot->name("aa"));
+    CPPUNIT_ASSERT(!constSnapshot->exists("ba"));
+    constSnapshot.reset();
+
+    // Second freeze: only the changed items are updated, cached paths are recomputed
+    constSnapshot = _liveSnapshot->freeze();
+    checkSnapshotsEqual(ConstSnapshot(*_liveSnapshot), *constSnapshot);
+    CPPUNIT_ASSERT(constSnapshot->path("aaa", path, ignore));
+    CPPUNIT_ASSERT_EQUAL(SyncPath("A/AA2/AAA"), path);
+    constSnapshot.reset();
+
+    // Move, then remove a subtree
+    const SnapshotItem movedItemAA("aa", "b", Str("AA2"), testhelpers::defaultTime, testhelpers::defaultTime,
+                                   NodeType::Directory, testhelpers::defaultFileSize, false, true, true);
+    _liveSnapshot->updateItem(movedItemAA);
+    constSnapshot = _liveSnapshot->freeze();
+    checkSnapshotsEqual(ConstSnapshot(*_liveSnapshot), *constSnapshot);
+    CPPUNIT_ASSERT(constSnapshot->path("aaa", path, ignore));
+    CPPUNIT_ASSERT_EQUAL(SyncPath("B/AA2/AAA"), path);
+    constSnapshot.reset();
+
+    CPPUNIT_ASSERT(_liveSnapshot->removeItem("b"));
+    constSnapshot = _liveSnapshot->freeze();
+    checkSnapshotsEqual(ConstSnapshot(*_liveSnapshot), *constSnapshot);
+    CPPUNIT_ASSERT(!constSnapshot->exists("b"));
+    CPPUNIT_ASSERT(!constSnapshot->exists("aa"));
+    CPPUNIT_ASSERT(!constSnapshot->exists("aaa"));
+
+    // A re-initialized snapshot is entirely copied again
+    constSnapshot.reset();
+    _liveSnapshot->init();
+    constSnapshot = _liveSnapshot->freeze();
+    checkSnapshotsEqual(ConstSnapshot(*_liveSnapshot), *constSnapshot);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), constSnapshot->nbItems());
+}
+
+void TestSnapshot::testFreezeSnapshotWhileCopyIsHeld() {
+    const auto heldSnapshot = _liveSnapshot->freeze();
+    const ConstSnapshot expectedHeldSnapshot(*_liveSnapshot);
+
+    _liveSnapshot->setName("aaa", Str("AAA2"));
+    CPPUNIT_ASSERT(_liveSnapshot->removeItem("b"));
+
+    // The held copy must not be modified by the next freeze
+    const auto constSnapshot = _liveSnapshot->freeze();
+    checkSnapshotsEqual(ConstSnapshot(*_liveSnapshot), *constSnapshot);
+    checkSnapshotsEqual(expectedHeldSnapshot, *heldSnapshot);
+    CPPUNIT_ASSERT(heldSnapshot->exists("b"));
+    CPPUNIT_ASSERT(!constSnapshot->exists("b"));
+}
+
+void TestSnapshot::testFreezeSnapshotEquivalence() {
+    std::mt19937 generator(42); // NOLINT(cert-msc51-cpp): the sequence must be reproducible
+    const auto randomIndex = [&generator](const size_t size) {
+        return std::uniform_int_distribution<size_t>(0, size - 1)(generator);
+    };
+
+    std::vector<NodeId> dirIds{_rootNodeId, "a", "b", "aa"};
+    std::vector<NodeId> fileIds{"aaa"};
+    int nextId = 0;
+
+    std::shared_ptr<ConstSnapshot> constSnapshot;
+    for (int round = 0; round < 50; ++round) {
+        for (int opIndex = 0; opIndex < 40; ++opIndex) {
+            switch (randomIndex(6)) {
+                case 0:
+                case 1: {
+                    // Create an item
+                    const bool isDir = randomIndex(3) == 0;
+                    const NodeId id = "n" + std::to_string(nextId++);
+                    const NodeId &parentId = dirIds[randomIndex(dirIds.size())];
+                    if (!_liveSnapshot->exists(parentId)) break;
+                    const SnapshotItem item(id, parentId, Str2SyncName(id), testhelpers::defaultTime, testhelpers::defaultTime,
+                                            isDir ? NodeType::Directory : NodeType::File,
+                                            isDir ? 0 : static_cast<int64_t>(randomIndex(1000)), false, true, true);
+                    CPPUNIT_ASSERT(_liveSnapshot->updateItem(item));
+                    (isDir ? dirIds : fileIds).push_back(id);
+                    break;
+                }
+                case 2: {
+                    // Rename an item
+                    auto &ids = randomIndex(2) ? dirIds : fileIds;
+                    const auto &id = ids[randomIndex(ids.size())];
+                    if (id == _rootNodeId || !_liveSnapshot->exists(id)) break;
+                    CPPUNIT_ASSERT(_liveSnapshot->setName(id, Str2SyncName(id + "_" + std::to_string(nextId++))));
+                    break;
+                }
+                case 3: {
+                    // Move an item
+                    auto &ids = randomIndex(2) ? dirIds : fileIds;
+                    const auto &id = ids[randomIndex(ids.size())];
+                    const auto &newParentId = dirIds[randomIndex(dirIds.size())];
+                    if (id == _rootNodeId || id == newParentId || !_liveSnapshot->exists(id) ||
+                        !_liveSnapshot->exists(newParentId) || _liveSnapshot->isAncestor(newParentId, id)) {
+                        break;
+                    }
+                    const SnapshotItem item(id, newParentId, _liveSnapshot->name(id), _liveSnapshot->createdAt(id),
+                                            _liveSnapshot->lastModified(id), _liveSnapshot->type(id), _liveSnapshot->size(id),
+                                            false, true, true);
+                    CPPUNIT_ASSERT(_liveSnapshot->updateItem(item));
+                    break;
+                }
+                case 4: {
+                    // Edit a file
+                    const auto &id = fileIds[randomIndex(fileIds.size())];
+                    if (!_liveSnapshot->exists(id)) break;
+                    CPPUNIT_ASSERT(_liveSnapshot->setLastModified(id, testhelpers::defaultTime + nextId++));
+                    CPPUNIT_ASSERT(_liveSnapshot->setContentChecksum(id, std::to_string(nextId++)));
+                    break;
+                }
+                default: {
+                    // Remove an item, possibly a whole subtree
+                    auto &ids = randomIndex(4) ? fileIds : dirIds;
+                    const auto &id = ids[randomIndex(ids.size())];
+                    if (id == _rootNodeId) break;
+                    CPPUNIT_ASSERT(_liveSnapshot->removeItem(id));
+                    break;
+                }
+            }
+        }
+
+        // Hold the previous copy from time to time to exercise the full copy
+        std::shared_ptr<ConstSnapshot> heldSnapshot;
+        std::unique_ptr<ConstSnapshot> expectedHeldSnapshot;
+        if (round % 10 == 9) {
+            heldSnapshot = constSnapshot;
+            expectedHeldSnapshot = std::make_unique<ConstSnapshot>(*constSnapshot);
+        }
+        constSnapshot.reset();
+
+        constSnapshot = _liveSnapshot->freeze();
+        checkSnapshotsEqual(ConstSnapshot(*_liveSnapshot), *constSnapshot);
+        if (heldSnapshot) {
+            checkSnapshotsEqual(*expectedHeldSnapshot, *heldSnapshot);
+        }
+    }
+}
+
 } // namespace KDC
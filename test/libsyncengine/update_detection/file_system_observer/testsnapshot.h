@@ -28,6 +28,7 @@ namespace KDC {
 class TestSnapshot : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST_SUITE(TestSnapshot);
         CPPUNIT_TEST(testGetItemId);
+        CPPUNIT_TEST(testGetItemIdAfterRenameAndMove);
         CPPUNIT_TEST(testSnapshot);
         CPPUNIT_TEST(testSize);
         CPPUNIT_TEST(testDuplicatedItem);
@@ -35,6 +36,9 @@ class TestSnapshot : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST(testPath);
         CPPUNIT_TEST(testCopySnapshot);
         CPPUNIT_TEST(testSnapshotRevision);
+        CPPUNIT_TEST(testFreezeSnapshot);
+        CPPUNIT_TEST(testFreezeSnapshotWhileCopyIsHeld);
+        CPPUNIT_TEST(testFreezeSnapshotEquivalence);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -43,6 +47,7 @@ class TestSnapshot : public CppUnit::TestFixture, public TestBase {
 
     private:
         void testGetItemId();
+        void testGetItemIdAfterRenameAndMove();
         void testSnapshot();
         void testSize();
         void testDuplicatedItem();
@@ -50,6 +55,9 @@ class TestSnapshot : public CppUnit::TestFixture, public TestBase {
         void testPath();
         void testCopySnapshot();
         void testSnapshotRevision();
+        void testFreezeSnapshot();
+        void testFreezeSnapshotWhileCopyIsHeld();
+        void testFreezeSnapshotEquivalence(); // Compare incremental freezes to deep copies after random changes
 
         std::unique_ptr<LiveSnapshot> _liveSnapshot;
         NodeId _rootNodeId;
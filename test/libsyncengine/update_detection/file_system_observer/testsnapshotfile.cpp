@@ -0,0 +1,295 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "testsnapshotfile.h"
+#include "update_detection/file_system_observer/remotefilesystemobserverworker.h"
+#include "update_detection/file_system_observer/snapshot/snapshotfile.h"
+
+#include "db/parmsdb.h"
+#include "jobs/syncjobmanager.h"
+#include "jobs/network/httpsessionpool.h"
+#include "keychainmanager/keychainmanager.h"
+#include "network/proxy.h"
+#include "requests/syncnodecache.h"
+
+#include "libcommon/utility/urlhelper.h"
+#include "libcommonserver/io/iohelper.h"
+#include "mocks/libcommonserver/db/mockdb.h"
+#include "test_utility/testhelpers.h"
+
+#include <version.h>
+
+#include <fstream>
+
+using namespace CppUnit;
+
+namespace KDC {
+
+namespace {
+
+constexpr int dirCount = 3;
+constexpr int filesPerDir = 5;
+
+std::string fileName(const int index) {
+    return "file" + std::to_string(index) + ".txt";
+}
+
+std::string readFile(const SyncPath &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+void writeFile(const SyncPath &path, const std::string &content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    (void) file.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+void checkSameItems(const Snapshot &expected, const Snapshot &actual) {
+    NodeSet expectedIds;
+    expected.ids(expectedIds);
+    NodeSet actualIds;
+    actual.ids(actualIds);
+    CPPUNIT_ASSERT(expectedIds == actualIds);
+
+    for (const auto &id: expectedIds) {
+        CPPUNIT_ASSERT_EQUAL(expected.parentId(id), actual.parentId(id));
+        CPPUNIT_ASSERT(expected.name(id) == actual.name(id));
+        CPPUNIT_ASSERT_EQUAL(expected.createdAt(id), actual.createdAt(id));
+        CPPUNIT_ASSERT_EQUAL(expected.lastModified(id), actual.lastModified(id));
+        CPPUNIT_ASSERT_EQUAL(expected.type(id), actual.type(id));
+        CPPUNIT_ASSERT_EQUAL(expected.size(id), actual.size(id));
+        CPPUNIT_ASSERT_EQUAL(expected.contentChecksum(id), actual.contentChecksum(id));
+        CPPUNIT_ASSERT_EQUAL(expected.canWrite(id), actual.canWrite(id));
+        CPPUNIT_ASSERT_EQUAL(expected.canShare(id), actual.canShare(id));
+        CPPUNIT_ASSERT_EQUAL(expected.isLink(id), actual.isLink(id));
+    }
+}
+
+} // namespace
+
+void TestSnapshotFile::setUp() {
+    TestBase::start();
+
+    _server = std::make_unique<MockKDriveServer>();
+    UrlHelper::setCustomApiUrl(_server->apiUrl());
+
+    _remoteSyncDirId = _server->createDirectory(MockKDriveServer::rootId, "testSnapshotFile");
+    for (int dirIndex = 0; dirIndex < dirCount; ++dirIndex) {
+        const NodeId dirId = _server->createDirectory(_remoteSyncDirId, "dir" + std::to_string(dirIndex));
+        for (int index = 0; index < filesPerDir; ++index) {
+            (void) _server->createFile(dirId, fileName(index), std::string(static_cast<size_t>(index), 'c'));
+        }
+        (void) _server->createDirectory(dirId, "subDir");
+    }
+
+    // The token is never checked by the mock server
+    ApiToken apiToken;
+    apiToken.setAccessToken("testToken");
+
+    const std::string keychainKey("123");
+    (void) KeyChainManager::instance(true);
+    (void) KeyChainManager::instance()->writeToken(keychainKey, apiToken.reconstructJsonString());
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, keychainKey);
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(_driveDbId, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    (void) Proxy::instance(ProxyConfig());
+
+    Sync sync(1, _driveDbId, _localTempDir.path(), "", "testSnapshotFile", _remoteSyncDirId);
+    sync.setDbPath(MockDb::makeDbName(1, 1, 1, 1));
+    (void) ParmsDb::instance()->insertSync(sync);
+
+    _syncPal = std::make_shared<SyncPalTest>(sync.dbId(), KDRIVE_VERSION_STRING);
+    _syncPal->syncDb()->setAutoDelete(true);
+    _syncPal->createSharedObjects();
+}
+
+void TestSnapshotFile::tearDown() {
+    if (_syncPal && _syncPal->syncDb()) {
+        (void) IoHelper::deleteItem(savedSnapshotPath());
+        (void) SyncNodeCache::instance()->update(_syncPal->syncDbId(), SyncNodeType::BlackList, {});
+        _syncPal->syncDb()->close();
+    }
+    _syncPal.reset();
+    _server.reset();
+    UrlHelper::setCustomApiUrl("");
+
+    HttpSessionPool::instance()->clear();
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    SyncJobManagerSingleton::instance()->stop();
+    SyncJobManagerSingleton::clear();
+    TestBase::stop();
+}
+
+std::shared_ptr<RemoteFileSystemObserverWorker> TestSnapshotFile::startObserver() {
+    auto observer = std::make_shared<RemoteFileSystemObserverWorker>(_syncPal, "Remote File System Observer", "RFSO");
+    CPPUNIT_ASSERT(observer->generateInitialSnapshot());
+    CPPUNIT_ASSERT(observer->liveSnapshot().isValid());
+    return observer;
+}
+
+SyncPath TestSnapshotFile::savedSnapshotPath() const {
+    return SnapshotFile::path(_syncPal->syncDb()->dbPath());
+}
+
+void TestSnapshotFile::testSaveAndLoad() {
+    LiveSnapshot snapshot(ReplicaSide::Remote, _syncPal->syncDb()->rootNode());
+    const NodeId rootId = snapshot.rootFolderId();
+    const auto time = testhelpers::defaultTime;
+    SnapshotItem file("11", "10", Str("résumé.txt"), time, time + 1, NodeType::File, 123, false, true, true);
+    file.setContentChecksum("xxh3:0123456789abcdef");
+    CPPUNIT_ASSERT(snapshot.updateItems({
+            SnapshotItem("10", rootId, Str("Documents"), time, time, NodeType::Directory, 0, false, true, true),
+            file,
+            SnapshotItem("12", "10", Str("link"), time, time, NodeType::File, 4, true, false, true),
+            SnapshotItem("13", "10", Str("Nested"), time, time, NodeType::Directory, 0, false, true, false),
+            SnapshotItem("14", "13", Str("empty.txt"), -1, 0, NodeType::File, 0, false, false, false),
+    }));
+
+    const SyncPath filePath = _localTempDir.path() / "snapshot";
+    const SnapshotFile::Header header{rootId, "cursor", "fingerprint"};
+    CPPUNIT_ASSERT(SnapshotFile::save(snapshot, header, filePath));
+
+    SnapshotFile::Header loadedHeader;
+    std::vector<SnapshotItem> items;
+    CPPUNIT_ASSERT(SnapshotFile::load(filePath, loadedHeader, items));
+    CPPUNIT_ASSERT_EQUAL(header.rootFolderId, loadedHeader.rootFolderId);
+    CPPUNIT_ASSERT_EQUAL(header.cursor, loadedHeader.cursor);
+    CPPUNIT_ASSERT_EQUAL(header.fingerprint, loadedHeader.fingerprint);
+    // The root item is not saved, and parents come before their children
+    CPPUNIT_ASSERT_EQUAL(size_t(5), items.size());
+    CPPUNIT_ASSERT_EQUAL(NodeId("10"), items.front().id());
+    CPPUNIT_ASSERT_EQUAL(NodeId("14"), items.back().id());
+
+    LiveSnapshot loadedSnapshot(ReplicaSide::Remote, _syncPal->syncDb()->rootNode());
+    CPPUNIT_ASSERT(loadedSnapshot.updateItems(items));
+    checkSameItems(snapshot, loadedSnapshot);
+}
+
+void TestSnapshotFile::testCorruptedFile() {
+    LiveSnapshot snapshot(ReplicaSide::Remote, _syncPal->syncDb()->rootNode());
+    const auto time = testhelpers::defaultTime;
+    CPPUNIT_ASSERT(snapshot.updateItems({
+            SnapshotItem("10", snapshot.rootFolderId(), Str("dir"), time, time, NodeType::Directory, 0, false, true, true),
+            SnapshotItem("11", "10", Str("file.txt"), time, time, NodeType::File, 10, false, true, true),
+    }));
+
+    const SyncPath filePath = _localTempDir.path() / "snapshot";
+    CPPUNIT_ASSERT(SnapshotFile::save(snapshot, {snapshot.rootFolderId(), "cursor", "fingerprint"}, filePath));
+    const std::string content = readFile(filePath);
+
+    SnapshotFile::Header header;
+    std::vector<SnapshotItem> items;
+    CPPUNIT_ASSERT(!SnapshotFile::load(_localTempDir.path() / "missing", header, items));
+
+    // Any changed byte is detected
+    for (size_t position = 0; position < content.size(); ++position) {
+        std::string corruptedContent = content;
+        corruptedContent[position] = static_cast<char>(corruptedContent[position] ^ 0x20);
+        writeFile(filePath, corruptedContent);
+        CPPUNIT_ASSERT(!SnapshotFile::load(filePath, header, items));
+    }
+
+    writeFile(filePath, content.substr(0, content.size() - 1));
+    CPPUNIT_ASSERT(!SnapshotFile::load(filePath, header, items));
+    writeFile(filePath, content + "x");
+    CPPUNIT_ASSERT(!SnapshotFile::load(filePath, header, items));
+    writeFile(filePath, "");
+    CPPUNIT_ASSERT(!SnapshotFile::load(filePath, header, items));
+
+    writeFile(filePath, content);
+    CPPUNIT_ASSERT(SnapshotFile::load(filePath, header, items));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), items.size());
+}
+
+void TestSnapshotFile::testWarmStart() {
+    const SyncPath filePath = savedSnapshotPath();
+    {
+        const auto observer = startObserver();
+        CPPUNIT_ASSERT_EQUAL(uint64_t(1), _server->stats().fullListingCount);
+        observer->saveSnapshot();
+    }
+    CPPUNIT_ASSERT(std::filesystem::exists(filePath));
+
+    // Changes made by another client while the app is not running
+    const NodeId dirId = _server->childId(_remoteSyncDirId, "dir0");
+    const NodeId otherDirId = _server->childId(_remoteSyncDirId, "dir1");
+    CPPUNIT_ASSERT(!_server->createFile(dirId, "new.txt", "new").empty());
+    CPPUNIT_ASSERT(_server->editFile(_server->childId(dirId, fileName(0)), "edited"));
+    CPPUNIT_ASSERT(_server->rename(_server->childId(dirId, fileName(1)), "renamed.txt"));
+    CPPUNIT_ASSERT(_server->move(_server->childId(dirId, fileName(2)), otherDirId));
+    CPPUNIT_ASSERT(_server->remove(_server->childId(dirId, fileName(3))));
+    CPPUNIT_ASSERT(_server->remove(_server->childId(dirId, "subDir")));
+    const NodeId newDirId = _server->createDirectory(otherDirId, "newDir");
+    CPPUNIT_ASSERT(!_server->createFile(newDirId, "nested.txt", "nested").empty());
+
+    _server->resetStats();
+    const auto warmObserver = startObserver();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), _server->stats().fullListingCount);
+    CPPUNIT_ASSERT(!std::filesystem::exists(filePath)); // A saved snapshot is used only once
+
+    const auto coldObserver = startObserver();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _server->stats().fullListingCount);
+    checkSameItems(coldObserver->liveSnapshot(), warmObserver->liveSnapshot());
+}
+
+void TestSnapshotFile::testWarmStartFallback() {
+    const SyncPath filePath = savedSnapshotPath();
+    auto observer = startObserver();
+    const uint64_t itemCount = observer->liveSnapshot().nbItems();
+
+    // Corrupted file
+    observer->saveSnapshot();
+    std::string content = readFile(filePath);
+    content[content.size() / 2] = static_cast<char>(content[content.size() / 2] ^ 0x20);
+    writeFile(filePath, content);
+    _server->resetStats();
+    observer = startObserver();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _server->stats().fullListingCount);
+    CPPUNIT_ASSERT_EQUAL(itemCount, observer->liveSnapshot().nbItems());
+    CPPUNIT_ASSERT(!std::filesystem::exists(filePath));
+
+    // Expired cursor
+    observer->saveSnapshot();
+    const NodeId newFileId = _server->createFile(_remoteSyncDirId, "new.txt", "new");
+    _server->expireCursors();
+    _server->resetStats();
+    observer = startObserver();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _server->stats().fullListingCount);
+    CPPUNIT_ASSERT(observer->liveSnapshot().exists(newFileId));
+    CPPUNIT_ASSERT(!std::filesystem::exists(filePath));
+
+    // Blacklist changed since the snapshot was saved
+    observer->saveSnapshot();
+    (void) SyncNodeCache::instance()->update(_syncPal->syncDbId(), SyncNodeType::BlackList,
+                                             {_server->childId(_remoteSyncDirId, "dir0")});
+    _server->resetStats();
+    observer = startObserver();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), _server->stats().fullListingCount);
+    CPPUNIT_ASSERT(!std::filesystem::exists(filePath));
+}
+
+} // namespace KDC
@@ -0,0 +1,65 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+
+#include "test_classes/syncpaltest.h"
+#include "test_utility/localtemporarydirectory.h"
+#include "test_utility/mockkdriveserver.h"
+
+using namespace CppUnit;
+
+namespace KDC {
+
+class RemoteFileSystemObserverWorker;
+
+class TestSnapshotFile : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestSnapshotFile);
+        CPPUNIT_TEST(testSaveAndLoad);
+        CPPUNIT_TEST(testCorruptedFile);
+        CPPUNIT_TEST(testWarmStart);
+        CPPUNIT_TEST(testWarmStartFallback);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    protected:
+        void testSaveAndLoad();
+        void testCorruptedFile();
+        void testWarmStart(); // The reloaded snapshot, updated with the changes made meanwhile, matches a full listing
+        void testWarmStartFallback(); // Full listing if the file is corrupted, the cursor expired or the settings changed
+
+    private:
+        // Returns a new remote observer whose initial snapshot has been generated, as on app start.
+        std::shared_ptr<RemoteFileSystemObserverWorker> startObserver();
+        [[nodiscard]] SyncPath savedSnapshotPath() const;
+
+        std::unique_ptr<MockKDriveServer> _server;
+        std::shared_ptr<SyncPalTest> _syncPal;
+        NodeId _remoteSyncDirId;
+        DriveDbId _driveDbId = 1;
+
+        LocalTemporaryDirectory _localTempDir{"testSnapshotFile"};
+};
+
+} // namespace KDC
@@ -0,0 +1,156 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkextensionstatus.h"
+#include "testsocketcomm.h"
+
+#include "server/comm/syncrootindex.h"
+#include "libcommon/utility/timerutility.h"
+#include "libcommon/utility/utility.h"
+#include "libparms/db/parmsdb.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <thread>
+
+namespace KDC {
+
+namespace {
+
+constexpr size_t requestCount = 100000;
+constexpr size_t syncCount = 3;
+constexpr size_t pathCount = 20000; // Entries of the folder browsed in the file manager
+
+const CommString requestPrefix = Str("RETRIEVE_FILE_STATUS:");
+const CommString replyPrefix = Str("STATUS:OK:");
+
+// Reads the next '\n' terminated line, `buffer` keeps the bytes received after it
+bool readLine(SocketCommChannelTest &channel, CommString &buffer, CommString &line) {
+    size_t pos;
+    while ((pos = buffer.find(Str('\n'))) == CommString::npos) {
+        CommChar data[4096];
+        const auto size = channel.readData(data, std::size(data));
+        if (size == 0) return false;
+        (void) buffer.append(data, size);
+    }
+
+    line = buffer.substr(0, pos);
+    (void) buffer.erase(0, pos + 1);
+    return true;
+}
+
+} // namespace
+
+void BenchmarkExtensionStatus::setUp() {
+    TestBase::start();
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, "123");
+    (void) ParmsDb::instance()->insertUser(user);
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+    const Drive drive(1, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+
+    for (SyncDbId syncDbId = 1; syncDbId <= static_cast<SyncDbId>(syncCount); ++syncDbId) {
+        const SyncPath syncPath = _localTempDir.path() / ("kDrive" + std::to_string(syncDbId));
+        (void) ParmsDb::instance()->insertSync(Sync(syncDbId, drive.dbId(), syncPath, NodeId(), SyncPath(), NodeId()));
+    }
+
+    // The requests target the last sync, which is the worst case for a linear scan of the sync list
+    const SyncPath folderPath = _localTempDir.path() / ("kDrive" + std::to_string(syncCount)) / "Folder";
+    for (size_t index = 0; index < pathCount; ++index) {
+        _paths.push_back(folderPath / ("file" + std::to_string(index) + ".txt"));
+    }
+}
+
+void BenchmarkExtensionStatus::tearDown() {
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    TestBase::stop();
+}
+
+double BenchmarkExtensionStatus::replayRequests(const std::function<bool(const SyncPath &, Sync &)> &syncForPath) {
+    SocketCommServerTest server("BenchmarkExtensionStatus");
+    CPPUNIT_ASSERT(server.listen());
+
+    Poco::Net::StreamSocket clientSocket;
+    clientSocket.connect(Poco::Net::SocketAddress(SocketCommServer::getHost(), server.getPort()));
+    SocketCommChannelTest clientChannel(clientSocket);
+
+    int remainWait = 100; // wait max 1 second
+    while (server.connections().empty() && remainWait-- > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const auto serverChannel = std::dynamic_pointer_cast<SocketCommChannelTest>(server.nextPendingConnection());
+    CPPUNIT_ASSERT(serverChannel);
+
+    size_t resolvedCount = 0;
+    std::thread serverThread([&serverChannel, &syncForPath, &resolvedCount]() {
+        CommString buffer;
+        CommString request;
+        for (size_t index = 0; index < requestCount && readLine(*serverChannel, buffer, request); ++index) {
+            const SyncPath path(request.substr(requestPrefix.size()));
+            if (Sync sync; syncForPath(path, sync) && sync.dbId() == static_cast<SyncDbId>(syncCount)) ++resolvedCount;
+            const CommString reply = replyPrefix + path.native() + Str('\n');
+            (void) serverChannel->writeData(reply.c_str(), reply.size());
+        }
+    });
+
+    // Like the file manager extensions, wait for the status of an item before asking for the next one
+    TimerUtility timer;
+    CommString buffer;
+    CommString reply;
+    for (size_t index = 0; index < requestCount; ++index) {
+        const CommString request = requestPrefix + _paths[index % _paths.size()].native() + Str('\n');
+        (void) clientChannel.writeData(request.c_str(), request.size());
+        if (!readLine(clientChannel, buffer, reply)) break;
+    }
+    const double duration = timer.elapsed<DoubleSeconds>().count();
+
+    serverThread.join();
+    CPPUNIT_ASSERT_EQUAL(requestCount, resolvedCount);
+    return duration;
+}
+
+void BenchmarkExtensionStatus::benchmarkStatusRequests() {
+    std::cout << std::endl;
+
+    const double parmsDbDuration = replayRequests([](const SyncPath &path, Sync &sync) {
+        std::vector<Sync> syncList;
+        if (!ParmsDb::instance()->selectAllSyncs(syncList)) return false;
+        for (const auto &tmpSync: syncList) {
+            if (CommonUtility::isSubDir(tmpSync.localPath(), path)) {
+                sync = tmpSync;
+                return true;
+            }
+        }
+        return false;
+    });
+    std::cout << requestCount << " status requests with ParmsDb::selectAllSyncs: " << parmsDbDuration << "s ("
+              << static_cast<double>(requestCount) / parmsDbDuration << " requests/s)" << std::endl;
+
+    const double indexDuration = replayRequests(
+            [](const SyncPath &path, Sync &sync) { return SyncRootIndex::instance()->syncForPath(path, sync); });
+    std::cout << requestCount << " status requests with SyncRootIndex: " << indexDuration << "s ("
+              << static_cast<double>(requestCount) / indexDuration << " requests/s)" << std::endl;
+}
+
+} // namespace KDC
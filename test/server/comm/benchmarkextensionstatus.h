@@ -0,0 +1,52 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/localtemporarydirectory.h"
+#include "libcommon/utility/types.h"
+
+#include <functional>
+
+namespace KDC {
+
+class Sync;
+
+class BenchmarkExtensionStatus : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(BenchmarkExtensionStatus);
+        CPPUNIT_TEST(benchmarkStatusRequests);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() override;
+        void tearDown() override;
+
+    private:
+        // Replays 100k RETRIEVE_FILE_STATUS requests sent by a client over a local socket. The server resolves the sync of each
+        // path either by loading the sync list from ParmsDb, as done before, or with the SyncRootIndex.
+        void benchmarkStatusRequests();
+
+        double replayRequests(const std::function<bool(const SyncPath &, Sync &)> &syncForPath);
+
+        std::vector<SyncPath> _paths;
+        LocalTemporaryDirectory _localTempDir{"benchmarkExtensionStatus"};
+};
+
+} // namespace KDC
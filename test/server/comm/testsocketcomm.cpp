@@ -20,8 +20,22 @@
 
 #include "libcommon/utility/utility.h"
 
+#include <algorithm>
+#include <filesystem>
+
 namespace KDC {
 
+static size_t threadCount() {
+#if defined(__linux__)
+    std::error_code ec;
+    const auto it = std::filesystem::directory_iterator("/proc/self/task", ec);
+    if (ec) return 0;
+    return static_cast<size_t>(std::distance(it, std::filesystem::directory_iterator()));
+#else
+    return 0;
+#endif
+}
+
 // Mock implementation of readMessage and sendMessage for testing purpose
 CommString SocketCommChannelTest::readMessage() {
     CommChar data[1024];
@@ -228,4 +242,79 @@ void TestSocketComm::testChannelReadAndWriteData() {
     CPPUNIT_ASSERT(message.starts_with(longMessage.substr(99, 101)));
     CPPUNIT_ASSERT_EQUAL(uint64_t(0), serverSidechannel->bytesAvailable());
 }
+
+void TestSocketComm::testManyConcurrentClients() {
+    constexpr size_t clientCount = 200;
+    constexpr int roundCount = 10;
+    const CommString request = Str("ping");
+
+    const auto threadCountBeforeListen = threadCount();
+
+    // Start an echo server
+    auto _socketCommServerTest = std::make_unique<SocketCommServerTest>("TestSocketComm::testManyConcurrentClients");
+    _socketCommServerTest->setNewConnectionCbk([&_socketCommServerTest]() {
+        _socketCommServerTest->nextPendingConnection()->setReadyReadCbk([](std::shared_ptr<AbstractCommChannel> channel) {
+            auto channelTest = std::dynamic_pointer_cast<SocketCommChannelTest>(channel);
+            CommChar data[1024];
+            if (const auto len = channelTest->readData(data, 1024); len > 0) (void) channelTest->writeData(data, len);
+        });
+    });
+    CPPUNIT_ASSERT_MESSAGE("Server failed to start listening", _socketCommServerTest->listen());
+
+    const auto threadCountAfterListen = threadCount();
+
+    // Connect the clients
+    std::vector<std::shared_ptr<SocketCommChannelTest>> clientSideChannels;
+    for (size_t index = 0; index < clientCount; ++index) {
+        Poco::Net::StreamSocket clientSocket;
+        clientSocket.connect(Poco::Net::SocketAddress(SocketCommServer::getHost(), _socketCommServerTest->getPort()));
+        clientSideChannels.push_back(std::make_shared<SocketCommChannelTest>(clientSocket));
+    }
+
+    int remainWait = 500; // wait max 5 seconds
+    while (_socketCommServerTest->connections().size() < clientCount && remainWait-- > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    CPPUNIT_ASSERT_EQUAL(clientCount, _socketCommServerTest->connections().size());
+
+    // All the clients send a request before any reply is read, so the requests are handled concurrently
+    std::vector<std::chrono::microseconds> latencies;
+    latencies.reserve(clientCount * roundCount);
+    for (int round = 0; round < roundCount; ++round) {
+        std::vector<std::chrono::steady_clock::time_point> sendTimes;
+        for (const auto &clientSideChannel: clientSideChannels) {
+            sendTimes.push_back(std::chrono::steady_clock::now());
+            CPPUNIT_ASSERT(clientSideChannel->sendMessage(request));
+        }
+
+        for (size_t index = 0; index < clientCount; ++index) {
+            CommChar data[16];
+            uint64_t received = 0;
+            while (received < request.size()) {
+                const auto len = clientSideChannels[index]->readData(data + received, request.size() - received);
+                CPPUNIT_ASSERT_MESSAGE("Connection lost while waiting for the reply", len > 0);
+                received += len;
+            }
+            latencies.push_back(
+                    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sendTimes[index]));
+            CPPUNIT_ASSERT(CommString(data, received) == request);
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto p50 = latencies[latencies.size() / 2];
+    const auto p99 = latencies[latencies.size() * 99 / 100];
+    LOG_INFO(Log::instance()->getLogger(),
+             clientCount << " clients, latency p50=" << p50.count() << "us p99=" << p99.count() << "us");
+    CPPUNIT_ASSERT_MESSAGE("Request latency p99 is too high", p99 < std::chrono::seconds(1));
+
+    // The number of server threads does not depend on the number of connections
+    if (threadCountBeforeListen > 0) {
+        CPPUNIT_ASSERT_EQUAL(threadCountBeforeListen + 1 + SocketCommServer::workerCount(), threadCountAfterListen);
+        CPPUNIT_ASSERT_EQUAL(threadCountAfterListen, threadCount());
+    }
+
+    clientSideChannels.clear();
+    _socketCommServerTest->close();
+}
 } // namespace KDC
@@ -32,6 +32,9 @@ class SocketCommChannelTest : public SocketCommChannel {
         bool canReadMessage() override { return true; }
         CommString readMessage() override;
         bool sendMessage(const CommString &message) override;
+
+        using SocketCommChannel::readData;
+        using SocketCommChannel::writeData;
 };
 
 class SocketCommServerTest : public SocketCommServer {
@@ -49,6 +52,7 @@ class TestSocketComm : public CppUnit::TestFixture, public TestBase {
         CPPUNIT_TEST(testServerCallbacks);
         CPPUNIT_TEST(testChannelReadyReadCallback);
         CPPUNIT_TEST(testChannelReadAndWriteData);
+        CPPUNIT_TEST(testManyConcurrentClients);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -59,5 +63,6 @@ class TestSocketComm : public CppUnit::TestFixture, public TestBase {
         void testServerCallbacks();
         void testChannelReadyReadCallback();
         void testChannelReadAndWriteData();
+        void testManyConcurrentClients();
 };
 } // namespace KDC
@@ -0,0 +1,137 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "testsyncrootindex.h"
+
+#include "server/comm/syncrootindex.h"
+#include "libcommon/utility/utility.h"
+#include "libparms/db/parmsdb.h"
+
+#include "mocks/libcommonserver/db/mockdb.h"
+
+#include <optional>
+
+namespace KDC {
+
+void TestSyncRootIndex::setUp() {
+    TestBase::start();
+
+    (void) ParmsDb::instance(_localTempDir.path() / MockDb::makeDbMockFileName(), KDRIVE_VERSION_STRING, true, true);
+
+    const User user(1, 1, "123");
+    (void) ParmsDb::instance()->insertUser(user);
+
+    const Account account(1, 1, user.dbId(), "account1");
+    (void) ParmsDb::instance()->insertAccount(account);
+
+    _driveDbId = 1;
+    const Drive drive(_driveDbId, 1, account.dbId(), std::string(), 0, std::string());
+    (void) ParmsDb::instance()->insertDrive(drive);
+}
+
+void TestSyncRootIndex::tearDown() {
+    ParmsDb::instance()->close();
+    ParmsDb::reset();
+    TestBase::stop();
+}
+
+void TestSyncRootIndex::testSyncForPath() {
+    const SyncPath syncPath1 = _localTempDir.path() / "kDrive";
+    const SyncPath syncPath2 = _localTempDir.path() / "kDrive2";
+    CPPUNIT_ASSERT(ParmsDb::instance()->insertSync(Sync(1, _driveDbId, syncPath1, NodeId(), SyncPath(), NodeId())));
+    CPPUNIT_ASSERT(ParmsDb::instance()->insertSync(Sync(2, _driveDbId, syncPath2, NodeId(), SyncPath(), NodeId())));
+
+    std::vector<Sync> syncList;
+    CPPUNIT_ASSERT(ParmsDb::instance()->selectAllSyncs(syncList));
+
+    // The index must give the same answer as a scan of the sync list loaded from ParmsDb
+    const std::vector<SyncPath> paths = {syncPath1,
+                                         syncPath1 / "A",
+                                         syncPath1 / "A" / "AA.txt",
+                                         syncPath2 / "B",
+                                         _localTempDir.path() / "kDrive3" / "C",
+                                         _localTempDir.path(),
+                                         SyncPath("dummy") / "kDrive"};
+    for (const auto &path: paths) {
+        std::optional<SyncDbId> expectedSyncDbId;
+        for (const auto &sync: syncList) {
+            if (CommonUtility::isSubDir(sync.localPath(), path)) {
+                expectedSyncDbId = sync.dbId();
+                break;
+            }
+        }
+
+        Sync sync;
+        const bool found = SyncRootIndex::instance()->syncForPath(path, sync);
+        CPPUNIT_ASSERT_EQUAL(expectedSyncDbId.has_value(), found);
+        if (found) CPPUNIT_ASSERT_EQUAL(*expectedSyncDbId, sync.dbId());
+    }
+}
+
+void TestSyncRootIndex::testSyncListChanges() {
+    const SyncPath syncPath = _localTempDir.path() / "kDrive";
+    const SyncPath filePath = syncPath / "A" / "AA.txt";
+
+    Sync sync;
+    CPPUNIT_ASSERT(!SyncRootIndex::instance()->syncForPath(filePath, sync));
+
+    // Added sync
+    CPPUNIT_ASSERT(ParmsDb::instance()->insertSync(Sync(1, _driveDbId, syncPath, NodeId(), SyncPath(), NodeId())));
+    CPPUNIT_ASSERT(SyncRootIndex::instance()->syncForPath(filePath, sync));
+    CPPUNIT_ASSERT_EQUAL(SyncDbId{1}, sync.dbId());
+    CPPUNIT_ASSERT(!sync.paused());
+
+    // Paused sync
+    bool found = false;
+    CPPUNIT_ASSERT(ParmsDb::instance()->setSyncPaused(1, true, found) && found);
+    CPPUNIT_ASSERT(SyncRootIndex::instance()->syncForPath(filePath, sync));
+    CPPUNIT_ASSERT(sync.paused());
+
+    // Updated sync
+    const SyncPath newSyncPath = _localTempDir.path() / "kDrive (2)";
+    sync.setLocalPath(newSyncPath);
+    CPPUNIT_ASSERT(ParmsDb::instance()->updateSync(sync, found) && found);
+    CPPUNIT_ASSERT(!SyncRootIndex::instance()->syncForPath(filePath, sync));
+    CPPUNIT_ASSERT(SyncRootIndex::instance()->syncForPath(newSyncPath / "A", sync));
+
+    // Removed sync
+    CPPUNIT_ASSERT(ParmsDb::instance()->deleteSync(1, found) && found);
+    CPPUNIT_ASSERT(!SyncRootIndex::instance()->syncForPath(newSyncPath / "A", sync));
+    std::vector<Sync> syncList;
+    CPPUNIT_ASSERT(SyncRootIndex::instance()->syncs(syncList));
+    CPPUNIT_ASSERT(syncList.empty());
+}
+
+void TestSyncRootIndex::testDeletedDrive() {
+    const SyncPath syncPath = _localTempDir.path() / "kDrive";
+    CPPUNIT_ASSERT(ParmsDb::instance()->insertSync(Sync(1, _driveDbId, syncPath, NodeId(), SyncPath(), NodeId())));
+
+    Sync sync;
+    CPPUNIT_ASSERT(SyncRootIndex::instance()->syncForPath(syncPath / "A", sync));
+
+    // The sync is deleted in cascade with its drive
+    bool found = false;
+    CPPUNIT_ASSERT(ParmsDb::instance()->deleteDrive(_driveDbId, found) && found);
+    CPPUNIT_ASSERT(!SyncRootIndex::instance()->syncForPath(syncPath / "A", sync));
+    std::vector<Sync> syncList;
+    CPPUNIT_ASSERT(SyncRootIndex::instance()->syncs(syncList));
+    CPPUNIT_ASSERT(syncList.empty());
+}
+
+} // namespace KDC
@@ -0,0 +1,47 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "testincludes.h"
+#include "test_utility/localtemporarydirectory.h"
+
+namespace KDC {
+
+class TestSyncRootIndex : public CppUnit::TestFixture, public TestBase {
+        CPPUNIT_TEST_SUITE(TestSyncRootIndex);
+        CPPUNIT_TEST(testSyncForPath);
+        CPPUNIT_TEST(testSyncListChanges);
+        CPPUNIT_TEST(testDeletedDrive);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() final;
+        void tearDown() override;
+
+        void testSyncForPath();
+        void testSyncListChanges();
+        void testDeletedDrive();
+
+    private:
+        LocalTemporaryDirectory _localTempDir{"testSyncRootIndex"};
+        int _driveDbId{0};
+};
+
+} // namespace KDC
@@ -31,6 +31,8 @@
 #include "appserver/testappserver.h"
 #include "comm/guicommchannel/testguicommchannel.h"
 #include "comm/testsocketcomm.h"
+#include "comm/testsyncrootindex.h"
+#include "comm/benchmarkextensionstatus.h"
 #if defined(KD_WINDOWS)
 #include "comm/testpipecomm.h"
 #endif
@@ -51,12 +53,14 @@ CPPUNIT_TEST_SUITE_REGISTRATION(TestWindowsUpdater);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestServerRequests);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestAppServer);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSocketComm);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSyncRootIndex);
 #if defined(KD_WINDOWS)
 CPPUNIT_TEST_SUITE_REGISTRATION(TestPipeComm);
 #endif
 CPPUNIT_TEST_SUITE_REGISTRATION(TestGuiCommChannel);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestAbstractGuiJob);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestGuiJobPriority);
+// CPPUNIT_TEST_SUITE_REGISTRATION(BenchmarkExtensionStatus);
 } // namespace KDC
 
 int main(int, char **) {
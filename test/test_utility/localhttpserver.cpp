@@ -0,0 +1,92 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "localhttpserver.h"
+
+#include "jobs/network/httpsessionpool.h"
+
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServerParams.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SocketAddress.h>
+
+namespace KDC {
+
+namespace {
+
+class CallbackRequestHandler final : public Poco::Net::HTTPRequestHandler {
+    public:
+        explicit CallbackRequestHandler(const LocalHttpServer::RequestHandler &handler) :
+            _handler(handler) {}
+
+        void handleRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) override {
+            _handler(request, response);
+        }
+
+    private:
+        const LocalHttpServer::RequestHandler &_handler;
+};
+
+class CallbackRequestHandlerFactory final : public Poco::Net::HTTPRequestHandlerFactory {
+    public:
+        explicit CallbackRequestHandlerFactory(const LocalHttpServer::RequestHandler &handler) :
+            _handler(handler) {}
+
+        Poco::Net::HTTPRequestHandler *createRequestHandler(const Poco::Net::HTTPServerRequest &) override {
+            return new CallbackRequestHandler(_handler);
+        }
+
+    private:
+        const LocalHttpServer::RequestHandler _handler;
+};
+
+} // namespace
+
+LocalHttpServer::LocalHttpServer(const RequestHandler &handler, const int maxThreads /*= 16*/) :
+    _threadPool(2, maxThreads) {
+    auto *params = new Poco::Net::HTTPServerParams();
+    params->setKeepAlive(true);
+    params->setMaxKeepAliveRequests(0); // No limit
+    params->setMaxThreads(maxThreads);
+
+    const Poco::Net::ServerSocket socket(Poco::Net::SocketAddress("127.0.0.1", 0));
+    _server = std::make_unique<Poco::Net::HTTPServer>(new CallbackRequestHandlerFactory(handler), _threadPool, socket, params);
+    _server->start();
+    HttpSessionPool::instance()->allowPlainHttp(true);
+}
+
+LocalHttpServer::~LocalHttpServer() {
+    HttpSessionPool::instance()->allowPlainHttp(false);
+    _server->stopAll(true);
+    _threadPool.joinAll();
+}
+
+Poco::UInt16 LocalHttpServer::port() const {
+    return _server->port();
+}
+
+std::string LocalHttpServer::url(const std::string &path /*= "/"*/) const {
+    return "http://127.0.0.1:" + std::to_string(port()) + path;
+}
+
+int LocalHttpServer::totalConnections() const {
+    return _server->totalConnections();
+}
+
+} // namespace KDC
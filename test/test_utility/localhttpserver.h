@@ -0,0 +1,57 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/ThreadPool.h>
+
+namespace KDC {
+
+/**
+ * @brief A plain HTTP server listening on the loopback interface, used to test network jobs without a live kDrive server.
+ * The server is started at creation and stopped at destruction. HttpSessionPool creates plain HTTP sessions while it runs.
+ */
+class LocalHttpServer {
+    public:
+        using RequestHandler = std::function<void(Poco::Net::HTTPServerRequest &, Poco::Net::HTTPServerResponse &)>;
+
+        explicit LocalHttpServer(const RequestHandler &handler, int maxThreads = 16);
+        ~LocalHttpServer();
+
+        [[nodiscard]] Poco::UInt16 port() const;
+        [[nodiscard]] std::string url(const std::string &path = "/") const;
+
+        /**
+         * @brief The number of TCP connections accepted since the server has been started.
+         */
+        [[nodiscard]] int totalConnections() const;
+
+    private:
+        // Each kept-alive connection holds a thread: the default pool of Poco would make the clients wait above 16 connections
+        Poco::ThreadPool _threadPool;
+        std::unique_ptr<Poco::Net::HTTPServer> _server;
+};
+
+} // namespace KDC
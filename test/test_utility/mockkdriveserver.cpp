@@ -0,0 +1,832 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mockkdriveserver.h"
+
+#include <algorithm>
+#include <charconv>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <Poco/DeflatingStream.h>
+#include <Poco/URI.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Parser.h>
+
+namespace KDC {
+
+const NodeId MockKDriveServer::rootId = "1";
+
+namespace {
+
+constexpr size_t sliceSize = 64 * 1024; // 64KB
+constexpr uint64_t defaultContinueListingLimit = 1000;
+const std::string mimeTypeJson = "application/json";
+
+int64_t toInt(const std::string &str) {
+    int64_t value = 0;
+    if (const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        ec != std::errc() || ptr != str.data() + str.size()) {
+        return 0;
+    }
+    return value;
+}
+
+std::string queryValue(const std::map<std::string, std::string, std::less<>> &query, const std::string &key) {
+    const auto it = query.find(key);
+    return it == query.end() ? std::string() : it->second;
+}
+
+SyncTime now() {
+    using namespace std::chrono;
+    return duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+}
+
+Poco::JSON::Object::Ptr parseJson(const std::string &body) {
+    if (body.empty()) return new Poco::JSON::Object();
+    try {
+        return Poco::JSON::Parser().parse(body).extract<Poco::JSON::Object::Ptr>();
+    } catch (const Poco::Exception &) {
+        return nullptr;
+    }
+}
+
+std::string toString(const Poco::JSON::Object &obj) {
+    std::ostringstream os;
+    obj.stringify(os);
+    return os.str();
+}
+
+std::string csvName(const std::string &name) {
+    if (name.find_first_of(",\"\n") == std::string::npos) return name;
+
+    std::string quotedName = "\"";
+    for (const char c: name) {
+        if (c == '"') quotedName.push_back('"');
+        quotedName.push_back(c);
+    }
+    quotedName.push_back('"');
+    return quotedName;
+}
+
+} // namespace
+
+MockKDriveServer::MockKDriveServer(const Settings &settings /*= {}*/) :
+    _settings(settings) {
+    Item root;
+    root.id = toInt(rootId);
+    root.isDir = true;
+    root.createdAt = now();
+    root.lastModifiedAt = root.createdAt;
+    _lastId = root.id;
+    (void) _items.try_emplace(root.id, std::move(root));
+
+    // The sync engine runs many jobs in parallel, and each kept-alive connection holds a server thread
+    _server = std::make_unique<LocalHttpServer>(
+            [this](Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+                handleRequest(request, response);
+            },
+            128);
+}
+
+MockKDriveServer::~MockKDriveServer() {
+    {
+        const std::scoped_lock lock(_mutex);
+        _stopping = true;
+    }
+    _changeCondition.notify_all(); // Release the pending long poll requests
+    _server.reset();
+}
+
+void MockKDriveServer::setSettings(const Settings &settings) {
+    const std::scoped_lock lock(_mutex);
+    _settings = settings;
+}
+
+MockKDriveServer::Settings MockKDriveServer::settings() const {
+    const std::scoped_lock lock(_mutex);
+    return _settings;
+}
+
+MockKDriveServer::Stats MockKDriveServer::stats() const {
+    return {_requestCount, _injectedErrorCount, _bytesReceived, _bytesSent, _fullListingCount};
+}
+
+void MockKDriveServer::resetStats() {
+    _requestCount = 0;
+    _injectedErrorCount = 0;
+    _bytesReceived = 0;
+    _bytesSent = 0;
+    _fullListingCount = 0;
+}
+
+NodeId MockKDriveServer::createDirectory(const NodeId &parentId, const std::string &name) {
+    const std::scoped_lock lock(_mutex);
+    const Item *item = addItem(toInt(parentId), name, true, now(), now());
+    return item ? std::to_string(item->id) : NodeId();
+}
+
+NodeId MockKDriveServer::createFile(const NodeId &parentId, const std::string &name, const std::string &content) {
+    const std::scoped_lock lock(_mutex);
+    const Item *item = addItem(toInt(parentId), name, false, now(), now(), std::string(content));
+    return item ? std::to_string(item->id) : NodeId();
+}
+
+bool MockKDriveServer::editFile(const NodeId &id, const std::string &content) {
+    const std::scoped_lock lock(_mutex);
+    Item *item = findItem(toInt(id));
+    return item && setContent(*item, std::string(content), now());
+}
+
+bool MockKDriveServer::rename(const NodeId &id, const std::string &name) {
+    const std::scoped_lock lock(_mutex);
+    Item *item = findItem(toInt(id));
+    return item && renameItem(*item, name);
+}
+
+bool MockKDriveServer::move(const NodeId &id, const NodeId &parentId) {
+    const std::scoped_lock lock(_mutex);
+    Item *item = findItem(toInt(id));
+    return item && moveItem(*item, toInt(parentId));
+}
+
+bool MockKDriveServer::remove(const NodeId &id) {
+    const std::scoped_lock lock(_mutex);
+    Item *item = findItem(toInt(id));
+    if (!item || item->id == toInt(rootId)) return false;
+
+    removeItem(*item);
+    return true;
+}
+
+void MockKDriveServer::expireCursors() {
+    const std::scoped_lock lock(_mutex);
+    _minValidCursor = _actions.size();
+}
+
+NodeId MockKDriveServer::childId(const NodeId &parentId, const std::string &name) const {
+    const std::scoped_lock lock(_mutex);
+    const Item *parent = findItem(toInt(parentId));
+    const Item *child = parent ? findChild(*parent, name) : nullptr;
+    return child ? std::to_string(child->id) : NodeId();
+}
+
+std::vector<NodeId> MockKDriveServer::childIds(const NodeId &parentId) const {
+    const std::scoped_lock lock(_mutex);
+    std::vector<NodeId> ids;
+    if (const Item *parent = findItem(toInt(parentId)); parent) {
+        for (const auto id: parent->children) ids.push_back(std::to_string(id));
+    }
+    return ids;
+}
+
+bool MockKDriveServer::content(const NodeId &id, std::string &content) const {
+    const std::scoped_lock lock(_mutex);
+    const Item *item = findItem(toInt(id));
+    if (!item || item->isDir) return false;
+
+    content = item->content;
+    return true;
+}
+
+uint64_t MockKDriveServer::fileCount(const NodeId &dirId) const {
+    const std::scoped_lock lock(_mutex);
+    const Item *dir = findItem(toInt(dirId));
+    return dir ? countFiles(*dir) : 0;
+}
+
+void MockKDriveServer::handleRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+    using Poco::Net::HTTPRequest;
+    using Poco::Net::HTTPResponse;
+
+    ++_requestCount;
+    const Settings settings = this->settings();
+    if (settings.latency.count() > 0) std::this_thread::sleep_for(settings.latency);
+
+    const Poco::URI uri(request.getURI());
+    std::vector<std::string> segments;
+    uri.getPathSegments(segments);
+    Query query;
+    for (const auto &[key, value]: uri.getQueryParameters()) query.insert_or_assign(key, value);
+    std::string body = readBody(request);
+
+    // Expected path: /<API version>/drive/<drive ID>/<endpoint>
+    if (segments.size() < 4 || segments[1] != "drive") {
+        sendError(response, HTTPResponse::HTTP_NOT_FOUND, "route_not_found");
+        return;
+    }
+    const std::vector<std::string> route(segments.begin() + 3, segments.end());
+    const std::string &method = request.getMethod();
+
+    const bool isListing = route.size() == 3 && route[0] == "files" && route[1] == "listing";
+    if (!isListing && injectError(settings.errorRate)) {
+        ++_injectedErrorCount;
+        sendError(response, HTTPResponse::HTTP_INTERNAL_SERVER_ERROR, "injected_error");
+        return;
+    }
+
+    if (isListing && route[2] == "full") return handleFullListing(query, response);
+    if (isListing && route[2] == "continue") return handleContinueListing(query, response);
+    if (isListing && route[2] == "longpoll") return handleLongPoll(query, response);
+
+    if (route[0] == "upload") {
+        if (route.size() == 1) return handleUpload(query, body, response);
+        if (route.size() == 3 && route[1] == "session" && route[2] == "start") return handleUploadSessionStart(body, response);
+        if (route.size() == 3 && route[1] == "session" && method == HTTPRequest::HTTP_DELETE)
+            return handleUploadSessionCancel(route[2], response);
+        if (route.size() == 4 && route[1] == "session" && route[3] == "chunk")
+            return handleUploadSessionChunk(route[2], query, body, response);
+        if (route.size() == 4 && route[1] == "session" && route[3] == "finish")
+            return handleUploadSessionFinish(route[2], body, response);
+    }
+
+    if (route[0] == "files" && route.size() >= 2) {
+        const int64_t id = toInt(route[1]);
+        if (route.size() == 2 && method == HTTPRequest::HTTP_GET) return handleFileInfo(id, response);
+        if (route.size() == 2 && method == HTTPRequest::HTTP_DELETE) return handleDelete(id, response);
+        if (route.size() == 3 && route[2] == "download") return handleDownload(id, response);
+        if (route.size() == 3 && route[2] == "directory") return handleCreateDirectory(id, body, response);
+        if (route.size() == 3 && route[2] == "rename") return handleRename(id, body, response);
+        if (route.size() == 4 && route[2] == "move") return handleMove(id, toInt(route[3]), body, response);
+    }
+
+    sendError(response, HTTPResponse::HTTP_NOT_FOUND, "route_not_found");
+}
+
+void MockKDriveServer::handleFullListing(const Query &query, Poco::Net::HTTPServerResponse &response) {
+    std::string csv = "id,parent_id,name,type,size,created_at,last_modified_at,can_write,is_link\n";
+    size_t cursor = 0;
+    {
+        const std::scoped_lock lock(_mutex);
+        const Item *dir = findItem(toInt(queryValue(query, "directory_id")));
+        if (!dir || !dir->isDir) {
+            sendError(response, Poco::Net::HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        appendCsvRows(*dir, csv);
+        cursor = _actions.size();
+    }
+    ++_fullListingCount;
+    csv += "#EOF\n";
+
+    std::ostringstream zippedCsv;
+    Poco::DeflatingOutputStream deflater(zippedCsv, Poco::DeflatingStreamBuf::STREAM_GZIP);
+    deflater << csv;
+    deflater.close();
+
+    response.set("X-kDrive-Cursor", std::to_string(cursor));
+    sendBody(response, zippedCsv.str(), "text/csv");
+}
+
+void MockKDriveServer::handleContinueListing(const Query &query, Poco::Net::HTTPServerResponse &response) {
+    const auto cursor = static_cast<size_t>(std::max<int64_t>(toInt(queryValue(query, "cursor")), 0));
+    auto limit = static_cast<size_t>(toInt(queryValue(query, "limit")));
+    if (limit == 0) limit = defaultContinueListingLimit;
+
+    std::string data;
+    bool expiredCursor = false;
+    {
+        const std::scoped_lock lock(_mutex);
+        expiredCursor = cursor < _minValidCursor;
+        const size_t begin = std::min(cursor, _actions.size());
+        const size_t end = std::min(begin + limit, _actions.size());
+        data = R"({"cursor":")" + std::to_string(end) + R"(","has_more":)" + (end < _actions.size() ? "true" : "false") +
+               R"(,"actions":[)";
+        for (size_t index = begin; index < end; ++index) {
+            if (index > begin) data += ",";
+            data += _actions[index];
+        }
+        data += "]}";
+    }
+
+    if (expiredCursor) {
+        sendError(response, Poco::Net::HTTPResponse::HTTP_BAD_REQUEST, "invalid_cursor");
+        return;
+    }
+    sendData(response, data);
+}
+
+void MockKDriveServer::handleLongPoll(const Query &query, Poco::Net::HTTPServerResponse &response) {
+    const auto cursor = static_cast<size_t>(std::max<int64_t>(toInt(queryValue(query, "cursor")), 0));
+    bool changes = false;
+    {
+        std::unique_lock lock(_mutex);
+        changes = _changeCondition.wait_for(lock, _settings.longPollTimeout,
+                                            [this, cursor] { return _stopping || _actions.size() > cursor; }) &&
+                  !_stopping;
+    }
+    sendBody(response, std::string(R"({"result":"success","changes":)") + (changes ? "true" : "false") + "}", mimeTypeJson);
+}
+
+void MockKDriveServer::handleUpload(const Query &query, std::string &body, Poco::Net::HTTPServerResponse &response) {
+    using Poco::Net::HTTPResponse;
+
+    if (static_cast<uint64_t>(toInt(queryValue(query, "total_size"))) != body.size()) {
+        sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "upload_error");
+        return;
+    }
+
+    const SyncTime createdAt = query.contains("created_at") ? toInt(queryValue(query, "created_at")) : now();
+    const SyncTime lastModifiedAt = query.contains("last_modified_at") ? toInt(queryValue(query, "last_modified_at")) : now();
+
+    std::string itemData;
+    {
+        const std::scoped_lock lock(_mutex);
+        Item *item = nullptr;
+        if (query.contains("file_id")) {
+            item = findItem(toInt(queryValue(query, "file_id")));
+            if (!item || item->isDir) {
+                sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+                return;
+            }
+            (void) setContent(*item, std::move(body), lastModifiedAt);
+        } else {
+            item = addItem(toInt(queryValue(query, "directory_id")), queryValue(query, "file_name"), false, createdAt,
+                           lastModifiedAt, std::move(body));
+            if (!item) {
+                sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "destination_already_exists");
+                return;
+            }
+        }
+        itemData = itemJson(*item);
+    }
+    sendData(response, itemData);
+}
+
+void MockKDriveServer::handleUploadSessionStart(const std::string &body, Poco::Net::HTTPServerResponse &response) {
+    using Poco::Net::HTTPResponse;
+
+    const auto json = parseJson(body);
+    if (!json) {
+        sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "invalid_request");
+        return;
+    }
+
+    UploadSession session;
+    session.fileId = toInt(json->optValue<std::string>("file_id", ""));
+    session.parentId = toInt(json->optValue<std::string>("directory_id", ""));
+    session.name = json->optValue<std::string>("file_name", "");
+    session.totalSize = static_cast<uint64_t>(toInt(json->optValue<std::string>("total_size", "")));
+
+    std::string token;
+    {
+        const std::scoped_lock lock(_mutex);
+        if (session.fileId) {
+            if (const Item *item = findItem(session.fileId); !item || item->isDir) {
+                sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+                return;
+            }
+        } else {
+            const Item *parent = findItem(session.parentId);
+            if (!parent || !parent->isDir) {
+                sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+                return;
+            }
+            if (findChild(*parent, session.name)) {
+                sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "destination_already_exists");
+                return;
+            }
+        }
+        token = "session" + std::to_string(++_lastUploadSessionNumber);
+        (void) _uploadSessions.try_emplace(token, std::move(session));
+    }
+
+    Poco::JSON::Object data;
+    (void) data.set("token", token);
+    sendData(response, toString(data));
+}
+
+void MockKDriveServer::handleUploadSessionChunk(const std::string &token, const Query &query, std::string &body,
+                                                Poco::Net::HTTPServerResponse &response) {
+    const auto chunkNumber = static_cast<uint64_t>(toInt(queryValue(query, "chunk_number")));
+    const size_t receivedBytes = body.size();
+    {
+        const std::scoped_lock lock(_mutex);
+        const auto sessionIt = _uploadSessions.find(token);
+        if (sessionIt == _uploadSessions.end()) {
+            sendError(response, Poco::Net::HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        sessionIt->second.chunks.insert_or_assign(chunkNumber, std::move(body));
+    }
+
+    Poco::JSON::Object data;
+    (void) data.set("received_bytes", static_cast<Poco::UInt64>(receivedBytes));
+    sendData(response, toString(data));
+}
+
+void MockKDriveServer::handleUploadSessionFinish(const std::string &token, const std::string &body,
+                                                 Poco::Net::HTTPServerResponse &response) {
+    using Poco::Net::HTTPResponse;
+
+    const auto json = parseJson(body);
+    if (!json) {
+        sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "invalid_request");
+        return;
+    }
+    const SyncTime createdAt = json->optValue<SyncTime>("created_at", now());
+    const SyncTime lastModifiedAt = json->optValue<SyncTime>("last_modified_at", now());
+
+    std::string itemData;
+    {
+        const std::scoped_lock lock(_mutex);
+        const auto sessionIt = _uploadSessions.find(token);
+        if (sessionIt == _uploadSessions.end()) {
+            sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        UploadSession session = std::move(sessionIt->second);
+        (void) _uploadSessions.erase(sessionIt);
+
+        std::string content;
+        content.reserve(session.totalSize);
+        for (auto &[_, chunk]: session.chunks) content += chunk;
+        if (content.size() != session.totalSize) {
+            sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "upload_not_terminated_error");
+            return;
+        }
+
+        Item *item = nullptr;
+        if (session.fileId) {
+            item = findItem(session.fileId);
+            if (!item || item->isDir) {
+                sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+                return;
+            }
+            (void) setContent(*item, std::move(content), lastModifiedAt);
+        } else {
+            item = addItem(session.parentId, session.name, false, createdAt, lastModifiedAt, std::move(content));
+            if (!item) {
+                sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "destination_already_exists");
+                return;
+            }
+        }
+        itemData = R"({"token":")" + token + R"(","file":)" + itemJson(*item) + "}";
+    }
+    sendData(response, itemData);
+}
+
+void MockKDriveServer::handleUploadSessionCancel(const std::string &token, Poco::Net::HTTPServerResponse &response) {
+    {
+        const std::scoped_lock lock(_mutex);
+        if (_uploadSessions.erase(token) == 0) {
+            sendError(response, Poco::Net::HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+    }
+    sendData(response, "true");
+}
+
+void MockKDriveServer::handleDownload(const int64_t id, Poco::Net::HTTPServerResponse &response) {
+    std::string content;
+    {
+        const std::scoped_lock lock(_mutex);
+        const Item *item = findItem(id);
+        if (!item || item->isDir) {
+            sendError(response, Poco::Net::HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        content = item->content;
+    }
+    sendBody(response, content, "application/octet-stream");
+}
+
+void MockKDriveServer::handleFileInfo(const int64_t id, Poco::Net::HTTPServerResponse &response) {
+    std::string itemData;
+    {
+        const std::scoped_lock lock(_mutex);
+        const Item *item = findItem(id);
+        if (!item) {
+            sendError(response, Poco::Net::HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        itemData = itemJson(*item);
+    }
+    sendData(response, itemData);
+}
+
+void MockKDriveServer::handleCreateDirectory(const int64_t parentId, const std::string &body,
+                                             Poco::Net::HTTPServerResponse &response) {
+    using Poco::Net::HTTPResponse;
+
+    const auto json = parseJson(body);
+    if (!json || !json->has("name")) {
+        sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "invalid_request");
+        return;
+    }
+
+    std::string itemData;
+    {
+        const std::scoped_lock lock(_mutex);
+        const Item *parent = findItem(parentId);
+        if (!parent || !parent->isDir) {
+            sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        const Item *item = addItem(parentId, json->getValue<std::string>("name"), true, now(), now());
+        if (!item) {
+            sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "destination_already_exists");
+            return;
+        }
+        itemData = itemJson(*item);
+    }
+    sendData(response, itemData);
+}
+
+void MockKDriveServer::handleMove(const int64_t id, const int64_t parentId, const std::string &body,
+                                  Poco::Net::HTTPServerResponse &response) {
+    using Poco::Net::HTTPResponse;
+
+    const auto json = parseJson(body);
+    if (!json) {
+        sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "invalid_request");
+        return;
+    }
+
+    std::string itemData;
+    {
+        const std::scoped_lock lock(_mutex);
+        Item *item = findItem(id);
+        const Item *parent = findItem(parentId);
+        if (!item || !parent || !parent->isDir) {
+            sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        if (const auto name = json->optValue<std::string>("name", item->name);
+            (name != item->name && !renameItem(*item, name)) || (item->parentId != parentId && !moveItem(*item, parentId))) {
+            sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "destination_already_exists");
+            return;
+        }
+        itemData = itemJson(*item);
+    }
+    sendData(response, itemData);
+}
+
+void MockKDriveServer::handleRename(const int64_t id, const std::string &body, Poco::Net::HTTPServerResponse &response) {
+    using Poco::Net::HTTPResponse;
+
+    const auto json = parseJson(body);
+    if (!json || !json->has("name")) {
+        sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "invalid_request");
+        return;
+    }
+
+    std::string itemData;
+    {
+        const std::scoped_lock lock(_mutex);
+        Item *item = findItem(id);
+        if (!item) {
+            sendError(response, HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        if (!renameItem(*item, json->getValue<std::string>("name"))) {
+            sendError(response, HTTPResponse::HTTP_BAD_REQUEST, "destination_already_exists");
+            return;
+        }
+        itemData = itemJson(*item);
+    }
+    sendData(response, itemData);
+}
+
+void MockKDriveServer::handleDelete(const int64_t id, Poco::Net::HTTPServerResponse &response) {
+    {
+        const std::scoped_lock lock(_mutex);
+        Item *item = findItem(id);
+        if (!item || item->id == toInt(rootId)) {
+            sendError(response, Poco::Net::HTTPResponse::HTTP_NOT_FOUND, "object_not_found");
+            return;
+        }
+        removeItem(*item);
+    }
+    sendData(response, "true");
+}
+
+std::string MockKDriveServer::readBody(Poco::Net::HTTPServerRequest &request) {
+    std::string body;
+    if (const auto length = request.getContentLength64(); length > 0) body.reserve(static_cast<size_t>(length));
+
+    std::istream &stream = request.stream();
+    std::vector<char> buffer(sliceSize);
+    while (stream) {
+        (void) stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto readCount = static_cast<size_t>(stream.gcount());
+        if (readCount == 0) break;
+
+        (void) body.append(buffer.data(), readCount);
+        waitForBandwidth(readCount);
+    }
+
+    _bytesReceived += body.size();
+    return body;
+}
+
+void MockKDriveServer::sendBody(Poco::Net::HTTPServerResponse &response, const std::string &body,
+                                const std::string &contentType) {
+    response.setContentType(contentType);
+    response.setContentLength64(static_cast<Poco::Int64>(body.size()));
+
+    std::ostream &stream = response.send();
+    for (size_t offset = 0; offset < body.size() && stream; offset += sliceSize) {
+        const size_t length = std::min(sliceSize, body.size() - offset);
+        (void) stream.write(body.data() + offset, static_cast<std::streamsize>(length));
+        waitForBandwidth(length);
+    }
+    (void) stream.flush();
+
+    _bytesSent += body.size();
+}
+
+void MockKDriveServer::sendData(Poco::Net::HTTPServerResponse &response, const std::string &dataJson) {
+    sendBody(response, R"({"result":"success","data":)" + dataJson + "}", mimeTypeJson);
+}
+
+void MockKDriveServer::sendError(Poco::Net::HTTPServerResponse &response, const Poco::Net::HTTPResponse::HTTPStatus status,
+                                 const std::string &code) {
+    response.setStatus(status);
+    sendBody(response, R"({"result":"error","error":{"code":")" + code + R"(","description":"Mock kDrive server error"}})",
+             mimeTypeJson);
+}
+
+void MockKDriveServer::waitForBandwidth(const uint64_t byteCount) const {
+    const uint64_t bandwidth = settings().bandwidth;
+    if (bandwidth == 0) return;
+
+    std::this_thread::sleep_for(std::chrono::microseconds(byteCount * 1000000 / bandwidth));
+}
+
+bool MockKDriveServer::injectError(const double errorRate) const {
+    if (errorRate <= 0.) return false;
+
+    thread_local std::mt19937 generator{std::random_device{}()};
+    return std::uniform_real_distribution<double>(0., 1.)(generator) < errorRate;
+}
+
+MockKDriveServer::Item *MockKDriveServer::findItem(const int64_t id) {
+    const auto it = _items.find(id);
+    return it == _items.end() ? nullptr : &it->second;
+}
+
+const MockKDriveServer::Item *MockKDriveServer::findItem(const int64_t id) const {
+    const auto it = _items.find(id);
+    return it == _items.end() ? nullptr : &it->second;
+}
+
+const MockKDriveServer::Item *MockKDriveServer::findChild(const Item &parent, const std::string &name) const {
+    for (const auto childId: parent.children) {
+        if (const Item *child = findItem(childId); child && child->name == name) return child;
+    }
+    return nullptr;
+}
+
+MockKDriveServer::Item *MockKDriveServer::addItem(const int64_t parentId, const std::string &name, const bool isDir,
+                                                  const SyncTime createdAt, const SyncTime lastModifiedAt,
+                                                  std::string &&content /*= {}*/) {
+    Item *parent = findItem(parentId);
+    if (!parent || !parent->isDir || name.empty() || findChild(*parent, name)) return nullptr;
+
+    Item item;
+    item.id = ++_lastId;
+    item.parentId = parentId;
+    item.name = name;
+    item.isDir = isDir;
+    item.content = std::move(content);
+    item.createdAt = createdAt;
+    item.lastModifiedAt = lastModifiedAt;
+    (void) parent->children.insert(item.id);
+
+    Item &newItem = _items.try_emplace(item.id, std::move(item)).first->second;
+    recordAction("file_create", newItem);
+    return &newItem;
+}
+
+bool MockKDriveServer::setContent(Item &item, std::string &&content, const SyncTime lastModifiedAt) {
+    if (item.isDir) return false;
+
+    item.content = std::move(content);
+    item.lastModifiedAt = lastModifiedAt;
+    recordAction("file_update", item);
+    return true;
+}
+
+bool MockKDriveServer::renameItem(Item &item, const std::string &name) {
+    const Item *parent = findItem(item.parentId);
+    if (!parent || name.empty() || findChild(*parent, name)) return false;
+
+    item.name = name;
+    recordAction("file_rename", item);
+    return true;
+}
+
+bool MockKDriveServer::moveItem(Item &item, const int64_t parentId) {
+    Item *parent = findItem(parentId);
+    if (!parent || !parent->isDir || findChild(*parent, item.name)) return false;
+
+    // The destination must not be inside the moved item
+    for (const Item *ancestor = parent; ancestor; ancestor = findItem(ancestor->parentId)) {
+        if (ancestor->id == item.id) return false;
+    }
+
+    recordAction("file_move_out", item);
+    (void) _items[item.parentId].children.erase(item.id);
+    item.parentId = parentId;
+    (void) parent->children.insert(item.id);
+    recordAction("file_move", item);
+    return true;
+}
+
+void MockKDriveServer::removeItem(Item &item) {
+    recordAction("file_trash", item);
+    (void) _items[item.parentId].children.erase(item.id);
+
+    std::vector<int64_t> removedIds{item.id};
+    for (size_t index = 0; index < removedIds.size(); ++index) {
+        const Item &removedItem = _items[removedIds[index]];
+        removedIds.insert(removedIds.end(), removedItem.children.begin(), removedItem.children.end());
+    }
+    for (const auto id: removedIds) (void) _items.erase(id);
+}
+
+std::string MockKDriveServer::path(const Item &item) const {
+    std::string path;
+    for (const Item *ancestor = &item; ancestor && ancestor->id != toInt(rootId); ancestor = findItem(ancestor->parentId)) {
+        path.insert(0, "/" + ancestor->name);
+    }
+    return path.empty() ? "/" : path;
+}
+
+std::string MockKDriveServer::itemJson(const Item &item) const {
+    Poco::JSON::Object capabilities;
+    (void) capabilities.set("can_write", true);
+
+    Poco::JSON::Object json;
+    (void) json.set("id", item.id);
+    (void) json.set("parent_id", item.parentId);
+    (void) json.set("name", item.name);
+    (void) json.set("type", item.isDir ? "dir" : "file");
+    (void) json.set("size", static_cast<Poco::UInt64>(item.content.size()));
+    (void) json.set("created_at", item.createdAt);
+    (void) json.set("last_modified_at", item.lastModifiedAt);
+    (void) json.set("path", path(item));
+    (void) json.set("capabilities", capabilities);
+    return toString(json);
+}
+
+void MockKDriveServer::recordAction(const std::string &action, const Item &item) {
+    Poco::JSON::Object capabilities;
+    (void) capabilities.set("can_write", true);
+
+    Poco::JSON::Object json;
+    (void) json.set("action", action);
+    (void) json.set("file_id", item.id);
+    (void) json.set("parent_id", item.parentId);
+    (void) json.set("path", path(item));
+    (void) json.set("file_type", item.isDir ? "dir" : "file");
+    (void) json.set("size", static_cast<Poco::UInt64>(item.content.size()));
+    (void) json.set("created_at", item.createdAt);
+    (void) json.set("last_modified_at", item.lastModifiedAt);
+    (void) json.set("capabilities", capabilities);
+    _actions.push_back(toString(json));
+
+    _changeCondition.notify_all();
+}
+
+void MockKDriveServer::appendCsvRows(const Item &dir, std::string &csv) const {
+    for (const auto childId: dir.children) {
+        const Item *child = findItem(childId);
+        if (!child) continue;
+
+        csv += std::to_string(child->id) + "," + std::to_string(child->parentId) + "," + csvName(child->name) + "," +
+               (child->isDir ? "dir" : "file") + "," + std::to_string(child->content.size()) + "," +
+               std::to_string(child->createdAt) + "," + std::to_string(child->lastModifiedAt) + ",1,0\n";
+        if (child->isDir) appendCsvRows(*child, csv);
+    }
+}
+
+uint64_t MockKDriveServer::countFiles(const Item &dir) const {
+    uint64_t count = 0;
+    for (const auto childId: dir.children) {
+        const Item *child = findItem(childId);
+        if (!child) continue;
+
+        count += child->isDir ? countFiles(*child) : 1;
+    }
+    return count;
+}
+
+} // namespace KDC
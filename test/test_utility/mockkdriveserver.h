@@ -0,0 +1,184 @@
+/*
+ * Infomaniak kDrive - Desktop
+ * Copyright (C) 2023-2026 Infomaniak Network SA
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "localhttpserver.h"
+#include "utility/types.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace KDC {
+
+/**
+ * @brief An in-memory kDrive, served on the loopback interface through the endpoints used by the sync engine: CSV full
+ * listing, listing continuation with cursor, long poll, upload, upload session, download, directory creation, move, rename
+ * and deletion.
+ * The API requests of the app are redirected to this server by calling `UrlHelper::setCustomApiUrl` with `apiUrl()`.
+ * Every change, made through the API or through the public methods simulating another client, is recorded in a change
+ * log read by the listing continuation.
+ */
+class MockKDriveServer {
+    public:
+        struct Settings {
+                // Waited before handling each request.
+                std::chrono::milliseconds latency{0};
+                // Bytes per second of each request body and each reply body. 0 means unlimited.
+                uint64_t bandwidth = 0;
+                // Share of the requests answered with an HTTP 500 error, listing requests excepted.
+                double errorRate = 0.;
+                // Maximum duration of a long poll request without any change.
+                std::chrono::milliseconds longPollTimeout{std::chrono::seconds(50)};
+        };
+
+        struct Stats {
+                uint64_t requestCount = 0;
+                uint64_t injectedErrorCount = 0;
+                uint64_t bytesReceived = 0;
+                uint64_t bytesSent = 0;
+                uint64_t fullListingCount = 0;
+        };
+
+        static const NodeId rootId;
+
+        explicit MockKDriveServer(const Settings &settings = {});
+        ~MockKDriveServer();
+
+        [[nodiscard]] std::string apiUrl() const { return _server->url(); }
+
+        void setSettings(const Settings &settings);
+        [[nodiscard]] Settings settings() const;
+
+        [[nodiscard]] Stats stats() const;
+        void resetStats();
+
+        // The methods below simulate the changes made by another client. They return an empty ID or false if the parent or the
+        // item does not exist or if the name is already used.
+        NodeId createDirectory(const NodeId &parentId, const std::string &name);
+        NodeId createFile(const NodeId &parentId, const std::string &name, const std::string &content);
+        bool editFile(const NodeId &id, const std::string &content);
+        bool rename(const NodeId &id, const std::string &name);
+        bool move(const NodeId &id, const NodeId &parentId);
+        bool remove(const NodeId &id);
+
+        // Rejects the listing continuation from any cursor older than the current state, as the server does with expired
+        // cursors.
+        void expireCursors();
+
+        [[nodiscard]] NodeId childId(const NodeId &parentId, const std::string &name) const;
+        [[nodiscard]] std::vector<NodeId> childIds(const NodeId &parentId) const;
+        [[nodiscard]] bool content(const NodeId &id, std::string &content) const;
+        // The number of files in the subtree of a directory.
+        [[nodiscard]] uint64_t fileCount(const NodeId &dirId) const;
+
+    private:
+        using Query = std::map<std::string, std::string, std::less<>>;
+
+        struct Item {
+                int64_t id = 0;
+                int64_t parentId = 0;
+                std::string name;
+                bool isDir = false;
+                std::string content;
+                SyncTime createdAt = 0;
+                SyncTime lastModifiedAt = 0;
+                std::set<int64_t> children;
+        };
+
+        struct UploadSession {
+                int64_t parentId = 0;
+                int64_t fileId = 0;
+                std::string name;
+                uint64_t totalSize = 0;
+                std::map<uint64_t, std::string> chunks;
+        };
+
+        void handleRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response);
+
+        void handleFullListing(const Query &query, Poco::Net::HTTPServerResponse &response);
+        void handleContinueListing(const Query &query, Poco::Net::HTTPServerResponse &response);
+        void handleLongPoll(const Query &query, Poco::Net::HTTPServerResponse &response);
+        void handleUpload(const Query &query, std::string &body, Poco::Net::HTTPServerResponse &response);
+        void handleUploadSessionStart(const std::string &body, Poco::Net::HTTPServerResponse &response);
+        void handleUploadSessionChunk(const std::string &token, const Query &query, std::string &body,
+                                      Poco::Net::HTTPServerResponse &response);
+        void handleUploadSessionFinish(const std::string &token, const std::string &body,
+                                       Poco::Net::HTTPServerResponse &response);
+        void handleUploadSessionCancel(const std::string &token, Poco::Net::HTTPServerResponse &response);
+        void handleDownload(int64_t id, Poco::Net::HTTPServerResponse &response);
+        void handleFileInfo(int64_t id, Poco::Net::HTTPServerResponse &response);
+        void handleCreateDirectory(int64_t parentId, const std::string &body, Poco::Net::HTTPServerResponse &response);
+        void handleMove(int64_t id, int64_t parentId, const std::string &body, Poco::Net::HTTPServerResponse &response);
+        void handleRename(int64_t id, const std::string &body, Poco::Net::HTTPServerResponse &response);
+        void handleDelete(int64_t id, Poco::Net::HTTPServerResponse &response);
+
+        std::string readBody(Poco::Net::HTTPServerRequest &request);
+        void sendBody(Poco::Net::HTTPServerResponse &response, const std::string &body, const std::string &contentType);
+        void sendData(Poco::Net::HTTPServerResponse &response, const std::string &dataJson);
+        void sendError(Poco::Net::HTTPServerResponse &response, Poco::Net::HTTPResponse::HTTPStatus status,
+                       const std::string &code);
+        void waitForBandwidth(uint64_t byteCount) const;
+        [[nodiscard]] bool injectError(double errorRate) const;
+
+        // The methods below must be called with `_mutex` locked.
+        Item *findItem(int64_t id);
+        const Item *findItem(int64_t id) const;
+        [[nodiscard]] const Item *findChild(const Item &parent, const std::string &name) const;
+        Item *addItem(int64_t parentId, const std::string &name, bool isDir, SyncTime createdAt, SyncTime lastModifiedAt,
+                      std::string &&content = {});
+        bool setContent(Item &item, std::string &&content, SyncTime lastModifiedAt);
+        bool renameItem(Item &item, const std::string &name);
+        bool moveItem(Item &item, int64_t parentId);
+        void removeItem(Item &item);
+        [[nodiscard]] std::string path(const Item &item) const;
+        [[nodiscard]] std::string itemJson(const Item &item) const;
+        void recordAction(const std::string &action, const Item &item);
+        void appendCsvRows(const Item &dir, std::string &csv) const;
+        uint64_t countFiles(const Item &dir) const;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _changeCondition;
+        bool _stopping = false;
+        Settings _settings;
+        std::unordered_map<int64_t, Item> _items;
+        int64_t _lastId = 0;
+        // Each action is stored as a JSON object of the listing continuation reply. The cursor is the number of actions read.
+        std::vector<std::string> _actions;
+        size_t _minValidCursor = 0;
+        std::unordered_map<std::string, UploadSession> _uploadSessions;
+        uint64_t _lastUploadSessionNumber = 0;
+
+        std::atomic<uint64_t> _requestCount{0};
+        std::atomic<uint64_t> _injectedErrorCount{0};
+        std::atomic<uint64_t> _bytesReceived{0};
+        std::atomic<uint64_t> _bytesSent{0};
+        std::atomic<uint64_t> _fullListingCount{0};
+
+        // Declared last: the request handlers must be stopped before the state is destroyed.
+        std::unique_ptr<LocalHttpServer> _server;
+};
+
+} // namespace KDC